@@ -27,10 +27,25 @@
 
 #include <array>
 #include <cstdint>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include <Crypt/codec/AES.hpp>
+#include <Crypt/codec/AES_CBC.hpp>
+#include <Crypt/codec/AES_CCM.hpp>
+#include <Crypt/codec/AES_CFB.hpp>
+#include <Crypt/codec/AES_CMAC.hpp>
+#include <Crypt/codec/AES_CTR.hpp>
+#include <Crypt/codec/AES_CTR_DRBG.hpp>
+#include <Crypt/codec/AES_GCM.hpp>
+#include <Crypt/codec/AES_GCM_SIV.hpp>
+#include <Crypt/codec/AES_key_cache.hpp>
+#include <Crypt/codec/AES_key_wrap.hpp>
+#include <Crypt/codec/AES_multi_buffer.hpp>
+#include <Crypt/codec/AES_OFB.hpp>
+#include <Crypt/codec/AES_XTS.hpp>
+#include <Crypt/worker_pool.hpp>
 
 constexpr std::array<uint8_t, 32> test_key =
 {
@@ -152,3 +167,914 @@ static inline void AES256_decode(benchmark::State& state)
 
 BENCHMARK(AES256_encode);
 BENCHMARK(AES256_decode);
+
+static inline void AES256_encode_blocks(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	for (auto _ : state)
+	{
+		AES_t::encode_blocks(tkey_schedule, buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static inline void AES256_decode_blocks(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	for (auto _ : state)
+	{
+		AES_t::decode_blocks(tkey_schedule, buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(AES256_encode_blocks)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(AES256_decode_blocks)->Arg(1 << 10)->Arg(1 << 16);
+
+static inline void AES256_CTR(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_CTR<AES_t> engine;
+	engine.reset(tkey_schedule, test_data);
+
+	for (auto _ : state)
+	{
+		engine.update(buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(AES256_CTR)->Arg(1 << 10)->Arg(1 << 16);
+
+static inline void AES256_GCM(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_GCM<AES_t> engine;
+	engine.set_key(tkey_schedule);
+
+	for (auto _ : state)
+	{
+		engine.reset(std::span<const uint8_t>{test_data.data(), 12});
+		engine.encode(buffer, buffer);
+		engine.finalize();
+		benchmark::DoNotOptimize(engine.tag());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(AES256_GCM)->Arg(1 << 10)->Arg(1 << 16);
+
+static inline void AES256_GCM_SIV_encode(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+	using SIV_t = crypto::AES_GCM_SIV<AES_t>;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+	const std::span<const uint8_t, SIV_t::nonce_lenght> nonce{test_data.data(), SIV_t::nonce_lenght};
+
+	SIV_t engine;
+	engine.set_key(tkey_schedule);
+
+	SIV_t::tag_t tag;
+	for (auto _ : state)
+	{
+		engine.encode(nonce, std::span<const uint8_t>{}, buffer, buffer, tag);
+		benchmark::DoNotOptimize(tag);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static inline void AES256_GCM_SIV_decode(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+	using SIV_t = crypto::AES_GCM_SIV<AES_t>;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+	const std::span<const uint8_t, SIV_t::nonce_lenght> nonce{test_data.data(), SIV_t::nonce_lenght};
+
+	SIV_t engine;
+	engine.set_key(tkey_schedule);
+
+	SIV_t::tag_t tag;
+	engine.encode(nonce, std::span<const uint8_t>{}, buffer, buffer, tag);
+	std::vector<uint8_t> out(buffer.size());
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(engine.decode(nonce, std::span<const uint8_t>{}, buffer, out, tag));
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(AES256_GCM_SIV_encode)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(AES256_GCM_SIV_decode)->Arg(1 << 10)->Arg(1 << 16);
+
+static inline void AES256_CCM(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_CCM<AES_t> engine;
+	engine.set_key(tkey_schedule);
+
+	for (auto _ : state)
+	{
+		engine.reset(std::span<const uint8_t>{test_data.data(), 12}, 0, buffer.size(), 16);
+		engine.encode(buffer);
+		engine.finalize();
+		benchmark::DoNotOptimize(engine.tag());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(AES256_CCM)->Arg(1 << 10)->Arg(1 << 16);
+
+static inline void AES256_CBC_encode(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_CBC<AES_t> engine;
+	engine.reset(tkey_schedule, test_data);
+
+	for (auto _ : state)
+	{
+		engine.encode(buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static inline void AES256_CBC_decode(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_CBC<AES_t> engine;
+	engine.reset(tkey_schedule, test_data);
+
+	for (auto _ : state)
+	{
+		engine.decode(buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(AES256_CBC_encode)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(AES256_CBC_decode)->Arg(1 << 10)->Arg(1 << 16);
+
+static inline void AES256_CFB_encode(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_CFB<AES_t> engine;
+	engine.reset(tkey_schedule, test_data);
+
+	for (auto _ : state)
+	{
+		engine.encode(buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static inline void AES256_CFB_decode(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_CFB<AES_t> engine;
+	engine.reset(tkey_schedule, test_data);
+
+	for (auto _ : state)
+	{
+		engine.decode(buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static inline void AES256_OFB(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_OFB<AES_t> engine;
+	engine.reset(tkey_schedule, test_data);
+
+	for (auto _ : state)
+	{
+		engine.update(buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+//	Note: Only the consumer side is timed, as if the key stream had been generated in the background.
+static inline void AES256_OFB_buffered(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_OFB_buffer<AES_t> engine{buffer.size()};
+	engine.reset(tkey_schedule, test_data);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		engine.fill();
+		state.ResumeTiming();
+		engine.update(buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(AES256_CFB_encode)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(AES256_CFB_decode)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(AES256_OFB)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(AES256_OFB_buffered)->Arg(1 << 16);
+
+static inline void AES256_XTS_sectors(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+	constexpr uintptr_t sector_size = 4096;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::key_schedule_t tkey_schedule_tweak;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+	AES_t::make_key_schedule(std::array<uint8_t, 32>{0x5A}, tkey_schedule_tweak);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_XTS<AES_t> engine;
+	engine.set_key(tkey_schedule, tkey_schedule_tweak);
+
+	for (auto _ : state)
+	{
+		engine.encode_sectors(0, sector_size, buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(AES256_XTS_sectors)->Arg(1 << 12)->Arg(1 << 16);
+
+//	Note: Compares the engines against each other, first argument is the crypto::AES_engine.
+static inline void AES256_engine_encode_blocks(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	if(!crypto::AES_set_engine(static_cast<crypto::AES_engine>(state.range(0))))
+	{
+		state.SkipWithError("Engine not supported");
+		return;
+	}
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(1)), 0x5A);
+
+	for (auto _ : state)
+	{
+		AES_t::encode_blocks(tkey_schedule, buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(1));
+	crypto::AES_set_engine(crypto::AES_engine::automatic);
+}
+
+static inline void AES256_engine_decode_blocks(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	if(!crypto::AES_set_engine(static_cast<crypto::AES_engine>(state.range(0))))
+	{
+		state.SkipWithError("Engine not supported");
+		return;
+	}
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(1)), 0x5A);
+
+	for (auto _ : state)
+	{
+		AES_t::decode_blocks(tkey_schedule, buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(1));
+	crypto::AES_set_engine(crypto::AES_engine::automatic);
+}
+
+static inline void AES256_engine_decode_blocks_dec_schedule(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	if(!crypto::AES_set_engine(static_cast<crypto::AES_engine>(state.range(0))))
+	{
+		state.SkipWithError("Engine not supported");
+		return;
+	}
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+	AES_t::dec_key_schedule_t tdec_schedule;
+	AES_t::make_dec_key_schedule(tkey_schedule, tdec_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(1)), 0x5A);
+
+	for (auto _ : state)
+	{
+		AES_t::decode_blocks(tdec_schedule, buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(1));
+	crypto::AES_set_engine(crypto::AES_engine::automatic);
+}
+
+static inline void AES256_engine_CTR(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	if(!crypto::AES_set_engine(static_cast<crypto::AES_engine>(state.range(0))))
+	{
+		state.SkipWithError("Engine not supported");
+		return;
+	}
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(1)), 0x5A);
+
+	crypto::AES_CTR<AES_t> engine;
+	engine.reset(tkey_schedule, test_data);
+
+	for (auto _ : state)
+	{
+		engine.update(buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(1));
+	crypto::AES_set_engine(crypto::AES_engine::automatic);
+}
+
+static inline void AES256_engine_GCM(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	if(!crypto::AES_set_engine(static_cast<crypto::AES_engine>(state.range(0))))
+	{
+		state.SkipWithError("Engine not supported");
+		return;
+	}
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(1)), 0x5A);
+
+	crypto::AES_GCM<AES_t> engine;
+	engine.set_key(tkey_schedule);
+
+	for (auto _ : state)
+	{
+		engine.reset(std::span<const uint8_t>{test_data.data(), 12});
+		engine.encode(buffer, buffer);
+		engine.finalize();
+		benchmark::DoNotOptimize(engine.tag());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(1));
+	crypto::AES_set_engine(crypto::AES_engine::automatic);
+}
+
+static inline void AES256_engine_XTS_sectors(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+	constexpr uintptr_t sector_size = 4096;
+
+	if(!crypto::AES_set_engine(static_cast<crypto::AES_engine>(state.range(0))))
+	{
+		state.SkipWithError("Engine not supported");
+		return;
+	}
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::key_schedule_t tkey_schedule_tweak;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+	AES_t::make_key_schedule(std::array<uint8_t, 32>{0x5A}, tkey_schedule_tweak);
+
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(1)), 0x5A);
+
+	crypto::AES_XTS<AES_t> engine;
+	engine.set_key(tkey_schedule, tkey_schedule_tweak);
+
+	for (auto _ : state)
+	{
+		engine.encode_sectors(0, sector_size, buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(1));
+	crypto::AES_set_engine(crypto::AES_engine::automatic);
+}
+
+//	Note: Second argument is the number of keys.
+static inline void AES256_engine_make_key_schedule(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	if(!crypto::AES_set_engine(static_cast<crypto::AES_engine>(state.range(0))))
+	{
+		state.SkipWithError("Engine not supported");
+		return;
+	}
+
+	const uintptr_t key_count = static_cast<uintptr_t>(state.range(1));
+	std::vector<uint8_t> keys(key_count * AES_t::key_lenght, 0x5A);
+	std::vector<AES_t::key_schedule_t> tkey_schedules(key_count);
+
+	for (auto _ : state)
+	{
+		for(uintptr_t i = 0; i < key_count; ++i)
+		{
+			AES_t::make_key_schedule(std::span<const uint8_t, AES_t::key_lenght>{keys.data() + i * AES_t::key_lenght, AES_t::key_lenght}, tkey_schedules[i]);
+		}
+		benchmark::DoNotOptimize(tkey_schedules.data());
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(1));
+	crypto::AES_set_engine(crypto::AES_engine::automatic);
+}
+
+static inline void AES256_engine_make_key_schedules(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	if(!crypto::AES_set_engine(static_cast<crypto::AES_engine>(state.range(0))))
+	{
+		state.SkipWithError("Engine not supported");
+		return;
+	}
+
+	const uintptr_t key_count = static_cast<uintptr_t>(state.range(1));
+	std::vector<uint8_t> keys(key_count * AES_t::key_lenght, 0x5A);
+	std::vector<AES_t::key_schedule_t> tkey_schedules(key_count);
+
+	for (auto _ : state)
+	{
+		AES_t::make_key_schedules(keys, tkey_schedules);
+		benchmark::DoNotOptimize(tkey_schedules.data());
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(1));
+	crypto::AES_set_engine(crypto::AES_engine::automatic);
+}
+
+//	Note: Every key is already cached, compare with \ref AES256_engine_make_key_schedule.
+static inline void AES256_engine_key_cache_get(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	if(!crypto::AES_set_engine(static_cast<crypto::AES_engine>(state.range(0))))
+	{
+		state.SkipWithError("Engine not supported");
+		return;
+	}
+
+	const uintptr_t key_count = static_cast<uintptr_t>(state.range(1));
+	std::vector<uint8_t> keys(key_count * AES_t::key_lenght);
+	for(uintptr_t i = 0; i < keys.size(); ++i)
+	{
+		keys[i] = static_cast<uint8_t>(i / AES_t::key_lenght);
+	}
+	std::vector<AES_t::key_schedule_t> tkey_schedules(key_count);
+
+	crypto::AES_key_cache<AES_t> cache{key_count * 2};
+	for (auto _ : state)
+	{
+		for(uintptr_t i = 0; i < key_count; ++i)
+		{
+			cache.get(std::span<const uint8_t, AES_t::key_lenght>{keys.data() + i * AES_t::key_lenght, AES_t::key_lenght}, tkey_schedules[i]);
+		}
+		benchmark::DoNotOptimize(tkey_schedules.data());
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(1));
+	crypto::AES_set_engine(crypto::AES_engine::automatic);
+}
+
+static void AES_engine_args(benchmark::internal::Benchmark* p_bench)
+{
+	for(const crypto::AES_engine tengine :
+		{
+			crypto::AES_engine::software, crypto::AES_engine::T_table, crypto::AES_engine::bitsliced,
+			crypto::AES_engine::AES_NI, crypto::AES_engine::VAES_AVX2, crypto::AES_engine::VAES_AVX512
+		})
+	{
+		p_bench->Args({static_cast<int64_t>(tengine), 1 << 12});
+	}
+}
+
+BENCHMARK(AES256_engine_encode_blocks)->Apply(AES_engine_args);
+BENCHMARK(AES256_engine_decode_blocks)->Apply(AES_engine_args);
+BENCHMARK(AES256_engine_decode_blocks_dec_schedule)->Apply(AES_engine_args);
+BENCHMARK(AES256_engine_CTR)->Apply(AES_engine_args);
+BENCHMARK(AES256_engine_GCM)->Apply(AES_engine_args);
+BENCHMARK(AES256_engine_XTS_sectors)->Apply(AES_engine_args);
+
+static void AES_engine_key_args(benchmark::internal::Benchmark* p_bench)
+{
+	for(const crypto::AES_engine tengine : {crypto::AES_engine::software, crypto::AES_engine::AES_NI})
+	{
+		p_bench->Args({static_cast<int64_t>(tengine), 64});
+	}
+}
+
+BENCHMARK(AES256_engine_make_key_schedule)->Apply(AES_engine_key_args);
+BENCHMARK(AES256_engine_make_key_schedules)->Apply(AES_engine_key_args);
+BENCHMARK(AES256_engine_key_cache_get)->Apply(AES_engine_key_args);
+
+//	Note: Many short records, each under its own key. range(0) is the record size, range(1) the number of records.
+static inline void AES256_CTR_records(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	const uintptr_t record_size		= static_cast<uintptr_t>(state.range(0));
+	const uintptr_t record_count	= static_cast<uintptr_t>(state.range(1));
+	std::vector<AES_t::key_schedule_t> tkey_schedules(record_count);
+	std::vector<uint8_t> buffer(record_size * record_count, 0x5A);
+	for(uintptr_t i = 0; i < record_count; ++i)
+	{
+		std::array<uint8_t, AES_t::key_lenght> key;
+		key.fill(static_cast<uint8_t>(i));
+		AES_t::make_key_schedule(key, tkey_schedules[i]);
+	}
+	const std::array<uint8_t, AES_t::block_lenght> iv{};
+
+	crypto::AES_CTR<AES_t> engine;
+	for (auto _ : state)
+	{
+		for(uintptr_t i = 0; i < record_count; ++i)
+		{
+			const std::span<uint8_t> record{buffer.data() + i * record_size, record_size};
+			engine.reset(tkey_schedules[i], iv);
+			engine.update(record, record);
+		}
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(buffer.size()));
+}
+
+static inline void AES256_multi_buffer_CBC(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+	using MB_t = crypto::AES_multi_buffer<AES_t>;
+
+	const uintptr_t record_size		= static_cast<uintptr_t>(state.range(0));
+	const uintptr_t record_count	= static_cast<uintptr_t>(state.range(1));
+	std::vector<AES_t::key_schedule_t> tkey_schedules(record_count);
+	std::vector<uint8_t> buffer(record_size * record_count, 0x5A);
+	std::vector<MB_t::job_t> jobs(record_count);
+	for(uintptr_t i = 0; i < record_count; ++i)
+	{
+		std::array<uint8_t, AES_t::key_lenght> key;
+		key.fill(static_cast<uint8_t>(i));
+		AES_t::make_key_schedule(key, tkey_schedules[i]);
+
+		const std::span<uint8_t> record{buffer.data() + i * record_size, record_size};
+		jobs[i].wkey	= &tkey_schedules[i];
+		jobs[i].input	= record;
+		jobs[i].out		= record;
+	}
+
+	for (auto _ : state)
+	{
+		MB_t::cbc_encode(jobs);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(buffer.size()));
+}
+
+static inline void AES256_multi_buffer_CTR(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+	using MB_t = crypto::AES_multi_buffer<AES_t>;
+
+	const uintptr_t record_size		= static_cast<uintptr_t>(state.range(0));
+	const uintptr_t record_count	= static_cast<uintptr_t>(state.range(1));
+	std::vector<AES_t::key_schedule_t> tkey_schedules(record_count);
+	std::vector<uint8_t> buffer(record_size * record_count, 0x5A);
+	std::vector<MB_t::job_t> jobs(record_count);
+	for(uintptr_t i = 0; i < record_count; ++i)
+	{
+		std::array<uint8_t, AES_t::key_lenght> key;
+		key.fill(static_cast<uint8_t>(i));
+		AES_t::make_key_schedule(key, tkey_schedules[i]);
+
+		const std::span<uint8_t> record{buffer.data() + i * record_size, record_size};
+		jobs[i].wkey	= &tkey_schedules[i];
+		jobs[i].input	= record;
+		jobs[i].out		= record;
+	}
+
+	for (auto _ : state)
+	{
+		MB_t::ctr_xor(jobs);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(buffer.size()));
+}
+
+BENCHMARK(AES256_CTR_records)->Args({64, 256})->Args({256, 256});
+BENCHMARK(AES256_multi_buffer_CBC)->Args({64, 256})->Args({256, 256});
+BENCHMARK(AES256_multi_buffer_CTR)->Args({64, 256})->Args({256, 256});
+
+static inline void AES256_GCM_parallel(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	crypto::worker_pool pool(static_cast<uint32_t>(state.range(1)));
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_GCM<AES_t> engine;
+	engine.set_key(tkey_schedule);
+
+	for (auto _ : state)
+	{
+		engine.reset(std::span<const uint8_t>{test_data.data(), 12});
+		engine.encode(pool, buffer, buffer);
+		engine.finalize();
+		benchmark::DoNotOptimize(engine.tag());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static inline void AES256_CTR_parallel(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+
+	crypto::worker_pool pool(static_cast<uint32_t>(state.range(1)));
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::AES_CTR<AES_t> engine;
+
+	for (auto _ : state)
+	{
+		engine.reset(tkey_schedule, std::span<const uint8_t, 16>{test_data.data(), 16});
+		engine.update(pool, buffer, buffer);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+//	Note: Arguments are the buffer size and the number of threads, 0 is one per hardware thread.
+BENCHMARK(AES256_GCM_parallel)->Args({1 << 26, 1})->Args({1 << 26, 0})->UseRealTime();
+BENCHMARK(AES256_CTR_parallel)->Args({1 << 26, 1})->Args({1 << 26, 0})->UseRealTime();
+
+static inline void AES128_CMAC_records(benchmark::State& state)
+{
+	using AES_t = crypto::AES_128;
+	using CMAC_t = crypto::AES_CMAC<AES_t>;
+
+	const uintptr_t record_size		= static_cast<uintptr_t>(state.range(0));
+	const uintptr_t record_count	= static_cast<uintptr_t>(state.range(1));
+	std::vector<CMAC_t::key_t> keys(record_count);
+	std::vector<uint8_t> buffer(record_size * record_count, 0x5A);
+	for(uintptr_t i = 0; i < record_count; ++i)
+	{
+		std::array<uint8_t, AES_t::key_lenght> key;
+		key.fill(static_cast<uint8_t>(i));
+		AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(key, tkey_schedule);
+		CMAC_t::make_key(tkey_schedule, keys[i]);
+	}
+
+	CMAC_t engine;
+	for (auto _ : state)
+	{
+		for(uintptr_t i = 0; i < record_count; ++i)
+		{
+			engine.set_key(keys[i]);
+			engine.reset();
+			engine.update(std::span<const uint8_t>{buffer.data() + i * record_size, record_size});
+			engine.finalize();
+			benchmark::DoNotOptimize(engine.tag().data());
+		}
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(buffer.size()));
+}
+
+static inline void AES128_CMAC_compute(benchmark::State& state)
+{
+	using AES_t = crypto::AES_128;
+	using CMAC_t = crypto::AES_CMAC<AES_t>;
+
+	const uintptr_t record_size		= static_cast<uintptr_t>(state.range(0));
+	const uintptr_t record_count	= static_cast<uintptr_t>(state.range(1));
+	std::vector<CMAC_t::key_t> keys(record_count);
+	std::vector<uint8_t> buffer(record_size * record_count, 0x5A);
+	std::vector<CMAC_t::job_t> jobs(record_count);
+	for(uintptr_t i = 0; i < record_count; ++i)
+	{
+		std::array<uint8_t, AES_t::key_lenght> key;
+		key.fill(static_cast<uint8_t>(i));
+		AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(key, tkey_schedule);
+		CMAC_t::make_key(tkey_schedule, keys[i]);
+
+		jobs[i].key		= &keys[i];
+		jobs[i].message	= std::span<const uint8_t>{buffer.data() + i * record_size, record_size};
+	}
+
+	for (auto _ : state)
+	{
+		CMAC_t::compute(jobs);
+		benchmark::DoNotOptimize(jobs.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(buffer.size()));
+}
+
+BENCHMARK(AES128_CMAC_records)->Args({64, 256})->Args({1024, 64});
+BENCHMARK(AES128_CMAC_compute)->Args({64, 256})->Args({1024, 64});
+
+static inline void AES256_key_unwrap(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+	using KW_t = crypto::AES_key_wrap<AES_t>;
+
+	const uintptr_t key_count = static_cast<uintptr_t>(state.range(0));
+	constexpr uintptr_t wrapped_size = 40;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::dec_key_schedule_t tdec_key_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+	AES_t::make_dec_key_schedule(tkey_schedule, tdec_key_schedule);
+
+	std::vector<uint8_t> wrapped(wrapped_size * key_count);
+	std::vector<uint8_t> out(wrapped.size());
+	for(uintptr_t i = 0; i < key_count; ++i)
+	{
+		KW_t::wrap(tkey_schedule, test_key, std::span<uint8_t>{wrapped.data() + i * wrapped_size, wrapped_size});
+	}
+
+	for (auto _ : state)
+	{
+		for(uintptr_t i = 0; i < key_count; ++i)
+		{
+			KW_t::unwrap(tdec_key_schedule,
+				std::span<const uint8_t>{wrapped.data() + i * wrapped_size, wrapped_size},
+				std::span<uint8_t>{out.data() + i * wrapped_size, wrapped_size - 8});
+		}
+		benchmark::DoNotOptimize(out.data());
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(key_count));
+}
+
+static inline void AES256_key_unwrap_batch(benchmark::State& state)
+{
+	using AES_t = crypto::AES_256;
+	using KW_t = crypto::AES_key_wrap<AES_t>;
+
+	const uintptr_t key_count = static_cast<uintptr_t>(state.range(0));
+	constexpr uintptr_t wrapped_size = 40;
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::dec_key_schedule_t tdec_key_schedule;
+	AES_t::make_key_schedule(test_key, tkey_schedule);
+	AES_t::make_dec_key_schedule(tkey_schedule, tdec_key_schedule);
+
+	std::vector<uint8_t> wrapped(wrapped_size * key_count);
+	std::vector<uint8_t> out(wrapped.size());
+	std::vector<KW_t::job_t> jobs(key_count);
+	for(uintptr_t i = 0; i < key_count; ++i)
+	{
+		KW_t::wrap(tkey_schedule, test_key, std::span<uint8_t>{wrapped.data() + i * wrapped_size, wrapped_size});
+		jobs[i].dkey	= &tdec_key_schedule;
+		jobs[i].input	= std::span<const uint8_t>{wrapped.data() + i * wrapped_size, wrapped_size};
+		jobs[i].out		= std::span<uint8_t>{out.data() + i * wrapped_size, wrapped_size - 8};
+	}
+
+	for (auto _ : state)
+	{
+		KW_t::unwrap(jobs);
+		benchmark::DoNotOptimize(out.data());
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(key_count));
+}
+
+BENCHMARK(AES256_key_unwrap)->Arg(1024);
+BENCHMARK(AES256_key_unwrap_batch)->Arg(1024);
+
+static bool bench_entropy_source(std::span<uint8_t, crypto::AES_CTR_DRBG::seed_lenght> p_out)
+{
+	for(uintptr_t i = 0; i < p_out.size(); ++i)
+	{
+		p_out[i] = static_cast<uint8_t>(i);
+	}
+	return true;
+}
+
+static inline void AES256_CTR_DRBG_generate(benchmark::State& state)
+{
+	const uintptr_t size = static_cast<uintptr_t>(state.range(0));
+
+	std::array<uint8_t, crypto::AES_CTR_DRBG::seed_lenght> entropy;
+	bench_entropy_source(entropy);
+
+	crypto::AES_CTR_DRBG drbg;
+	drbg.instantiate(entropy);
+
+	std::vector<uint8_t> out(size);
+	for (auto _ : state)
+	{
+		drbg.generate(out);
+		benchmark::DoNotOptimize(out.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+}
+
+static inline void AES256_CTR_DRBG_thread_generate(benchmark::State& state)
+{
+	const uintptr_t size = static_cast<uintptr_t>(state.range(0));
+
+	crypto::AES_CTR_DRBG::set_entropy_source(bench_entropy_source);
+
+	std::vector<uint8_t> out(size);
+	for (auto _ : state)
+	{
+		crypto::AES_CTR_DRBG::thread_generate(out);
+		benchmark::DoNotOptimize(out.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+}
+
+BENCHMARK(AES256_CTR_DRBG_generate)->Arg(16)->Arg(32)->Arg(4096);
+BENCHMARK(AES256_CTR_DRBG_thread_generate)->Arg(16)->Arg(32)->Arg(4096);
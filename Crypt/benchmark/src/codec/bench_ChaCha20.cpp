@@ -0,0 +1,95 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <Crypt/codec/ChaCha20.hpp>
+#include <Crypt/codec/ChaCha20_Poly1305.hpp>
+
+constexpr std::array<uint8_t, 32> test_key =
+{
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+};
+
+constexpr std::array<uint8_t, 12> test_nonce =
+{
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00,
+};
+
+static inline void ChaCha20(benchmark::State& state)
+{
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(crypto::ChaCha20::xor_stream(test_key, test_nonce, 1, buffer, buffer));
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(ChaCha20)->Arg(1 << 10)->Arg(1 << 16);
+
+static inline void ChaCha20_Poly1305_encode(benchmark::State& state)
+{
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::ChaCha20_Poly1305 engine;
+	engine.set_key(test_key);
+
+	crypto::ChaCha20_Poly1305::tag_t tag;
+	for (auto _ : state)
+	{
+		engine.encode(test_nonce, std::span<const uint8_t>{}, buffer, buffer, tag);
+		benchmark::DoNotOptimize(tag);
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static inline void ChaCha20_Poly1305_decode(benchmark::State& state)
+{
+	std::vector<uint8_t> buffer(static_cast<uintptr_t>(state.range(0)), 0x5A);
+
+	crypto::ChaCha20_Poly1305 engine;
+	engine.set_key(test_key);
+
+	crypto::ChaCha20_Poly1305::tag_t tag;
+	engine.encode(test_nonce, std::span<const uint8_t>{}, buffer, buffer, tag);
+	std::vector<uint8_t> out(buffer.size());
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(engine.decode(test_nonce, std::span<const uint8_t>{}, buffer, out, tag));
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(ChaCha20_Poly1305_encode)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(ChaCha20_Poly1305_decode)->Arg(1 << 10)->Arg(1 << 16);
@@ -43,6 +43,27 @@ namespace crypto
 		};
 	}//namespace _p
 
+	///	\brief Implementation used by \ref AES_128, \ref AES_192 and \ref AES_256
+	enum class AES_engine: uint8_t
+	{
+		automatic,	//!< Best implementation supported by the running CPU
+		software,	//!< Portable byte-wise implementation
+		AES_NI,		//!< x86-64 AES-NI instructions
+		T_table,	//!< Portable 32 bit lookup table implementation, faster than \ref software but uses 8KB of tables
+		bitsliced,	//!< Constant time SSE2 implementation processing 8 blocks at once, preferred when \ref AES_NI is not available
+		VAES_AVX2,	//!< \ref AES_NI with 256 bit VAES instructions for multi-block work, 2 blocks per instruction
+		VAES_AVX512,//!< \ref AES_NI with 512 bit VAES instructions for multi-block work, 4 blocks per instruction
+	};
+
+	///	\brief Replaces the implementation used by all AES key sizes.
+	///	\return false if the engine is not supported by the running CPU, in which case nothing changes.
+	///	\warning Not thread safe, it is meant for testing and benchmarking.
+	///		The best available engine is already selected on startup.
+	bool AES_set_engine(AES_engine p_engine);
+
+	///	\brief Currently active engine, never returns \ref AES_engine::automatic
+	AES_engine AES_get_engine();
+
 	class AES_128
 	{
 	public:
@@ -52,16 +73,59 @@ namespace crypto
 
 		static constexpr uintptr_t key_schedule_size = (number_of_rounds + 1) * 4;
 
+		///	\brief Encoding round keys, each round key is one 16 byte aligned 128 bit lane.
 		struct key_schedule_t
 		{
-			alignas(8) std::array<_p::wblock_t, key_schedule_size> wkey;
+			alignas(16) std::array<_p::wblock_t, key_schedule_size> wkey;
+		};
+
+		///	\brief Decoding round keys (equivalent inverse cipher), in the order they are applied.
+		///		The middle round keys have InvMixColumns applied to them.
+		struct dec_key_schedule_t
+		{
+			alignas(16) std::array<_p::wblock_t, key_schedule_size> wkey;
+		};
+
+		///	\brief Encoding and decoding round keys of the same key, padded to whole cache lines.
+		///		Meant to be stored in large tables, i.e. one per session.
+		struct alignas(64) key_t
+		{
+			key_schedule_t		enc;
+			dec_key_schedule_t	dec;
 		};
 
 	public:
 		static void make_key_schedule(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_wkey);
 
+		///	\brief Expands several keys at once, the expansions are interleaved to hide instruction latency.
+		///	\param[in]  p_keys - Concatenated keys, size must be a multiple of \ref key_lenght.
+		///	\param[out] p_wkey - One schedule per key, must be at least as large as the number of keys.
+		static void make_key_schedules(std::span<const uint8_t> p_keys, std::span<key_schedule_t> p_wkey);
+
+		///	\brief Derives the decoding round keys once with the active engine, instead of on every call to decode.
+		static void make_dec_key_schedule(const key_schedule_t& p_wkey, dec_key_schedule_t& p_dkey);
+
+		///	\brief Expands both the encoding and decoding round keys.
+		static void make_key(std::span<const uint8_t, key_lenght> p_key, key_t& p_out);
+
 		static void encode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
 		static void decode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+
+		///	\brief Encodes/decodes consecutive independent blocks (ECB), several blocks are processed concurrently.
+		///	\param[in]  p_input - Size must be a multiple of \ref block_lenght, any trailing partial block is ignored.
+		///	\param[out] p_out   - Must be at least as large as p_input. Can be the same buffer as p_input.
+		static void encode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+		static void decode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref decode and \ref decode_blocks, using the precomputed decoding round keys.
+		static void decode(const dec_key_schedule_t& p_dkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+		static void decode_blocks(const dec_key_schedule_t& p_dkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref encode, \ref decode, \ref encode_blocks and \ref decode_blocks, using the combined key.
+		static void encode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+		static void decode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+		static void encode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+		static void decode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
 	};
 
 	class AES_192
@@ -73,16 +137,59 @@ namespace crypto
 
 		static constexpr uintptr_t key_schedule_size = (number_of_rounds + 1) * 4;
 
+		///	\brief Encoding round keys, each round key is one 16 byte aligned 128 bit lane.
 		struct key_schedule_t
 		{
-			alignas(8) std::array<_p::wblock_t, key_schedule_size> wkey;
+			alignas(16) std::array<_p::wblock_t, key_schedule_size> wkey;
+		};
+
+		///	\brief Decoding round keys (equivalent inverse cipher), in the order they are applied.
+		///		The middle round keys have InvMixColumns applied to them.
+		struct dec_key_schedule_t
+		{
+			alignas(16) std::array<_p::wblock_t, key_schedule_size> wkey;
+		};
+
+		///	\brief Encoding and decoding round keys of the same key, padded to whole cache lines.
+		///		Meant to be stored in large tables, i.e. one per session.
+		struct alignas(64) key_t
+		{
+			key_schedule_t		enc;
+			dec_key_schedule_t	dec;
 		};
 
 	public:
 		static void make_key_schedule(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_wkey);
 
+		///	\brief Expands several keys at once, the expansions are interleaved to hide instruction latency.
+		///	\param[in]  p_keys - Concatenated keys, size must be a multiple of \ref key_lenght.
+		///	\param[out] p_wkey - One schedule per key, must be at least as large as the number of keys.
+		static void make_key_schedules(std::span<const uint8_t> p_keys, std::span<key_schedule_t> p_wkey);
+
+		///	\brief Derives the decoding round keys once with the active engine, instead of on every call to decode.
+		static void make_dec_key_schedule(const key_schedule_t& p_wkey, dec_key_schedule_t& p_dkey);
+
+		///	\brief Expands both the encoding and decoding round keys.
+		static void make_key(std::span<const uint8_t, key_lenght> p_key, key_t& p_out);
+
 		static void encode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
 		static void decode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+
+		///	\brief Encodes/decodes consecutive independent blocks (ECB), several blocks are processed concurrently.
+		///	\param[in]  p_input - Size must be a multiple of \ref block_lenght, any trailing partial block is ignored.
+		///	\param[out] p_out   - Must be at least as large as p_input. Can be the same buffer as p_input.
+		static void encode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+		static void decode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref decode and \ref decode_blocks, using the precomputed decoding round keys.
+		static void decode(const dec_key_schedule_t& p_dkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+		static void decode_blocks(const dec_key_schedule_t& p_dkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref encode, \ref decode, \ref encode_blocks and \ref decode_blocks, using the combined key.
+		static void encode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+		static void decode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+		static void encode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+		static void decode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
 	};
 
 	class AES_256
@@ -94,15 +201,58 @@ namespace crypto
 
 		static constexpr uintptr_t key_schedule_size = (number_of_rounds + 1) * 4;
 
+		///	\brief Encoding round keys, each round key is one 16 byte aligned 128 bit lane.
 		struct key_schedule_t
 		{
-			alignas(8) std::array<_p::wblock_t, key_schedule_size> wkey;
+			alignas(16) std::array<_p::wblock_t, key_schedule_size> wkey;
+		};
+
+		///	\brief Decoding round keys (equivalent inverse cipher), in the order they are applied.
+		///		The middle round keys have InvMixColumns applied to them.
+		struct dec_key_schedule_t
+		{
+			alignas(16) std::array<_p::wblock_t, key_schedule_size> wkey;
+		};
+
+		///	\brief Encoding and decoding round keys of the same key, padded to whole cache lines.
+		///		Meant to be stored in large tables, i.e. one per session.
+		struct alignas(64) key_t
+		{
+			key_schedule_t		enc;
+			dec_key_schedule_t	dec;
 		};
 
 	public:
 		static void make_key_schedule(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_wkey);
 
+		///	\brief Expands several keys at once, the expansions are interleaved to hide instruction latency.
+		///	\param[in]  p_keys - Concatenated keys, size must be a multiple of \ref key_lenght.
+		///	\param[out] p_wkey - One schedule per key, must be at least as large as the number of keys.
+		static void make_key_schedules(std::span<const uint8_t> p_keys, std::span<key_schedule_t> p_wkey);
+
+		///	\brief Derives the decoding round keys once with the active engine, instead of on every call to decode.
+		static void make_dec_key_schedule(const key_schedule_t& p_wkey, dec_key_schedule_t& p_dkey);
+
+		///	\brief Expands both the encoding and decoding round keys.
+		static void make_key(std::span<const uint8_t, key_lenght> p_key, key_t& p_out);
+
 		static void encode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
 		static void decode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+
+		///	\brief Encodes/decodes consecutive independent blocks (ECB), several blocks are processed concurrently.
+		///	\param[in]  p_input - Size must be a multiple of \ref block_lenght, any trailing partial block is ignored.
+		///	\param[out] p_out   - Must be at least as large as p_input. Can be the same buffer as p_input.
+		static void encode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+		static void decode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref decode and \ref decode_blocks, using the precomputed decoding round keys.
+		static void decode(const dec_key_schedule_t& p_dkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+		static void decode_blocks(const dec_key_schedule_t& p_dkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref encode, \ref decode, \ref encode_blocks and \ref decode_blocks, using the combined key.
+		static void encode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+		static void decode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out);
+		static void encode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+		static void decode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
 	};
 }
@@ -0,0 +1,92 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES-CBC - Cipher block chaining mode of operation
+///			Symmetric block cypher
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	///	\brief Cipher block chaining mode (NIST SP 800-38A) on top of \ref AES_128, \ref AES_192 or \ref AES_256
+	///		Encoding is inherently serial, decoding processes several blocks concurrently.
+	///	\note No padding is applied, only whole blocks are processed.
+	template<typename AES_t>
+	class AES_CBC
+	{
+	public:
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+		using dec_key_schedule_t = typename AES_t::dec_key_schedule_t;
+		using key_t = typename AES_t::key_t;
+		using iv_t = std::array<uint8_t, block_lenght>;
+
+	public:
+		///	\brief Sets the key and the initialization vector, the decoding round keys are derived here.
+		void reset(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_iv);
+
+		///	\brief Same as above, the decoding round keys are taken from p_key instead of being derived.
+		void reset(const key_t& p_key, std::span<const uint8_t, block_lenght> p_iv);
+
+		///	\brief Encodes/decodes consecutive blocks, calls can be chained.
+		///	\param[in]  p_input - Any trailing partial block is not processed.
+		///	\param[out] p_out   - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\return Number of bytes processed, a multiple of \ref block_lenght.
+		///		The unprocessed bytes are left untouched, they must be given again at the start of the next call.
+		uintptr_t encode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+		uintptr_t decode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref encode and \ref decode, in place.
+		uintptr_t encode(std::span<uint8_t> p_data);
+		uintptr_t decode(std::span<uint8_t> p_data);
+
+		///	\brief Same as \ref encode and \ref decode, in place over a scatter-gather list.
+		///		The buffers are treated as one contiguous stream, a block can straddle buffers.
+		///	\return Number of bytes processed from the start of the list, any trailing partial block of the whole list is not processed.
+		uintptr_t encode(std::span<const std::span<uint8_t>> p_buffers);
+		uintptr_t decode(std::span<const std::span<uint8_t>> p_buffers);
+
+		///	\brief Chaining value, i.e. the last cipher text block processed
+		inline const iv_t& iv() const { return m_iv; }
+
+	private:
+		template<bool Encode>
+		void process_blocks(const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count);
+
+		template<bool Encode>
+		uintptr_t process_buffers(std::span<const std::span<uint8_t>> p_buffers);
+
+	private:
+		key_t						m_key;
+		alignas(16) iv_t			m_iv {0};
+	};
+} //namespace crypto
@@ -0,0 +1,111 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES-CCM - Counter with CBC-MAC
+///			Authenticated encryption with associated data
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	///	\brief Counter with CBC-MAC (NIST SP 800-38C, RFC 3610) on top of \ref AES_128, \ref AES_192 or \ref AES_256
+	///		The counter key stream and the CBC-MAC are computed in a single pass over the data.
+	///	\note Usage: set_key() once, then for every message
+	///		reset(), update_aad() (optional), encode() or decode(), finalize(), and tag() or verify().
+	///		Unlike GCM, the sizes of the additional data and of the payload must be known upfront.
+	template<typename AES_t>
+	class AES_CCM
+	{
+	public:
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+		static constexpr uintptr_t max_tag_lenght = 16;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+		using tag_t = std::array<uint8_t, max_tag_lenght>;
+
+	public:
+		void set_key(const key_schedule_t& p_wkey);
+
+		///	\brief Starts a new message.
+		///	\param[in] p_nonce    - 7 to 13 bytes, must never repeat for the same key.
+		///		The payload size is limited to 2^(8 * (15 - nonce size)) - 1 bytes.
+		///	\param[in] p_tag_size - Even number in the range [4, 16].
+		///	\return false if any of the parameters is out of range.
+		bool reset(std::span<const uint8_t> p_nonce, uint64_t p_aad_size, uint64_t p_data_size, uintptr_t p_tag_size);
+
+		///	\brief Additional authenticated data, calls can be split at any byte boundary.
+		///	\return false if encode() or decode() was already called for this message,
+		///		or if it exceeds the size given to reset().
+		bool update_aad(std::span<const uint8_t> p_data);
+
+		///	\brief Encrypts/decrypts, calls can be split at any byte boundary.
+		///		Do not mix encode() and decode() in the same message.
+		///	\param[out] p_out - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\return false if it exceeds the size given to reset(), in which case nothing is done.
+		bool encode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+		bool decode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref encode and \ref decode, in place.
+		bool encode(std::span<uint8_t> p_data);
+		bool decode(std::span<uint8_t> p_data);
+
+		///	\brief Computes the authentication tag
+		///	\return false if less additional data or payload was processed than was given to reset().
+		bool finalize();
+
+		inline std::span<const uint8_t> tag() const { return std::span<const uint8_t>{m_tag.data(), m_tag_size}; }
+
+		///	\brief Constant time comparison of the computed tag against p_tag.
+		///	\return false if the tags do not match or the size of p_tag is not the one given to reset().
+		bool verify(std::span<const uint8_t> p_tag) const;
+
+	private:
+		void mac_update(const uint8_t* p_data, uintptr_t p_size);
+		void mac_pending();
+		bool process(const uint8_t* p_input, uint8_t* p_out, uintptr_t p_size, bool p_encode);
+		void process_blocks(const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count, bool p_encode);
+
+	private:
+		key_schedule_t						m_wkey;
+		std::array<uint64_t, 2>				m_counter {0, 0};
+		alignas(16) std::array<uint8_t, 16>	m_mac {0};
+		alignas(16) std::array<uint8_t, 16>	m_mask {0};
+		alignas(16) std::array<uint8_t, 16>	m_cached {0};
+		alignas(16) std::array<uint8_t, 16>	m_pending {0};
+		tag_t								m_tag {0};
+		uint64_t							m_aad_size = 0;
+		uint64_t							m_data_size = 0;
+		uint64_t							m_aad_left = 0;
+		uint64_t							m_data_left = 0;
+		uint8_t								m_pending_size = 0;
+		uint8_t								m_tag_size = 0;
+	};
+} //namespace crypto
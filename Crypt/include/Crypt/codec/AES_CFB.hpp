@@ -0,0 +1,74 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES - Cipher feedback mode
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	///	\brief Cipher feedback mode with 128 bit feedback (CFB-128, NIST SP 800-38A) on top of \ref AES_128, \ref AES_192 or \ref AES_256
+	///		Encoding is inherently serial. Decoding has all the cipher text available,
+	///		so all its blocks are encoded at once with the multi-block encode.
+	template<typename AES_t>
+	class AES_CFB
+	{
+	public:
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+		using iv_t = std::array<uint8_t, block_lenght>;
+
+	public:
+		void reset(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_iv);
+
+		///	\brief Encodes/decodes a stream, calls can be split at any byte boundary.
+		///	\param[out] p_out - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\warning Encoding and decoding calls must not be mixed without a \ref reset in between.
+		void encode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+		void decode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref encode and \ref decode, in place.
+		void encode(std::span<uint8_t> p_data);
+		void decode(std::span<uint8_t> p_data);
+
+	private:
+		void decode_blocks(const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count);
+
+	private:
+		key_schedule_t				m_wkey;
+		//	Note: Previous cipher text block. While a block is partially processed (m_used != 0),
+		//	the bytes past m_used are still the key stream of the current block.
+		alignas(16) iv_t			m_register {0};
+		uint8_t						m_used = 0;
+	};
+} //namespace crypto
@@ -0,0 +1,108 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES-CMAC - Cipher based message authentication code
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	///	\brief Key schedule together with the CMAC subkeys, derived once by \ref AES_CMAC::make_key
+	template<typename AES_t>
+	struct AES_CMAC_key
+	{
+		typename AES_t::key_schedule_t			wkey;
+		alignas(16) std::array<uint8_t, 16>		k1;
+		alignas(16) std::array<uint8_t, 16>		k2;
+	};
+
+	///	\brief CMAC (NIST SP 800-38B, RFC 4493) on top of \ref AES_128, \ref AES_192 or \ref AES_256
+	///	\note Usage: set_key() once, then for every message reset(), update(), finalize(), and tag() or verify().
+	///		Many short messages are better served by \ref compute, which interleaves their chains.
+	template<typename AES_t>
+	class AES_CMAC
+	{
+	public:
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+		static constexpr uintptr_t tag_lenght = 16;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+		using key_t = AES_CMAC_key<AES_t>;
+		using tag_t = std::array<uint8_t, tag_lenght>;
+
+		///	\brief Independent message for \ref compute
+		struct job_t
+		{
+			const key_t*				key = nullptr;
+			std::span<const uint8_t>	message;
+			tag_t						tag {0};
+		};
+
+	public:
+		///	\brief Derives the subkeys K1 and K2.
+		static void make_key(const key_schedule_t& p_wkey, key_t& p_key);
+
+		///	\brief Computes the tag of every job.
+		///		A single CBC-MAC chain is latency bound, the chains of several messages are interleaved instead.
+		static void compute(std::span<job_t> p_jobs);
+
+		///	\brief Sets the key and derives the subkeys, it can be reused for any number of messages.
+		void set_key(const key_schedule_t& p_wkey);
+		void set_key(const key_t& p_key);
+
+		///	\brief Starts a new message.
+		///	\param[in] p_tag_size - Size of the tag accepted by verify(), in the range [8, 16] (NIST SP 800-38B 6.3).
+		///	\return false if p_tag_size is out of range.
+		bool reset(uintptr_t p_tag_size = tag_lenght);
+
+		///	\brief Calls can be split at any byte boundary.
+		void update(std::span<const uint8_t> p_data);
+
+		///	\brief Computes the tag.
+		void finalize();
+
+		///	\brief Full tag, a truncated tag is made of its first \ref tag_size bytes.
+		inline const tag_t& tag() const { return m_tag; }
+		inline uintptr_t tag_size() const { return m_tag_size; }
+
+		///	\brief Constant time comparison of the first \ref tag_size bytes of the computed tag against p_tag.
+		///	\return false if the tags do not match or the size of p_tag is not the one given to reset().
+		bool verify(std::span<const uint8_t> p_tag) const;
+
+	private:
+		key_t								m_key;
+		alignas(16) std::array<uint8_t, 16>	m_chain {0};
+		alignas(16) std::array<uint8_t, 16>	m_cached {0};
+		tag_t								m_tag {0};
+		uint8_t								m_cached_size = 0;
+		uint8_t								m_tag_size = tag_lenght;
+	};
+} //namespace crypto
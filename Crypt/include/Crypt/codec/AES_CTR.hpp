@@ -0,0 +1,87 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES-CTR - Counter mode of operation
+///			Symmetric stream cypher
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	class worker_pool;
+
+	///	\brief Counter mode (NIST SP 800-38A) on top of \ref AES_128, \ref AES_192 or \ref AES_256
+	///		The counter block is incremented as a 128 bit big endian integer.
+	///		Encoding and decoding are the same operation.
+	template<typename AES_t>
+	class AES_CTR
+	{
+	public:
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+		using counter_t = std::array<uint8_t, block_lenght>;
+
+		///	\brief Size of the pieces a buffer is split into by the \ref worker_pool overload of \ref update.
+		static constexpr uintptr_t parallel_chunk = 256 * 1024;
+
+	public:
+		void reset(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_counter);
+
+		///	\brief Applies the key stream, calls can be split at any byte boundary.
+		///	\param[out] p_out - Must be at least as large as p_input. Can be the same buffer as p_input.
+		void update(std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref update, in place.
+		void update(std::span<uint8_t> p_data);
+
+		///	\brief Same as \ref update, in place over a scatter-gather list.
+		///		The buffers are treated as one contiguous stream, a block can straddle buffers.
+		void update(std::span<const std::span<uint8_t>> p_buffers);
+
+		///	\brief Same as \ref update, split across p_pool for very large buffers.
+		///		Each task processes \ref parallel_chunk bytes starting from its own counter offset.
+		///		Buffers of less than 2 chunks are processed on the calling thread.
+		void update(worker_pool& p_pool, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Counter of the next key stream block to be generated
+		counter_t counter() const;
+
+	private:
+		void increment(uint8_t* p_out);
+
+	private:
+		key_schedule_t						m_wkey;
+		std::array<uint64_t, 2>				m_counter {0, 0};
+		alignas(8) std::array<uint8_t, 16>	m_cached {0};
+		uint8_t								m_cached_size = 0;
+	};
+} //namespace crypto
@@ -0,0 +1,113 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES CTR_DRBG - Deterministic random bit generator
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	///	\brief CTR_DRBG (NIST SP 800-90A) on top of \ref AES_256, without derivation function.
+	///		The entropy input must be full entropy and exactly \ref seed_lenght bytes.
+	///	\note An instance is not thread safe, \ref thread_generate gives each thread its own instance.
+	class AES_CTR_DRBG
+	{
+	public:
+		static constexpr uintptr_t block_lenght = AES_256::block_lenght;
+		static constexpr uintptr_t key_lenght = AES_256::key_lenght;
+		static constexpr uintptr_t seed_lenght = key_lenght + block_lenght;
+
+		///	\brief Maximum number of bytes per \ref generate call (2^19 bits).
+		static constexpr uintptr_t max_request = uintptr_t{1} << 16;
+
+		///	\brief Number of \ref generate calls after which a reseed is required (2^48).
+		static constexpr uint64_t reseed_interval = uint64_t{1} << 48;
+
+		///	\brief Size of the pre-generated output held by each thread's generator.
+		static constexpr uintptr_t thread_buffer_size = 4096;
+
+		///	\brief Number of buffer refills after which a thread's generator reseeds itself from the entropy source.
+		static constexpr uint64_t thread_reseed_interval = uint64_t{1} << 16;
+
+		///	\brief Fills p_out with \ref seed_lenght bytes of full entropy.
+		///	\return false if no entropy is available.
+		///	\note Can be called concurrently from different threads.
+		using entropy_source_t = bool (*)(std::span<uint8_t, seed_lenght> p_out);
+
+	public:
+		///	\brief Seeds the generator, any previous state is discarded.
+		///	\param[in] p_personalization - At most \ref seed_lenght bytes, can be empty.
+		///	\return false if p_personalization is too long, in which case nothing is done.
+		bool instantiate(std::span<const uint8_t, seed_lenght> p_entropy, std::span<const uint8_t> p_personalization = {});
+
+		///	\brief Mixes new entropy into the state and resets the reseed counter.
+		///	\param[in] p_additional - At most \ref seed_lenght bytes, can be empty.
+		///	\return false if the generator was not instantiated or p_additional is too long, in which case nothing is done.
+		bool reseed(std::span<const uint8_t, seed_lenght> p_entropy, std::span<const uint8_t> p_additional = {});
+
+		///	\brief Fills p_out with random bytes.
+		///	\param[in] p_additional - At most \ref seed_lenght bytes, can be empty.
+		///	\return false if a reseed is required, the generator was not instantiated,
+		///		p_out is larger than \ref max_request or p_additional is too long, in which case nothing is done.
+		bool generate(std::span<uint8_t> p_out, std::span<const uint8_t> p_additional = {});
+
+		///	\brief true if \ref generate will fail until \ref reseed is called.
+		bool reseed_required() const;
+
+		///	\brief Wipes the state, the generator must be instantiated again before use.
+		void uninstantiate();
+
+		///	\brief Sets the source used to seed and reseed the per thread generators.
+		///		Should be set before the first call to \ref thread_generate.
+		static void set_entropy_source(entropy_source_t p_source);
+
+		///	\brief Fills p_out from the calling thread's generator.
+		///		Small requests are served from a buffer of pre-generated output,
+		///		the generator is seeded from the entropy source on first use and reseeded periodically.
+		///	\note After a fork() the child discards the state it inherited and seeds a new generator on its next call,
+		///		so that parent and child never hand out the same bytes.
+		///	\return false if no entropy source is set or the source failed, in which case p_out is zeroed.
+		static bool thread_generate(std::span<uint8_t> p_out);
+
+		///	\brief Discards the calling thread's buffer and reseeds its generator from the entropy source.
+		///	\return false if no entropy source is set or the source failed,
+		///		the thread's generator is then uninstantiated and will try again on the next use.
+		static bool thread_reseed();
+
+	private:
+		void update(const uint8_t* p_provided);
+
+	private:
+		AES_256::key_schedule_t	m_wkey;
+		std::array<uint64_t, 2>	m_counter {0, 0};	//!< V + 1, the next counter block
+		uint64_t				m_reseed_counter = 0;	//!< 0 if not instantiated
+	};
+} //namespace crypto
@@ -0,0 +1,142 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES-GCM - Galois/Counter Mode
+///			Authenticated encryption with associated data
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	class worker_pool;
+
+	namespace _p
+	{
+		///	\brief Powers of the hash subkey H^1 .. H^16
+		struct GHASH_key_t
+		{
+			alignas(16) std::array<std::array<uint64_t, 2>, 16> power;
+		};
+	}//namespace _p
+
+	///	\brief Galois/Counter Mode (NIST SP 800-38D) on top of \ref AES_128, \ref AES_192 or \ref AES_256
+	///		Encryption and authentication are done in a single pass over the data.
+	///	\note Usage: set_key() once, then for every message
+	///		reset(), update_aad() (optional), encode() or decode(), finalize(), and tag() or verify().
+	template<typename AES_t>
+	class AES_GCM
+	{
+	public:
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+		static constexpr uintptr_t tag_lenght = 16;
+
+		///	\brief Maximum number of bytes encrypted under one IV, 2^32 - 2 blocks (NIST SP 800-38D 5.2.1.1).
+		///		Past this point the 32 bit counter would wrap around and reuse the key stream.
+		static constexpr uint64_t max_data_size = (uint64_t{0xFFFFFFFF} - 1) * block_lenght;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+		using tag_t = std::array<uint8_t, tag_lenght>;
+
+		///	\brief Size of the pieces a buffer is split into by the \ref worker_pool overloads of \ref encode and \ref decode.
+		static constexpr uintptr_t parallel_chunk = 256 * 1024;
+
+	public:
+		///	\brief Sets the key and precomputes the hash subkey, it can be reused for any number of messages.
+		void set_key(const key_schedule_t& p_wkey);
+
+		///	\brief Starts a new message.
+		///	\param[in] p_iv - Initialization vector, 12 bytes is recommended. Must never repeat for the same key.
+		///	\param[in] p_tag_size - Size of the tag accepted by verify(), one of 16, 15, 14, 13, 12, 8 or 4 (NIST SP 800-38D 5.2.1.2).
+		///		Sizes of 8 and 4 are only safe with the limits on message length and count of NIST SP 800-38D Appendix C.
+		///	\return false if p_iv is empty or p_tag_size is not one of the allowed sizes.
+		bool reset(std::span<const uint8_t> p_iv, uintptr_t p_tag_size = tag_lenght);
+
+		///	\brief Additional authenticated data, calls can be split at any byte boundary.
+		///	\return false if encode() or decode() was already called for this message.
+		bool update_aad(std::span<const uint8_t> p_data);
+
+		///	\brief Same as \ref update_aad, over a scatter-gather list. The buffers are treated as one contiguous stream.
+		bool update_aad(std::span<const std::span<const uint8_t>> p_buffers);
+
+		///	\brief Encrypts/decrypts, calls can be split at any byte boundary.
+		///		Do not mix encode() and decode() in the same message.
+		///	\param[out] p_out - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\return false if the message would exceed \ref max_data_size, in which case nothing is done.
+		bool encode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+		bool decode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref encode and \ref decode, in place.
+		bool encode(std::span<uint8_t> p_data);
+		bool decode(std::span<uint8_t> p_data);
+
+		///	\brief Same as \ref encode and \ref decode, in place over a scatter-gather list.
+		///		The buffers are treated as one contiguous stream, a block can straddle buffers.
+		bool encode(std::span<const std::span<uint8_t>> p_buffers);
+		bool decode(std::span<const std::span<uint8_t>> p_buffers);
+
+		///	\brief Same as \ref encode and \ref decode, split across p_pool for very large buffers.
+		///		Each task encrypts and hashes \ref parallel_chunk bytes starting from its own counter offset,
+		///		the partial hashes are then joined with powers of H. Buffers of less than 2 chunks are processed on the calling thread.
+		bool encode(worker_pool& p_pool, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+		bool decode(worker_pool& p_pool, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Computes the authentication tag
+		void finalize();
+
+		///	\brief Full tag, a truncated tag is made of its first \ref tag_size bytes.
+		inline const tag_t& tag() const { return m_tag; }
+		inline uintptr_t tag_size() const { return m_tag_size; }
+
+		///	\brief Constant time comparison of the first \ref tag_size bytes of the computed tag against p_tag.
+		///	\return false if the tags do not match or the size of p_tag is not the one given to reset().
+		bool verify(std::span<const uint8_t> p_tag) const;
+
+	private:
+		bool process(const uint8_t* p_input, uint8_t* p_out, uintptr_t p_size, bool p_encode);
+		void process_blocks(const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count, bool p_encode);
+		bool process_parallel(worker_pool& p_pool, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_size, bool p_encode);
+		bool fits(uint64_t p_size) const;
+		void hash_pending();
+
+	private:
+		key_schedule_t						m_wkey;
+		_p::GHASH_key_t						m_hash_key;
+		std::array<uint64_t, 2>				m_hash {0, 0};
+		std::array<uint64_t, 2>				m_counter {0, 0};
+		alignas(8) std::array<uint8_t, 16>	m_mask {0};
+		alignas(8) std::array<uint8_t, 16>	m_cached {0};
+		alignas(8) std::array<uint8_t, 16>	m_pending {0};
+		tag_t								m_tag {0};
+		uint64_t							m_aad_size = 0;
+		uint64_t							m_data_size = 0;
+		uint8_t								m_tag_size = tag_lenght;
+	};
+} //namespace crypto
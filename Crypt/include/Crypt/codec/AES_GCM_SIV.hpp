@@ -0,0 +1,80 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES-GCM-SIV - Nonce misuse resistant authenticated encryption
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	///	\brief AES-GCM-SIV (RFC 8452) on top of \ref AES_128 or \ref AES_256
+	///		The tag is computed over the plain text and used as the counter of the encryption, repeating a nonce
+	///		only reveals whether the same message was encrypted twice. Encryption with a fixed nonce is deterministic.
+	///	\note The whole message must be known upfront, encode() and decode() take it in one call.
+	///		Every message derives its own encryption and authentication keys from the key and the nonce.
+	template<typename AES_t>
+	class AES_GCM_SIV
+	{
+		static_assert(AES_t::key_lenght == 16 || AES_t::key_lenght == 32, "GCM-SIV is only defined for AES-128 and AES-256");
+
+	public:
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+		static constexpr uintptr_t tag_lenght = 16;
+		static constexpr uintptr_t nonce_lenght = 12;
+
+		///	\brief Maximum size of the plain text and of the additional data, 2^36 bytes
+		static constexpr uint64_t max_size = uint64_t{1} << 36;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+		using tag_t = std::array<uint8_t, tag_lenght>;
+
+	public:
+		///	\brief Sets the key generating key, it can be reused for any number of messages.
+		void set_key(const key_schedule_t& p_wkey);
+
+		///	\brief Encrypts p_input and computes its tag.
+		///	\param[in]  p_aad - Additional authenticated data, can be empty.
+		///	\param[out] p_out - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\return false if p_input or p_aad are larger than \ref max_size or p_out is too small, in which case nothing is done.
+		bool encode(std::span<const uint8_t, nonce_lenght> p_nonce, std::span<const uint8_t> p_aad,
+			std::span<const uint8_t> p_input, std::span<uint8_t> p_out, tag_t& p_tag) const;
+
+		///	\brief Decrypts p_input and checks it against p_tag.
+		///	\param[out] p_out - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\return false if the tag does not match, the sizes are not valid or p_out is too small.
+		///		The first p_input.size() bytes of p_out are zeroed if the tag does not match.
+		bool decode(std::span<const uint8_t, nonce_lenght> p_nonce, std::span<const uint8_t> p_aad,
+			std::span<const uint8_t> p_input, std::span<uint8_t> p_out, const tag_t& p_tag) const;
+
+	private:
+		key_schedule_t m_wkey;
+	};
+} //namespace crypto
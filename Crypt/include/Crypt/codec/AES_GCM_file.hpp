@@ -0,0 +1,81 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES-GCM - Streaming file encryption
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <filesystem>
+#include <span>
+
+#include "AES_GCM.hpp"
+
+namespace crypto
+{
+	class worker_pool;
+
+	///	\brief Encrypts and decrypts whole files with \ref AES_GCM.
+	///		Reading of the next chunk, encryption of the current one and writing of the previous one overlap,
+	///		chunks go around a ring of buffers between a reader thread, the calling thread and a writer thread.
+	///	\note The output is the cipher text, same size as the input, followed by the \ref tag_lenght byte tag.
+	///		The input and output must be different files, the call fails otherwise.
+	///		The output is written to p_output with ".part" appended, and only renamed to p_output once it is complete
+	///		(and for \ref decode once the tag matches). On failure it is removed and p_output is left untouched.
+	template<typename AES_t>
+	class AES_GCM_file
+	{
+	public:
+		static constexpr uintptr_t tag_lenght = AES_GCM<AES_t>::tag_lenght;
+
+		///	\brief Upper bound on chunk_size * buffer_count.
+		static constexpr uintptr_t max_ring_size = uintptr_t{1} << 30;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+
+		struct options_t
+		{
+			uintptr_t		chunk_size		= uintptr_t{1} << 20;	//!< Bytes per ring buffer, a multiple of the block size
+			uint32_t		buffer_count	= 4;					//!< Number of ring buffers, at least 3 for the stages to overlap
+			bool			memory_map		= true;					//!< Encrypts straight from a read only mapping of the input, instead of reading it into the ring
+			worker_pool*	pool			= nullptr;				//!< If set, each chunk is also split across the pool
+		};
+
+	public:
+		///	\param[in] p_iv  - Initialization vector, 12 bytes is recommended. Must never repeat for the same key.
+		///	\param[in] p_aad - Additional authenticated data, can be empty.
+		///	\return false if p_iv is empty, the options are not valid, the input is larger than \ref AES_GCM::max_data_size,
+		///		p_input and p_output are the same file or the files can not be read or written.
+		static bool encode(const key_schedule_t& p_wkey, std::span<const uint8_t> p_iv, std::span<const uint8_t> p_aad,
+			const std::filesystem::path& p_input, const std::filesystem::path& p_output, const options_t& p_options = {});
+
+		///	\brief Decrypts a file produced by \ref encode.
+		///	\return false if the tag does not match, p_iv is empty, the options are not valid, the input is too large,
+		///		p_input and p_output are the same file or the files can not be read or written.
+		static bool decode(const key_schedule_t& p_wkey, std::span<const uint8_t> p_iv, std::span<const uint8_t> p_aad,
+			const std::filesystem::path& p_input, const std::filesystem::path& p_output, const options_t& p_options = {});
+	};
+} //namespace crypto
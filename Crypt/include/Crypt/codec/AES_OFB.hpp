@@ -0,0 +1,117 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES - Output feedback mode
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <span>
+#include <vector>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	///	\brief Output feedback mode (NIST SP 800-38A) on top of \ref AES_128, \ref AES_192 or \ref AES_256
+	///		The key stream does not depend on the data, see \ref AES_OFB_buffer to generate it ahead of time.
+	///		Encoding and decoding are the same operation.
+	template<typename AES_t>
+	class AES_OFB
+	{
+	public:
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+		using iv_t = std::array<uint8_t, block_lenght>;
+
+	public:
+		void reset(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_iv);
+
+		///	\brief Applies the key stream, calls can be split at any byte boundary.
+		///	\param[out] p_out - Must be at least as large as p_input. Can be the same buffer as p_input.
+		void update(std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref update, in place.
+		void update(std::span<uint8_t> p_data);
+
+		///	\brief Writes the next p_out.size() bytes of key stream, the stream advances as if they were used by \ref update.
+		void key_stream(std::span<uint8_t> p_out);
+
+	private:
+		key_schedule_t				m_wkey;
+		alignas(16) iv_t			m_register {0};	//!< Last key stream block
+		uint8_t						m_cached_size = 0;	//!< Unused bytes at the end of m_register
+	};
+
+	///	\brief OFB key stream generated ahead of time into a ring buffer,
+	///		so that only the XOR remains to be done when the data arrives.
+	///		\ref fill and \ref update can run at the same time, on one producer thread and one consumer thread.
+	///	\note Key stream is wiped as soon as \ref update has used it, and the whole buffer on \ref reset and on destruction.
+	template<typename AES_t>
+	class AES_OFB_buffer
+	{
+	public:
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+
+	public:
+		///	\param[in] p_capacity - Size of the ring buffer in bytes, rounded up to a whole number of blocks.
+		explicit AES_OFB_buffer(uintptr_t p_capacity);
+		~AES_OFB_buffer();
+
+		AES_OFB_buffer(const AES_OFB_buffer&) = delete;
+		AES_OFB_buffer& operator = (const AES_OFB_buffer&) = delete;
+
+		///	\brief Discards the buffered key stream.
+		///	\warning Must not run at the same time as \ref fill or \ref update.
+		void reset(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_iv);
+
+		///	\brief Producer side, generates key stream until the buffer is full.
+		///	\return Number of key stream bytes generated.
+		uintptr_t fill();
+
+		///	\brief Consumer side, number of key stream bytes ready to be used by \ref update.
+		uintptr_t available() const;
+
+		///	\brief Consumer side, applies the buffered key stream.
+		///	\param[out] p_out - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\return false if less than p_input.size() bytes of key stream are buffered, in which case nothing is done.
+		bool update(std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Same as \ref update, in place.
+		bool update(std::span<uint8_t> p_data);
+
+	private:
+		AES_OFB<AES_t>						m_generator;
+		std::vector<uint8_t>				m_buffer;
+		alignas(64) std::atomic<uint64_t>	m_produced {0};	//!< Total bytes generated, written by the producer
+		alignas(64) std::atomic<uint64_t>	m_consumed {0};	//!< Total bytes used, written by the consumer
+	};
+} //namespace crypto
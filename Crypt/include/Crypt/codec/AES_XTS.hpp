@@ -0,0 +1,86 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES-XTS - XEX tweaked code book with cipher text stealing
+///			Symmetric block cypher for storage devices
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+#include <type_traits>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	///	\brief XTS mode (IEEE 1619, NIST SP 800-38E) on top of \ref AES_128 or \ref AES_256
+	///		Each data unit (sector) is encoded independently, its tweak is derived from the sector number.
+	///		Data units that are not a multiple of \ref block_lenght use cipher text stealing.
+	///	\note The data key and the tweak key must be different (IEEE 1619 5.1), \ref set_key fails otherwise.
+	template<typename AES_t>
+	class AES_XTS
+	{
+		static_assert(!std::is_same_v<AES_t, AES_192>, "XTS is only defined for AES_128 and AES_256");
+
+	public:
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+		using dec_key_schedule_t = typename AES_t::dec_key_schedule_t;
+		using tweak_t = std::array<uint8_t, block_lenght>;
+
+	public:
+		///	\return false if p_data_key and p_tweak_key are the same key, in which case the previous keys are kept.
+		bool set_key(const key_schedule_t& p_data_key, const key_schedule_t& p_tweak_key);
+
+		///	\brief Encodes/decodes a single data unit.
+		///	\param[in]  p_tweak - Tweak value before encryption, i.e. the data unit number as a 128 bit little endian integer.
+		///	\param[in]  p_input - Must be at least \ref block_lenght bytes long.
+		///	\param[out] p_out   - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\return false if p_input is shorter than \ref block_lenght.
+		bool encode(std::span<const uint8_t, block_lenght> p_tweak, std::span<const uint8_t> p_input, std::span<uint8_t> p_out) const;
+		bool decode(std::span<const uint8_t, block_lenght> p_tweak, std::span<const uint8_t> p_input, std::span<uint8_t> p_out) const;
+
+		///	\brief Encodes/decodes consecutive data units of p_sector_size bytes, numbered from p_sector onwards.
+		///	\param[out] p_out - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\return false if p_sector_size is smaller than \ref block_lenght or the size of p_input is not a multiple of p_sector_size.
+		bool encode_sectors(uint64_t p_sector, uintptr_t p_sector_size, std::span<const uint8_t> p_input, std::span<uint8_t> p_out) const;
+		bool decode_sectors(uint64_t p_sector, uintptr_t p_sector_size, std::span<const uint8_t> p_input, std::span<uint8_t> p_out) const;
+
+	private:
+		template<bool Encode>
+		void process_unit(uint8_t* p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_size) const;
+
+		template<bool Encode>
+		bool process_sectors(uint64_t p_sector, uintptr_t p_sector_size, std::span<const uint8_t> p_input, std::span<uint8_t> p_out) const;
+
+	private:
+		key_schedule_t		m_data_key;
+		dec_key_schedule_t	m_data_dkey;
+		key_schedule_t		m_tweak_key;
+	};
+} //namespace crypto
@@ -0,0 +1,235 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES - Compile time key schedule and encoding
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <bit>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	namespace _p
+	{
+		struct AES_tables
+		{
+			static constexpr std::array<uint8_t, 256> s_box =
+			{
+				0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+				0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+				0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+				0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+				0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+				0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+				0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+				0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+				0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+				0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+				0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+				0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+				0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+				0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+				0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+				0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+			};
+
+			static constexpr std::array<uint8_t, 10> rcon =
+			{
+				0x01, 0x02, 0x04, 0x08, 0x10,
+				0x20, 0x40, 0x80, 0x1B, 0x36,
+			};
+		};
+	} //namespace _p
+
+	///	\brief Compile time evaluable key expansion and encoding for \ref AES_128, \ref AES_192 or \ref AES_256.
+	///		Meant for constants derived from fixed keys, e.g.
+	///		`static constexpr AES_256::key_schedule_t wkey = AES_constexpr<AES_256>::make_key_schedule(key);`
+	///		The schedule is the same as the one from AES_t::make_key_schedule and can be used with any engine.
+	///	\warning Plain table lookups, not constant time and much slower than the engines when evaluated at run time.
+	template<typename AES_t>
+	class AES_constexpr
+	{
+	public:
+		static constexpr uintptr_t key_lenght = AES_t::key_lenght;
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+		static constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+		using block_t = std::array<uint8_t, block_lenght>;
+
+	private:
+		using tables = _p::AES_tables;
+		using word_t = std::array<uint8_t, 4>;
+		static constexpr uintptr_t key_words = key_lenght / 4;
+
+		//	Note: A union member can only be read at compile time if it is the active one,
+		//	the schedule is written and read through ui32 with the bytes in memory order.
+		static constexpr _p::wblock_t to_wblock(const word_t& p_word)
+		{
+			if constexpr(std::endian::native == std::endian::little)
+			{
+				return _p::wblock_t{.ui32 = static_cast<uint32_t>(p_word[0] | p_word[1] << 8 | p_word[2] << 16 | p_word[3] << 24)};
+			}
+			else
+			{
+				return _p::wblock_t{.ui32 = static_cast<uint32_t>(p_word[3] | p_word[2] << 8 | p_word[1] << 16 | p_word[0] << 24)};
+			}
+		}
+
+		static constexpr word_t from_wblock(const _p::wblock_t& p_word)
+		{
+			const uint32_t val = p_word.ui32;
+			if constexpr(std::endian::native == std::endian::little)
+			{
+				return word_t{static_cast<uint8_t>(val), static_cast<uint8_t>(val >> 8), static_cast<uint8_t>(val >> 16), static_cast<uint8_t>(val >> 24)};
+			}
+			else
+			{
+				return word_t{static_cast<uint8_t>(val >> 24), static_cast<uint8_t>(val >> 16), static_cast<uint8_t>(val >> 8), static_cast<uint8_t>(val)};
+			}
+		}
+
+		static constexpr uint8_t xtime(const uint8_t p_val)
+		{
+			return static_cast<uint8_t>((p_val << 1) ^ ((p_val & 0x80) ? 0x1B : 0x00));
+		}
+
+		static constexpr void add_round_key(block_t& p_state, const key_schedule_t& p_wkey, const uintptr_t p_round)
+		{
+			for(uintptr_t c = 0; c < 4; ++c)
+			{
+				const word_t round_key = from_wblock(p_wkey.wkey[p_round * 4 + c]);
+				for(uintptr_t r = 0; r < 4; ++r)
+				{
+					p_state[c * 4 + r] ^= round_key[r];
+				}
+			}
+		}
+
+		//	Note: SubBytes and ShiftRows in one pass, row r is rotated left by r columns.
+		static constexpr void sub_shift(block_t& p_state)
+		{
+			const block_t in = p_state;
+			for(uintptr_t c = 0; c < 4; ++c)
+			{
+				for(uintptr_t r = 0; r < 4; ++r)
+				{
+					p_state[c * 4 + r] = tables::s_box[in[((c + r) % 4) * 4 + r]];
+				}
+			}
+		}
+
+		static constexpr void mix_columns(block_t& p_state)
+		{
+			for(uintptr_t c = 0; c < 4; ++c)
+			{
+				uint8_t* const col = p_state.data() + c * 4;
+				const uint8_t a0 = col[0];
+				const uint8_t a1 = col[1];
+				const uint8_t a2 = col[2];
+				const uint8_t a3 = col[3];
+				const uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+				col[0] ^= all ^ xtime(a0 ^ a1);
+				col[1] ^= all ^ xtime(a1 ^ a2);
+				col[2] ^= all ^ xtime(a2 ^ a3);
+				col[3] ^= all ^ xtime(a3 ^ a0);
+			}
+		}
+
+	public:
+		static constexpr key_schedule_t make_key_schedule(std::span<const uint8_t, key_lenght> p_key)
+		{
+			std::array<word_t, AES_t::key_schedule_size> words{};
+			for(uintptr_t i = 0; i < key_lenght; ++i)
+			{
+				words[i / 4][i % 4] = p_key[i];
+			}
+
+			for(uintptr_t i = key_words; i < words.size(); ++i)
+			{
+				word_t temp = words[i - 1];
+				if(i % key_words == 0)
+				{
+					temp = word_t{
+						static_cast<uint8_t>(tables::s_box[temp[1]] ^ tables::rcon[i / key_words - 1]),
+						tables::s_box[temp[2]],
+						tables::s_box[temp[3]],
+						tables::s_box[temp[0]]};
+				}
+				else if(key_words > 6 && i % key_words == 4)
+				{
+					for(uint8_t& tbyte : temp)
+					{
+						tbyte = tables::s_box[tbyte];
+					}
+				}
+
+				for(uintptr_t j = 0; j < 4; ++j)
+				{
+					words[i][j] = words[i - key_words][j] ^ temp[j];
+				}
+			}
+
+			key_schedule_t out{};
+			for(uintptr_t i = 0; i < words.size(); ++i)
+			{
+				out.wkey[i] = to_wblock(words[i]);
+			}
+			return out;
+		}
+
+		static constexpr block_t encode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input)
+		{
+			block_t state{};
+			for(uintptr_t i = 0; i < block_lenght; ++i)
+			{
+				state[i] = p_input[i];
+			}
+
+			add_round_key(state, p_wkey, 0);
+			for(uintptr_t round = 1; round < number_of_rounds; ++round)
+			{
+				sub_shift(state);
+				mix_columns(state);
+				add_round_key(state, p_wkey, round);
+			}
+			sub_shift(state);
+			add_round_key(state, p_wkey, number_of_rounds);
+
+			return state;
+		}
+
+		///	\brief Same as \ref encode, from the raw key.
+		static constexpr block_t encode(std::span<const uint8_t, key_lenght> p_key, std::span<const uint8_t, block_lenght> p_input)
+		{
+			return encode(make_key_schedule(p_key), p_input);
+		}
+	};
+} //namespace crypto
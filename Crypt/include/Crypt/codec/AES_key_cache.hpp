@@ -0,0 +1,80 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES - Key schedule cache
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+
+#pragma once
+#include <cstdint>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	///	\brief Fixed size cache of expanded keys, for when the same keys are used over and over.
+	///		Keys are hashed with \ref CRC_32C into sets of \ref ways entries, a full set evicts an entry with the CLOCK policy.
+	///		Lookups do not take locks, only inserting a new key locks the set it goes into.
+	///	\note Cached key schedules are wiped when evicted, erased and when the cache is destroyed.
+	///	\note The hash is not keyed, keys chosen to collide can only make each other miss.
+	template<typename AES_t>
+	class AES_key_cache
+	{
+	public:
+		static constexpr uintptr_t key_lenght = AES_t::key_lenght;
+		static constexpr uintptr_t ways = 8;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+
+	public:
+		///	\param[in] p_capacity - Maximum number of keys, rounded up to a power of 2 number of sets. At least one set is used.
+		explicit AES_key_cache(uintptr_t p_capacity);
+		~AES_key_cache();
+
+		AES_key_cache(const AES_key_cache&) = delete;
+		AES_key_cache& operator = (const AES_key_cache&) = delete;
+
+		///	\brief Maximum number of keys held at once.
+		uintptr_t capacity() const;
+
+		///	\brief Copies the cached schedule of p_key, the key is expanded and inserted if it is not cached.
+		void get(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_out);
+
+		///	\brief Same as \ref get, without inserting.
+		///	\return false if p_key is not cached, in which case p_out is zeroed.
+		bool find(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_out) const;
+
+		///	\brief Removes and wipes p_key, i.e. after it is revoked.
+		void erase(std::span<const uint8_t, key_lenght> p_key);
+
+		///	\brief Removes and wipes all keys.
+		void clear();
+
+	private:
+		struct state_t;
+		state_t* m_state;
+	};
+} //namespace crypto
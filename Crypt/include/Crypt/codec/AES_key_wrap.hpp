@@ -0,0 +1,106 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES key wrap - Key wrapping with and without padding
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	///	\brief AES key wrap (RFC 3394, NIST SP 800-38F KW) and key wrap with padding (RFC 5649, KWP)
+	///		on top of \ref AES_128, \ref AES_192 or \ref AES_256
+	///	\note Unwrapping uses the decoding round keys, see AES_t::make_dec_key_schedule.
+	///		Many wrapped keys are better served by the batch \ref unwrap and \ref unwrap_pad,
+	///		which interleave their chains.
+	template<typename AES_t>
+	class AES_key_wrap
+	{
+	public:
+		static constexpr uintptr_t semiblock_lenght = 8;
+		static constexpr uintptr_t lanes = 8;
+
+		using key_schedule_t = typename AES_t::key_schedule_t;
+		using dec_key_schedule_t = typename AES_t::dec_key_schedule_t;
+
+		///	\brief Independent wrapped key for the batch \ref unwrap and \ref unwrap_pad
+		struct job_t
+		{
+			const dec_key_schedule_t*	dkey = nullptr;
+			std::span<const uint8_t>	input;				//!< Wrapped key
+			std::span<uint8_t>			out;				//!< Must be at least input.size() - 8, can be the same buffer as input
+			uintptr_t					out_size = 0;		//!< Size of the unwrapped key, 0 if it failed
+			bool						valid = false;		//!< false if the size is not valid or the integrity check failed
+		};
+
+	public:
+		///	\brief Size of the output of \ref wrap_pad for a key of p_size bytes.
+		static constexpr uintptr_t wrap_pad_size(const uintptr_t p_size)
+		{
+			return ((p_size + semiblock_lenght - 1) & ~(semiblock_lenght - 1)) + semiblock_lenght;
+		}
+
+		///	\brief Wraps p_input (KW).
+		///	\param[in]  p_input - Size must be a multiple of \ref semiblock_lenght and at least 16 bytes.
+		///	\param[out] p_out   - Must be at least p_input.size() + 8, can be the same buffer as p_input.
+		///	\return false if the size of p_input or p_out is not valid, in which case nothing is done.
+		static bool wrap(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Unwraps p_input (KW).
+		///	\param[in]  p_input - Size must be a multiple of \ref semiblock_lenght and at least 24 bytes.
+		///	\param[out] p_out   - Must be at least p_input.size() - 8, can be the same buffer as p_input.
+		///	\return false if the size of p_input or p_out is not valid or if the integrity check fails.
+		///		The first p_input.size() - 8 bytes of p_out are zeroed if the integrity check fails.
+		static bool unwrap(const dec_key_schedule_t& p_dkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Wraps p_input with padding (KWP).
+		///	\param[in]  p_input - Size must be in the range [1, 2^32 - 1].
+		///	\param[out] p_out   - Must be at least \ref wrap_pad_size of p_input.size(), can be the same buffer as p_input.
+		///	\return false if the size of p_input or p_out is not valid, in which case nothing is done.
+		static bool wrap_pad(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+
+		///	\brief Unwraps p_input with padding (KWP).
+		///	\param[in]  p_input    - Size must be a multiple of \ref semiblock_lenght and at least 16 bytes.
+		///	\param[out] p_out      - Must be at least p_input.size() - 8, can be the same buffer as p_input.
+		///	\param[out] p_out_size - Size of the unwrapped key, 0 if it failed.
+		///	\return false if the size of p_input or p_out is not valid or if the integrity check fails.
+		///		The first p_input.size() - 8 bytes of p_out are zeroed if the integrity check fails.
+		static bool unwrap_pad(const dec_key_schedule_t& p_dkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out, uintptr_t& p_out_size);
+
+		///	\brief Unwraps every job (KW), job_t::out_size and job_t::valid are set on each of them.
+		///		The unwrap of a single key is a chain of 6 * n dependent block decodes, up to \ref lanes chains
+		///		are interleaved instead, one block of each per step. Jobs can use different keys and sizes.
+		///	\return false if any of the jobs failed.
+		///	\note Only the AES-NI based engines interleave, the others process the jobs one after the other.
+		static bool unwrap(std::span<job_t> p_jobs);
+
+		///	\brief Same as the batch \ref unwrap, with padding (KWP).
+		static bool unwrap_pad(std::span<job_t> p_jobs);
+	};
+} //namespace crypto
@@ -0,0 +1,84 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		AES multi-buffer - Many independent messages, each with its own key
+///			Interleaved through the AES pipeline
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "AES.hpp"
+
+namespace crypto
+{
+	///	\brief Independent message processed by \ref AES_multi_buffer
+	template<typename AES_t>
+	struct AES_job
+	{
+		const typename AES_t::key_schedule_t* wkey = nullptr;
+
+		///	\brief Initialization vector (CBC) or counter block (CTR), unused by ECB.
+		///		Updated once the message is done, so that it can be continued.
+		alignas(16) std::array<uint8_t, AES_t::block_lenght> iv {0};
+
+		std::span<const uint8_t>	input;
+		std::span<uint8_t>			out;	//!< Must be at least as large as input, can be the same buffer as input. Unused by CBC-MAC.
+	};
+
+	///	\brief Processes many short independent messages, each under its own key.
+	///		Up to \ref lanes messages are interleaved, one block of each per step, so that the latency of a message
+	///		is hidden behind the work of the others. A lane is refilled with the next job as soon as its message ends,
+	///		messages can have different lengths.
+	///	\note Only the AES-NI based engines interleave, the others process the jobs one after the other.
+	template<typename AES_t>
+	class AES_multi_buffer
+	{
+	public:
+		static constexpr uintptr_t block_lenght = AES_t::block_lenght;
+		static constexpr uintptr_t lanes = 8;
+
+		using job_t = AES_job<AES_t>;
+
+	public:
+		///	\brief Independent blocks (ECB) on every job.
+		///	\return false if the input size of a job is not a multiple of \ref block_lenght, in which case nothing is done.
+		static bool encode_blocks(std::span<job_t> p_jobs);
+
+		///	\brief Cipher block chaining encode on every job, job_t::iv is updated to the last cipher text block.
+		///	\return false if the input size of a job is not a multiple of \ref block_lenght, in which case nothing is done.
+		static bool cbc_encode(std::span<job_t> p_jobs);
+
+		///	\brief Same as \ref cbc_encode without writing the cipher text (CBC-MAC), job_t::out is not used.
+		///	\return false if the input size of a job is not a multiple of \ref block_lenght, in which case nothing is done.
+		static bool cbc_mac(std::span<job_t> p_jobs);
+
+		///	\brief Counter mode on every job, the input can have any size.
+		///		job_t::iv is updated to the counter of the next unused block, a trailing partial block uses up a whole counter.
+		static void ctr_xor(std::span<job_t> p_jobs);
+	};
+} //namespace crypto
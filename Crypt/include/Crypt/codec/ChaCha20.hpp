@@ -0,0 +1,74 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		ChaCha20 - Stream cypher
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+
+namespace crypto
+{
+	///	\brief Implementation used by \ref ChaCha20 and by the Poly1305 of \ref ChaCha20_Poly1305
+	enum class ChaCha20_engine: uint8_t
+	{
+		automatic,	//!< Best implementation supported by the running CPU
+		software,	//!< Portable one block at a time implementation
+		SSE2,		//!< x86-64 SSE2, 4 blocks at once
+		AVX2,		//!< x86-64 AVX2, 8 blocks at once, Poly1305 hashes 4 blocks at once
+		AVX512,		//!< x86-64 AVX-512, 16 blocks at once, Poly1305 same as \ref AVX2
+	};
+
+	///	\brief Replaces the implementation used by \ref ChaCha20 and \ref ChaCha20_Poly1305.
+	///	\return false if the engine is not supported by the running CPU, in which case nothing changes.
+	///	\warning Not thread safe, it is meant for testing and benchmarking.
+	///		The best available engine is already selected on startup.
+	bool ChaCha20_set_engine(ChaCha20_engine p_engine);
+
+	///	\brief Currently active engine, never returns \ref ChaCha20_engine::automatic
+	ChaCha20_engine ChaCha20_get_engine();
+
+	///	\brief ChaCha20 stream cypher (RFC 8439), 96 bit nonce and 32 bit block counter.
+	class ChaCha20
+	{
+	public:
+		static constexpr uintptr_t key_lenght = 32;
+		static constexpr uintptr_t nonce_lenght = 12;
+		static constexpr uintptr_t block_lenght = 64;
+
+		///	\brief Maximum number of bytes that can be encrypted from block 0 onwards
+		static constexpr uint64_t max_size = uint64_t{1} << 38;
+
+	public:
+		///	\brief p_out = p_input ^ key stream, starting at block p_counter.
+		///		Encryption and decryption are the same operation.
+		///	\param[out] p_out - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\return false if p_out is too small or the block counter would wrap around, in which case nothing is done.
+		static bool xor_stream(std::span<const uint8_t, key_lenght> p_key, std::span<const uint8_t, nonce_lenght> p_nonce, uint32_t p_counter,
+			std::span<const uint8_t> p_input, std::span<uint8_t> p_out);
+	};
+} //namespace crypto
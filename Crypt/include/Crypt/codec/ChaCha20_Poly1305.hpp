@@ -0,0 +1,77 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		ChaCha20-Poly1305 - Authenticated encryption
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "ChaCha20.hpp"
+
+namespace crypto
+{
+	///	\brief ChaCha20-Poly1305 (RFC 8439) authenticated encryption.
+	///		Does not depend on AES, it is the preferred AEAD on CPUs without AES instructions.
+	///	\note The whole message is taken in one call, the encryption and the hash are done chunk by chunk
+	///		so that the data is still in cache for the second pass.
+	class ChaCha20_Poly1305
+	{
+	public:
+		static constexpr uintptr_t key_lenght = ChaCha20::key_lenght;
+		static constexpr uintptr_t nonce_lenght = ChaCha20::nonce_lenght;
+		static constexpr uintptr_t tag_lenght = 16;
+
+		///	\brief Maximum size of the plain text, block 0 of the key stream is used for the Poly1305 key.
+		static constexpr uint64_t max_size = ChaCha20::max_size - ChaCha20::block_lenght;
+
+		using key_t = std::array<uint8_t, key_lenght>;
+		using tag_t = std::array<uint8_t, tag_lenght>;
+
+	public:
+		///	\brief Sets the key, it can be reused for any number of messages.
+		void set_key(std::span<const uint8_t, key_lenght> p_key);
+
+		///	\brief Encrypts p_input and computes its tag.
+		///	\param[in]  p_nonce - Must never repeat for the same key.
+		///	\param[in]  p_aad   - Additional authenticated data, can be empty.
+		///	\param[out] p_out   - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\return false if p_input is larger than \ref max_size or p_out is too small, in which case nothing is done.
+		bool encode(std::span<const uint8_t, nonce_lenght> p_nonce, std::span<const uint8_t> p_aad,
+			std::span<const uint8_t> p_input, std::span<uint8_t> p_out, tag_t& p_tag) const;
+
+		///	\brief Checks p_input against p_tag and decrypts it.
+		///	\param[out] p_out - Must be at least as large as p_input. Can be the same buffer as p_input.
+		///	\return false if the tag does not match, the sizes are not valid or p_out is too small.
+		///		The first p_input.size() bytes of p_out are zeroed if the tag does not match.
+		bool decode(std::span<const uint8_t, nonce_lenght> p_nonce, std::span<const uint8_t> p_aad,
+			std::span<const uint8_t> p_input, std::span<uint8_t> p_out, const tag_t& p_tag) const;
+
+	private:
+		key_t m_key;
+	};
+} //namespace crypto
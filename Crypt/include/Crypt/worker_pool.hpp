@@ -0,0 +1,69 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		Worker pool - Splits bulk work across threads
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+#include <cstdint>
+
+namespace crypto
+{
+	///	\brief Fixed set of worker threads used to split very large buffers, see AES_CTR::update and AES_GCM::encode.
+	///		The threads are started once and sleep while there is no work.
+	///	\note \ref run can be called from several threads, calls are served one at a time.
+	class worker_pool
+	{
+	public:
+		using task_t = void (*)(void* p_context, uintptr_t p_index);
+
+	public:
+		///	\param[in] p_threads - Total number of threads taking part in \ref run, including the caller.
+		///		0 uses one per hardware thread.
+		explicit worker_pool(uint32_t p_threads = 0);
+		~worker_pool();
+
+		worker_pool(const worker_pool&) = delete;
+		worker_pool& operator = (const worker_pool&) = delete;
+
+		///	\brief Number of threads taking part in \ref run, including the caller.
+		uint32_t size() const;
+
+		///	\brief Calls p_task(p_context, i) for every i in [0, p_count), the calling thread also takes tasks.
+		///		Returns once all tasks are done.
+		void run(uintptr_t p_count, task_t p_task, void* p_context);
+
+		///	\brief Same as \ref run, for any callable taking the task index.
+		template<typename Task>
+		void run(uintptr_t p_count, Task& p_task)
+		{
+			run(p_count, [](void* p_context, uintptr_t p_index) { (*static_cast<Task*>(p_context))(p_index); }, &p_task);
+		}
+
+	private:
+		struct state_t;
+		state_t* m_state;
+	};
+} //namespace crypto
@@ -26,20 +26,27 @@
 //======== ======== ======== ======== ======== ======== ======== ========
 
 #include <Crypt/codec/AES.hpp>
+#include <Crypt/codec/AES_constexpr.hpp>
 
+#include <atomic>
 #include <bit>
 #include <cstring>
+#include <utility>
 
 #include <CoreLib/core_type.hpp>
+#include <CoreLib/core_endian.hpp>
 
 #if defined(_M_AMD64) || defined(__amd64__)
 #	include <emmintrin.h>
+#	include <CoreLib/core_cpu.hpp>
 #endif
 
+#include "isa_target.hpp"
+#include "block_help.hpp"
+#include "AES_engine.hpp"
+
 namespace crypto
 {
-	using core::literals::operator "" _ui8;
-
 	static constexpr std::array<uint8_t, 256> invert_s_box(const std::array<uint8_t, 256>& p_s_box)
 	{
 		std::array<uint8_t, 256> out{};
@@ -87,54 +94,34 @@ namespace crypto
 		return out;
 	}
 
+	///	\brief Combined SubBytes + MixColumns table, one 32 bit column (row 0 in the least significant byte) per input byte.
+	static constexpr std::array<uint32_t, 256> compute_T(const std::array<uint8_t, 256>& p_box, uint8_t p_m0, uint8_t p_m1, uint8_t p_m2, uint8_t p_m3)
+	{
+		std::array<uint32_t, 256> out{};
+
+		for(uintptr_t i = 0; i < 256; ++i)
+		{
+			const uint8_t val = p_box[i];
+			out[i] =
+				static_cast<uint32_t>(galois_mult(val, p_m0)) |
+				static_cast<uint32_t>(galois_mult(val, p_m1)) << 8 |
+				static_cast<uint32_t>(galois_mult(val, p_m2)) << 16 |
+				static_cast<uint32_t>(galois_mult(val, p_m3)) << 24;
+		}
+
+		return out;
+	}
+
 	struct AES_Help
 	{
 		static constexpr uintptr_t block_lenght = 16;
 		using state_t = std::array<uint8_t, block_lenght>;
 
-		static constexpr std::array<uint8_t, 256> s_box =
-		{
-			0x63_ui8, 0x7c_ui8, 0x77_ui8, 0x7b_ui8, 0xf2_ui8, 0x6b_ui8, 0x6f_ui8, 0xc5_ui8,
-			0x30_ui8, 0x01_ui8, 0x67_ui8, 0x2b_ui8, 0xfe_ui8, 0xd7_ui8, 0xab_ui8, 0x76_ui8,
-			0xca_ui8, 0x82_ui8, 0xc9_ui8, 0x7d_ui8, 0xfa_ui8, 0x59_ui8, 0x47_ui8, 0xf0_ui8,
-			0xad_ui8, 0xd4_ui8, 0xa2_ui8, 0xaf_ui8, 0x9c_ui8, 0xa4_ui8, 0x72_ui8, 0xc0_ui8,
-			0xb7_ui8, 0xfd_ui8, 0x93_ui8, 0x26_ui8, 0x36_ui8, 0x3f_ui8, 0xf7_ui8, 0xcc_ui8,
-			0x34_ui8, 0xa5_ui8, 0xe5_ui8, 0xf1_ui8, 0x71_ui8, 0xd8_ui8, 0x31_ui8, 0x15_ui8,
-			0x04_ui8, 0xc7_ui8, 0x23_ui8, 0xc3_ui8, 0x18_ui8, 0x96_ui8, 0x05_ui8, 0x9a_ui8,
-			0x07_ui8, 0x12_ui8, 0x80_ui8, 0xe2_ui8, 0xeb_ui8, 0x27_ui8, 0xb2_ui8, 0x75_ui8,
-			0x09_ui8, 0x83_ui8, 0x2c_ui8, 0x1a_ui8, 0x1b_ui8, 0x6e_ui8, 0x5a_ui8, 0xa0_ui8,
-			0x52_ui8, 0x3b_ui8, 0xd6_ui8, 0xb3_ui8, 0x29_ui8, 0xe3_ui8, 0x2f_ui8, 0x84_ui8,
-			0x53_ui8, 0xd1_ui8, 0x00_ui8, 0xed_ui8, 0x20_ui8, 0xfc_ui8, 0xb1_ui8, 0x5b_ui8,
-			0x6a_ui8, 0xcb_ui8, 0xbe_ui8, 0x39_ui8, 0x4a_ui8, 0x4c_ui8, 0x58_ui8, 0xcf_ui8,
-			0xd0_ui8, 0xef_ui8, 0xaa_ui8, 0xfb_ui8, 0x43_ui8, 0x4d_ui8, 0x33_ui8, 0x85_ui8,
-			0x45_ui8, 0xf9_ui8, 0x02_ui8, 0x7f_ui8, 0x50_ui8, 0x3c_ui8, 0x9f_ui8, 0xa8_ui8,
-			0x51_ui8, 0xa3_ui8, 0x40_ui8, 0x8f_ui8, 0x92_ui8, 0x9d_ui8, 0x38_ui8, 0xf5_ui8,
-			0xbc_ui8, 0xb6_ui8, 0xda_ui8, 0x21_ui8, 0x10_ui8, 0xff_ui8, 0xf3_ui8, 0xd2_ui8,
-			0xcd_ui8, 0x0c_ui8, 0x13_ui8, 0xec_ui8, 0x5f_ui8, 0x97_ui8, 0x44_ui8, 0x17_ui8,
-			0xc4_ui8, 0xa7_ui8, 0x7e_ui8, 0x3d_ui8, 0x64_ui8, 0x5d_ui8, 0x19_ui8, 0x73_ui8,
-			0x60_ui8, 0x81_ui8, 0x4f_ui8, 0xdc_ui8, 0x22_ui8, 0x2a_ui8, 0x90_ui8, 0x88_ui8,
-			0x46_ui8, 0xee_ui8, 0xb8_ui8, 0x14_ui8, 0xde_ui8, 0x5e_ui8, 0x0b_ui8, 0xdb_ui8,
-			0xe0_ui8, 0x32_ui8, 0x3a_ui8, 0x0a_ui8, 0x49_ui8, 0x06_ui8, 0x24_ui8, 0x5c_ui8,
-			0xc2_ui8, 0xd3_ui8, 0xac_ui8, 0x62_ui8, 0x91_ui8, 0x95_ui8, 0xe4_ui8, 0x79_ui8,
-			0xe7_ui8, 0xc8_ui8, 0x37_ui8, 0x6d_ui8, 0x8d_ui8, 0xd5_ui8, 0x4e_ui8, 0xa9_ui8,
-			0x6c_ui8, 0x56_ui8, 0xf4_ui8, 0xea_ui8, 0x65_ui8, 0x7a_ui8, 0xae_ui8, 0x08_ui8,
-			0xba_ui8, 0x78_ui8, 0x25_ui8, 0x2e_ui8, 0x1c_ui8, 0xa6_ui8, 0xb4_ui8, 0xc6_ui8,
-			0xe8_ui8, 0xdd_ui8, 0x74_ui8, 0x1f_ui8, 0x4b_ui8, 0xbd_ui8, 0x8b_ui8, 0x8a_ui8,
-			0x70_ui8, 0x3e_ui8, 0xb5_ui8, 0x66_ui8, 0x48_ui8, 0x03_ui8, 0xf6_ui8, 0x0e_ui8,
-			0x61_ui8, 0x35_ui8, 0x57_ui8, 0xb9_ui8, 0x86_ui8, 0xc1_ui8, 0x1d_ui8, 0x9e_ui8,
-			0xe1_ui8, 0xf8_ui8, 0x98_ui8, 0x11_ui8, 0x69_ui8, 0xd9_ui8, 0x8e_ui8, 0x94_ui8,
-			0x9b_ui8, 0x1e_ui8, 0x87_ui8, 0xe9_ui8, 0xce_ui8, 0x55_ui8, 0x28_ui8, 0xdf_ui8,
-			0x8c_ui8, 0xa1_ui8, 0x89_ui8, 0x0d_ui8, 0xbf_ui8, 0xe6_ui8, 0x42_ui8, 0x68_ui8,
-			0x41_ui8, 0x99_ui8, 0x2d_ui8, 0x0f_ui8, 0xb0_ui8, 0x54_ui8, 0xbb_ui8, 0x16_ui8,
-		};
+		static constexpr const std::array<uint8_t, 256>& s_box = _p::AES_tables::s_box;
 
 		static constexpr std::array<uint8_t, 256> inv_s_box = invert_s_box(s_box);
 
-		static constexpr std::array<uint8_t, 10> rcon =
-		{
-			0x01_ui8, 0x02_ui8, 0x04_ui8, 0x08_ui8, 0x10_ui8,
-			0x20_ui8, 0x40_ui8, 0x80_ui8, 0x1B_ui8, 0x36_ui8,
-		};
+		static constexpr const std::array<uint8_t, 10>& rcon = _p::AES_tables::rcon;
 
 		//static constexpr std::array<uint8_t, 256> gal_02 = compute_gal(0x02);
 		static constexpr std::array<uint8_t, 256> gal_03 = compute_gal(0x03);
@@ -461,147 +448,2991 @@ namespace crypto
 			memcpy(p_out.data(), &state, sizeof(state));
 		}
 
+		template<typename T>
+		static void encode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			for(; p_count; --p_count, p_input += block_lenght, p_out += block_lenght)
+			{
+				encode<T>(p_wkey, std::span<const uint8_t, 16>{p_input, 16}, std::span<uint8_t, 16>{p_out, 16});
+			}
+		}
+
+		template<typename T>
+		static void decode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			for(; p_count; --p_count, p_input += block_lenght, p_out += block_lenght)
+			{
+				decode<T>(p_wkey, std::span<const uint8_t, 16>{p_input, 16}, std::span<uint8_t, 16>{p_out, 16});
+			}
+		}
+
+		///	\brief Round keys in the order they are applied by the equivalent inverse cipher, the middle ones with InvMixColumns applied.
+		///	\tparam Mix - Provides InvMixColumns, engines that must not index tables with key material supply their own.
+		template<typename T, typename Mix = AES_Help>
+		static void make_dec_key(const typename T::key_schedule_t& p_wkey, typename T::dec_key_schedule_t& p_dkey)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			const _p::wblock_t* const wkey = p_wkey.wkey.data();
+			_p::wblock_t* const dkey = p_dkey.wkey.data();
+
+			memcpy(dkey, wkey + number_of_rounds * 4, 16);
+			for(uintptr_t i = 1; i < number_of_rounds; ++i)
+			{
+				alignas(16) state_t round_key;
+				memcpy(&round_key, wkey + (number_of_rounds - i) * 4, 16);
+				Mix::InvMixColumns(round_key);
+				memcpy(dkey + i * 4, &round_key, 16);
+			}
+			memcpy(dkey + number_of_rounds * 4, wkey, 16);
+		}
+
+		///	\brief Byte-wise key expansion
+		///	\tparam Box - Provides SubWord, engines that must not index tables with key material supply their own.
+		template<typename T, typename Box = AES_Help>
+		static void make_key(const uint8_t* const p_key, typename T::key_schedule_t& p_wkey)
+		{
+			if constexpr(std::is_same_v<T, AES_128>)
+			{
+				memcpy(p_wkey.wkey.data(), p_key, T::key_lenght);
+
+				_p::wblock_t* pivot = p_wkey.wkey.data();
+
+				for(uint8_t i = 0; i < 10; ++i)
+				{
+					_p::wblock_t* const pivot_next = pivot + 4;
+					memcpy(pivot_next, pivot, 16);
+
+					_p::wblock_t temp = *(pivot + 3);
+					AES_Help::RotWord(temp.ui32);
+					Box::SubWord(temp);
+					temp.ui8[0] ^= AES_Help::rcon[i];
+
+					pivot_next[0].ui32 ^= temp.ui32;
+					pivot_next[1].ui32 ^= pivot_next[0].ui32;
+					pivot_next[2].ui32 ^= pivot_next[1].ui32;
+					pivot_next[3].ui32 ^= pivot_next[2].ui32;
+
+					pivot = pivot_next;
+				}
+			}
+			else if constexpr(std::is_same_v<T, AES_192>)
+			{
+				memcpy(p_wkey.wkey.data(), p_key, T::key_lenght);
+
+				_p::wblock_t* pivot = p_wkey.wkey.data();
+
+				for(uint8_t i = 0; i < 7; ++i)
+				{
+					_p::wblock_t* const pivot_next = pivot + 6;
+					memcpy(pivot_next, pivot, 24);
+
+					_p::wblock_t temp = *(pivot + 5);
+					AES_Help::RotWord(temp.ui32);
+					Box::SubWord(temp);
+					temp.ui8[0] ^= AES_Help::rcon[i];
+
+					pivot_next[0].ui32 ^= temp.ui32;
+					pivot_next[1].ui32 ^= pivot_next[0].ui32;
+					pivot_next[2].ui32 ^= pivot_next[1].ui32;
+					pivot_next[3].ui32 ^= pivot_next[2].ui32;
+					pivot_next[4].ui32 ^= pivot_next[3].ui32;
+					pivot_next[5].ui32 ^= pivot_next[4].ui32;
+
+					pivot = pivot_next;
+				}
+				{
+					_p::wblock_t* const pivot_next = pivot + 6;
+					memcpy(pivot_next, pivot, 16);
+					_p::wblock_t temp = *(pivot + 5);
+					AES_Help::RotWord(temp.ui32);
+					Box::SubWord(temp);
+					temp.ui8[0] ^= AES_Help::rcon[7];
+					pivot_next[0].ui32 ^= temp.ui32;
+					pivot_next[1].ui32 ^= pivot_next[0].ui32;
+					pivot_next[2].ui32 ^= pivot_next[1].ui32;
+					pivot_next[3].ui32 ^= pivot_next[2].ui32;
+				}
+			}
+			else
+			{
+				static_assert(std::is_same_v<T, AES_256>);
+				memcpy(p_wkey.wkey.data(), p_key, T::key_lenght);
+
+				_p::wblock_t* pivot = p_wkey.wkey.data();
+
+				for(uint8_t i = 0; i < 6; ++i)
+				{
+					_p::wblock_t* const pivot_next = pivot + 8;
+					memcpy(pivot_next, pivot, 32);
+
+					_p::wblock_t temp = *(pivot + 7);
+					AES_Help::RotWord(temp.ui32);
+					Box::SubWord(temp);
+					temp.ui8[0] ^= AES_Help::rcon[i];
+
+					pivot_next[0].ui32 ^= temp.ui32;
+					pivot_next[1].ui32 ^= pivot_next[0].ui32;
+					pivot_next[2].ui32 ^= pivot_next[1].ui32;
+					pivot_next[3].ui32 ^= pivot_next[2].ui32;
+
+					temp = pivot_next[3];
+					Box::SubWord(temp);
+
+					pivot_next[4].ui32 ^= temp.ui32;
+					pivot_next[5].ui32 ^= pivot_next[4].ui32;
+					pivot_next[6].ui32 ^= pivot_next[5].ui32;
+					pivot_next[7].ui32 ^= pivot_next[6].ui32;
+
+					pivot = pivot_next;
+				}
+				{
+					_p::wblock_t* const pivot_next = pivot + 8;
+					memcpy(pivot_next, pivot, 16);
+					_p::wblock_t temp = *(pivot + 7);
+					AES_Help::RotWord(temp.ui32);
+					Box::SubWord(temp);
+					temp.ui8[0] ^= AES_Help::rcon[6];
+					pivot_next[0].ui32 ^= temp.ui32;
+					pivot_next[1].ui32 ^= pivot_next[0].ui32;
+					pivot_next[2].ui32 ^= pivot_next[1].ui32;
+					pivot_next[3].ui32 ^= pivot_next[2].ui32;
+				}
+			}
+		}
+
+		template<typename T, typename Box = AES_Help>
+		static void make_keys(const uint8_t* p_keys, typename T::key_schedule_t* p_wkey, uintptr_t p_count)
+		{
+			for(; p_count; --p_count, p_keys += T::key_lenght, ++p_wkey)
+			{
+				make_key<T, Box>(p_keys, *p_wkey);
+			}
+		}
+
+		//	Note: Equivalent inverse cipher, InvSubBytes and InvShiftRows commute
+		//	and InvMixColumns was already applied to the round keys.
+		template<typename T>
+		static inline void decode(const typename T::dec_key_schedule_t& p_dkey, std::span<const uint8_t, 16> p_input, std::span<uint8_t, 16> p_out)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			alignas(16) state_t state;
+			memcpy(&state, p_input.data(), sizeof(state));
+
+			const _p::wblock_t* kpivot = p_dkey.wkey.data();
+
+			AddRoundKey(state, std::span<const _p::wblock_t, 4>{kpivot, 4});
+			kpivot += 4;
+
+			for(uint8_t i = 0; i < number_of_rounds - 1; ++i, kpivot += 4)
+			{
+				InvShiftRows(state);
+				InvSubBytes(state);
+				InvMixColumns(state);
+				AddRoundKey(state, std::span<const _p::wblock_t, 4>{kpivot, 4});
+			}
+
+			InvShiftRows(state);
+			InvSubBytes(state);
+			AddRoundKey(state, std::span<const _p::wblock_t, 4>{kpivot, 4});
+
+			memcpy(p_out.data(), &state, sizeof(state));
+		}
+
+		template<typename T>
+		static void decode_blocks(const typename T::dec_key_schedule_t& p_dkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			for(; p_count; --p_count, p_input += block_lenght, p_out += block_lenght)
+			{
+				decode<T>(p_dkey, std::span<const uint8_t, 16>{p_input, 16}, std::span<uint8_t, 16>{p_out, 16});
+			}
+		}
 	};
 
-	void AES_128::make_key_schedule(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_wkey)
+	//	Note: Classic 32 bit T-table implementation.
+	//	Each round is 16 table lookups merging SubBytes, ShiftRows and MixColumns, at the cost of 4KB of tables per direction.
+	//	Decoding uses the equivalent inverse cipher, which requires InvMixColumns to be applied to the middle round keys.
+	//	With an encoding key schedule they are derived on the fly, there is no separate schedule to build per call.
+	struct AES_T_table_Help
 	{
-		memcpy(p_wkey.wkey.data(), p_key.data(), key_lenght);
+		static constexpr uintptr_t block_lenght = 16;
+
+		static constexpr std::array<uint32_t, 256> Te0 = compute_T(AES_Help::s_box, 0x02, 0x01, 0x01, 0x03);
+		static constexpr std::array<uint32_t, 256> Te1 = compute_T(AES_Help::s_box, 0x03, 0x02, 0x01, 0x01);
+		static constexpr std::array<uint32_t, 256> Te2 = compute_T(AES_Help::s_box, 0x01, 0x03, 0x02, 0x01);
+		static constexpr std::array<uint32_t, 256> Te3 = compute_T(AES_Help::s_box, 0x01, 0x01, 0x03, 0x02);
 
-		_p::wblock_t* pivot = p_wkey.wkey.data();
+		static constexpr std::array<uint32_t, 256> Td0 = compute_T(AES_Help::inv_s_box, 0x0E, 0x09, 0x0D, 0x0B);
+		static constexpr std::array<uint32_t, 256> Td1 = compute_T(AES_Help::inv_s_box, 0x0B, 0x0E, 0x09, 0x0D);
+		static constexpr std::array<uint32_t, 256> Td2 = compute_T(AES_Help::inv_s_box, 0x0D, 0x0B, 0x0E, 0x09);
+		static constexpr std::array<uint32_t, 256> Td3 = compute_T(AES_Help::inv_s_box, 0x09, 0x0D, 0x0B, 0x0E);
 
-		for(uint8_t i = 0; i < 10; ++i)
+		static inline uint32_t load_column(const uint8_t* const p_data)
 		{
-			_p::wblock_t* const pivot_next = pivot + 4;
-			memcpy(pivot_next, pivot, 16);
+			uint32_t val;
+			memcpy(&val, p_data, 4);
+			return core::endian_little2host(val);
+		}
 
-			_p::wblock_t temp = *(pivot + 3);
-			AES_Help::RotWord(temp.ui32);
-			AES_Help::SubWord(temp);
-			temp.ui8[0] ^= AES_Help::rcon[i];
+		static inline void store_column(uint8_t* const p_out, uint32_t p_val)
+		{
+			p_val = core::endian_host2little(p_val);
+			memcpy(p_out, &p_val, 4);
+		}
 
-			pivot_next[0].ui32 ^= temp.ui32;
-			pivot_next[1].ui32 ^= pivot_next[0].ui32;
-			pivot_next[2].ui32 ^= pivot_next[1].ui32;
-			pivot_next[3].ui32 ^= pivot_next[2].ui32;
+		static inline uint32_t round_key(const _p::wblock_t& p_word)
+		{
+			return core::endian_little2host(p_word.ui32);
+		}
 
-			pivot = pivot_next;
+		static inline uint32_t sub_column(const uint32_t p_0, const uint32_t p_1, const uint32_t p_2, const uint32_t p_3, const std::array<uint8_t, 256>& p_box)
+		{
+			return
+				static_cast<uint32_t>(p_box[p_0 & 0xFF]) |
+				static_cast<uint32_t>(p_box[(p_1 >> 8) & 0xFF]) << 8 |
+				static_cast<uint32_t>(p_box[(p_2 >> 16) & 0xFF]) << 16 |
+				static_cast<uint32_t>(p_box[p_3 >> 24]) << 24;
 		}
-	}
 
-	void AES_128::encode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
-	{
-		AES_Help::encode<AES_128>(p_wkey, p_input, p_out);
-	}
+		//	Note: The S-box cancels the inverse S-box merged into the Td tables, leaving InvMixColumns.
+		static inline uint32_t inv_mix_column(const uint32_t p_column)
+		{
+			const std::array<uint8_t, 256>& s_box = AES_Help::s_box;
+			return
+				Td0[s_box[p_column & 0xFF]] ^
+				Td1[s_box[(p_column >> 8) & 0xFF]] ^
+				Td2[s_box[(p_column >> 16) & 0xFF]] ^
+				Td3[s_box[p_column >> 24]];
+		}
 
+		//	Note: Round key p_round, column p_column, of the equivalent inverse cipher.
+		//	Derive selects whether p_rk is an encoding key schedule, or already a decoding one.
+		template<typename T, bool Derive>
+		static inline uint32_t dec_round_key(const _p::wblock_t* const p_rk, const uintptr_t p_round, const uintptr_t p_column)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			if constexpr(Derive)
+			{
+				const uint32_t column = round_key(p_rk[(number_of_rounds - p_round) * 4 + p_column]);
+				return (p_round == 0 || p_round == number_of_rounds) ? column : inv_mix_column(column);
+			}
+			else
+			{
+				return round_key(p_rk[p_round * 4 + p_column]);
+			}
+		}
 
-	void AES_128::decode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
-	{
-		AES_Help::decode<AES_128>(p_wkey, p_input, p_out);
-	}
+		template<typename T>
+		static void encode(const typename T::key_schedule_t& p_wkey, std::span<const uint8_t, 16> p_input, std::span<uint8_t, 16> p_out)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			const _p::wblock_t* rk = p_wkey.wkey.data();
 
+			uint32_t s0 = load_column(p_input.data())      ^ round_key(rk[0]);
+			uint32_t s1 = load_column(p_input.data() + 4)  ^ round_key(rk[1]);
+			uint32_t s2 = load_column(p_input.data() + 8)  ^ round_key(rk[2]);
+			uint32_t s3 = load_column(p_input.data() + 12) ^ round_key(rk[3]);
 
-	void AES_192::make_key_schedule(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_wkey)
-	{
-		memcpy(p_wkey.wkey.data(), p_key.data(), key_lenght);
+			for(uintptr_t r = 1; r < number_of_rounds; ++r)
+			{
+				rk += 4;
+				const uint32_t t0 = Te0[s0 & 0xFF] ^ Te1[(s1 >> 8) & 0xFF] ^ Te2[(s2 >> 16) & 0xFF] ^ Te3[s3 >> 24] ^ round_key(rk[0]);
+				const uint32_t t1 = Te0[s1 & 0xFF] ^ Te1[(s2 >> 8) & 0xFF] ^ Te2[(s3 >> 16) & 0xFF] ^ Te3[s0 >> 24] ^ round_key(rk[1]);
+				const uint32_t t2 = Te0[s2 & 0xFF] ^ Te1[(s3 >> 8) & 0xFF] ^ Te2[(s0 >> 16) & 0xFF] ^ Te3[s1 >> 24] ^ round_key(rk[2]);
+				const uint32_t t3 = Te0[s3 & 0xFF] ^ Te1[(s0 >> 8) & 0xFF] ^ Te2[(s1 >> 16) & 0xFF] ^ Te3[s2 >> 24] ^ round_key(rk[3]);
+				s0 = t0;
+				s1 = t1;
+				s2 = t2;
+				s3 = t3;
+			}
 
-		_p::wblock_t* pivot = p_wkey.wkey.data();
+			rk += 4;
+			const std::array<uint8_t, 256>& s_box = AES_Help::s_box;
+			store_column(p_out.data(),      sub_column(s0, s1, s2, s3, s_box) ^ round_key(rk[0]));
+			store_column(p_out.data() + 4,  sub_column(s1, s2, s3, s0, s_box) ^ round_key(rk[1]));
+			store_column(p_out.data() + 8,  sub_column(s2, s3, s0, s1, s_box) ^ round_key(rk[2]));
+			store_column(p_out.data() + 12, sub_column(s3, s0, s1, s2, s_box) ^ round_key(rk[3]));
+		}
 
-		for(uint8_t i = 0; i < 7; ++i)
+		template<typename T, bool Derive>
+		static void decode_rounds(const _p::wblock_t* const p_rk, const uint8_t* const p_input, uint8_t* const p_out)
 		{
-			_p::wblock_t* const pivot_next = pivot + 6;
-			memcpy(pivot_next, pivot, 24);
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
 
-			_p::wblock_t temp = *(pivot + 5);
-			AES_Help::RotWord(temp.ui32);
-			AES_Help::SubWord(temp);
-			temp.ui8[0] ^= AES_Help::rcon[i];
+			uint32_t s0 = load_column(p_input)      ^ dec_round_key<T, Derive>(p_rk, 0, 0);
+			uint32_t s1 = load_column(p_input + 4)  ^ dec_round_key<T, Derive>(p_rk, 0, 1);
+			uint32_t s2 = load_column(p_input + 8)  ^ dec_round_key<T, Derive>(p_rk, 0, 2);
+			uint32_t s3 = load_column(p_input + 12) ^ dec_round_key<T, Derive>(p_rk, 0, 3);
 
-			pivot_next[0].ui32 ^= temp.ui32;
-			pivot_next[1].ui32 ^= pivot_next[0].ui32;
-			pivot_next[2].ui32 ^= pivot_next[1].ui32;
-			pivot_next[3].ui32 ^= pivot_next[2].ui32;
-			pivot_next[4].ui32 ^= pivot_next[3].ui32;
-			pivot_next[5].ui32 ^= pivot_next[4].ui32;
+			for(uintptr_t r = 1; r < number_of_rounds; ++r)
+			{
+				const uint32_t t0 = Td0[s0 & 0xFF] ^ Td1[(s3 >> 8) & 0xFF] ^ Td2[(s2 >> 16) & 0xFF] ^ Td3[s1 >> 24] ^ dec_round_key<T, Derive>(p_rk, r, 0);
+				const uint32_t t1 = Td0[s1 & 0xFF] ^ Td1[(s0 >> 8) & 0xFF] ^ Td2[(s3 >> 16) & 0xFF] ^ Td3[s2 >> 24] ^ dec_round_key<T, Derive>(p_rk, r, 1);
+				const uint32_t t2 = Td0[s2 & 0xFF] ^ Td1[(s1 >> 8) & 0xFF] ^ Td2[(s0 >> 16) & 0xFF] ^ Td3[s3 >> 24] ^ dec_round_key<T, Derive>(p_rk, r, 2);
+				const uint32_t t3 = Td0[s3 & 0xFF] ^ Td1[(s2 >> 8) & 0xFF] ^ Td2[(s1 >> 16) & 0xFF] ^ Td3[s0 >> 24] ^ dec_round_key<T, Derive>(p_rk, r, 3);
+				s0 = t0;
+				s1 = t1;
+				s2 = t2;
+				s3 = t3;
+			}
 
-			pivot = pivot_next;
+			const std::array<uint8_t, 256>& inv_s_box = AES_Help::inv_s_box;
+			store_column(p_out,      sub_column(s0, s3, s2, s1, inv_s_box) ^ dec_round_key<T, Derive>(p_rk, number_of_rounds, 0));
+			store_column(p_out + 4,  sub_column(s1, s0, s3, s2, inv_s_box) ^ dec_round_key<T, Derive>(p_rk, number_of_rounds, 1));
+			store_column(p_out + 8,  sub_column(s2, s1, s0, s3, inv_s_box) ^ dec_round_key<T, Derive>(p_rk, number_of_rounds, 2));
+			store_column(p_out + 12, sub_column(s3, s2, s1, s0, inv_s_box) ^ dec_round_key<T, Derive>(p_rk, number_of_rounds, 3));
 		}
+
+		template<typename T>
+		static void decode(const typename T::dec_key_schedule_t& p_dkey, std::span<const uint8_t, 16> p_input, std::span<uint8_t, 16> p_out)
 		{
-			_p::wblock_t* const pivot_next = pivot + 6;
-			memcpy(pivot_next, pivot, 16);
-			_p::wblock_t temp = *(pivot + 5);
-			AES_Help::RotWord(temp.ui32);
-			AES_Help::SubWord(temp);
-			temp.ui8[0] ^= AES_Help::rcon[7];
-			pivot_next[0].ui32 ^= temp.ui32;
-			pivot_next[1].ui32 ^= pivot_next[0].ui32;
-			pivot_next[2].ui32 ^= pivot_next[1].ui32;
-			pivot_next[3].ui32 ^= pivot_next[2].ui32;
+			decode_rounds<T, false>(p_dkey.wkey.data(), p_input.data(), p_out.data());
 		}
-	}
 
-	void AES_192::encode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
-	{
-		AES_Help::encode<AES_192>(p_wkey, p_input, p_out);
-	}
+		template<typename T>
+		static void decode(const typename T::key_schedule_t& p_wkey, std::span<const uint8_t, 16> p_input, std::span<uint8_t, 16> p_out)
+		{
+			decode_rounds<T, true>(p_wkey.wkey.data(), p_input.data(), p_out.data());
+		}
 
-	void AES_192::decode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
-	{
-		AES_Help::decode<AES_192>(p_wkey, p_input, p_out);
-	}
+		template<typename T>
+		static void make_dec_key(const typename T::key_schedule_t& p_wkey, typename T::dec_key_schedule_t& p_dkey)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			for(uintptr_t r = 0; r <= number_of_rounds; ++r)
+			{
+				for(uintptr_t c = 0; c < 4; ++c)
+				{
+					p_dkey.wkey[r * 4 + c].ui32 = core::endian_host2little(dec_round_key<T, true>(p_wkey.wkey.data(), r, c));
+				}
+			}
+		}
 
-	void AES_256::make_key_schedule(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_wkey)
+		template<typename T>
+		static void encode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			for(; p_count; --p_count, p_input += block_lenght, p_out += block_lenght)
+			{
+				encode<T>(p_wkey, std::span<const uint8_t, 16>{p_input, 16}, std::span<uint8_t, 16>{p_out, 16});
+			}
+		}
+
+		template<typename T>
+		static void decode_blocks(const typename T::dec_key_schedule_t& p_dkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			for(; p_count; --p_count, p_input += block_lenght, p_out += block_lenght)
+			{
+				decode<T>(p_dkey, std::span<const uint8_t, 16>{p_input, 16}, std::span<uint8_t, 16>{p_out, 16});
+			}
+		}
+
+		template<typename T>
+		static void decode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			if(p_count == 1)
+			{
+				decode_rounds<T, true>(p_wkey.wkey.data(), p_input, p_out);
+				return;
+			}
+			typename T::dec_key_schedule_t dkey;
+			make_dec_key<T>(p_wkey, dkey);
+			decode_blocks<T>(dkey, p_input, p_out, p_count);
+		}
+	};
+
+	//	Note: Modes of operation for the portable engines, built on top of their multi-block primitives.
+	template<typename Core>
+	struct AES_Block_modes: public Core
 	{
-		memcpy(p_wkey.wkey.data(), p_key.data(), key_lenght);
+		static constexpr uintptr_t block_lenght = 16;
+
+		//	Note: The portable engines share the byte-wise key expansion.
+		template<typename T>
+		static void make_key(const uint8_t* const p_key, typename T::key_schedule_t& p_wkey)
+		{
+			AES_Help::make_key<T>(p_key, p_wkey);
+		}
+
+		template<typename T>
+		static void make_keys(const uint8_t* p_keys, typename T::key_schedule_t* p_wkey, uintptr_t p_count)
+		{
+			AES_Help::make_keys<T>(p_keys, p_wkey, p_count);
+		}
 
-		_p::wblock_t* pivot = p_wkey.wkey.data();
+		template<typename T>
+		static void make_dec_key(const typename T::key_schedule_t& p_wkey, typename T::dec_key_schedule_t& p_dkey)
+		{
+			Core::template make_dec_key<T>(p_wkey, p_dkey);
+		}
 
-		for(uint8_t i = 0; i < 6; ++i)
+		template<typename T>
+		static void ctr_xor(const typename T::key_schedule_t& p_wkey, _p::AES_counter_t& p_counter, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
 		{
-			_p::wblock_t* const pivot_next = pivot + 8;
-			memcpy(pivot_next, pivot, 32);
+			constexpr uintptr_t stride = 8;
+			alignas(16) std::array<uint8_t, block_lenght * stride> key_stream;
+
+			uint64_t counter_hi = p_counter[0];
+			uint64_t counter_lo = p_counter[1];
 
-			_p::wblock_t temp = *(pivot + 7);
-			AES_Help::RotWord(temp.ui32);
-			AES_Help::SubWord(temp);
-			temp.ui8[0] ^= AES_Help::rcon[i];
+			while(p_count)
+			{
+				const uintptr_t block_count = p_count < stride ? p_count : stride;
+				const uintptr_t chunk_size  = block_count * block_lenght;
+
+				for(uintptr_t i = 0; i < block_count; ++i)
+				{
+					const uint64_t hi = core::endian_host2big(counter_hi);
+					const uint64_t lo = core::endian_host2big(counter_lo);
+					memcpy(key_stream.data() + i * block_lenght, &hi, 8);
+					memcpy(key_stream.data() + i * block_lenght + 8, &lo, 8);
+					if(++counter_lo == 0)
+					{
+						++counter_hi;
+					}
+				}
+
+				Core::template encode_blocks<T>(p_wkey, key_stream.data(), key_stream.data(), block_count);
+				xor_bytes(p_out, p_input, key_stream.data(), chunk_size);
+
+				p_input += chunk_size;
+				p_out   += chunk_size;
+				p_count -= block_count;
+			}
 
-			pivot_next[0].ui32 ^= temp.ui32;
-			pivot_next[1].ui32 ^= pivot_next[0].ui32;
-			pivot_next[2].ui32 ^= pivot_next[1].ui32;
-			pivot_next[3].ui32 ^= pivot_next[2].ui32;
+			p_counter[0] = counter_hi;
+			p_counter[1] = counter_lo;
+		}
 
-			temp = pivot_next[3];
-			AES_Help::SubWord(temp);
+		template<typename T>
+		static void cbc_encode(const typename T::key_schedule_t& p_wkey, uint8_t* const p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			alignas(16) std::array<uint8_t, block_lenght> chain;
+			memcpy(chain.data(), p_iv, block_lenght);
 
-			pivot_next[4].ui32 ^= temp.ui32;
-			pivot_next[5].ui32 ^= pivot_next[4].ui32;
-			pivot_next[6].ui32 ^= pivot_next[5].ui32;
-			pivot_next[7].ui32 ^= pivot_next[6].ui32;
+			for(; p_count; --p_count, p_input += block_lenght, p_out += block_lenght)
+			{
+				xor_bytes(chain.data(), chain.data(), p_input, block_lenght);
+				Core::template encode<T>(p_wkey, chain, chain);
+				memcpy(p_out, chain.data(), block_lenght);
+			}
 
-			pivot = pivot_next;
+			memcpy(p_iv, chain.data(), block_lenght);
 		}
+
+		template<typename T>
+		static void cfb_encode(const typename T::key_schedule_t& p_wkey, uint8_t* const p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
 		{
-			_p::wblock_t* const pivot_next = pivot + 8;
-			memcpy(pivot_next, pivot, 16);
-			_p::wblock_t temp = *(pivot + 7);
-			AES_Help::RotWord(temp.ui32);
-			AES_Help::SubWord(temp);
-			temp.ui8[0] ^= AES_Help::rcon[6];
-			pivot_next[0].ui32 ^= temp.ui32;
-			pivot_next[1].ui32 ^= pivot_next[0].ui32;
-			pivot_next[2].ui32 ^= pivot_next[1].ui32;
-			pivot_next[3].ui32 ^= pivot_next[2].ui32;
+			alignas(16) std::array<uint8_t, block_lenght> chain;
+			memcpy(chain.data(), p_iv, block_lenght);
+
+			for(; p_count; --p_count, p_input += block_lenght, p_out += block_lenght)
+			{
+				Core::template encode<T>(p_wkey, chain, chain);
+				xor_bytes(chain.data(), chain.data(), p_input, block_lenght);
+				memcpy(p_out, chain.data(), block_lenght);
+			}
+
+			memcpy(p_iv, chain.data(), block_lenght);
 		}
-	}
 
-	void AES_256::encode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+		//	Note: The cipher text is saved before decoding so that p_out can be the same as p_input,
+		//	the first block of the buffer holds the previous cipher text block.
+		template<typename T>
+		static void cbc_decode(const typename T::dec_key_schedule_t& p_dkey, uint8_t* const p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t stride = 8;
+			alignas(16) std::array<uint8_t, block_lenght * (stride + 1)> cipher;
+			memcpy(cipher.data(), p_iv, block_lenght);
+
+			while(p_count)
+			{
+				const uintptr_t block_count = p_count < stride ? p_count : stride;
+				const uintptr_t chunk_size  = block_count * block_lenght;
+
+				memcpy(cipher.data() + block_lenght, p_input, chunk_size);
+				Core::template decode_blocks<T>(p_dkey, p_input, p_out, block_count);
+				xor_bytes(p_out, p_out, cipher.data(), chunk_size);
+				memcpy(cipher.data(), cipher.data() + chunk_size, block_lenght);
+
+				p_input += chunk_size;
+				p_out   += chunk_size;
+				p_count -= block_count;
+			}
+
+			memcpy(p_iv, cipher.data(), block_lenght);
+		}
+
+		///	\brief Multiplication by x in GF(2^128), little endian (IEEE 1619)
+		static inline void xts_double(uint64_t& p_lo, uint64_t& p_hi)
+		{
+			const uint64_t carry = p_hi >> 63;
+			p_hi = (p_hi << 1) | (p_lo >> 63);
+			p_lo = (p_lo << 1) ^ (0x87 & (0 - carry));
+		}
+
+		//	Note: Key_t is the encoding or the decoding schedule, depending on the direction.
+		template<typename T, bool Encode, typename Key_t>
+		static void xts(const Key_t& p_key, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t stride = 8;
+			alignas(16) std::array<uint8_t, block_lenght * stride> tweaks;
+			alignas(16) std::array<uint8_t, block_lenght * stride> buffer;
+
+			uint64_t tweak_lo;
+			uint64_t tweak_hi;
+			memcpy(&tweak_lo, p_tweak, 8);
+			memcpy(&tweak_hi, p_tweak + 8, 8);
+			tweak_lo = core::endian_little2host(tweak_lo);
+			tweak_hi = core::endian_little2host(tweak_hi);
+
+			while(p_count)
+			{
+				const uintptr_t block_count = p_count < stride ? p_count : stride;
+				const uintptr_t chunk_size  = block_count * block_lenght;
+
+				for(uintptr_t i = 0; i < block_count; ++i)
+				{
+					const uint64_t lo = core::endian_host2little(tweak_lo);
+					const uint64_t hi = core::endian_host2little(tweak_hi);
+					memcpy(tweaks.data() + i * block_lenght, &lo, 8);
+					memcpy(tweaks.data() + i * block_lenght + 8, &hi, 8);
+					xts_double(tweak_lo, tweak_hi);
+				}
+
+				xor_bytes(buffer.data(), p_input, tweaks.data(), chunk_size);
+				if constexpr(Encode)
+				{
+					Core::template encode_blocks<T>(p_key, buffer.data(), buffer.data(), block_count);
+				}
+				else
+				{
+					Core::template decode_blocks<T>(p_key, buffer.data(), buffer.data(), block_count);
+				}
+				xor_bytes(p_out, buffer.data(), tweaks.data(), chunk_size);
+
+				p_input += chunk_size;
+				p_out   += chunk_size;
+				p_count -= block_count;
+			}
+
+			tweak_lo = core::endian_host2little(tweak_lo);
+			tweak_hi = core::endian_host2little(tweak_hi);
+			memcpy(p_tweak, &tweak_lo, 8);
+			memcpy(p_tweak + 8, &tweak_hi, 8);
+		}
+
+		template<typename T>
+		static void xts_encode(const typename T::key_schedule_t& p_wkey, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			xts<T, true>(p_wkey, p_tweak, p_input, p_out, p_count);
+		}
+
+		template<typename T>
+		static void xts_decode(const typename T::dec_key_schedule_t& p_dkey, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			xts<T, false>(p_dkey, p_tweak, p_input, p_out, p_count);
+		}
+	};
+
+#if defined(_M_AMD64) || defined(__amd64__)
+	//	Note: Bitsliced constant time implementation, 8 blocks are processed at once.
+	//	Plane i holds bit i of every byte of the 8 blocks, each 64 bit half covering 4 blocks with
+	//	byte (row, column) of block b at bit (16 * row + 4 * column + b).
+	//	SubBytes is evaluated as a boolean circuit (Boyar-Peralta) and ShiftRows/MixColumns as shifts and rotations,
+	//	there are no secret dependent memory accesses or branches.
+	struct AES_bitslice_Help
 	{
-		AES_Help::encode<AES_256>(p_wkey, p_input, p_out);
-	}
+		static constexpr uintptr_t block_lenght = 16;
+		static constexpr uintptr_t lanes = 8;
 
-	void AES_256::decode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+		using slice_t = std::array<__m128i, 8>;
+
+		template<typename T>
+		using sliced_key_t = std::array<slice_t, T::number_of_rounds + 1>;
+
+		static inline __m128i bnot(const __m128i p_val)
+		{
+			return _mm_xor_si128(p_val, _mm_set1_epi32(-1));
+		}
+
+		static inline __m128i rotr16(const __m128i p_val)
+		{
+			return _mm_shufflehi_epi16(_mm_shufflelo_epi16(p_val, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+		}
+
+		static inline __m128i rotr32(const __m128i p_val)
+		{
+			return _mm_shuffle_epi32(p_val, _MM_SHUFFLE(2, 3, 0, 1));
+		}
+
+		template<int Shift>
+		static inline void swap_bits(__m128i& p_a, __m128i& p_b, const __m128i p_mask)
+		{
+			const __m128i a = p_a;
+			const __m128i b = p_b;
+			p_a = _mm_or_si128(_mm_and_si128(a, p_mask), _mm_slli_epi64(_mm_and_si128(b, p_mask), Shift));
+			p_b = _mm_or_si128(_mm_and_si128(_mm_srli_epi64(a, Shift), p_mask), _mm_andnot_si128(p_mask, b));
+		}
+
+		///	\brief Transposes the 8x8 bit matrix formed by the same byte of the 8 registers, it is its own inverse.
+		static inline void ortho(slice_t& p_q)
+		{
+			const __m128i m1 = _mm_set1_epi8(0x55);
+			const __m128i m2 = _mm_set1_epi8(0x33);
+			const __m128i m4 = _mm_set1_epi8(0x0F);
+
+			swap_bits<1>(p_q[0], p_q[1], m1);
+			swap_bits<1>(p_q[2], p_q[3], m1);
+			swap_bits<1>(p_q[4], p_q[5], m1);
+			swap_bits<1>(p_q[6], p_q[7], m1);
+
+			swap_bits<2>(p_q[0], p_q[2], m2);
+			swap_bits<2>(p_q[1], p_q[3], m2);
+			swap_bits<2>(p_q[4], p_q[6], m2);
+			swap_bits<2>(p_q[5], p_q[7], m2);
+
+			swap_bits<4>(p_q[0], p_q[4], m4);
+			swap_bits<4>(p_q[1], p_q[5], m4);
+			swap_bits<4>(p_q[2], p_q[6], m4);
+			swap_bits<4>(p_q[3], p_q[7], m4);
+		}
+
+		//	Note: Interleaving the bytes of both halves of a block puts columns 0 and 2 in the low 64 bits
+		//	and columns 1 and 3 in the high 64 bits, in the order ortho expects.
+		static inline __m128i interleave(const __m128i p_block)
+		{
+			return _mm_unpacklo_epi8(p_block, _mm_srli_si128(p_block, 8));
+		}
+
+		static inline __m128i deinterleave(const __m128i p_val)
+		{
+			return _mm_packus_epi16(_mm_and_si128(p_val, _mm_set1_epi16(0x00FF)), _mm_srli_epi16(p_val, 8));
+		}
+
+		static inline void load(const uint8_t* const p_input, slice_t& p_q)
+		{
+			const __m128i* const input = reinterpret_cast<const __m128i*>(p_input);
+			for(uintptr_t b = 0; b < 4; ++b)
+			{
+				const __m128i t0 = interleave(_mm_loadu_si128(input + b));
+				const __m128i t1 = interleave(_mm_loadu_si128(input + b + 4));
+				p_q[b]     = _mm_unpacklo_epi64(t0, t1);
+				p_q[b + 4] = _mm_unpackhi_epi64(t0, t1);
+			}
+			ortho(p_q);
+		}
+
+		static inline void store(slice_t& p_q, uint8_t* const p_out)
+		{
+			ortho(p_q);
+			__m128i* const out = reinterpret_cast<__m128i*>(p_out);
+			for(uintptr_t b = 0; b < 4; ++b)
+			{
+				_mm_storeu_si128(out + b,     deinterleave(_mm_unpacklo_epi64(p_q[b], p_q[b + 4])));
+				_mm_storeu_si128(out + b + 4, deinterleave(_mm_unpackhi_epi64(p_q[b], p_q[b + 4])));
+			}
+		}
+
+		///	\brief Round keys replicated over the 8 blocks, done once per call.
+		///	\param[in] p_key - Encoding or decoding schedule.
+		template<typename T, typename Key_t>
+		static void slice_key(const Key_t& p_key, sliced_key_t<T>& p_skey)
+		{
+			const __m128i* const round_key = reinterpret_cast<const __m128i*>(p_key.wkey.data());
+			for(uintptr_t r = 0; r <= T::number_of_rounds; ++r)
+			{
+				const __m128i t = interleave(_mm_load_si128(round_key + r));
+				slice_t& q = p_skey[r];
+				q[0] = q[1] = q[2] = q[3] = _mm_unpacklo_epi64(t, t);
+				q[4] = q[5] = q[6] = q[7] = _mm_unpackhi_epi64(t, t);
+				ortho(q);
+			}
+		}
+
+		static inline void add_round_key(slice_t& p_q, const slice_t& p_key)
+		{
+			for(uintptr_t i = 0; i < 8; ++i)
+			{
+				p_q[i] = _mm_xor_si128(p_q[i], p_key[i]);
+			}
+		}
+
+		//	Note: Circuit by Boyar and Peralta, 113 gates. Bit 7 is x0 and bit 0 is x7.
+		static inline void sub_bytes(slice_t& p_q)
+		{
+			const __m128i x0 = p_q[7];
+			const __m128i x1 = p_q[6];
+			const __m128i x2 = p_q[5];
+			const __m128i x3 = p_q[4];
+			const __m128i x4 = p_q[3];
+			const __m128i x5 = p_q[2];
+			const __m128i x6 = p_q[1];
+			const __m128i x7 = p_q[0];
+
+			//top linear transformation
+			const __m128i y14 = _mm_xor_si128(x3, x5);
+			const __m128i y13 = _mm_xor_si128(x0, x6);
+			const __m128i y9  = _mm_xor_si128(x0, x3);
+			const __m128i y8  = _mm_xor_si128(x0, x5);
+			const __m128i t0  = _mm_xor_si128(x1, x2);
+			const __m128i y1  = _mm_xor_si128(t0, x7);
+			const __m128i y4  = _mm_xor_si128(y1, x3);
+			const __m128i y12 = _mm_xor_si128(y13, y14);
+			const __m128i y2  = _mm_xor_si128(y1, x0);
+			const __m128i y5  = _mm_xor_si128(y1, x6);
+			const __m128i y3  = _mm_xor_si128(y5, y8);
+			const __m128i t1  = _mm_xor_si128(x4, y12);
+			const __m128i y15 = _mm_xor_si128(t1, x5);
+			const __m128i y20 = _mm_xor_si128(t1, x1);
+			const __m128i y6  = _mm_xor_si128(y15, x7);
+			const __m128i y10 = _mm_xor_si128(y15, t0);
+			const __m128i y11 = _mm_xor_si128(y20, y9);
+			const __m128i y7  = _mm_xor_si128(x7, y11);
+			const __m128i y17 = _mm_xor_si128(y10, y11);
+			const __m128i y19 = _mm_xor_si128(y10, y8);
+			const __m128i y16 = _mm_xor_si128(t0, y11);
+			const __m128i y21 = _mm_xor_si128(y13, y16);
+			const __m128i y18 = _mm_xor_si128(x0, y16);
+
+			//non-linear section
+			const __m128i t2  = _mm_and_si128(y12, y15);
+			const __m128i t3  = _mm_and_si128(y3, y6);
+			const __m128i t4  = _mm_xor_si128(t3, t2);
+			const __m128i t5  = _mm_and_si128(y4, x7);
+			const __m128i t6  = _mm_xor_si128(t5, t2);
+			const __m128i t7  = _mm_and_si128(y13, y16);
+			const __m128i t8  = _mm_and_si128(y5, y1);
+			const __m128i t9  = _mm_xor_si128(t8, t7);
+			const __m128i t10 = _mm_and_si128(y2, y7);
+			const __m128i t11 = _mm_xor_si128(t10, t7);
+			const __m128i t12 = _mm_and_si128(y9, y11);
+			const __m128i t13 = _mm_and_si128(y14, y17);
+			const __m128i t14 = _mm_xor_si128(t13, t12);
+			const __m128i t15 = _mm_and_si128(y8, y10);
+			const __m128i t16 = _mm_xor_si128(t15, t12);
+			const __m128i t17 = _mm_xor_si128(t4, t14);
+			const __m128i t18 = _mm_xor_si128(t6, t16);
+			const __m128i t19 = _mm_xor_si128(t9, t14);
+			const __m128i t20 = _mm_xor_si128(t11, t16);
+			const __m128i t21 = _mm_xor_si128(t17, y20);
+			const __m128i t22 = _mm_xor_si128(t18, y19);
+			const __m128i t23 = _mm_xor_si128(t19, y21);
+			const __m128i t24 = _mm_xor_si128(t20, y18);
+
+			const __m128i t25 = _mm_xor_si128(t21, t22);
+			const __m128i t26 = _mm_and_si128(t21, t23);
+			const __m128i t27 = _mm_xor_si128(t24, t26);
+			const __m128i t28 = _mm_and_si128(t25, t27);
+			const __m128i t29 = _mm_xor_si128(t28, t22);
+			const __m128i t30 = _mm_xor_si128(t23, t24);
+			const __m128i t31 = _mm_xor_si128(t22, t26);
+			const __m128i t32 = _mm_and_si128(t31, t30);
+			const __m128i t33 = _mm_xor_si128(t32, t24);
+			const __m128i t34 = _mm_xor_si128(t23, t33);
+			const __m128i t35 = _mm_xor_si128(t27, t33);
+			const __m128i t36 = _mm_and_si128(t24, t35);
+			const __m128i t37 = _mm_xor_si128(t36, t34);
+			const __m128i t38 = _mm_xor_si128(t27, t36);
+			const __m128i t39 = _mm_and_si128(t29, t38);
+			const __m128i t40 = _mm_xor_si128(t25, t39);
+
+			const __m128i t41 = _mm_xor_si128(t40, t37);
+			const __m128i t42 = _mm_xor_si128(t29, t33);
+			const __m128i t43 = _mm_xor_si128(t29, t40);
+			const __m128i t44 = _mm_xor_si128(t33, t37);
+			const __m128i t45 = _mm_xor_si128(t42, t41);
+			const __m128i z0  = _mm_and_si128(t44, y15);
+			const __m128i z1  = _mm_and_si128(t37, y6);
+			const __m128i z2  = _mm_and_si128(t33, x7);
+			const __m128i z3  = _mm_and_si128(t43, y16);
+			const __m128i z4  = _mm_and_si128(t40, y1);
+			const __m128i z5  = _mm_and_si128(t29, y7);
+			const __m128i z6  = _mm_and_si128(t42, y11);
+			const __m128i z7  = _mm_and_si128(t45, y17);
+			const __m128i z8  = _mm_and_si128(t41, y10);
+			const __m128i z9  = _mm_and_si128(t44, y12);
+			const __m128i z10 = _mm_and_si128(t37, y3);
+			const __m128i z11 = _mm_and_si128(t33, y4);
+			const __m128i z12 = _mm_and_si128(t43, y13);
+			const __m128i z13 = _mm_and_si128(t40, y5);
+			const __m128i z14 = _mm_and_si128(t29, y2);
+			const __m128i z15 = _mm_and_si128(t42, y9);
+			const __m128i z16 = _mm_and_si128(t45, y14);
+			const __m128i z17 = _mm_and_si128(t41, y8);
+
+			//bottom linear transformation
+			const __m128i t46 = _mm_xor_si128(z15, z16);
+			const __m128i t47 = _mm_xor_si128(z10, z11);
+			const __m128i t48 = _mm_xor_si128(z5, z13);
+			const __m128i t49 = _mm_xor_si128(z9, z10);
+			const __m128i t50 = _mm_xor_si128(z2, z12);
+			const __m128i t51 = _mm_xor_si128(z2, z5);
+			const __m128i t52 = _mm_xor_si128(z7, z8);
+			const __m128i t53 = _mm_xor_si128(z0, z3);
+			const __m128i t54 = _mm_xor_si128(z6, z7);
+			const __m128i t55 = _mm_xor_si128(z16, z17);
+			const __m128i t56 = _mm_xor_si128(z12, t48);
+			const __m128i t57 = _mm_xor_si128(t50, t53);
+			const __m128i t58 = _mm_xor_si128(z4, t46);
+			const __m128i t59 = _mm_xor_si128(z3, t54);
+			const __m128i t60 = _mm_xor_si128(t46, t57);
+			const __m128i t61 = _mm_xor_si128(z14, t57);
+			const __m128i t62 = _mm_xor_si128(t52, t58);
+			const __m128i t63 = _mm_xor_si128(t49, t58);
+			const __m128i t64 = _mm_xor_si128(z4, t59);
+			const __m128i t65 = _mm_xor_si128(t61, t62);
+			const __m128i t66 = _mm_xor_si128(z1, t63);
+			const __m128i s0  = _mm_xor_si128(t59, t63);
+			const __m128i s6  = _mm_xor_si128(t56, bnot(t62));
+			const __m128i s7  = _mm_xor_si128(t48, bnot(t60));
+			const __m128i t67 = _mm_xor_si128(t64, t65);
+			const __m128i s3  = _mm_xor_si128(t53, t66);
+			const __m128i s4  = _mm_xor_si128(t51, t66);
+			const __m128i s5  = _mm_xor_si128(t47, t65);
+			const __m128i s1  = _mm_xor_si128(t64, bnot(s3));
+			const __m128i s2  = _mm_xor_si128(t55, bnot(t67));
+
+			p_q[7] = s0;
+			p_q[6] = s1;
+			p_q[5] = s2;
+			p_q[4] = s3;
+			p_q[3] = s4;
+			p_q[2] = s5;
+			p_q[1] = s6;
+			p_q[0] = s7;
+		}
+
+		///	\brief Inverse of the SubBytes affine transformation, InvSubBytes = affine * SubBytes * affine
+		static inline void inv_affine(slice_t& p_q)
+		{
+			const slice_t q = p_q;
+			for(uintptr_t i = 0; i < 8; ++i)
+			{
+				p_q[i] = _mm_xor_si128(_mm_xor_si128(q[(i + 2) % 8], q[(i + 5) % 8]), q[(i + 7) % 8]);
+			}
+			p_q[0] = bnot(p_q[0]);
+			p_q[2] = bnot(p_q[2]);
+		}
+
+		static inline void inv_sub_bytes(slice_t& p_q)
+		{
+			inv_affine(p_q);
+			sub_bytes(p_q);
+			inv_affine(p_q);
+		}
+
+		//	Note: Each row is a 16 bit word of the 64 bit halves, ShiftRows rotates row r right by 4 * r bits.
+		//	Multiplying by 2^(16 - k) leaves x << (16 - k) in the low and x >> k in the high half of the product,
+		//	so a rotation by a different amount on every word is 2 multiplications.
+		static inline __m128i rotate_rows(const __m128i p_val, const __m128i p_factor)
+		{
+			return _mm_or_si128(_mm_mullo_epi16(p_val, p_factor), _mm_mulhi_epu16(p_val, p_factor));
+		}
+
+		static inline void shift_rows(slice_t& p_q)
+		{
+			const __m128i factor = _mm_set_epi16(16, 256, 4096, 1, 16, 256, 4096, 1);
+			for(__m128i& x : p_q)
+			{
+				x = rotate_rows(x, factor);
+			}
+		}
+
+		static inline void inv_shift_rows(slice_t& p_q)
+		{
+			const __m128i factor = _mm_set_epi16(4096, 256, 16, 1, 4096, 256, 16, 1);
+			for(__m128i& x : p_q)
+			{
+				x = rotate_rows(x, factor);
+			}
+		}
+
+		//	Note: rotr16 brings row r + 1 to row r, rotr32 rows r + 2 and r + 3.
+		//	out = {02}*a0 ^ {03}*a1 ^ a2 ^ a3 = {02}*(a0 ^ a1) ^ a1 ^ rotr32(a0 ^ a1)
+		static inline void mix_columns(slice_t& p_q)
+		{
+			slice_t r;
+			slice_t s;
+			for(uintptr_t i = 0; i < 8; ++i)
+			{
+				r[i] = rotr16(p_q[i]);
+				s[i] = _mm_xor_si128(p_q[i], r[i]);
+			}
+
+			p_q[0] = _mm_xor_si128(_mm_xor_si128(s[7], r[0]), rotr32(s[0]));
+			p_q[1] = _mm_xor_si128(_mm_xor_si128(_mm_xor_si128(s[0], s[7]), r[1]), rotr32(s[1]));
+			p_q[2] = _mm_xor_si128(_mm_xor_si128(s[1], r[2]), rotr32(s[2]));
+			p_q[3] = _mm_xor_si128(_mm_xor_si128(_mm_xor_si128(s[2], s[7]), r[3]), rotr32(s[3]));
+			p_q[4] = _mm_xor_si128(_mm_xor_si128(_mm_xor_si128(s[3], s[7]), r[4]), rotr32(s[4]));
+			p_q[5] = _mm_xor_si128(_mm_xor_si128(s[4], r[5]), rotr32(s[5]));
+			p_q[6] = _mm_xor_si128(_mm_xor_si128(s[5], r[6]), rotr32(s[6]));
+			p_q[7] = _mm_xor_si128(_mm_xor_si128(s[6], r[7]), rotr32(s[7]));
+		}
+
+		//	Note: InvMixColumns = MixColumns * ({04}x^2 + {05}), the second factor being a0 ^= {04}*(a0 ^ a2) on every row.
+		static inline void inv_mix_columns(slice_t& p_q)
+		{
+			slice_t d;
+			for(uintptr_t i = 0; i < 8; ++i)
+			{
+				d[i] = _mm_xor_si128(p_q[i], rotr32(p_q[i]));
+			}
+
+			p_q[0] = _mm_xor_si128(p_q[0], d[6]);
+			p_q[1] = _mm_xor_si128(p_q[1], _mm_xor_si128(d[6], d[7]));
+			p_q[2] = _mm_xor_si128(p_q[2], _mm_xor_si128(d[0], d[7]));
+			p_q[3] = _mm_xor_si128(p_q[3], _mm_xor_si128(d[1], d[6]));
+			p_q[4] = _mm_xor_si128(p_q[4], _mm_xor_si128(_mm_xor_si128(d[2], d[6]), d[7]));
+			p_q[5] = _mm_xor_si128(p_q[5], _mm_xor_si128(d[3], d[7]));
+			p_q[6] = _mm_xor_si128(p_q[6], d[4]);
+			p_q[7] = _mm_xor_si128(p_q[7], d[5]);
+
+			mix_columns(p_q);
+		}
+
+		//	Note: SubWord of the key expansion through the same circuit, byte j of the word is bit j of every plane.
+		static inline void SubWord(_p::wblock_t& p_word)
+		{
+			slice_t q;
+			for(uintptr_t i = 0; i < 8; ++i)
+			{
+				uint32_t plane = 0;
+				for(uintptr_t j = 0; j < 4; ++j)
+				{
+					plane |= static_cast<uint32_t>((p_word.ui8[j] >> i) & 1) << j;
+				}
+				q[i] = _mm_cvtsi32_si128(static_cast<int32_t>(plane));
+			}
+
+			sub_bytes(q);
+
+			for(uintptr_t j = 0; j < 4; ++j)
+			{
+				uint32_t byte = 0;
+				for(uintptr_t i = 0; i < 8; ++i)
+				{
+					byte |= ((static_cast<uint32_t>(_mm_cvtsi128_si32(q[i])) >> j) & 1) << i;
+				}
+				p_word.ui8[j] = static_cast<uint8_t>(byte);
+			}
+		}
+
+		static inline uint8_t xtime(const uint8_t p_val)
+		{
+			return static_cast<uint8_t>((p_val << 1) ^ (0x1B & (0 - (p_val >> 7))));
+		}
+
+		//	Note: InvMixColumns of the decoding key schedule without the gal tables, same factorization as inv_mix_columns.
+		static void InvMixColumns(AES_Help::state_t& p_state)
+		{
+			for(uintptr_t c = 0; c < block_lenght; c += 4)
+			{
+				uint8_t* const a = p_state.data() + c;
+
+				const uint8_t u = xtime(xtime(static_cast<uint8_t>(a[0] ^ a[2])));
+				const uint8_t v = xtime(xtime(static_cast<uint8_t>(a[1] ^ a[3])));
+				a[0] ^= u;
+				a[1] ^= v;
+				a[2] ^= u;
+				a[3] ^= v;
+
+				const uint8_t a0  = a[0];
+				const uint8_t all = static_cast<uint8_t>(a[0] ^ a[1] ^ a[2] ^ a[3]);
+				a[0] ^= all ^ xtime(static_cast<uint8_t>(a[0] ^ a[1]));
+				a[1] ^= all ^ xtime(static_cast<uint8_t>(a[1] ^ a[2]));
+				a[2] ^= all ^ xtime(static_cast<uint8_t>(a[2] ^ a[3]));
+				a[3] ^= all ^ xtime(static_cast<uint8_t>(a[3] ^ a0));
+			}
+		}
+
+		template<typename T>
+		static inline void encode_sliced(const sliced_key_t<T>& p_skey, slice_t& p_q)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+
+			add_round_key(p_q, p_skey[0]);
+			for(uintptr_t r = 1; r < number_of_rounds; ++r)
+			{
+				sub_bytes(p_q);
+				shift_rows(p_q);
+				mix_columns(p_q);
+				add_round_key(p_q, p_skey[r]);
+			}
+			sub_bytes(p_q);
+			shift_rows(p_q);
+			add_round_key(p_q, p_skey[number_of_rounds]);
+		}
+
+		//	Note: Equivalent inverse cipher, the round keys are sliced from the decoding schedule.
+		template<typename T>
+		static inline void decode_sliced(const sliced_key_t<T>& p_skey, slice_t& p_q)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+
+			add_round_key(p_q, p_skey[0]);
+			for(uintptr_t r = 1; r < number_of_rounds; ++r)
+			{
+				inv_sub_bytes(p_q);
+				inv_shift_rows(p_q);
+				inv_mix_columns(p_q);
+				add_round_key(p_q, p_skey[r]);
+			}
+			inv_sub_bytes(p_q);
+			inv_shift_rows(p_q);
+			add_round_key(p_q, p_skey[number_of_rounds]);
+		}
+
+		template<typename T, bool Encode>
+		static void process_blocks(const sliced_key_t<T>& p_skey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			slice_t q;
+			for(; p_count >= lanes; p_count -= lanes, p_input += block_lenght * lanes, p_out += block_lenght * lanes)
+			{
+				load(p_input, q);
+				if constexpr(Encode)
+				{
+					encode_sliced<T>(p_skey, q);
+				}
+				else
+				{
+					decode_sliced<T>(p_skey, q);
+				}
+				store(q, p_out);
+			}
+
+			if(p_count)
+			{
+				alignas(16) std::array<uint8_t, block_lenght * lanes> buffer{};
+				memcpy(buffer.data(), p_input, p_count * block_lenght);
+				process_blocks<T, Encode>(p_skey, buffer.data(), buffer.data(), lanes);
+				memcpy(p_out, buffer.data(), p_count * block_lenght);
+			}
+		}
+
+		template<typename T>
+		static void encode(const typename T::key_schedule_t& p_wkey, std::span<const uint8_t, 16> p_input, std::span<uint8_t, 16> p_out)
+		{
+			sliced_key_t<T> skey;
+			slice_key<T>(p_wkey, skey);
+			process_blocks<T, true>(skey, p_input.data(), p_out.data(), 1);
+		}
+
+		template<typename T>
+		static void decode(const typename T::dec_key_schedule_t& p_dkey, std::span<const uint8_t, 16> p_input, std::span<uint8_t, 16> p_out)
+		{
+			sliced_key_t<T> skey;
+			slice_key<T>(p_dkey, skey);
+			process_blocks<T, false>(skey, p_input.data(), p_out.data(), 1);
+		}
+
+		template<typename T>
+		static void decode(const typename T::key_schedule_t& p_wkey, std::span<const uint8_t, 16> p_input, std::span<uint8_t, 16> p_out)
+		{
+			typename T::dec_key_schedule_t dkey;
+			AES_Help::make_dec_key<T, AES_bitslice_Help>(p_wkey, dkey);
+			decode<T>(dkey, p_input, p_out);
+		}
+
+		template<typename T>
+		static void encode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			sliced_key_t<T> skey;
+			slice_key<T>(p_wkey, skey);
+			process_blocks<T, true>(skey, p_input, p_out, p_count);
+		}
+
+		template<typename T>
+		static void decode_blocks(const typename T::dec_key_schedule_t& p_dkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			sliced_key_t<T> skey;
+			slice_key<T>(p_dkey, skey);
+			process_blocks<T, false>(skey, p_input, p_out, p_count);
+		}
+
+		template<typename T>
+		static void decode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			typename T::dec_key_schedule_t dkey;
+			AES_Help::make_dec_key<T, AES_bitslice_Help>(p_wkey, dkey);
+			decode_blocks<T>(dkey, p_input, p_out, p_count);
+		}
+	};
+
+	struct AES_bitslice_modes: public AES_Block_modes<AES_bitslice_Help>
+	{
+		//	Note: Key expansion with the bitsliced S-box, the key bytes never index a table.
+		template<typename T>
+		static void make_key(const uint8_t* const p_key, typename T::key_schedule_t& p_wkey)
+		{
+			AES_Help::make_key<T, AES_bitslice_Help>(p_key, p_wkey);
+		}
+
+		template<typename T>
+		static void make_keys(const uint8_t* p_keys, typename T::key_schedule_t* p_wkey, uintptr_t p_count)
+		{
+			AES_Help::make_keys<T, AES_bitslice_Help>(p_keys, p_wkey, p_count);
+		}
+
+		template<typename T>
+		static void make_dec_key(const typename T::key_schedule_t& p_wkey, typename T::dec_key_schedule_t& p_dkey)
+		{
+			AES_Help::make_dec_key<T, AES_bitslice_Help>(p_wkey, p_dkey);
+		}
+
+		//	Note: The round keys are sliced only once for the whole key stream.
+		template<typename T>
+		static void ctr_xor(const typename T::key_schedule_t& p_wkey, _p::AES_counter_t& p_counter, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			sliced_key_t<T> skey;
+			slice_key<T>(p_wkey, skey);
+
+			alignas(16) std::array<uint8_t, block_lenght * lanes> key_stream;
+			slice_t q;
+
+			uint64_t counter_hi = p_counter[0];
+			uint64_t counter_lo = p_counter[1];
+
+			while(p_count)
+			{
+				const uintptr_t block_count = p_count < lanes ? p_count : lanes;
+				const uintptr_t chunk_size  = block_count * block_lenght;
+
+				for(uintptr_t i = 0; i < lanes; ++i)
+				{
+					const uint64_t hi = core::endian_host2big(counter_hi);
+					const uint64_t lo = core::endian_host2big(counter_lo);
+					memcpy(key_stream.data() + i * block_lenght, &hi, 8);
+					memcpy(key_stream.data() + i * block_lenght + 8, &lo, 8);
+					if(i < block_count && ++counter_lo == 0)
+					{
+						++counter_hi;
+					}
+				}
+
+				load(key_stream.data(), q);
+				encode_sliced<T>(skey, q);
+				store(q, key_stream.data());
+				xor_bytes(p_out, p_input, key_stream.data(), chunk_size);
+
+				p_input += chunk_size;
+				p_out   += chunk_size;
+				p_count -= block_count;
+			}
+
+			p_counter[0] = counter_hi;
+			p_counter[1] = counter_lo;
+		}
+	};
+
+	struct AES_NI_Help
+	{
+		template<typename T>
+		ISA_TARGET("aes")
+		static void encode(const typename T::key_schedule_t& p_wkey, std::span<const uint8_t, 16> p_input, std::span<uint8_t, 16> p_out)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			const __m128i* const round_key = reinterpret_cast<const __m128i*>(p_wkey.wkey.data());
+
+			__m128i state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input.data())), _mm_load_si128(round_key));
+			for(uintptr_t i = 1; i < number_of_rounds; ++i)
+			{
+				state = _mm_aesenc_si128(state, _mm_load_si128(round_key + i));
+			}
+			state = _mm_aesenclast_si128(state, _mm_load_si128(round_key + number_of_rounds));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out.data()), state);
+		}
+
+		//	Note: AESDEC implements the equivalent inverse cipher,
+		//	the middle round keys need InvMixColumns applied to them.
+		template<typename T>
+		ISA_TARGET("aes")
+		static void decode(const typename T::key_schedule_t& p_wkey, std::span<const uint8_t, 16> p_input, std::span<uint8_t, 16> p_out)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			const __m128i* const round_key = reinterpret_cast<const __m128i*>(p_wkey.wkey.data());
+
+			__m128i state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input.data())), _mm_load_si128(round_key + number_of_rounds));
+			for(uintptr_t i = number_of_rounds - 1; i; --i)
+			{
+				state = _mm_aesdec_si128(state, _mm_aesimc_si128(_mm_load_si128(round_key + i)));
+			}
+			state = _mm_aesdeclast_si128(state, _mm_load_si128(round_key));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out.data()), state);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes")
+		static void decode(const typename T::dec_key_schedule_t& p_dkey, std::span<const uint8_t, 16> p_input, std::span<uint8_t, 16> p_out)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			const __m128i* const round_key = reinterpret_cast<const __m128i*>(p_dkey.wkey.data());
+
+			__m128i state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input.data())), _mm_load_si128(round_key));
+			for(uintptr_t i = 1; i < number_of_rounds; ++i)
+			{
+				state = _mm_aesdec_si128(state, _mm_load_si128(round_key + i));
+			}
+			state = _mm_aesdeclast_si128(state, _mm_load_si128(round_key + number_of_rounds));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out.data()), state);
+		}
+
+		//	Note: Key expansion.
+		//	SubWord is done with AESENCLAST on a register holding the same word in every column, so that ShiftRows has no effect
+		//	and the round constant is added as the round key. AESKEYGENASSIST does the same but is microcoded on most cores,
+		//	with a throughput several times lower. The chain of XORs over the previous words is done with byte shifts.
+		//	Every key is a serial dependency chain, several keys are expanded together to hide the latency.
+		static constexpr uintptr_t key_lanes = 4;
+
+		template<typename T>
+		static constexpr uintptr_t key_rounds = (T::key_schedule_size - 1) / (T::key_lenght / 4);
+
+		///	\brief Every word is XORed with all the words below it
+		ISA_TARGET("sse2")
+		static inline __m128i prefix_xor(__m128i p_val)
+		{
+			p_val = _mm_xor_si128(p_val, _mm_slli_si128(p_val, 4));
+			return _mm_xor_si128(p_val, _mm_slli_si128(p_val, 8));
+		}
+
+		///	\brief SubWord(word) ^ p_rcon, p_word must hold the same word in every column
+		ISA_TARGET("aes")
+		static inline __m128i sub_word(const __m128i p_word, const uint8_t p_rcon)
+		{
+			return _mm_aesenclast_si128(p_word, _mm_set1_epi32(p_rcon));
+		}
+
+		///	\brief Byte shuffle that broadcasts RotWord of word 3
+		ISA_TARGET("ssse3")
+		static inline __m128i rot_word_3()
+		{
+			return _mm_set_epi8(12, 15, 14, 13, 12, 15, 14, 13, 12, 15, 14, 13, 12, 15, 14, 13);
+		}
+
+		///	\brief Byte shuffle that broadcasts RotWord of word 1
+		ISA_TARGET("ssse3")
+		static inline __m128i rot_word_1()
+		{
+			return _mm_set_epi8(4, 7, 6, 5, 4, 7, 6, 5, 4, 7, 6, 5, 4, 7, 6, 5);
+		}
+
+		template<uintptr_t R, uintptr_t Lanes>
+		ISA_TARGET("aes,ssse3")
+		static inline void key_round_128(std::array<__m128i, Lanes>& p_lo, AES_128::key_schedule_t* const p_wkey)
+		{
+			for(uintptr_t i = 0; i < Lanes; ++i)
+			{
+				const __m128i assist = sub_word(_mm_shuffle_epi8(p_lo[i], rot_word_3()), AES_Help::rcon[R]);
+				p_lo[i] = _mm_xor_si128(prefix_xor(p_lo[i]), assist);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_wkey[i].wkey.data() + (R + 1) * 4), p_lo[i]);
+			}
+		}
+
+		//	Note: p_hi holds the last 2 words of the previous round in its low half.
+		template<uintptr_t R, uintptr_t Lanes>
+		ISA_TARGET("aes,ssse3")
+		static inline void key_round_192(std::array<__m128i, Lanes>& p_lo, std::array<__m128i, Lanes>& p_hi, AES_192::key_schedule_t* const p_wkey)
+		{
+			for(uintptr_t i = 0; i < Lanes; ++i)
+			{
+				const __m128i assist = sub_word(_mm_shuffle_epi8(p_hi[i], rot_word_1()), AES_Help::rcon[R]);
+				p_lo[i] = _mm_xor_si128(prefix_xor(p_lo[i]), assist);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_wkey[i].wkey.data() + (R + 1) * 6), p_lo[i]);
+				if constexpr(R + 1 < key_rounds<AES_192>)
+				{
+					p_hi[i] = _mm_xor_si128(_mm_xor_si128(p_hi[i], _mm_slli_si128(p_hi[i], 4)), _mm_shuffle_epi32(p_lo[i], 0xFF));
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(p_wkey[i].wkey.data() + (R + 1) * 6 + 4), p_hi[i]);
+				}
+			}
+		}
+
+		//	Note: The second half of the round uses SubWord without RotWord or round constant.
+		template<uintptr_t R, uintptr_t Lanes>
+		ISA_TARGET("aes,ssse3")
+		static inline void key_round_256(std::array<__m128i, Lanes>& p_lo, std::array<__m128i, Lanes>& p_hi, AES_256::key_schedule_t* const p_wkey)
+		{
+			for(uintptr_t i = 0; i < Lanes; ++i)
+			{
+				const __m128i assist = sub_word(_mm_shuffle_epi8(p_hi[i], rot_word_3()), AES_Help::rcon[R]);
+				p_lo[i] = _mm_xor_si128(prefix_xor(p_lo[i]), assist);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_wkey[i].wkey.data() + (R + 1) * 8), p_lo[i]);
+				if constexpr(R + 1 < key_rounds<AES_256>)
+				{
+					p_hi[i] = _mm_xor_si128(prefix_xor(p_hi[i]), sub_word(_mm_shuffle_epi32(p_lo[i], 0xFF), 0));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(p_wkey[i].wkey.data() + (R + 1) * 8 + 4), p_hi[i]);
+				}
+			}
+		}
+
+		template<typename T, uintptr_t Lanes, uintptr_t... R>
+		ISA_TARGET("aes,ssse3")
+		static inline void expand_keys(const uint8_t* const p_keys, typename T::key_schedule_t* const p_wkey, std::index_sequence<R...>)
+		{
+			constexpr uintptr_t key_lenght = T::key_lenght;
+
+			std::array<__m128i, Lanes> lo;
+			std::array<__m128i, Lanes> hi;
+			for(uintptr_t i = 0; i < Lanes; ++i)
+			{
+				const uint8_t* const key = p_keys + i * key_lenght;
+				memcpy(p_wkey[i].wkey.data(), key, key_lenght);
+				lo[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+				if constexpr(key_lenght == 24)
+				{
+					hi[i] = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(key + 16));
+				}
+				else if constexpr(key_lenght == 32)
+				{
+					hi[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + 16));
+				}
+			}
+
+			if constexpr(std::is_same_v<T, AES_128>)
+			{
+				(key_round_128<R>(lo, p_wkey), ...);
+			}
+			else if constexpr(std::is_same_v<T, AES_192>)
+			{
+				(key_round_192<R>(lo, hi, p_wkey), ...);
+			}
+			else
+			{
+				static_assert(std::is_same_v<T, AES_256>);
+				(key_round_256<R>(lo, hi, p_wkey), ...);
+			}
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,ssse3")
+		static void make_key(const uint8_t* const p_key, typename T::key_schedule_t& p_wkey)
+		{
+			expand_keys<T, 1>(p_key, &p_wkey, std::make_index_sequence<key_rounds<T>>{});
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,ssse3")
+		static void make_keys(const uint8_t* p_keys, typename T::key_schedule_t* p_wkey, uintptr_t p_count)
+		{
+			constexpr std::make_index_sequence<key_rounds<T>> seq;
+
+			for(; p_count >= key_lanes; p_count -= key_lanes, p_keys += key_lanes * T::key_lenght, p_wkey += key_lanes)
+			{
+				expand_keys<T, key_lanes>(p_keys, p_wkey, seq);
+			}
+			for(; p_count; --p_count, p_keys += T::key_lenght, ++p_wkey)
+			{
+				expand_keys<T, 1>(p_keys, p_wkey, seq);
+			}
+		}
+
+		template<typename T>
+		ISA_TARGET("aes")
+		static void make_dec_key(const typename T::key_schedule_t& p_wkey, typename T::dec_key_schedule_t& p_dkey)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			const __m128i* const wkey = reinterpret_cast<const __m128i*>(p_wkey.wkey.data());
+			__m128i* const dkey = reinterpret_cast<__m128i*>(p_dkey.wkey.data());
+
+			_mm_store_si128(dkey, _mm_load_si128(wkey + number_of_rounds));
+			for(uintptr_t i = 1; i < number_of_rounds; ++i)
+			{
+				_mm_store_si128(dkey + i, _mm_aesimc_si128(_mm_load_si128(wkey + (number_of_rounds - i))));
+			}
+			_mm_store_si128(dkey + number_of_rounds, _mm_load_si128(wkey));
+		}
+
+		//	Note: Multi-block helpers.
+		//	AESENC/AESDEC have a latency of several cycles but can be issued every cycle,
+		//	independent blocks are interleaved so that the pipeline is kept full.
+		static constexpr uintptr_t lanes = 8;
+		using lanes_t = std::array<__m128i, lanes>;
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_load_xor(lanes_t& p_state, const uint8_t* const p_input, const __m128i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input) + I), p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_store(const lanes_t& p_state, uint8_t* const p_out, std::index_sequence<I...>)
+		{
+			(_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out) + I, p_state[I]), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_enc(lanes_t& p_state, const __m128i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm_aesenc_si128(p_state[I], p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_enclast(lanes_t& p_state, const __m128i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm_aesenclast_si128(p_state[I], p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_dec(lanes_t& p_state, const __m128i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm_aesdec_si128(p_state[I], p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_declast(lanes_t& p_state, const __m128i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm_aesdeclast_si128(p_state[I], p_key)), ...);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes")
+		static void encode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			constexpr std::make_index_sequence<lanes> seq;
+
+			std::array<__m128i, number_of_rounds + 1> round_key;
+			for(uintptr_t i = 0; i <= number_of_rounds; ++i)
+			{
+				round_key[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + i);
+			}
+
+			for(; p_count >= lanes; p_count -= lanes, p_input += lanes * 16, p_out += lanes * 16)
+			{
+				lanes_t state;
+				lanes_load_xor(state, p_input, round_key[0], seq);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					lanes_enc(state, round_key[i], seq);
+				}
+				lanes_enclast(state, round_key[number_of_rounds], seq);
+				lanes_store(state, p_out, seq);
+			}
+
+			for(; p_count; --p_count, p_input += 16, p_out += 16)
+			{
+				__m128i state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input)), round_key[0]);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					state = _mm_aesenc_si128(state, round_key[i]);
+				}
+				state = _mm_aesenclast_si128(state, round_key[number_of_rounds]);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out), state);
+			}
+		}
+
+		///	\brief Decoding round keys, in the order they are applied.
+		template<typename T>
+		ISA_TARGET("aes")
+		static inline void load_dec_key(const typename T::dec_key_schedule_t& p_dkey, std::array<__m128i, T::number_of_rounds + 1>& p_round_key)
+		{
+			for(uintptr_t i = 0; i <= T::number_of_rounds; ++i)
+			{
+				p_round_key[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_dkey.wkey.data()) + i);
+			}
+		}
+
+		template<typename T>
+		ISA_TARGET("aes")
+		static void decode_lanes(const std::array<__m128i, T::number_of_rounds + 1>& p_round_key, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			constexpr std::make_index_sequence<lanes> seq;
+
+			for(; p_count >= lanes; p_count -= lanes, p_input += lanes * 16, p_out += lanes * 16)
+			{
+				lanes_t state;
+				lanes_load_xor(state, p_input, p_round_key[0], seq);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					lanes_dec(state, p_round_key[i], seq);
+				}
+				lanes_declast(state, p_round_key[number_of_rounds], seq);
+				lanes_store(state, p_out, seq);
+			}
+
+			for(; p_count; --p_count, p_input += 16, p_out += 16)
+			{
+				__m128i state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input)), p_round_key[0]);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					state = _mm_aesdec_si128(state, p_round_key[i]);
+				}
+				state = _mm_aesdeclast_si128(state, p_round_key[number_of_rounds]);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out), state);
+			}
+		}
+
+		template<typename T>
+		ISA_TARGET("aes")
+		static void decode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+
+			std::array<__m128i, number_of_rounds + 1> round_key;
+			round_key[0] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + number_of_rounds);
+			for(uintptr_t i = 1; i < number_of_rounds; ++i)
+			{
+				round_key[i] = _mm_aesimc_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + (number_of_rounds - i)));
+			}
+			round_key[number_of_rounds] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()));
+
+			decode_lanes<T>(round_key, p_input, p_out, p_count);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes")
+		static void decode_blocks(const typename T::dec_key_schedule_t& p_dkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			std::array<__m128i, T::number_of_rounds + 1> round_key;
+			load_dec_key<T>(p_dkey, round_key);
+			decode_lanes<T>(round_key, p_input, p_out, p_count);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_load(lanes_t& p_state, const uint8_t* const p_input, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input) + I)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_xor(lanes_t& p_state, const lanes_t& p_other, const __m128i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm_xor_si128(p_other[I], p_key)), ...);
+		}
+
+		//	Note: p_state[i + 1] ^= p_cipher[i]
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_chain(lanes_t& p_state, const lanes_t& p_cipher, std::index_sequence<I...>)
+		{
+			((p_state[I + 1] = _mm_xor_si128(p_state[I + 1], p_cipher[I])), ...);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes")
+		static void cbc_encode(const typename T::key_schedule_t& p_wkey, uint8_t* const p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+
+			std::array<__m128i, number_of_rounds + 1> round_key;
+			for(uintptr_t i = 0; i <= number_of_rounds; ++i)
+			{
+				round_key[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + i);
+			}
+
+			__m128i chain = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_iv));
+			for(; p_count; --p_count, p_input += 16, p_out += 16)
+			{
+				chain = _mm_xor_si128(_mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input)), chain), round_key[0]);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					chain = _mm_aesenc_si128(chain, round_key[i]);
+				}
+				chain = _mm_aesenclast_si128(chain, round_key[number_of_rounds]);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out), chain);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_iv), chain);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes")
+		static void cfb_encode(const typename T::key_schedule_t& p_wkey, uint8_t* const p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+
+			std::array<__m128i, number_of_rounds + 1> round_key;
+			for(uintptr_t i = 0; i <= number_of_rounds; ++i)
+			{
+				round_key[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + i);
+			}
+
+			__m128i chain = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_iv));
+			for(; p_count; --p_count, p_input += 16, p_out += 16)
+			{
+				chain = _mm_xor_si128(chain, round_key[0]);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					chain = _mm_aesenc_si128(chain, round_key[i]);
+				}
+				chain = _mm_aesenclast_si128(chain, round_key[number_of_rounds]);
+				chain = _mm_xor_si128(chain, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out), chain);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_iv), chain);
+		}
+
+		//	Note: The cipher text blocks are kept in registers, so p_out can be the same as p_input.
+		template<typename T>
+		ISA_TARGET("aes")
+		static void cbc_decode(const typename T::dec_key_schedule_t& p_dkey, uint8_t* const p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			constexpr std::make_index_sequence<lanes> seq;
+
+			std::array<__m128i, number_of_rounds + 1> round_key;
+			load_dec_key<T>(p_dkey, round_key);
+
+			__m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_iv));
+
+			for(; p_count >= lanes; p_count -= lanes, p_input += lanes * 16, p_out += lanes * 16)
+			{
+				lanes_t cipher;
+				lanes_t state;
+				lanes_load(cipher, p_input, seq);
+				lanes_xor(state, cipher, round_key[0], seq);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					lanes_dec(state, round_key[i], seq);
+				}
+				lanes_declast(state, round_key[number_of_rounds], seq);
+				state[0] = _mm_xor_si128(state[0], previous);
+				lanes_chain(state, cipher, std::make_index_sequence<lanes - 1>{});
+				previous = cipher[lanes - 1];
+				lanes_store(state, p_out, seq);
+			}
+
+			for(; p_count; --p_count, p_input += 16, p_out += 16)
+			{
+				const __m128i cipher = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input));
+				__m128i state = _mm_xor_si128(cipher, round_key[0]);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					state = _mm_aesdec_si128(state, round_key[i]);
+				}
+				state = _mm_aesdeclast_si128(state, round_key[number_of_rounds]);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out), _mm_xor_si128(state, previous));
+				previous = cipher;
+			}
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_iv), previous);
+		}
+
+		///	\brief Multiplication by x in GF(2^128), little endian (IEEE 1619)
+		///	\note Every 32 bit lane is shifted, the carry out of each lane is rotated into the next one,
+		///		and the carry out of the top lane is folded back as 0x87.
+		ISA_TARGET("sse2")
+		static inline __m128i xts_double(const __m128i p_tweak)
+		{
+			const __m128i carry = _mm_shuffle_epi32(_mm_srai_epi32(p_tweak, 31), 0x93);
+			return _mm_xor_si128(_mm_slli_epi32(p_tweak, 1), _mm_and_si128(carry, _mm_set_epi32(1, 1, 1, 0x87)));
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_tweak(lanes_t& p_tweak, __m128i& p_next, std::index_sequence<I...>)
+		{
+			(((p_tweak[I] = p_next), (p_next = xts_double(p_next))), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_load_xor_tweak(lanes_t& p_state, const uint8_t* const p_input, const lanes_t& p_tweak, const __m128i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input) + I), _mm_xor_si128(p_tweak[I], p_key))), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_xor_tweak_store(const lanes_t& p_state, const lanes_t& p_tweak, uint8_t* const p_out, std::index_sequence<I...>)
+		{
+			(_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out) + I, _mm_xor_si128(p_state[I], p_tweak[I])), ...);
+		}
+
+		//	Note: Key_t is the encoding or the decoding schedule, both are in the order they are applied.
+		template<typename T, bool Encode, typename Key_t>
+		ISA_TARGET("aes")
+		static void xts(const Key_t& p_key, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			constexpr std::make_index_sequence<lanes> seq;
+
+			std::array<__m128i, number_of_rounds + 1> round_key;
+			for(uintptr_t i = 0; i <= number_of_rounds; ++i)
+			{
+				round_key[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_key.wkey.data()) + i);
+			}
+
+			__m128i tweak = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_tweak));
+
+			for(; p_count >= lanes; p_count -= lanes, p_input += lanes * 16, p_out += lanes * 16)
+			{
+				lanes_t tweaks;
+				lanes_t state;
+				lanes_tweak(tweaks, tweak, seq);
+				lanes_load_xor_tweak(state, p_input, tweaks, round_key[0], seq);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					if constexpr(Encode)
+					{
+						lanes_enc(state, round_key[i], seq);
+					}
+					else
+					{
+						lanes_dec(state, round_key[i], seq);
+					}
+				}
+				if constexpr(Encode)
+				{
+					lanes_enclast(state, round_key[number_of_rounds], seq);
+				}
+				else
+				{
+					lanes_declast(state, round_key[number_of_rounds], seq);
+				}
+				lanes_xor_tweak_store(state, tweaks, p_out, seq);
+			}
+
+			for(; p_count; --p_count, p_input += 16, p_out += 16)
+			{
+				__m128i state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input)), _mm_xor_si128(tweak, round_key[0]));
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					if constexpr(Encode)
+					{
+						state = _mm_aesenc_si128(state, round_key[i]);
+					}
+					else
+					{
+						state = _mm_aesdec_si128(state, round_key[i]);
+					}
+				}
+				if constexpr(Encode)
+				{
+					state = _mm_aesenclast_si128(state, round_key[number_of_rounds]);
+				}
+				else
+				{
+					state = _mm_aesdeclast_si128(state, round_key[number_of_rounds]);
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out), _mm_xor_si128(state, tweak));
+				tweak = xts_double(tweak);
+			}
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_tweak), tweak);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes")
+		static void xts_encode(const typename T::key_schedule_t& p_wkey, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			xts<T, true>(p_wkey, p_tweak, p_input, p_out, p_count);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes")
+		static void xts_decode(const typename T::dec_key_schedule_t& p_dkey, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			xts<T, false>(p_dkey, p_tweak, p_input, p_out, p_count);
+		}
+
+		ISA_TARGET("aes")
+		static inline __m128i ctr_block(const uint64_t p_hi, const uint64_t p_lo)
+		{
+			return _mm_set_epi64x(static_cast<int64_t>(core::endian_host2big(p_lo)), static_cast<int64_t>(core::endian_host2big(p_hi)));
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_ctr(lanes_t& p_state, uint64_t& p_hi, uint64_t& p_lo, const __m128i p_key, std::index_sequence<I...>)
+		{
+			(((p_state[I] = _mm_xor_si128(ctr_block(p_hi, p_lo), p_key)), (p_hi += (++p_lo == 0))), ...);
+		}
+
+		//	Note: Only valid if the low half of the counter does not wrap around within the lanes.
+		//	The counter is kept as a host order 128 bit integer and byte reversed into a big endian block.
+		template<uintptr_t... I>
+		ISA_TARGET("aes,ssse3")
+		static inline void lanes_ctr_fast(lanes_t& p_state, const uint64_t p_hi, const uint64_t p_lo, const __m128i p_key, std::index_sequence<I...>)
+		{
+			const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+			const __m128i base = _mm_set_epi64x(static_cast<int64_t>(p_hi), static_cast<int64_t>(p_lo));
+			((p_state[I] = _mm_xor_si128(_mm_shuffle_epi8(_mm_add_epi64(base, _mm_set_epi64x(0, I)), reverse), p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("aes")
+		static inline void lanes_xor_store(const lanes_t& p_state, const uint8_t* const p_input, uint8_t* const p_out, std::index_sequence<I...>)
+		{
+			(_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out) + I,
+				_mm_xor_si128(p_state[I], _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input) + I))), ...);
+		}
+
+		//	Note: Counter blocks are built in registers and the key stream never touches memory.
+		template<typename T>
+		ISA_TARGET("aes,ssse3")
+		static void ctr_xor(const typename T::key_schedule_t& p_wkey, _p::AES_counter_t& p_counter, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			constexpr std::make_index_sequence<lanes> seq;
+
+			std::array<__m128i, number_of_rounds + 1> round_key;
+			for(uintptr_t i = 0; i <= number_of_rounds; ++i)
+			{
+				round_key[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + i);
+			}
+
+			uint64_t counter_hi = p_counter[0];
+			uint64_t counter_lo = p_counter[1];
+
+			for(; p_count >= lanes; p_count -= lanes, p_input += lanes * 16, p_out += lanes * 16)
+			{
+				lanes_t state;
+				if(counter_lo <= UINT64_MAX - lanes)
+				{
+					lanes_ctr_fast(state, counter_hi, counter_lo, round_key[0], seq);
+					counter_lo += lanes;
+				}
+				else
+				{
+					lanes_ctr(state, counter_hi, counter_lo, round_key[0], seq);
+				}
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					lanes_enc(state, round_key[i], seq);
+				}
+				lanes_enclast(state, round_key[number_of_rounds], seq);
+				lanes_xor_store(state, p_input, p_out, seq);
+			}
+
+			for(; p_count; --p_count, p_input += 16, p_out += 16)
+			{
+				__m128i state = _mm_xor_si128(ctr_block(counter_hi, counter_lo), round_key[0]);
+				counter_hi += (++counter_lo == 0);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					state = _mm_aesenc_si128(state, round_key[i]);
+				}
+				state = _mm_aesenclast_si128(state, round_key[number_of_rounds]);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out), _mm_xor_si128(state, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input))));
+			}
+
+			p_counter[0] = counter_hi;
+			p_counter[1] = counter_lo;
+		}
+	};
+
+	//	Note: VAES applies the AES round instructions to every 128 bit lane of a YMM/ZMM register.
+	//	The bulk of ECB, CTR and XTS goes through the wide kernels,
+	//	the remainder and the serial modes (CBC encode) go through the AES-NI kernels.
+	struct AES_VAES_AVX512_Help: public AES_NI_Help
+	{
+		static constexpr uintptr_t vec_blocks	= 4;
+		static constexpr uintptr_t lanes		= 8;
+		static constexpr uintptr_t group		= lanes * vec_blocks;
+		using lanes_t = std::array<__m512i, lanes>;
+
+		template<uintptr_t N>
+		ISA_TARGET("avx512f")
+		static inline void broadcast_key(const std::array<__m128i, N>& p_key, std::array<__m512i, N>& p_wide_key)
+		{
+			for(uintptr_t i = 0; i < N; ++i)
+			{
+				p_wide_key[i] = _mm512_broadcast_i32x4(p_key[i]);
+			}
+		}
+
+		template<typename Key_t, uintptr_t N>
+		ISA_TARGET("avx512f")
+		static inline void load_key(const Key_t& p_key, std::array<__m512i, N>& p_wide_key)
+		{
+			for(uintptr_t i = 0; i < N; ++i)
+			{
+				p_wide_key[i] = _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(p_key.wkey.data()) + i));
+			}
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx512f")
+		static inline void lanes_load_xor(lanes_t& p_state, const uint8_t* const p_input, const __m512i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm512_xor_si512(_mm512_loadu_si512(reinterpret_cast<const __m512i*>(p_input) + I), p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx512f")
+		static inline void lanes_store(const lanes_t& p_state, uint8_t* const p_out, std::index_sequence<I...>)
+		{
+			(_mm512_storeu_si512(reinterpret_cast<__m512i*>(p_out) + I, p_state[I]), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("vaes,avx512f")
+		static inline void lanes_enc(lanes_t& p_state, const __m512i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm512_aesenc_epi128(p_state[I], p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("vaes,avx512f")
+		static inline void lanes_enclast(lanes_t& p_state, const __m512i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm512_aesenclast_epi128(p_state[I], p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("vaes,avx512f")
+		static inline void lanes_dec(lanes_t& p_state, const __m512i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm512_aesdec_epi128(p_state[I], p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("vaes,avx512f")
+		static inline void lanes_declast(lanes_t& p_state, const __m512i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm512_aesdeclast_epi128(p_state[I], p_key)), ...);
+		}
+
+		template<typename T, bool Encode>
+		ISA_TARGET("vaes,avx512f")
+		static inline void lanes_rounds(lanes_t& p_state, const std::array<__m512i, T::number_of_rounds + 1>& p_round_key)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			constexpr std::make_index_sequence<lanes> seq;
+
+			for(uintptr_t i = 1; i < number_of_rounds; ++i)
+			{
+				if constexpr(Encode)
+				{
+					lanes_enc(p_state, p_round_key[i], seq);
+				}
+				else
+				{
+					lanes_dec(p_state, p_round_key[i], seq);
+				}
+			}
+			if constexpr(Encode)
+			{
+				lanes_enclast(p_state, p_round_key[number_of_rounds], seq);
+			}
+			else
+			{
+				lanes_declast(p_state, p_round_key[number_of_rounds], seq);
+			}
+		}
+
+		//	Note: p_count is a multiple of group
+		template<typename T, bool Encode>
+		ISA_TARGET("vaes,avx512f")
+		static void process_lanes(const std::array<__m512i, T::number_of_rounds + 1>& p_round_key, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr std::make_index_sequence<lanes> seq;
+
+			for(; p_count; p_count -= group, p_input += group * 16, p_out += group * 16)
+			{
+				lanes_t state;
+				lanes_load_xor(state, p_input, p_round_key[0], seq);
+				lanes_rounds<T, Encode>(state, p_round_key);
+				lanes_store(state, p_out, seq);
+			}
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx512f")
+		static void encode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			const uintptr_t wide = p_count - p_count % group;
+			if(wide)
+			{
+				std::array<__m512i, T::number_of_rounds + 1> round_key;
+				load_key(p_wkey, round_key);
+				process_lanes<T, true>(round_key, p_input, p_out, wide);
+			}
+			AES_NI_Help::encode_blocks<T>(p_wkey, p_input + wide * 16, p_out + wide * 16, p_count - wide);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx512f")
+		static void decode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+
+			const uintptr_t wide = p_count - p_count % group;
+			if(wide)
+			{
+				std::array<__m128i, number_of_rounds + 1> round_key;
+				round_key[0] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + number_of_rounds);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					round_key[i] = _mm_aesimc_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + (number_of_rounds - i)));
+				}
+				round_key[number_of_rounds] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()));
+
+				std::array<__m512i, number_of_rounds + 1> wide_key;
+				broadcast_key(round_key, wide_key);
+				process_lanes<T, false>(wide_key, p_input, p_out, wide);
+			}
+			AES_NI_Help::decode_blocks<T>(p_wkey, p_input + wide * 16, p_out + wide * 16, p_count - wide);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx512f")
+		static void decode_blocks(const typename T::dec_key_schedule_t& p_dkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			const uintptr_t wide = p_count - p_count % group;
+			if(wide)
+			{
+				std::array<__m512i, T::number_of_rounds + 1> round_key;
+				load_key(p_dkey, round_key);
+				process_lanes<T, false>(round_key, p_input, p_out, wide);
+			}
+			AES_NI_Help::decode_blocks<T>(p_dkey, p_input + wide * 16, p_out + wide * 16, p_count - wide);
+		}
+
+		//	Note: Every 128 bit lane holds a host order counter, byte reversed into a big endian block.
+		template<uintptr_t... I>
+		ISA_TARGET("avx512f,avx512bw")
+		static inline void lanes_ctr(lanes_t& p_state, __m512i& p_counter, const __m512i p_key, std::index_sequence<I...>)
+		{
+			const __m512i reverse = _mm512_broadcast_i32x4(_mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+			const __m512i step = _mm512_broadcast_i32x4(_mm_set_epi64x(0, vec_blocks));
+			(((p_state[I] = _mm512_xor_si512(_mm512_shuffle_epi8(p_counter, reverse), p_key)), (p_counter = _mm512_add_epi64(p_counter, step))), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx512f")
+		static inline void lanes_xor_store(const lanes_t& p_state, const uint8_t* const p_input, uint8_t* const p_out, std::index_sequence<I...>)
+		{
+			(_mm512_storeu_si512(reinterpret_cast<__m512i*>(p_out) + I,
+				_mm512_xor_si512(p_state[I], _mm512_loadu_si512(reinterpret_cast<const __m512i*>(p_input) + I))), ...);
+		}
+
+		//	Note: The wide kernel only runs while the low half of the counter does not wrap around,
+		//	the AES-NI kernel takes care of the carry.
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx512f,avx512bw")
+		static void ctr_xor(const typename T::key_schedule_t& p_wkey, _p::AES_counter_t& p_counter, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr std::make_index_sequence<lanes> seq;
+
+			const uint64_t until_wrap = ~p_counter[1];
+			uintptr_t wide = static_cast<uintptr_t>(p_count < until_wrap ? p_count : until_wrap);
+			wide -= wide % group;
+
+			if(wide)
+			{
+				std::array<__m512i, T::number_of_rounds + 1> round_key;
+				load_key(p_wkey, round_key);
+
+				__m512i counter = _mm512_add_epi64(
+					_mm512_broadcast_i32x4(_mm_set_epi64x(static_cast<int64_t>(p_counter[0]), static_cast<int64_t>(p_counter[1]))),
+					_mm512_set_epi64(0, 3, 0, 2, 0, 1, 0, 0));
+
+				const uint8_t* input = p_input;
+				uint8_t* out = p_out;
+				for(uintptr_t count = wide; count; count -= group, input += group * 16, out += group * 16)
+				{
+					lanes_t state;
+					lanes_ctr(state, counter, round_key[0], seq);
+					lanes_rounds<T, true>(state, round_key);
+					lanes_xor_store(state, input, out, seq);
+				}
+				p_counter[1] += wide;
+			}
+			AES_NI_Help::ctr_xor<T>(p_wkey, p_counter, p_input + wide * 16, p_out + wide * 16, p_count - wide);
+		}
+
+		///	\brief Multiplies every lane by x^vec_blocks in GF(2^128), little endian (IEEE 1619)
+		///	\note The bits shifted out of each 64 bit half are moved into the other half,
+		///		the ones out of the top half are folded back multiplied by 0x87 (x^7 + x^2 + x + 1).
+		ISA_TARGET("avx512f")
+		static inline __m512i xts_advance(const __m512i p_tweak)
+		{
+			const __m512i carry = _mm512_shuffle_epi32(_mm512_srli_epi64(p_tweak, 64 - vec_blocks), _MM_PERM_BADC);
+			const __m512i fold = _mm512_maskz_mov_epi64(0x55, carry);
+			const __m512i reduce = _mm512_xor_si512(_mm512_xor_si512(_mm512_slli_epi64(fold, 1), _mm512_slli_epi64(fold, 2)), _mm512_slli_epi64(fold, 7));
+			return _mm512_xor_si512(_mm512_xor_si512(_mm512_slli_epi64(p_tweak, vec_blocks), carry), reduce);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx512f")
+		static inline void lanes_tweak(lanes_t& p_tweak, __m512i& p_next, std::index_sequence<I...>)
+		{
+			(((p_tweak[I] = p_next), (p_next = xts_advance(p_next))), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx512f")
+		static inline void lanes_load_xor_tweak(lanes_t& p_state, const uint8_t* const p_input, const lanes_t& p_tweak, const __m512i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm512_xor_si512(_mm512_loadu_si512(reinterpret_cast<const __m512i*>(p_input) + I), _mm512_xor_si512(p_tweak[I], p_key))), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx512f")
+		static inline void lanes_xor_tweak_store(const lanes_t& p_state, const lanes_t& p_tweak, uint8_t* const p_out, std::index_sequence<I...>)
+		{
+			(_mm512_storeu_si512(reinterpret_cast<__m512i*>(p_out) + I, _mm512_xor_si512(p_state[I], p_tweak[I])), ...);
+		}
+
+		template<typename T, bool Encode, typename Key_t>
+		ISA_TARGET("aes,vaes,avx512f")
+		static void xts(const Key_t& p_key, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr std::make_index_sequence<lanes> seq;
+
+			const uintptr_t wide = p_count - p_count % group;
+			if(wide)
+			{
+				std::array<__m512i, T::number_of_rounds + 1> round_key;
+				load_key(p_key, round_key);
+
+				const __m128i tweak_0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_tweak));
+				const __m128i tweak_1 = xts_double(tweak_0);
+				const __m128i tweak_2 = xts_double(tweak_1);
+				const __m128i tweak_3 = xts_double(tweak_2);
+				__m512i tweak = _mm512_inserti32x4(_mm512_inserti32x4(_mm512_inserti32x4(_mm512_castsi128_si512(tweak_0), tweak_1, 1), tweak_2, 2), tweak_3, 3);
+
+				const uint8_t* input = p_input;
+				uint8_t* out = p_out;
+				for(uintptr_t count = wide; count; count -= group, input += group * 16, out += group * 16)
+				{
+					lanes_t tweaks;
+					lanes_t state;
+					lanes_tweak(tweaks, tweak, seq);
+					lanes_load_xor_tweak(state, input, tweaks, round_key[0], seq);
+					lanes_rounds<T, Encode>(state, round_key);
+					lanes_xor_tweak_store(state, tweaks, out, seq);
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_tweak), _mm512_castsi512_si128(tweak));
+			}
+			AES_NI_Help::xts<T, Encode>(p_key, p_tweak, p_input + wide * 16, p_out + wide * 16, p_count - wide);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx512f")
+		static void xts_encode(const typename T::key_schedule_t& p_wkey, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			xts<T, true>(p_wkey, p_tweak, p_input, p_out, p_count);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx512f")
+		static void xts_decode(const typename T::dec_key_schedule_t& p_dkey, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			xts<T, false>(p_dkey, p_tweak, p_input, p_out, p_count);
+		}
+	};
+
+	struct AES_VAES_AVX2_Help: public AES_NI_Help
+	{
+		static constexpr uintptr_t vec_blocks	= 2;
+		static constexpr uintptr_t lanes		= 8;
+		static constexpr uintptr_t group		= lanes * vec_blocks;
+		using lanes_t = std::array<__m256i, lanes>;
+
+		template<uintptr_t N>
+		ISA_TARGET("avx2")
+		static inline void broadcast_key(const std::array<__m128i, N>& p_key, std::array<__m256i, N>& p_wide_key)
+		{
+			for(uintptr_t i = 0; i < N; ++i)
+			{
+				p_wide_key[i] = _mm256_broadcastsi128_si256(p_key[i]);
+			}
+		}
+
+		template<typename Key_t, uintptr_t N>
+		ISA_TARGET("avx2")
+		static inline void load_key(const Key_t& p_key, std::array<__m256i, N>& p_wide_key)
+		{
+			for(uintptr_t i = 0; i < N; ++i)
+			{
+				p_wide_key[i] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(p_key.wkey.data()) + i));
+			}
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx2")
+		static inline void lanes_load_xor(lanes_t& p_state, const uint8_t* const p_input, const __m256i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_input) + I), p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx2")
+		static inline void lanes_store(const lanes_t& p_state, uint8_t* const p_out, std::index_sequence<I...>)
+		{
+			(_mm256_storeu_si256(reinterpret_cast<__m256i*>(p_out) + I, p_state[I]), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("vaes,avx2")
+		static inline void lanes_enc(lanes_t& p_state, const __m256i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm256_aesenc_epi128(p_state[I], p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("vaes,avx2")
+		static inline void lanes_enclast(lanes_t& p_state, const __m256i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm256_aesenclast_epi128(p_state[I], p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("vaes,avx2")
+		static inline void lanes_dec(lanes_t& p_state, const __m256i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm256_aesdec_epi128(p_state[I], p_key)), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("vaes,avx2")
+		static inline void lanes_declast(lanes_t& p_state, const __m256i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm256_aesdeclast_epi128(p_state[I], p_key)), ...);
+		}
+
+		template<typename T, bool Encode>
+		ISA_TARGET("vaes,avx2")
+		static inline void lanes_rounds(lanes_t& p_state, const std::array<__m256i, T::number_of_rounds + 1>& p_round_key)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+			constexpr std::make_index_sequence<lanes> seq;
+
+			for(uintptr_t i = 1; i < number_of_rounds; ++i)
+			{
+				if constexpr(Encode)
+				{
+					lanes_enc(p_state, p_round_key[i], seq);
+				}
+				else
+				{
+					lanes_dec(p_state, p_round_key[i], seq);
+				}
+			}
+			if constexpr(Encode)
+			{
+				lanes_enclast(p_state, p_round_key[number_of_rounds], seq);
+			}
+			else
+			{
+				lanes_declast(p_state, p_round_key[number_of_rounds], seq);
+			}
+		}
+
+		//	Note: p_count is a multiple of group
+		template<typename T, bool Encode>
+		ISA_TARGET("vaes,avx2")
+		static void process_lanes(const std::array<__m256i, T::number_of_rounds + 1>& p_round_key, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr std::make_index_sequence<lanes> seq;
+
+			for(; p_count; p_count -= group, p_input += group * 16, p_out += group * 16)
+			{
+				lanes_t state;
+				lanes_load_xor(state, p_input, p_round_key[0], seq);
+				lanes_rounds<T, Encode>(state, p_round_key);
+				lanes_store(state, p_out, seq);
+			}
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx2")
+		static void encode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			const uintptr_t wide = p_count - p_count % group;
+			if(wide)
+			{
+				std::array<__m256i, T::number_of_rounds + 1> round_key;
+				load_key(p_wkey, round_key);
+				process_lanes<T, true>(round_key, p_input, p_out, wide);
+			}
+			AES_NI_Help::encode_blocks<T>(p_wkey, p_input + wide * 16, p_out + wide * 16, p_count - wide);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx2")
+		static void decode_blocks(const typename T::key_schedule_t& p_wkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr uintptr_t number_of_rounds = T::number_of_rounds;
+
+			const uintptr_t wide = p_count - p_count % group;
+			if(wide)
+			{
+				std::array<__m128i, number_of_rounds + 1> round_key;
+				round_key[0] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + number_of_rounds);
+				for(uintptr_t i = 1; i < number_of_rounds; ++i)
+				{
+					round_key[i] = _mm_aesimc_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + (number_of_rounds - i)));
+				}
+				round_key[number_of_rounds] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()));
+
+				std::array<__m256i, number_of_rounds + 1> wide_key;
+				broadcast_key(round_key, wide_key);
+				process_lanes<T, false>(wide_key, p_input, p_out, wide);
+			}
+			AES_NI_Help::decode_blocks<T>(p_wkey, p_input + wide * 16, p_out + wide * 16, p_count - wide);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx2")
+		static void decode_blocks(const typename T::dec_key_schedule_t& p_dkey, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			const uintptr_t wide = p_count - p_count % group;
+			if(wide)
+			{
+				std::array<__m256i, T::number_of_rounds + 1> round_key;
+				load_key(p_dkey, round_key);
+				process_lanes<T, false>(round_key, p_input, p_out, wide);
+			}
+			AES_NI_Help::decode_blocks<T>(p_dkey, p_input + wide * 16, p_out + wide * 16, p_count - wide);
+		}
+
+		//	Note: Every 128 bit lane holds a host order counter, byte reversed into a big endian block.
+		template<uintptr_t... I>
+		ISA_TARGET("avx2")
+		static inline void lanes_ctr(lanes_t& p_state, __m256i& p_counter, const __m256i p_key, std::index_sequence<I...>)
+		{
+			const __m256i reverse = _mm256_broadcastsi128_si256(_mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+			const __m256i step = _mm256_broadcastsi128_si256(_mm_set_epi64x(0, vec_blocks));
+			(((p_state[I] = _mm256_xor_si256(_mm256_shuffle_epi8(p_counter, reverse), p_key)), (p_counter = _mm256_add_epi64(p_counter, step))), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx2")
+		static inline void lanes_xor_store(const lanes_t& p_state, const uint8_t* const p_input, uint8_t* const p_out, std::index_sequence<I...>)
+		{
+			(_mm256_storeu_si256(reinterpret_cast<__m256i*>(p_out) + I,
+				_mm256_xor_si256(p_state[I], _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_input) + I))), ...);
+		}
+
+		//	Note: The wide kernel only runs while the low half of the counter does not wrap around,
+		//	the AES-NI kernel takes care of the carry.
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx2")
+		static void ctr_xor(const typename T::key_schedule_t& p_wkey, _p::AES_counter_t& p_counter, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr std::make_index_sequence<lanes> seq;
+
+			const uint64_t until_wrap = ~p_counter[1];
+			uintptr_t wide = static_cast<uintptr_t>(p_count < until_wrap ? p_count : until_wrap);
+			wide -= wide % group;
+
+			if(wide)
+			{
+				std::array<__m256i, T::number_of_rounds + 1> round_key;
+				load_key(p_wkey, round_key);
+
+				__m256i counter = _mm256_add_epi64(
+					_mm256_broadcastsi128_si256(_mm_set_epi64x(static_cast<int64_t>(p_counter[0]), static_cast<int64_t>(p_counter[1]))),
+					_mm256_set_epi64x(0, 1, 0, 0));
+
+				const uint8_t* input = p_input;
+				uint8_t* out = p_out;
+				for(uintptr_t count = wide; count; count -= group, input += group * 16, out += group * 16)
+				{
+					lanes_t state;
+					lanes_ctr(state, counter, round_key[0], seq);
+					lanes_rounds<T, true>(state, round_key);
+					lanes_xor_store(state, input, out, seq);
+				}
+				p_counter[1] += wide;
+			}
+			AES_NI_Help::ctr_xor<T>(p_wkey, p_counter, p_input + wide * 16, p_out + wide * 16, p_count - wide);
+		}
+
+		///	\brief Multiplies every lane by x^vec_blocks in GF(2^128), little endian (IEEE 1619)
+		///	\note The bits shifted out of each 64 bit half are moved into the other half,
+		///		the ones out of the top half are folded back multiplied by 0x87 (x^7 + x^2 + x + 1).
+		ISA_TARGET("avx2")
+		static inline __m256i xts_advance(const __m256i p_tweak)
+		{
+			const __m256i carry = _mm256_shuffle_epi32(_mm256_srli_epi64(p_tweak, 64 - vec_blocks), 0x4E);
+			const __m256i fold = _mm256_blend_epi32(_mm256_setzero_si256(), carry, 0x33);
+			const __m256i reduce = _mm256_xor_si256(_mm256_xor_si256(_mm256_slli_epi64(fold, 1), _mm256_slli_epi64(fold, 2)), _mm256_slli_epi64(fold, 7));
+			return _mm256_xor_si256(_mm256_xor_si256(_mm256_slli_epi64(p_tweak, vec_blocks), carry), reduce);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx2")
+		static inline void lanes_tweak(lanes_t& p_tweak, __m256i& p_next, std::index_sequence<I...>)
+		{
+			(((p_tweak[I] = p_next), (p_next = xts_advance(p_next))), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx2")
+		static inline void lanes_load_xor_tweak(lanes_t& p_state, const uint8_t* const p_input, const lanes_t& p_tweak, const __m256i p_key, std::index_sequence<I...>)
+		{
+			((p_state[I] = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_input) + I), _mm256_xor_si256(p_tweak[I], p_key))), ...);
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("avx2")
+		static inline void lanes_xor_tweak_store(const lanes_t& p_state, const lanes_t& p_tweak, uint8_t* const p_out, std::index_sequence<I...>)
+		{
+			(_mm256_storeu_si256(reinterpret_cast<__m256i*>(p_out) + I, _mm256_xor_si256(p_state[I], p_tweak[I])), ...);
+		}
+
+		template<typename T, bool Encode, typename Key_t>
+		ISA_TARGET("aes,vaes,avx2")
+		static void xts(const Key_t& p_key, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			constexpr std::make_index_sequence<lanes> seq;
+
+			const uintptr_t wide = p_count - p_count % group;
+			if(wide)
+			{
+				std::array<__m256i, T::number_of_rounds + 1> round_key;
+				load_key(p_key, round_key);
+
+				const __m128i tweak_0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_tweak));
+				const __m128i tweak_1 = xts_double(tweak_0);
+				__m256i tweak = _mm256_set_m128i(tweak_1, tweak_0);
+
+				const uint8_t* input = p_input;
+				uint8_t* out = p_out;
+				for(uintptr_t count = wide; count; count -= group, input += group * 16, out += group * 16)
+				{
+					lanes_t tweaks;
+					lanes_t state;
+					lanes_tweak(tweaks, tweak, seq);
+					lanes_load_xor_tweak(state, input, tweaks, round_key[0], seq);
+					lanes_rounds<T, Encode>(state, round_key);
+					lanes_xor_tweak_store(state, tweaks, out, seq);
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_tweak), _mm256_castsi256_si128(tweak));
+			}
+			AES_NI_Help::xts<T, Encode>(p_key, p_tweak, p_input + wide * 16, p_out + wide * 16, p_count - wide);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx2")
+		static void xts_encode(const typename T::key_schedule_t& p_wkey, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			xts<T, true>(p_wkey, p_tweak, p_input, p_out, p_count);
+		}
+
+		template<typename T>
+		ISA_TARGET("aes,vaes,avx2")
+		static void xts_decode(const typename T::dec_key_schedule_t& p_dkey, uint8_t* const p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			xts<T, false>(p_dkey, p_tweak, p_input, p_out, p_count);
+		}
+	};
+#endif
+
+	namespace
+	{
+		template<typename T>
+		struct AES_engine_table
+		{
+			using block_cb_t      = void (*)(const typename T::key_schedule_t&, std::span<const uint8_t, 16>, std::span<uint8_t, 16>);
+			using blocks_cb_t     = void (*)(const typename T::key_schedule_t&, const uint8_t*, uint8_t*, uintptr_t);
+			using dec_block_cb_t  = void (*)(const typename T::dec_key_schedule_t&, std::span<const uint8_t, 16>, std::span<uint8_t, 16>);
+			using dec_blocks_cb_t = void (*)(const typename T::dec_key_schedule_t&, const uint8_t*, uint8_t*, uintptr_t);
+			using ctr_cb_t        = void (*)(const typename T::key_schedule_t&, _p::AES_counter_t&, const uint8_t*, uint8_t*, uintptr_t);
+			using chain_cb_t      = void (*)(const typename T::key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+			using dec_chain_cb_t  = void (*)(const typename T::dec_key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+			using key_cb_t        = void (*)(const uint8_t*, typename T::key_schedule_t&);
+			using keys_cb_t       = void (*)(const uint8_t*, typename T::key_schedule_t*, uintptr_t);
+			using dec_key_cb_t    = void (*)(const typename T::key_schedule_t&, typename T::dec_key_schedule_t&);
+
+			key_cb_t        make_key;
+			keys_cb_t       make_keys;
+			dec_key_cb_t    make_dec_key;
+
+			block_cb_t      encode;
+			block_cb_t      decode;
+			blocks_cb_t     encode_blocks;
+			blocks_cb_t     decode_blocks;
+			dec_block_cb_t  dec_decode;
+			dec_blocks_cb_t dec_decode_blocks;
+			ctr_cb_t        ctr_xor;
+			chain_cb_t      cbc_encode;
+			chain_cb_t      cfb_encode;
+			dec_chain_cb_t  cbc_decode;
+			chain_cb_t      xts_encode;
+			dec_chain_cb_t  xts_decode;
+
+			template<typename Help>
+			static constexpr AES_engine_table make()
+			{
+				return AES_engine_table
+				{
+					.make_key          = Help::template make_key<T>,
+					.make_keys         = Help::template make_keys<T>,
+					.make_dec_key      = Help::template make_dec_key<T>,
+					.encode            = Help::template encode<T>,
+					.decode            = Help::template decode<T>,
+					.encode_blocks     = Help::template encode_blocks<T>,
+					.decode_blocks     = Help::template decode_blocks<T>,
+					.dec_decode        = Help::template decode<T>,
+					.dec_decode_blocks = Help::template decode_blocks<T>,
+					.ctr_xor           = Help::template ctr_xor<T>,
+					.cbc_encode        = Help::template cbc_encode<T>,
+					.cfb_encode        = Help::template cfb_encode<T>,
+					.cbc_decode        = Help::template cbc_decode<T>,
+					.xts_encode        = Help::template xts_encode<T>,
+					.xts_decode        = Help::template xts_decode<T>,
+				};
+			}
+		};
+
+		struct AES_Dispatch
+		{
+			AES_engine id;
+			AES_engine_table<AES_128> aes_128;
+			AES_engine_table<AES_192> aes_192;
+			AES_engine_table<AES_256> aes_256;
+
+			template<typename Help>
+			static constexpr AES_Dispatch make(const AES_engine p_id)
+			{
+				return AES_Dispatch
+				{
+					.id = p_id,
+					.aes_128 = AES_engine_table<AES_128>::make<Help>(),
+					.aes_192 = AES_engine_table<AES_192>::make<Help>(),
+					.aes_256 = AES_engine_table<AES_256>::make<Help>(),
+				};
+			}
+		};
+
+		constexpr AES_Dispatch software_engine = AES_Dispatch::make<AES_Block_modes<AES_Help>>(AES_engine::software);
+		constexpr AES_Dispatch T_table_engine  = AES_Dispatch::make<AES_Block_modes<AES_T_table_Help>>(AES_engine::T_table);
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		constexpr AES_Dispatch bitsliced_engine = AES_Dispatch::make<AES_bitslice_modes>(AES_engine::bitsliced);
+		constexpr AES_Dispatch AES_NI_engine = AES_Dispatch::make<AES_NI_Help>(AES_engine::AES_NI);
+		constexpr AES_Dispatch VAES_AVX2_engine = AES_Dispatch::make<AES_VAES_AVX2_Help>(AES_engine::VAES_AVX2);
+		constexpr AES_Dispatch VAES_AVX512_engine = AES_Dispatch::make<AES_VAES_AVX512_Help>(AES_engine::VAES_AVX512);
+
+		//	Note: The counter mode kernel also relies on SSSE3 byte shuffles.
+		static inline bool AES_NI_supported()
+		{
+			return core::amd64::CPU_feature_su::AES() && core::amd64::CPU_feature_su::SSSE3();
+		}
+
+		//	Note: The VAES engines fall back to the AES-NI kernels for the remainders.
+		static inline bool VAES_AVX2_supported()
+		{
+			return AES_NI_supported() && core::amd64::CPU_feature_su::VAES() && core::amd64::CPU_feature_su::AVX2();
+		}
+
+		static inline bool VAES_AVX512_supported()
+		{
+			return AES_NI_supported() && core::amd64::CPU_feature_su::VAES() &&
+				core::amd64::CPU_feature_su::AVX512F() && core::amd64::CPU_feature_su::AVX512BW();
+		}
+
+		const AES_Dispatch* select_engine(const AES_engine p_engine)
+		{
+			switch(p_engine)
+			{
+			case AES_engine::automatic:
+				if(VAES_AVX512_supported())
+				{
+					return &VAES_AVX512_engine;
+				}
+				if(VAES_AVX2_supported())
+				{
+					return &VAES_AVX2_engine;
+				}
+				return AES_NI_supported() ? &AES_NI_engine : &bitsliced_engine;
+			case AES_engine::software:
+				return &software_engine;
+			case AES_engine::T_table:
+				return &T_table_engine;
+			case AES_engine::bitsliced:
+				return &bitsliced_engine;
+			case AES_engine::AES_NI:
+				return AES_NI_supported() ? &AES_NI_engine : nullptr;
+			case AES_engine::VAES_AVX2:
+				return VAES_AVX2_supported() ? &VAES_AVX2_engine : nullptr;
+			case AES_engine::VAES_AVX512:
+				return VAES_AVX512_supported() ? &VAES_AVX512_engine : nullptr;
+			default:
+				break;
+			}
+			return nullptr;
+		}
+#else
+		const AES_Dispatch* select_engine(const AES_engine p_engine)
+		{
+			switch(p_engine)
+			{
+			case AES_engine::automatic:
+			case AES_engine::software:
+				return &software_engine;
+			case AES_engine::T_table:
+				return &T_table_engine;
+			default:
+				break;
+			}
+			return nullptr;
+		}
+#endif
+
+		//	Note: Constant initialized, so that it is usable from other static initializers,
+		//	the automatic choice is resolved on first use. The tables are constant, relaxed ordering is enough.
+		static std::atomic<const AES_Dispatch*> active_engine{nullptr};
+
+		static inline const AES_Dispatch& current_engine()
+		{
+			const AES_Dispatch* engine = active_engine.load(std::memory_order_relaxed);
+			if(engine == nullptr) [[unlikely]]
+			{
+				const AES_Dispatch* const selected = select_engine(AES_engine::automatic);
+				if(active_engine.compare_exchange_strong(engine, selected, std::memory_order_relaxed))
+				{
+					engine = selected;
+				}
+			}
+			return *engine;
+		}
+	} //namespace
+
+	bool AES_set_engine(const AES_engine p_engine)
+	{
+		const AES_Dispatch* const engine = select_engine(p_engine);
+		if(engine)
+		{
+			active_engine.store(engine, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	AES_engine AES_get_engine()
+	{
+		return current_engine().id;
+	}
+
+	namespace _p
+	{
+		namespace
+		{
+			template<typename AES_t>
+			static inline const AES_engine_table<AES_t>& active_table()
+			{
+				if constexpr(std::is_same_v<AES_t, AES_128>)
+				{
+					return current_engine().aes_128;
+				}
+				else if constexpr(std::is_same_v<AES_t, AES_192>)
+				{
+					return current_engine().aes_192;
+				}
+				else
+				{
+					static_assert(std::is_same_v<AES_t, AES_256>);
+					return current_engine().aes_256;
+				}
+			}
+		} //namespace
+
+		bool AES_NI_active()
+		{
+			const AES_engine engine = current_engine().id;
+			return engine == AES_engine::AES_NI || engine == AES_engine::VAES_AVX2 || engine == AES_engine::VAES_AVX512;
+		}
+
+		template<typename AES_t>
+		void AES_ctr_xor(const typename AES_t::key_schedule_t& p_wkey, AES_counter_t& p_counter, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			active_table<AES_t>().ctr_xor(p_wkey, p_counter, p_input, p_out, p_count);
+		}
+
+		template<typename AES_t>
+		void AES_cbc_encode(const typename AES_t::key_schedule_t& p_wkey, uint8_t* p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			active_table<AES_t>().cbc_encode(p_wkey, p_iv, p_input, p_out, p_count);
+		}
+
+		template<typename AES_t>
+		void AES_cfb_encode(const typename AES_t::key_schedule_t& p_wkey, uint8_t* p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			active_table<AES_t>().cfb_encode(p_wkey, p_iv, p_input, p_out, p_count);
+		}
+
+		//	Note: The cipher text goes through a small scratch buffer, the chain is serial anyway.
+		template<typename AES_t>
+		void AES_cbc_mac(const typename AES_t::key_schedule_t& p_wkey, uint8_t* p_iv, const uint8_t* p_input, uintptr_t p_count)
+		{
+			constexpr uintptr_t scratch_blocks = 8;
+			alignas(16) std::array<uint8_t, scratch_blocks * 16> scratch;
+
+			const AES_engine_table<AES_t>& table = active_table<AES_t>();
+			while(p_count)
+			{
+				const uintptr_t count = p_count < scratch_blocks ? p_count : scratch_blocks;
+				table.cbc_encode(p_wkey, p_iv, p_input, scratch.data(), count);
+				p_input += count * 16;
+				p_count -= count;
+			}
+		}
+
+		template<typename AES_t>
+		void AES_cbc_decode(const typename AES_t::dec_key_schedule_t& p_dkey, uint8_t* p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			active_table<AES_t>().cbc_decode(p_dkey, p_iv, p_input, p_out, p_count);
+		}
+
+		template<typename AES_t>
+		void AES_xts_encode(const typename AES_t::key_schedule_t& p_wkey, uint8_t* p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			active_table<AES_t>().xts_encode(p_wkey, p_tweak, p_input, p_out, p_count);
+		}
+
+		template<typename AES_t>
+		void AES_xts_decode(const typename AES_t::dec_key_schedule_t& p_dkey, uint8_t* p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+			active_table<AES_t>().xts_decode(p_dkey, p_tweak, p_input, p_out, p_count);
+		}
+
+		template void AES_ctr_xor<AES_128>(const AES_128::key_schedule_t&, AES_counter_t&, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_ctr_xor<AES_192>(const AES_192::key_schedule_t&, AES_counter_t&, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_ctr_xor<AES_256>(const AES_256::key_schedule_t&, AES_counter_t&, const uint8_t*, uint8_t*, uintptr_t);
+
+		template void AES_cbc_encode<AES_128>(const AES_128::key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_cbc_encode<AES_192>(const AES_192::key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_cbc_encode<AES_256>(const AES_256::key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+
+		template void AES_cfb_encode<AES_128>(const AES_128::key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_cfb_encode<AES_192>(const AES_192::key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_cfb_encode<AES_256>(const AES_256::key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+
+		template void AES_cbc_mac<AES_128>(const AES_128::key_schedule_t&, uint8_t*, const uint8_t*, uintptr_t);
+		template void AES_cbc_mac<AES_192>(const AES_192::key_schedule_t&, uint8_t*, const uint8_t*, uintptr_t);
+		template void AES_cbc_mac<AES_256>(const AES_256::key_schedule_t&, uint8_t*, const uint8_t*, uintptr_t);
+
+		template void AES_cbc_decode<AES_128>(const AES_128::dec_key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_cbc_decode<AES_192>(const AES_192::dec_key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_cbc_decode<AES_256>(const AES_256::dec_key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+
+		template void AES_xts_encode<AES_128>(const AES_128::key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_xts_encode<AES_192>(const AES_192::key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_xts_encode<AES_256>(const AES_256::key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+
+		template void AES_xts_decode<AES_128>(const AES_128::dec_key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_xts_decode<AES_192>(const AES_192::dec_key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+		template void AES_xts_decode<AES_256>(const AES_256::dec_key_schedule_t&, uint8_t*, const uint8_t*, uint8_t*, uintptr_t);
+	} //namespace _p
+
+	void AES_128::make_key_schedule(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_wkey)
+	{
+		current_engine().aes_128.make_key(p_key.data(), p_wkey);
+	}
+
+	void AES_128::make_key_schedules(std::span<const uint8_t> p_keys, std::span<key_schedule_t> p_wkey)
+	{
+		current_engine().aes_128.make_keys(p_keys.data(), p_wkey.data(), p_keys.size() / key_lenght);
+	}
+
+	void AES_128::encode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_128.encode(p_wkey, p_input, p_out);
+	}
+
+
+	void AES_128::decode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_128.decode(p_wkey, p_input, p_out);
+	}
+
+	void AES_128::encode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_128.encode_blocks(p_wkey, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_128::decode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_128.decode_blocks(p_wkey, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_128::make_dec_key_schedule(const key_schedule_t& p_wkey, dec_key_schedule_t& p_dkey)
+	{
+		current_engine().aes_128.make_dec_key(p_wkey, p_dkey);
+	}
+
+	void AES_128::decode(const dec_key_schedule_t& p_dkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_128.dec_decode(p_dkey, p_input, p_out);
+	}
+
+	void AES_128::decode_blocks(const dec_key_schedule_t& p_dkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_128.dec_decode_blocks(p_dkey, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_128::make_key(std::span<const uint8_t, key_lenght> p_key, key_t& p_out)
+	{
+		current_engine().aes_128.make_key(p_key.data(), p_out.enc);
+		current_engine().aes_128.make_dec_key(p_out.enc, p_out.dec);
+	}
+
+	void AES_128::encode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_128.encode(p_key.enc, p_input, p_out);
+	}
+
+	void AES_128::decode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_128.dec_decode(p_key.dec, p_input, p_out);
+	}
+
+	void AES_128::encode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_128.encode_blocks(p_key.enc, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_128::decode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_128.dec_decode_blocks(p_key.dec, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+
+	void AES_192::make_key_schedule(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_wkey)
+	{
+		current_engine().aes_192.make_key(p_key.data(), p_wkey);
+	}
+
+	void AES_192::make_key_schedules(std::span<const uint8_t> p_keys, std::span<key_schedule_t> p_wkey)
+	{
+		current_engine().aes_192.make_keys(p_keys.data(), p_wkey.data(), p_keys.size() / key_lenght);
+	}
+
+	void AES_192::encode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_192.encode(p_wkey, p_input, p_out);
+	}
+
+	void AES_192::decode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_192.decode(p_wkey, p_input, p_out);
+	}
+
+	void AES_192::encode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_192.encode_blocks(p_wkey, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_192::decode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_192.decode_blocks(p_wkey, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_192::make_dec_key_schedule(const key_schedule_t& p_wkey, dec_key_schedule_t& p_dkey)
+	{
+		current_engine().aes_192.make_dec_key(p_wkey, p_dkey);
+	}
+
+	void AES_192::decode(const dec_key_schedule_t& p_dkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_192.dec_decode(p_dkey, p_input, p_out);
+	}
+
+	void AES_192::decode_blocks(const dec_key_schedule_t& p_dkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_192.dec_decode_blocks(p_dkey, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_192::make_key(std::span<const uint8_t, key_lenght> p_key, key_t& p_out)
+	{
+		current_engine().aes_192.make_key(p_key.data(), p_out.enc);
+		current_engine().aes_192.make_dec_key(p_out.enc, p_out.dec);
+	}
+
+	void AES_192::encode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_192.encode(p_key.enc, p_input, p_out);
+	}
+
+	void AES_192::decode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_192.dec_decode(p_key.dec, p_input, p_out);
+	}
+
+	void AES_192::encode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_192.encode_blocks(p_key.enc, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_192::decode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_192.dec_decode_blocks(p_key.dec, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_256::make_key_schedule(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_wkey)
+	{
+		current_engine().aes_256.make_key(p_key.data(), p_wkey);
+	}
+
+	void AES_256::make_key_schedules(std::span<const uint8_t> p_keys, std::span<key_schedule_t> p_wkey)
+	{
+		current_engine().aes_256.make_keys(p_keys.data(), p_wkey.data(), p_keys.size() / key_lenght);
+	}
+
+	void AES_256::encode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_256.encode(p_wkey, p_input, p_out);
+	}
+
+	void AES_256::decode(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_256.decode(p_wkey, p_input, p_out);
+	}
+
+	void AES_256::encode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_256.encode_blocks(p_wkey, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_256::decode_blocks(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_256.decode_blocks(p_wkey, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_256::make_dec_key_schedule(const key_schedule_t& p_wkey, dec_key_schedule_t& p_dkey)
+	{
+		current_engine().aes_256.make_dec_key(p_wkey, p_dkey);
+	}
+
+	void AES_256::decode(const dec_key_schedule_t& p_dkey, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_256.dec_decode(p_dkey, p_input, p_out);
+	}
+
+	void AES_256::decode_blocks(const dec_key_schedule_t& p_dkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_256.dec_decode_blocks(p_dkey, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_256::make_key(std::span<const uint8_t, key_lenght> p_key, key_t& p_out)
+	{
+		current_engine().aes_256.make_key(p_key.data(), p_out.enc);
+		current_engine().aes_256.make_dec_key(p_out.enc, p_out.dec);
+	}
+
+	void AES_256::encode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_256.encode(p_key.enc, p_input, p_out);
+	}
+
+	void AES_256::decode(const key_t& p_key, std::span<const uint8_t, block_lenght> p_input, std::span<uint8_t, block_lenght> p_out)
+	{
+		current_engine().aes_256.dec_decode(p_key.dec, p_input, p_out);
+	}
+
+	void AES_256::encode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		current_engine().aes_256.encode_blocks(p_key.enc, p_input.data(), p_out.data(), p_input.size() / block_lenght);
+	}
+
+	void AES_256::decode_blocks(const key_t& p_key, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
 	{
-		AES_Help::decode<AES_256>(p_wkey, p_input, p_out);
+		current_engine().aes_256.dec_decode_blocks(p_key.dec, p_input.data(), p_out.data(), p_input.size() / block_lenght);
 	}
 
 
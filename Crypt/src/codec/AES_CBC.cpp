@@ -0,0 +1,178 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/AES_CBC.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include "AES_engine.hpp"
+
+namespace crypto
+{
+	template<typename AES_t>
+	void AES_CBC<AES_t>::reset(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_iv)
+	{
+		m_key.enc = p_wkey;
+		AES_t::make_dec_key_schedule(p_wkey, m_key.dec);
+		memcpy(m_iv.data(), p_iv.data(), block_lenght);
+	}
+
+	template<typename AES_t>
+	void AES_CBC<AES_t>::reset(const key_t& p_key, std::span<const uint8_t, block_lenght> p_iv)
+	{
+		m_key = p_key;
+		memcpy(m_iv.data(), p_iv.data(), block_lenght);
+	}
+
+	template<typename AES_t>
+	template<bool Encode>
+	void AES_CBC<AES_t>::process_blocks(const uint8_t* const p_input, uint8_t* const p_out, const uintptr_t p_count)
+	{
+		if constexpr(Encode)
+		{
+			_p::AES_cbc_encode<AES_t>(m_key.enc, m_iv.data(), p_input, p_out, p_count);
+		}
+		else
+		{
+			_p::AES_cbc_decode<AES_t>(m_key.dec, m_iv.data(), p_input, p_out, p_count);
+		}
+	}
+
+	//	Note: A block that straddles buffers is gathered into a staging block, processed, and scattered back.
+	//	Everything else is processed where it is.
+	template<typename AES_t>
+	template<bool Encode>
+	uintptr_t AES_CBC<AES_t>::process_buffers(std::span<const std::span<uint8_t>> p_buffers)
+	{
+		alignas(16) std::array<uint8_t, block_lenght> staged;
+		std::array<std::span<uint8_t>, block_lenght> parts;
+		uintptr_t staged_size	= 0;
+		uintptr_t part_count	= 0;
+		uintptr_t processed		= 0;
+
+		for(const std::span<uint8_t>& tbuffer : p_buffers)
+		{
+			uint8_t*	pivot	= tbuffer.data();
+			uintptr_t	size	= tbuffer.size();
+			if(size == 0)
+			{
+				continue;
+			}
+
+			if(staged_size)
+			{
+				const uintptr_t count = std::min<uintptr_t>(block_lenght - staged_size, size);
+				memcpy(staged.data() + staged_size, pivot, count);
+				parts[part_count++] = std::span<uint8_t>{pivot, count};
+				staged_size	+= count;
+				pivot		+= count;
+				size		-= count;
+
+				if(staged_size < block_lenght)
+				{
+					continue;
+				}
+
+				process_blocks<Encode>(staged.data(), staged.data(), 1);
+				uintptr_t offset = 0;
+				for(uintptr_t i = 0; i < part_count; ++i)
+				{
+					memcpy(parts[i].data(), staged.data() + offset, parts[i].size());
+					offset += parts[i].size();
+				}
+				staged_size	= 0;
+				part_count	= 0;
+				processed	+= block_lenght;
+			}
+
+			const uintptr_t block_count = size / block_lenght;
+			process_blocks<Encode>(pivot, pivot, block_count);
+			pivot		+= block_count * block_lenght;
+			size		-= block_count * block_lenght;
+			processed	+= block_count * block_lenght;
+
+			if(size)
+			{
+				memcpy(staged.data(), pivot, size);
+				parts[0]	= std::span<uint8_t>{pivot, size};
+				part_count	= 1;
+				staged_size	= size;
+			}
+		}
+		return processed;
+	}
+
+	template<typename AES_t>
+	uintptr_t AES_CBC<AES_t>::encode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		const uintptr_t block_count = p_input.size() / block_lenght;
+		process_blocks<true>(p_input.data(), p_out.data(), block_count);
+		return block_count * block_lenght;
+	}
+
+	template<typename AES_t>
+	uintptr_t AES_CBC<AES_t>::decode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		const uintptr_t block_count = p_input.size() / block_lenght;
+		process_blocks<false>(p_input.data(), p_out.data(), block_count);
+		return block_count * block_lenght;
+	}
+
+	template<typename AES_t>
+	uintptr_t AES_CBC<AES_t>::encode(std::span<uint8_t> p_data)
+	{
+		const uintptr_t block_count = p_data.size() / block_lenght;
+		process_blocks<true>(p_data.data(), p_data.data(), block_count);
+		return block_count * block_lenght;
+	}
+
+	template<typename AES_t>
+	uintptr_t AES_CBC<AES_t>::decode(std::span<uint8_t> p_data)
+	{
+		const uintptr_t block_count = p_data.size() / block_lenght;
+		process_blocks<false>(p_data.data(), p_data.data(), block_count);
+		return block_count * block_lenght;
+	}
+
+	template<typename AES_t>
+	uintptr_t AES_CBC<AES_t>::encode(std::span<const std::span<uint8_t>> p_buffers)
+	{
+		return process_buffers<true>(p_buffers);
+	}
+
+	template<typename AES_t>
+	uintptr_t AES_CBC<AES_t>::decode(std::span<const std::span<uint8_t>> p_buffers)
+	{
+		return process_buffers<false>(p_buffers);
+	}
+
+	template class AES_CBC<AES_128>;
+	template class AES_CBC<AES_192>;
+	template class AES_CBC<AES_256>;
+
+} //namespace crypto
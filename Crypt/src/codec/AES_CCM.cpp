@@ -0,0 +1,441 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/AES_CCM.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <CoreLib/core_endian.hpp>
+
+#include "isa_target.hpp"
+#include "block_help.hpp"
+#include "AES_engine.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		//	Note: Number of blocks that go through the counter and the MAC passes back to back
+		//	when there is no fused kernel, small enough to stay in L1.
+		static constexpr uintptr_t chunk_blocks = 8;
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		//	Note: Fused AES-NI kernel. The CBC-MAC chain is serial while the counter blocks are independent,
+		//	so the key stream goes through the rounds together with the MAC and is computed in the shadow of its latency.
+		//	Every block is loaded once and used by both.
+		struct AES_CCM_NI_Help
+		{
+			ISA_TARGET("aes")
+			static inline __m128i ctr_block(const uint64_t p_hi, const uint64_t p_lo)
+			{
+				return _mm_set_epi64x(static_cast<int64_t>(core::endian_host2big(p_lo)), static_cast<int64_t>(core::endian_host2big(p_hi)));
+			}
+
+			template<typename AES_t, bool Encode>
+			ISA_TARGET("aes")
+			static void crypt(const typename AES_t::key_schedule_t& p_wkey, uint8_t* const p_mac, std::array<uint64_t, 2>& p_counter, const uint8_t* p_input, uint8_t* p_out, const uintptr_t p_count)
+			{
+				constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+
+				std::array<__m128i, number_of_rounds + 1> round_key;
+				for(uintptr_t i = 0; i <= number_of_rounds; ++i)
+				{
+					round_key[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + i);
+				}
+
+				__m128i mac = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_mac));
+				uint64_t counter_hi = p_counter[0];
+				uint64_t counter_lo = p_counter[1];
+
+				if constexpr(Encode)
+				{
+					for(uintptr_t i = 0; i < p_count; ++i, p_input += 16, p_out += 16)
+					{
+						const __m128i plain = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input));
+						__m128i tmac = _mm_xor_si128(_mm_xor_si128(mac, plain), round_key[0]);
+						__m128i tctr = _mm_xor_si128(ctr_block(counter_hi, counter_lo), round_key[0]);
+						counter_hi += (++counter_lo == 0);
+
+						for(uintptr_t r = 1; r < number_of_rounds; ++r)
+						{
+							tmac = _mm_aesenc_si128(tmac, round_key[r]);
+							tctr = _mm_aesenc_si128(tctr, round_key[r]);
+						}
+						mac = _mm_aesenclast_si128(tmac, round_key[number_of_rounds]);
+						tctr = _mm_aesenclast_si128(tctr, round_key[number_of_rounds]);
+
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out), _mm_xor_si128(plain, tctr));
+					}
+				}
+				else
+				{
+					//	Note: The plain text of a block is only known after its key stream,
+					//	so the key stream of the next block is computed together with the MAC of the current one.
+					//	The key stream computed on the last iteration is not used.
+					if(p_count == 0)
+					{
+						return;
+					}
+
+					__m128i key_stream = _mm_xor_si128(ctr_block(counter_hi, counter_lo), round_key[0]);
+					for(uintptr_t r = 1; r < number_of_rounds; ++r)
+					{
+						key_stream = _mm_aesenc_si128(key_stream, round_key[r]);
+					}
+					key_stream = _mm_aesenclast_si128(key_stream, round_key[number_of_rounds]);
+
+					for(uintptr_t i = 0; i < p_count; ++i, p_input += 16, p_out += 16)
+					{
+						counter_hi += (++counter_lo == 0);
+
+						const __m128i plain = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input)), key_stream);
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out), plain);
+
+						__m128i tmac = _mm_xor_si128(_mm_xor_si128(mac, plain), round_key[0]);
+						__m128i tctr = _mm_xor_si128(ctr_block(counter_hi, counter_lo), round_key[0]);
+
+						for(uintptr_t r = 1; r < number_of_rounds; ++r)
+						{
+							tmac = _mm_aesenc_si128(tmac, round_key[r]);
+							tctr = _mm_aesenc_si128(tctr, round_key[r]);
+						}
+						mac = _mm_aesenclast_si128(tmac, round_key[number_of_rounds]);
+						key_stream = _mm_aesenclast_si128(tctr, round_key[number_of_rounds]);
+					}
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_mac), mac);
+				p_counter[0] = counter_hi;
+				p_counter[1] = counter_lo;
+			}
+		};
+#endif
+	} //namespace
+
+	template<typename AES_t>
+	void AES_CCM<AES_t>::set_key(const key_schedule_t& p_wkey)
+	{
+		m_wkey = p_wkey;
+	}
+
+	template<typename AES_t>
+	bool AES_CCM<AES_t>::reset(std::span<const uint8_t> p_nonce, const uint64_t p_aad_size, const uint64_t p_data_size, const uintptr_t p_tag_size)
+	{
+		const uintptr_t nonce_size = p_nonce.size();
+		if(nonce_size < 7 || nonce_size > 13 || p_tag_size < 4 || p_tag_size > max_tag_lenght || (p_tag_size & 1))
+		{
+			return false;
+		}
+
+		//	Note: L, the size of the length field and of the block counter
+		const uintptr_t length_size = 15 - nonce_size;
+		if(length_size < 8 && (p_data_size >> (length_size * 8)))
+		{
+			return false;
+		}
+
+		alignas(16) std::array<uint8_t, block_lenght> block;
+
+		//	B0 = flags || nonce || payload size
+		block[0] = static_cast<uint8_t>((p_aad_size ? 0x40 : 0) | (((p_tag_size - 2) / 2) << 3) | (length_size - 1));
+		memcpy(block.data() + 1, p_nonce.data(), nonce_size);
+		for(uintptr_t i = 0; i < length_size; ++i)
+		{
+			block[15 - i] = static_cast<uint8_t>(i < 8 ? p_data_size >> (i * 8) : 0);
+		}
+		AES_t::encode(m_wkey, block, m_mac);
+
+		//	A0 = flags || nonce || 0, the payload starts at counter 1
+		block[0] = static_cast<uint8_t>(length_size - 1);
+		memset(block.data() + 1 + nonce_size, 0, length_size);
+		AES_t::encode(m_wkey, block, m_mask);
+
+		memcpy(m_counter.data(), block.data(), block_lenght);
+		m_counter[0] = core::endian_big2host(m_counter[0]);
+		m_counter[1] = core::endian_big2host(m_counter[1]) + 1;
+
+		//	The additional data is prefixed by its encoded size
+		m_pending_size = 0;
+		if(p_aad_size)
+		{
+			if(p_aad_size < 0xFF00)
+			{
+				m_pending[0] = static_cast<uint8_t>(p_aad_size >> 8);
+				m_pending[1] = static_cast<uint8_t>(p_aad_size);
+				m_pending_size = 2;
+			}
+			else if(p_aad_size <= 0xFFFFFFFF)
+			{
+				const uint32_t size = core::endian_host2big(static_cast<uint32_t>(p_aad_size));
+				m_pending[0] = 0xFF;
+				m_pending[1] = 0xFE;
+				memcpy(m_pending.data() + 2, &size, 4);
+				m_pending_size = 6;
+			}
+			else
+			{
+				const uint64_t size = core::endian_host2big(p_aad_size);
+				m_pending[0] = 0xFF;
+				m_pending[1] = 0xFF;
+				memcpy(m_pending.data() + 2, &size, 8);
+				m_pending_size = 10;
+			}
+		}
+
+		m_aad_size	= p_aad_size;
+		m_data_size	= p_data_size;
+		m_aad_left	= p_aad_size;
+		m_data_left	= p_data_size;
+		m_tag_size	= static_cast<uint8_t>(p_tag_size);
+		return true;
+	}
+
+	template<typename AES_t>
+	void AES_CCM<AES_t>::mac_update(const uint8_t* p_data, uintptr_t p_size)
+	{
+		if(m_pending_size)
+		{
+			const uintptr_t count = std::min<uintptr_t>(block_lenght - m_pending_size, p_size);
+			memcpy(m_pending.data() + m_pending_size, p_data, count);
+			m_pending_size = static_cast<uint8_t>(m_pending_size + count);
+			p_data += count;
+			p_size -= count;
+
+			if(m_pending_size < block_lenght)
+			{
+				return;
+			}
+			_p::AES_cbc_mac<AES_t>(m_wkey, m_mac.data(), m_pending.data(), 1);
+			m_pending_size = 0;
+		}
+
+		const uintptr_t block_count = p_size / block_lenght;
+		_p::AES_cbc_mac<AES_t>(m_wkey, m_mac.data(), p_data, block_count);
+		p_data += block_count * block_lenght;
+		p_size -= block_count * block_lenght;
+
+		memcpy(m_pending.data(), p_data, p_size);
+		m_pending_size = static_cast<uint8_t>(p_size);
+	}
+
+	//	Note: Zero pads and authenticates the partial block, if any.
+	template<typename AES_t>
+	void AES_CCM<AES_t>::mac_pending()
+	{
+		if(m_pending_size)
+		{
+			memset(m_pending.data() + m_pending_size, 0, block_lenght - m_pending_size);
+			_p::AES_cbc_mac<AES_t>(m_wkey, m_mac.data(), m_pending.data(), 1);
+			m_pending_size = 0;
+		}
+	}
+
+	template<typename AES_t>
+	bool AES_CCM<AES_t>::update_aad(std::span<const uint8_t> p_data)
+	{
+		if(m_data_left != m_data_size || p_data.size() > m_aad_left)
+		{
+			return false;
+		}
+
+		m_aad_left -= p_data.size();
+		mac_update(p_data.data(), p_data.size());
+		return true;
+	}
+
+	template<typename AES_t>
+	void AES_CCM<AES_t>::process_blocks(const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count, const bool p_encode)
+	{
+#if defined(_M_AMD64) || defined(__amd64__)
+		if(_p::AES_NI_active())
+		{
+			if(p_encode)
+			{
+				AES_CCM_NI_Help::crypt<AES_t, true>(m_wkey, m_mac.data(), m_counter, p_input, p_out, p_count);
+			}
+			else
+			{
+				AES_CCM_NI_Help::crypt<AES_t, false>(m_wkey, m_mac.data(), m_counter, p_input, p_out, p_count);
+			}
+			return;
+		}
+#endif
+
+		while(p_count)
+		{
+			const uintptr_t count = std::min(p_count, chunk_blocks);
+			if(p_encode)
+			{
+				_p::AES_cbc_mac<AES_t>(m_wkey, m_mac.data(), p_input, count);
+				_p::AES_ctr_xor<AES_t>(m_wkey, m_counter, p_input, p_out, count);
+			}
+			else
+			{
+				_p::AES_ctr_xor<AES_t>(m_wkey, m_counter, p_input, p_out, count);
+				_p::AES_cbc_mac<AES_t>(m_wkey, m_mac.data(), p_out, count);
+			}
+			p_input	+= count * block_lenght;
+			p_out	+= count * block_lenght;
+			p_count	-= count;
+		}
+	}
+
+	//	Note: m_pending holds the plain text of the current partial block and m_cached its key stream.
+	template<typename AES_t>
+	bool AES_CCM<AES_t>::process(const uint8_t* p_input, uint8_t* p_out, uintptr_t p_size, const bool p_encode)
+	{
+		if(p_size > m_data_left || m_aad_left)
+		{
+			return false;
+		}
+		if(p_size == 0)
+		{
+			return true;
+		}
+
+		if(m_data_left == m_data_size)
+		{
+			mac_pending();
+		}
+		m_data_left -= p_size;
+
+		if(m_pending_size)
+		{
+			const uintptr_t offset	= m_pending_size;
+			const uintptr_t count	= std::min<uintptr_t>(block_lenght - offset, p_size);
+			if(p_encode)
+			{
+				memcpy(m_pending.data() + offset, p_input, count);
+				xor_bytes(p_out, p_input, m_cached.data() + offset, count);
+			}
+			else
+			{
+				xor_bytes(p_out, p_input, m_cached.data() + offset, count);
+				memcpy(m_pending.data() + offset, p_out, count);
+			}
+			m_pending_size = static_cast<uint8_t>(offset + count);
+			p_input	+= count;
+			p_out	+= count;
+			p_size	-= count;
+
+			if(m_pending_size < block_lenght)
+			{
+				return true;
+			}
+			_p::AES_cbc_mac<AES_t>(m_wkey, m_mac.data(), m_pending.data(), 1);
+			m_pending_size = 0;
+		}
+
+		const uintptr_t block_count = p_size / block_lenght;
+		process_blocks(p_input, p_out, block_count, p_encode);
+		p_input	+= block_count * block_lenght;
+		p_out	+= block_count * block_lenght;
+		p_size	-= block_count * block_lenght;
+
+		if(p_size)
+		{
+			const uint64_t counter_hi = core::endian_host2big(m_counter[0]);
+			const uint64_t counter_lo = core::endian_host2big(m_counter[1]);
+			memcpy(m_cached.data(), &counter_hi, 8);
+			memcpy(m_cached.data() + 8, &counter_lo, 8);
+			AES_t::encode(m_wkey, m_cached, m_cached);
+			m_counter[0] += (++m_counter[1] == 0);
+
+			if(p_encode)
+			{
+				memcpy(m_pending.data(), p_input, p_size);
+				xor_bytes(p_out, p_input, m_cached.data(), p_size);
+			}
+			else
+			{
+				xor_bytes(p_out, p_input, m_cached.data(), p_size);
+				memcpy(m_pending.data(), p_out, p_size);
+			}
+			m_pending_size = static_cast<uint8_t>(p_size);
+		}
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_CCM<AES_t>::encode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		return process(p_input.data(), p_out.data(), p_input.size(), true);
+	}
+
+	template<typename AES_t>
+	bool AES_CCM<AES_t>::decode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		return process(p_input.data(), p_out.data(), p_input.size(), false);
+	}
+
+	template<typename AES_t>
+	bool AES_CCM<AES_t>::encode(std::span<uint8_t> p_data)
+	{
+		return process(p_data.data(), p_data.data(), p_data.size(), true);
+	}
+
+	template<typename AES_t>
+	bool AES_CCM<AES_t>::decode(std::span<uint8_t> p_data)
+	{
+		return process(p_data.data(), p_data.data(), p_data.size(), false);
+	}
+
+	template<typename AES_t>
+	bool AES_CCM<AES_t>::finalize()
+	{
+		if(m_aad_left || m_data_left)
+		{
+			return false;
+		}
+
+		mac_pending();
+		xor_bytes(m_tag.data(), m_mac.data(), m_mask.data(), max_tag_lenght);
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_CCM<AES_t>::verify(std::span<const uint8_t> p_tag) const
+	{
+		if(p_tag.size() != m_tag_size)
+		{
+			return false;
+		}
+
+		uint8_t diff = 0;
+		for(uintptr_t i = 0; i < p_tag.size(); ++i)
+		{
+			diff |= static_cast<uint8_t>(m_tag[i] ^ p_tag[i]);
+		}
+		return diff == 0;
+	}
+
+	template class AES_CCM<AES_128>;
+	template class AES_CCM<AES_192>;
+	template class AES_CCM<AES_256>;
+
+} //namespace crypto
@@ -0,0 +1,181 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+
+#include <Crypt/codec/AES_CFB.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include "block_help.hpp"
+#include "AES_engine.hpp"
+
+namespace crypto
+{
+	template<typename AES_t>
+	void AES_CFB<AES_t>::reset(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_iv)
+	{
+		m_wkey = p_wkey;
+		memcpy(m_register.data(), p_iv.data(), block_lenght);
+		m_used = 0;
+	}
+
+	//	Note: Key stream block 0 comes from the previous cipher text block, the rest from the cipher text of this chunk.
+	//	The last cipher text block is saved before p_out is written, so that p_out can be the same as p_input.
+	template<typename AES_t>
+	void AES_CFB<AES_t>::decode_blocks(const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+	{
+		constexpr uintptr_t chunk_blocks = 64;
+		alignas(16) std::array<uint8_t, chunk_blocks * block_lenght> key_stream;
+
+		while(p_count)
+		{
+			const uintptr_t block_count	= std::min(p_count, chunk_blocks);
+			const uintptr_t chunk_size	= block_count * block_lenght;
+
+			AES_t::encode(m_wkey, m_register, std::span<uint8_t, block_lenght>{key_stream.data(), block_lenght});
+			AES_t::encode_blocks(m_wkey, std::span<const uint8_t>{p_input, chunk_size - block_lenght},
+				std::span<uint8_t>{key_stream.data() + block_lenght, chunk_size - block_lenght});
+
+			memcpy(m_register.data(), p_input + chunk_size - block_lenght, block_lenght);
+			xor_bytes(p_out, p_input, key_stream.data(), chunk_size);
+
+			p_input	+= chunk_size;
+			p_out	+= chunk_size;
+			p_count	-= block_count;
+		}
+	}
+
+	template<typename AES_t>
+	void AES_CFB<AES_t>::encode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		const uint8_t*	pivot	= p_input.data();
+		uint8_t*		out		= p_out.data();
+		uintptr_t		size	= p_input.size();
+
+		if(m_used)
+		{
+			const uintptr_t count = std::min<uintptr_t>(block_lenght - m_used, size);
+			for(uintptr_t i = 0; i < count; ++i)
+			{
+				m_register[m_used + i] ^= pivot[i];
+				out[i] = m_register[m_used + i];
+			}
+			m_used = static_cast<uint8_t>((m_used + count) % block_lenght);
+			pivot	+= count;
+			out		+= count;
+			size	-= count;
+		}
+
+		if(size >= block_lenght)
+		{
+			const uintptr_t block_count	= size / block_lenght;
+			const uintptr_t chunk_size	= block_count * block_lenght;
+
+			_p::AES_cfb_encode<AES_t>(m_wkey, m_register.data(), pivot, out, block_count);
+
+			pivot	+= chunk_size;
+			out		+= chunk_size;
+			size	-= chunk_size;
+		}
+
+		if(size)
+		{
+			AES_t::encode(m_wkey, m_register, m_register);
+			for(uintptr_t i = 0; i < size; ++i)
+			{
+				m_register[i] ^= pivot[i];
+				out[i] = m_register[i];
+			}
+			m_used = static_cast<uint8_t>(size);
+		}
+	}
+
+	template<typename AES_t>
+	void AES_CFB<AES_t>::decode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		const uint8_t*	pivot	= p_input.data();
+		uint8_t*		out		= p_out.data();
+		uintptr_t		size	= p_input.size();
+
+		if(m_used)
+		{
+			const uintptr_t count = std::min<uintptr_t>(block_lenght - m_used, size);
+			for(uintptr_t i = 0; i < count; ++i)
+			{
+				const uint8_t cipher = pivot[i];
+				out[i] = static_cast<uint8_t>(m_register[m_used + i] ^ cipher);
+				m_register[m_used + i] = cipher;
+			}
+			m_used = static_cast<uint8_t>((m_used + count) % block_lenght);
+			pivot	+= count;
+			out		+= count;
+			size	-= count;
+		}
+
+		if(size >= block_lenght)
+		{
+			const uintptr_t block_count	= size / block_lenght;
+			const uintptr_t chunk_size	= block_count * block_lenght;
+
+			decode_blocks(pivot, out, block_count);
+
+			pivot	+= chunk_size;
+			out		+= chunk_size;
+			size	-= chunk_size;
+		}
+
+		if(size)
+		{
+			AES_t::encode(m_wkey, m_register, m_register);
+			for(uintptr_t i = 0; i < size; ++i)
+			{
+				const uint8_t cipher = pivot[i];
+				out[i] = static_cast<uint8_t>(m_register[i] ^ cipher);
+				m_register[i] = cipher;
+			}
+			m_used = static_cast<uint8_t>(size);
+		}
+	}
+
+	template<typename AES_t>
+	void AES_CFB<AES_t>::encode(std::span<uint8_t> p_data)
+	{
+		encode(p_data, p_data);
+	}
+
+	template<typename AES_t>
+	void AES_CFB<AES_t>::decode(std::span<uint8_t> p_data)
+	{
+		decode(p_data, p_data);
+	}
+
+	template class AES_CFB<AES_128>;
+	template class AES_CFB<AES_192>;
+	template class AES_CFB<AES_256>;
+} //namespace crypto
@@ -0,0 +1,233 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/AES_CMAC.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <CoreLib/core_endian.hpp>
+
+#include <Crypt/codec/AES_multi_buffer.hpp>
+
+#include "block_help.hpp"
+#include "AES_engine.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		//	Note: Number of jobs set up for the multi-buffer passes at once
+		static constexpr uintptr_t job_stride = 32;
+
+		///	\brief Multiplication by x in GF(2^128), big endian (NIST SP 800-38B)
+		static inline void cmac_double(const uint8_t* const p_input, uint8_t* const p_out)
+		{
+			uint64_t hi;
+			uint64_t lo;
+			memcpy(&hi, p_input, 8);
+			memcpy(&lo, p_input + 8, 8);
+			hi = core::endian_big2host(hi);
+			lo = core::endian_big2host(lo);
+
+			const uint64_t carry = hi >> 63;
+			hi = (hi << 1) | (lo >> 63);
+			lo = (lo << 1) ^ (0x87 & (0 - carry));
+
+			hi = core::endian_host2big(hi);
+			lo = core::endian_host2big(lo);
+			memcpy(p_out, &hi, 8);
+			memcpy(p_out + 8, &lo, 8);
+		}
+
+		///	\brief Last block to be encoded: (M_n ^ K1) if complete, (M_n || 10..0) ^ K2 otherwise, chained with p_chain.
+		template<typename Key_t>
+		static inline void last_block(const Key_t& p_key, const uint8_t* const p_chain, const uint8_t* const p_tail, const uintptr_t p_size, uint8_t* const p_out)
+		{
+			alignas(16) std::array<uint8_t, 16> block;
+			if(p_size == 16)
+			{
+				xor_bytes(block.data(), p_tail, p_key.k1.data(), 16);
+			}
+			else
+			{
+				if(p_size)
+				{
+					memcpy(block.data(), p_tail, p_size);
+				}
+				block[p_size] = 0x80;
+				memset(block.data() + p_size + 1, 0, 15 - p_size);
+				xor_bytes(block.data(), block.data(), p_key.k2.data(), 16);
+			}
+			xor_bytes(p_out, block.data(), p_chain, 16);
+		}
+	} //namespace
+
+	template<typename AES_t>
+	void AES_CMAC<AES_t>::make_key(const key_schedule_t& p_wkey, key_t& p_key)
+	{
+		p_key.wkey = p_wkey;
+
+		alignas(16) std::array<uint8_t, block_lenght> L{0};
+		AES_t::encode(p_wkey, L, L);
+		cmac_double(L.data(), p_key.k1.data());
+		cmac_double(p_key.k1.data(), p_key.k2.data());
+	}
+
+	template<typename AES_t>
+	void AES_CMAC<AES_t>::set_key(const key_schedule_t& p_wkey)
+	{
+		make_key(p_wkey, m_key);
+	}
+
+	template<typename AES_t>
+	void AES_CMAC<AES_t>::set_key(const key_t& p_key)
+	{
+		m_key = p_key;
+	}
+
+	template<typename AES_t>
+	bool AES_CMAC<AES_t>::reset(uintptr_t p_tag_size)
+	{
+		if(p_tag_size < 8 || p_tag_size > tag_lenght)
+		{
+			return false;
+		}
+
+		m_chain.fill(0);
+		m_cached_size = 0;
+		m_tag_size = static_cast<uint8_t>(p_tag_size);
+		return true;
+	}
+
+	//	Note: The last block is treated differently, so the final 1 to 16 bytes are always held back until finalize().
+	template<typename AES_t>
+	void AES_CMAC<AES_t>::update(std::span<const uint8_t> p_data)
+	{
+		const uint8_t*	pivot	= p_data.data();
+		uintptr_t		size	= p_data.size();
+
+		if(size == 0)
+		{
+			return;
+		}
+
+		if(m_cached_size)
+		{
+			const uintptr_t count = std::min<uintptr_t>(block_lenght - m_cached_size, size);
+			memcpy(m_cached.data() + m_cached_size, pivot, count);
+			m_cached_size = static_cast<uint8_t>(m_cached_size + count);
+			pivot	+= count;
+			size	-= count;
+
+			if(size == 0)
+			{
+				return;
+			}
+			_p::AES_cbc_mac<AES_t>(m_key.wkey, m_chain.data(), m_cached.data(), 1);
+			m_cached_size = 0;
+		}
+
+		const uintptr_t block_count = (size - 1) / block_lenght;
+		_p::AES_cbc_mac<AES_t>(m_key.wkey, m_chain.data(), pivot, block_count);
+		pivot	+= block_count * block_lenght;
+		size	-= block_count * block_lenght;
+
+		memcpy(m_cached.data(), pivot, size);
+		m_cached_size = static_cast<uint8_t>(size);
+	}
+
+	template<typename AES_t>
+	void AES_CMAC<AES_t>::finalize()
+	{
+		alignas(16) std::array<uint8_t, block_lenght> block;
+		last_block(m_key, m_chain.data(), m_cached.data(), m_cached_size, block.data());
+		AES_t::encode(m_key.wkey, block, m_tag);
+	}
+
+	template<typename AES_t>
+	bool AES_CMAC<AES_t>::verify(std::span<const uint8_t> p_tag) const
+	{
+		if(p_tag.size() != m_tag_size)
+		{
+			return false;
+		}
+
+		uint8_t diff = 0;
+		for(uintptr_t i = 0; i < m_tag_size; ++i)
+		{
+			diff |= static_cast<uint8_t>(m_tag[i] ^ p_tag[i]);
+		}
+		return diff == 0;
+	}
+
+	//	Note: Two multi-buffer passes, CBC-MAC over all but the last block of every message,
+	//	then the masked last blocks as independent blocks under their own keys.
+	template<typename AES_t>
+	void AES_CMAC<AES_t>::compute(std::span<job_t> p_jobs)
+	{
+		using MB_t = AES_multi_buffer<AES_t>;
+
+		std::array<typename MB_t::job_t, job_stride> mb_jobs;
+		alignas(16) std::array<std::array<uint8_t, block_lenght>, job_stride> last;
+
+		while(!p_jobs.empty())
+		{
+			const uintptr_t count = std::min<uintptr_t>(p_jobs.size(), job_stride);
+
+			for(uintptr_t i = 0; i < count; ++i)
+			{
+				const job_t& tjob = p_jobs[i];
+				const uintptr_t size = tjob.message.size();
+				typename MB_t::job_t& mb_job = mb_jobs[i];
+				mb_job.wkey		= &tjob.key->wkey;
+				mb_job.iv.fill(0);
+				mb_job.input	= tjob.message.first(size ? (size - 1) / block_lenght * block_lenght : 0);
+				mb_job.out		= std::span<uint8_t>{};
+			}
+			MB_t::cbc_mac(std::span<typename MB_t::job_t>{mb_jobs.data(), count});
+
+			for(uintptr_t i = 0; i < count; ++i)
+			{
+				job_t& tjob = p_jobs[i];
+				typename MB_t::job_t& mb_job = mb_jobs[i];
+				const uintptr_t prefix = mb_job.input.size();
+				last_block(*tjob.key, mb_job.iv.data(), tjob.message.data() + prefix, tjob.message.size() - prefix, last[i].data());
+				mb_job.input	= last[i];
+				mb_job.out		= tjob.tag;
+			}
+			MB_t::encode_blocks(std::span<typename MB_t::job_t>{mb_jobs.data(), count});
+
+			p_jobs = p_jobs.subspan(count);
+		}
+	}
+
+	template class AES_CMAC<AES_128>;
+	template class AES_CMAC<AES_192>;
+	template class AES_CMAC<AES_256>;
+
+} //namespace crypto
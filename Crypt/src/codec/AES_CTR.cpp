@@ -0,0 +1,178 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/AES_CTR.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <CoreLib/core_endian.hpp>
+
+#include <Crypt/worker_pool.hpp>
+
+#include "block_help.hpp"
+#include "AES_engine.hpp"
+
+namespace crypto
+{
+	template<typename AES_t>
+	void AES_CTR<AES_t>::reset(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_counter)
+	{
+		m_wkey = p_wkey;
+		memcpy(m_counter.data(), p_counter.data(), block_lenght);
+		m_counter[0] = core::endian_big2host(m_counter[0]);
+		m_counter[1] = core::endian_big2host(m_counter[1]);
+		m_cached_size = 0;
+	}
+
+	template<typename AES_t>
+	void AES_CTR<AES_t>::increment(uint8_t* const p_out)
+	{
+		const uint64_t hi = core::endian_host2big(m_counter[0]);
+		const uint64_t lo = core::endian_host2big(m_counter[1]);
+		memcpy(p_out, &hi, 8);
+		memcpy(p_out + 8, &lo, 8);
+
+		if(++m_counter[1] == 0)
+		{
+			++m_counter[0];
+		}
+	}
+
+	template<typename AES_t>
+	typename AES_CTR<AES_t>::counter_t AES_CTR<AES_t>::counter() const
+	{
+		counter_t out;
+		const uint64_t hi = core::endian_host2big(m_counter[0]);
+		const uint64_t lo = core::endian_host2big(m_counter[1]);
+		memcpy(out.data(), &hi, 8);
+		memcpy(out.data() + 8, &lo, 8);
+		return out;
+	}
+
+	template<typename AES_t>
+	void AES_CTR<AES_t>::update(std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		const uint8_t*	pivot	= p_input.data();
+		uint8_t*		out		= p_out.data();
+		uintptr_t		size	= p_input.size();
+
+		if(m_cached_size)
+		{
+			const uintptr_t count = std::min<uintptr_t>(m_cached_size, size);
+			xor_bytes(out, pivot, m_cached.data() + (block_lenght - m_cached_size), count);
+			m_cached_size = static_cast<uint8_t>(m_cached_size - count);
+			pivot	+= count;
+			out		+= count;
+			size	-= count;
+		}
+
+		if(size >= block_lenght)
+		{
+			const uintptr_t block_count	= size / block_lenght;
+			const uintptr_t chunk_size	= block_count * block_lenght;
+
+			_p::AES_ctr_xor<AES_t>(m_wkey, m_counter, pivot, out, block_count);
+
+			pivot	+= chunk_size;
+			out		+= chunk_size;
+			size	-= chunk_size;
+		}
+
+		if(size)
+		{
+			increment(m_cached.data());
+			AES_t::encode(m_wkey, m_cached, m_cached);
+			xor_bytes(out, pivot, m_cached.data(), size);
+			m_cached_size = static_cast<uint8_t>(block_lenght - size);
+		}
+	}
+
+	template<typename AES_t>
+	void AES_CTR<AES_t>::update(std::span<uint8_t> p_data)
+	{
+		update(p_data, p_data);
+	}
+
+	template<typename AES_t>
+	void AES_CTR<AES_t>::update(std::span<const std::span<uint8_t>> p_buffers)
+	{
+		for(const std::span<uint8_t>& tbuffer : p_buffers)
+		{
+			update(tbuffer, tbuffer);
+		}
+	}
+
+	template<typename AES_t>
+	void AES_CTR<AES_t>::update(worker_pool& p_pool, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		constexpr uintptr_t chunk_blocks = parallel_chunk / block_lenght;
+
+		const uint8_t*	pivot	= p_input.data();
+		uint8_t*		out		= p_out.data();
+		uintptr_t		size	= p_input.size();
+
+		//	Note: Left over key stream is used first, so that the parallel part starts on a fresh counter block.
+		const uintptr_t head = std::min<uintptr_t>(m_cached_size, size);
+		update(std::span<const uint8_t>{pivot, head}, std::span<uint8_t>{out, head});
+		pivot	+= head;
+		out		+= head;
+		size	-= head;
+
+		const uintptr_t block_count = size / block_lenght;
+		const uintptr_t chunk_count = (block_count + chunk_blocks - 1) / chunk_blocks;
+		if(p_pool.size() < 2 || chunk_count < 2)
+		{
+			update(std::span<const uint8_t>{pivot, size}, std::span<uint8_t>{out, size});
+			return;
+		}
+
+		auto task = [&](const uintptr_t p_index)
+			{
+				const uintptr_t first = p_index * chunk_blocks;
+				const uintptr_t count = std::min(chunk_blocks, block_count - first);
+
+				_p::AES_counter_t counter = m_counter;
+				counter[1] += first;
+				counter[0] += counter[1] < first;
+
+				_p::AES_ctr_xor<AES_t>(m_wkey, counter, pivot + first * block_lenght, out + first * block_lenght, count);
+			};
+		p_pool.run(chunk_count, task);
+
+		m_counter[1] += block_count;
+		m_counter[0] += m_counter[1] < block_count;
+
+		const uintptr_t done = block_count * block_lenght;
+		update(std::span<const uint8_t>{pivot + done, size - done}, std::span<uint8_t>{out + done, size - done});
+	}
+
+	template class AES_CTR<AES_128>;
+	template class AES_CTR<AES_192>;
+	template class AES_CTR<AES_256>;
+
+} //namespace crypto
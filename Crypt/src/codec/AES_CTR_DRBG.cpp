@@ -0,0 +1,342 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/AES_CTR_DRBG.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#ifndef _WIN32
+#	include <pthread.h>
+#endif
+
+#include <CoreLib/core_endian.hpp>
+
+#include "block_help.hpp"
+#include "AES_engine.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		//	Note: The key stream is produced by running the counter mode engine over zeros,
+		//	reading them from a constant avoids an extra pass to clear the output first.
+		static constexpr uintptr_t zero_input_size = AES_CTR_DRBG::thread_buffer_size;
+		alignas(64) static constexpr std::array<uint8_t, zero_input_size> zero_input{};
+
+		static void increment(_p::AES_counter_t& p_counter)
+		{
+			if(++p_counter[1] == 0)
+			{
+				++p_counter[0];
+			}
+		}
+
+		static void key_stream(const AES_256::key_schedule_t& p_wkey, _p::AES_counter_t& p_counter, uint8_t* p_out, uintptr_t p_size)
+		{
+			constexpr uintptr_t block_lenght = AES_CTR_DRBG::block_lenght;
+
+			while(p_size >= block_lenght)
+			{
+				const uintptr_t size = std::min(p_size, zero_input_size) & ~(block_lenght - 1);
+				_p::AES_ctr_xor<AES_256>(p_wkey, p_counter, zero_input.data(), p_out, size / block_lenght);
+				p_out  += size;
+				p_size -= size;
+			}
+
+			if(p_size)
+			{
+				alignas(8) std::array<uint8_t, block_lenght> block;
+				_p::AES_ctr_xor<AES_256>(p_wkey, p_counter, zero_input.data(), block.data(), 1);
+				memcpy(p_out, block.data(), p_size);
+				wipe(block.data(), block_lenght);
+			}
+		}
+
+		//	Note: Input shorter than the seed is zero padded, as specified when there is no derivation function.
+		static void pad_seed(std::span<const uint8_t> p_input, std::array<uint8_t, AES_CTR_DRBG::seed_lenght>& p_out)
+		{
+			p_out.fill(0);
+			memcpy(p_out.data(), p_input.data(), p_input.size());
+		}
+	} //namespace
+
+	void AES_CTR_DRBG::update(const uint8_t* const p_provided)
+	{
+		alignas(8) std::array<uint8_t, seed_lenght> temp;
+		_p::AES_ctr_xor<AES_256>(m_wkey, m_counter, p_provided, temp.data(), seed_lenght / block_lenght);
+
+		AES_256::make_key_schedule(std::span<const uint8_t, key_lenght>{temp.data(), key_lenght}, m_wkey);
+
+		memcpy(m_counter.data(), temp.data() + key_lenght, block_lenght);
+		m_counter[0] = core::endian_big2host(m_counter[0]);
+		m_counter[1] = core::endian_big2host(m_counter[1]);
+		increment(m_counter);
+
+		wipe(temp.data(), seed_lenght);
+	}
+
+	bool AES_CTR_DRBG::instantiate(std::span<const uint8_t, seed_lenght> p_entropy, std::span<const uint8_t> p_personalization)
+	{
+		if(p_personalization.size() > seed_lenght)
+		{
+			return false;
+		}
+
+		alignas(8) std::array<uint8_t, seed_lenght> seed;
+		pad_seed(p_personalization, seed);
+		for(uintptr_t i = 0; i < seed_lenght; ++i)
+		{
+			seed[i] ^= p_entropy[i];
+		}
+
+		AES_256::make_key_schedule(std::span<const uint8_t, key_lenght>{zero_input.data(), key_lenght}, m_wkey);
+		m_counter = {0, 1};
+		update(seed.data());
+		m_reseed_counter = 1;
+
+		wipe(seed.data(), seed_lenght);
+		return true;
+	}
+
+	bool AES_CTR_DRBG::reseed(std::span<const uint8_t, seed_lenght> p_entropy, std::span<const uint8_t> p_additional)
+	{
+		if(m_reseed_counter == 0 || p_additional.size() > seed_lenght)
+		{
+			return false;
+		}
+
+		alignas(8) std::array<uint8_t, seed_lenght> seed;
+		pad_seed(p_additional, seed);
+		for(uintptr_t i = 0; i < seed_lenght; ++i)
+		{
+			seed[i] ^= p_entropy[i];
+		}
+
+		update(seed.data());
+		m_reseed_counter = 1;
+
+		wipe(seed.data(), seed_lenght);
+		return true;
+	}
+
+	bool AES_CTR_DRBG::generate(std::span<uint8_t> p_out, std::span<const uint8_t> p_additional)
+	{
+		if(m_reseed_counter == 0 || reseed_required() || p_out.size() > max_request || p_additional.size() > seed_lenght)
+		{
+			return false;
+		}
+
+		alignas(8) std::array<uint8_t, seed_lenght> additional;
+		pad_seed(p_additional, additional);
+		if(!p_additional.empty())
+		{
+			update(additional.data());
+		}
+
+		key_stream(m_wkey, m_counter, p_out.data(), p_out.size());
+
+		update(additional.data());
+		++m_reseed_counter;
+
+		wipe(additional.data(), seed_lenght);
+		return true;
+	}
+
+	bool AES_CTR_DRBG::reseed_required() const
+	{
+		return m_reseed_counter > reseed_interval;
+	}
+
+	void AES_CTR_DRBG::uninstantiate()
+	{
+		wipe(&m_wkey, sizeof(m_wkey));
+		wipe(m_counter.data(), sizeof(m_counter));
+		m_reseed_counter = 0;
+	}
+
+	//======== ======== ======== ======== ======== ======== ======== ========
+	//	Per thread generators
+	//======== ======== ======== ======== ======== ======== ======== ========
+
+	namespace
+	{
+		static std::atomic<AES_CTR_DRBG::entropy_source_t> entropy_source{nullptr};
+
+		//	Note: A child process starts with a copy of the forking thread's generator and would repeat the parent's output.
+		//	Every fork moves to a new generation, a state seeded in an older one is discarded before it is used again.
+		static std::atomic<uint64_t> fork_generation{0};
+
+#ifndef _WIN32
+		static void on_fork_child()
+		{
+			fork_generation.fetch_add(1, std::memory_order_relaxed);
+		}
+#endif
+
+		static void watch_fork()
+		{
+#ifndef _WIN32
+			[[maybe_unused]] static const bool registered = (pthread_atfork(nullptr, nullptr, on_fork_child) == 0);
+#endif
+		}
+
+		//	Note: The buffer is served from the front, bytes are wiped as soon as they are handed out
+		//	so that past output can not be recovered from the state.
+		struct DRBG_thread_state
+		{
+			AES_CTR_DRBG drbg;
+			uint64_t refills = 0;
+			uint64_t generation = 0;
+			uintptr_t available = 0;
+			alignas(64) std::array<uint8_t, AES_CTR_DRBG::thread_buffer_size> buffer;
+
+			~DRBG_thread_state()
+			{
+				drbg.uninstantiate();
+				wipe(buffer.data(), buffer.size());
+			}
+		};
+
+		static thread_local DRBG_thread_state thread_state;
+
+		static bool seed(DRBG_thread_state& p_state)
+		{
+			watch_fork();
+
+			const AES_CTR_DRBG::entropy_source_t source = entropy_source.load(std::memory_order_acquire);
+
+			alignas(8) std::array<uint8_t, AES_CTR_DRBG::seed_lenght> entropy;
+			if(source == nullptr || !source(entropy))
+			{
+				p_state.drbg.uninstantiate();
+				wipe(entropy.data(), entropy.size());
+				return false;
+			}
+
+			if(!p_state.drbg.reseed(entropy))
+			{
+				p_state.drbg.instantiate(entropy);
+			}
+			p_state.refills = 0;
+			p_state.generation = fork_generation.load(std::memory_order_relaxed);
+
+			wipe(entropy.data(), entropy.size());
+			return true;
+		}
+
+		//	Note: The generator is left uninstantiated, it is seeded anew on the next refill.
+		static DRBG_thread_state& current_state()
+		{
+			DRBG_thread_state& state = thread_state;
+			if(state.generation != fork_generation.load(std::memory_order_relaxed))
+			{
+				state.drbg.uninstantiate();
+				wipe(state.buffer.data(), state.buffer.size());
+				state.available = 0;
+				state.refills = 0;
+			}
+			return state;
+		}
+
+		//	Note: p_size must not be larger than AES_CTR_DRBG::max_request.
+		static bool fill(DRBG_thread_state& p_state, uint8_t* const p_out, const uintptr_t p_size)
+		{
+			if(p_state.refills >= AES_CTR_DRBG::thread_reseed_interval && !seed(p_state))
+			{
+				return false;
+			}
+
+			if(!p_state.drbg.generate(std::span<uint8_t>{p_out, p_size}))
+			{
+				if(!seed(p_state) || !p_state.drbg.generate(std::span<uint8_t>{p_out, p_size}))
+				{
+					return false;
+				}
+			}
+			++p_state.refills;
+			return true;
+		}
+	} //namespace
+
+	void AES_CTR_DRBG::set_entropy_source(const entropy_source_t p_source)
+	{
+		entropy_source.store(p_source, std::memory_order_release);
+	}
+
+	bool AES_CTR_DRBG::thread_generate(std::span<uint8_t> p_out)
+	{
+		DRBG_thread_state& state = current_state();
+
+		uint8_t* out = p_out.data();
+		uintptr_t size = p_out.size();
+		while(size)
+		{
+			if(state.available == 0)
+			{
+				//	Note: Large requests bypass the buffer, they are already as wide as the refill.
+				if(size >= thread_buffer_size)
+				{
+					const uintptr_t direct = std::min(size, max_request);
+					if(!fill(state, out, direct))
+					{
+						memset(p_out.data(), 0, p_out.size());
+						return false;
+					}
+					out  += direct;
+					size -= direct;
+					continue;
+				}
+
+				if(!fill(state, state.buffer.data(), thread_buffer_size))
+				{
+					memset(p_out.data(), 0, p_out.size());
+					return false;
+				}
+				state.available = thread_buffer_size;
+			}
+
+			uint8_t* const pivot = state.buffer.data() + (thread_buffer_size - state.available);
+			const uintptr_t count = std::min(size, state.available);
+			memcpy(out, pivot, count);
+			memset(pivot, 0, count);
+			state.available -= count;
+			out  += count;
+			size -= count;
+		}
+		return true;
+	}
+
+	bool AES_CTR_DRBG::thread_reseed()
+	{
+		DRBG_thread_state& state = current_state();
+		wipe(state.buffer.data(), state.buffer.size());
+		state.available = 0;
+		return seed(state);
+	}
+} //namespace crypto
@@ -0,0 +1,823 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/AES_GCM.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <CoreLib/core_endian.hpp>
+
+#include <Crypt/worker_pool.hpp>
+
+#if defined(_M_AMD64) || defined(__amd64__)
+#	include <CoreLib/core_cpu.hpp>
+#endif
+
+#include "isa_target.hpp"
+#include "block_help.hpp"
+#include "AES_engine.hpp"
+#include "GHASH.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		using _p::GHASH;
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		//	Note: Fused AES-NI + carry-less multiplication kernel.
+		//	The hash of a group of blocks has no dependency on the AES rounds of the next group,
+		//	so the out of order core overlaps both and the data is only read and written once.
+		struct AES_GCM_NI_Help
+		{
+			static constexpr uintptr_t lanes = GHASH::aggregate;
+			using lanes_t = std::array<__m128i, lanes>;
+
+			template<uintptr_t... I>
+			ISA_TARGET("aes,ssse3")
+			static inline void lanes_ctr(lanes_t& p_state, __m128i& p_counter, const __m128i p_key, std::index_sequence<I...>)
+			{
+				const __m128i one = _mm_set_epi64x(0, 1);
+				(((p_state[I] = _mm_xor_si128(_p::GHASH_clmul::reverse(p_counter), p_key)), (p_counter = _mm_add_epi64(p_counter, one))), ...);
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("aes")
+			static inline void lanes_enc(lanes_t& p_state, const __m128i p_key, std::index_sequence<I...>)
+			{
+				((p_state[I] = _mm_aesenc_si128(p_state[I], p_key)), ...);
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("aes")
+			static inline void lanes_enclast_xor(lanes_t& p_state, const __m128i p_key, const uint8_t* const p_input, uint8_t* const p_out, std::index_sequence<I...>)
+			{
+				((p_state[I] = _mm_xor_si128(_mm_aesenclast_si128(p_state[I], p_key), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input) + I))), ...);
+				(_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out) + I, p_state[I]), ...);
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("ssse3")
+			static inline void lanes_reverse(lanes_t& p_out, const lanes_t& p_state, std::index_sequence<I...>)
+			{
+				((p_out[I] = _p::GHASH_clmul::reverse(p_state[I])), ...);
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("ssse3")
+			static inline void lanes_load_reverse(lanes_t& p_out, const uint8_t* const p_input, std::index_sequence<I...>)
+			{
+				((p_out[I] = _p::GHASH_clmul::reverse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input) + I))), ...);
+			}
+
+			//	Note: The caller guarantees that the low 32 bits of the counter do not wrap around.
+			template<typename AES_t, bool Encode>
+			ISA_TARGET("aes,pclmul,ssse3")
+			static void crypt(const typename AES_t::key_schedule_t& p_wkey, const GHASH::key_t& p_hash_key,
+				_p::AES_counter_t& p_counter, GHASH::block_t& p_hash,
+				const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+			{
+				constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+
+				std::array<__m128i, number_of_rounds + 1> round_key;
+				for(uintptr_t i = 0; i <= number_of_rounds; ++i)
+				{
+					round_key[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + i);
+				}
+
+				std::array<__m128i, GHASH::aggregate> power;
+				_p::GHASH_clmul::load_key(p_hash_key, power);
+
+				__m128i hash = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_hash.data()));
+				__m128i counter = _mm_set_epi64x(static_cast<int64_t>(p_counter[0]), static_cast<int64_t>(p_counter[1]));
+				const __m128i one = _mm_set_epi64x(0, 1);
+
+				constexpr std::make_index_sequence<lanes> seq;
+
+				lanes_t pending;
+				bool has_pending = false;
+
+				for(; p_count >= lanes; p_count -= lanes, p_input += lanes * 16, p_out += lanes * 16)
+				{
+					lanes_t state;
+					lanes_ctr(state, counter, round_key[0], seq);
+
+					if constexpr(Encode)
+					{
+						if(has_pending)
+						{
+							hash = _p::GHASH_clmul::hash_blocks(hash, pending.data(), lanes, power.data());
+						}
+					}
+					else
+					{
+						lanes_load_reverse(pending, p_input, seq);
+						hash = _p::GHASH_clmul::hash_blocks(hash, pending.data(), lanes, power.data());
+					}
+
+					for(uintptr_t r = 1; r < number_of_rounds; ++r)
+					{
+						lanes_enc(state, round_key[r], seq);
+					}
+					lanes_enclast_xor(state, round_key[number_of_rounds], p_input, p_out, seq);
+
+					if constexpr(Encode)
+					{
+						lanes_reverse(pending, state, seq);
+					}
+					has_pending = true;
+				}
+
+				if constexpr(Encode)
+				{
+					if(has_pending)
+					{
+						hash = _p::GHASH_clmul::hash_blocks(hash, pending.data(), lanes, power.data());
+					}
+				}
+				else
+				{
+					_p::GHASH_clmul::update(power, hash, p_input, p_count);
+				}
+
+				for(uintptr_t j = 0; j < p_count; ++j)
+				{
+					__m128i state = _mm_xor_si128(_p::GHASH_clmul::reverse(counter), round_key[0]);
+					counter = _mm_add_epi64(counter, one);
+					for(uintptr_t r = 1; r < number_of_rounds; ++r)
+					{
+						state = _mm_aesenc_si128(state, round_key[r]);
+					}
+					state = _mm_aesenclast_si128(state, round_key[number_of_rounds]);
+					state = _mm_xor_si128(state, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input) + j));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out) + j, state);
+				}
+
+				if constexpr(Encode)
+				{
+					_p::GHASH_clmul::update(power, hash, p_out, p_count);
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_hash.data()), hash);
+				alignas(16) std::array<uint64_t, 2> counter_out;
+				_mm_store_si128(reinterpret_cast<__m128i*>(counter_out.data()), counter);
+				p_counter[0] = counter_out[1];
+				p_counter[1] = counter_out[0];
+			}
+		};
+
+		//	Note: 512 bit version of the fused kernel, VAES and VPCLMULQDQ process 4 blocks per instruction.
+		//	Each group of 16 blocks is multiplied by H^16 .. H^1, the 4 lanes of the products are summed
+		//	and reduced once. The remainder goes through the 128 bit kernel.
+		struct AES_GCM_VAES_Help
+		{
+			static constexpr uintptr_t vec_blocks	= 4;
+			static constexpr uintptr_t lanes		= GHASH::key_powers / vec_blocks;
+			using lanes_t = std::array<__m512i, lanes>;
+
+			ISA_TARGET("avx512f,avx512bw")
+			static inline __m512i reverse(const __m512i p_block)
+			{
+				return _mm512_shuffle_epi8(p_block, _mm512_broadcast_i32x4(_mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)));
+			}
+
+			ISA_TARGET("avx512f")
+			static inline __m128i fold(const __m512i p_val)
+			{
+				const __m256i half = _mm256_xor_si256(_mm512_castsi512_si256(p_val), _mm512_extracti64x4_epi64(p_val, 1));
+				return _mm_xor_si128(_mm256_castsi256_si128(half), _mm256_extracti128_si256(half, 1));
+			}
+
+			//	Note: p_power[j] holds H^(16 - 4j) .. H^(13 - 4j), the key holds them in ascending order.
+			ISA_TARGET("avx512f")
+			static inline void load_key(const GHASH::key_t& p_key, lanes_t& p_power)
+			{
+				for(uintptr_t i = 0; i < lanes; ++i)
+				{
+					const __m512i power = _mm512_loadu_si512(p_key.power[GHASH::key_powers - vec_blocks * (i + 1)].data());
+					p_power[i] = _mm512_shuffle_i64x2(power, power, 0x1B);
+				}
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("avx512f,avx512bw")
+			static inline void lanes_ctr(lanes_t& p_state, __m512i& p_counter, const __m512i p_key, std::index_sequence<I...>)
+			{
+				const __m512i step = _mm512_broadcast_i32x4(_mm_set_epi64x(0, vec_blocks));
+				(((p_state[I] = _mm512_xor_si512(reverse(p_counter), p_key)), (p_counter = _mm512_add_epi64(p_counter, step))), ...);
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("vaes,avx512f")
+			static inline void lanes_enc(lanes_t& p_state, const __m512i p_key, std::index_sequence<I...>)
+			{
+				((p_state[I] = _mm512_aesenc_epi128(p_state[I], p_key)), ...);
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("vaes,avx512f")
+			static inline void lanes_enclast_xor(lanes_t& p_state, const __m512i p_key, const uint8_t* const p_input, uint8_t* const p_out, std::index_sequence<I...>)
+			{
+				((p_state[I] = _mm512_xor_si512(_mm512_aesenclast_epi128(p_state[I], p_key), _mm512_loadu_si512(reinterpret_cast<const __m512i*>(p_input) + I))), ...);
+				(_mm512_storeu_si512(reinterpret_cast<__m512i*>(p_out) + I, p_state[I]), ...);
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("avx512f,avx512bw")
+			static inline void lanes_reverse(lanes_t& p_out, const lanes_t& p_state, std::index_sequence<I...>)
+			{
+				((p_out[I] = reverse(p_state[I])), ...);
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("avx512f,avx512bw")
+			static inline void lanes_load_reverse(lanes_t& p_out, const uint8_t* const p_input, std::index_sequence<I...>)
+			{
+				((p_out[I] = reverse(_mm512_loadu_si512(reinterpret_cast<const __m512i*>(p_input) + I))), ...);
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("vpclmulqdq,avx512f")
+			static inline void lanes_multiply(__m512i& p_lo, __m512i& p_mid, __m512i& p_hi, const lanes_t& p_blocks, const lanes_t& p_power, std::index_sequence<I...>)
+			{
+				((p_lo  = _mm512_xor_si512(p_lo,  _mm512_clmulepi64_epi128(p_blocks[I], p_power[I], 0x00))), ...);
+				((p_hi  = _mm512_xor_si512(p_hi,  _mm512_clmulepi64_epi128(p_blocks[I], p_power[I], 0x11))), ...);
+				((p_mid = _mm512_xor_si512(p_mid, _mm512_clmulepi64_epi128(p_blocks[I], p_power[I], 0x01))), ...);
+				((p_mid = _mm512_xor_si512(p_mid, _mm512_clmulepi64_epi128(p_blocks[I], p_power[I], 0x10))), ...);
+			}
+
+			///	\brief Hashes \ref GHASH::key_powers byte reversed blocks
+			ISA_TARGET("vpclmulqdq,avx512f")
+			static inline __m128i hash_lanes(const __m128i p_state, lanes_t p_blocks, const lanes_t& p_power)
+			{
+				p_blocks[0] = _mm512_xor_si512(p_blocks[0], _mm512_zextsi128_si512(p_state));
+
+				__m512i lo  = _mm512_setzero_si512();
+				__m512i mid = _mm512_setzero_si512();
+				__m512i hi  = _mm512_setzero_si512();
+				lanes_multiply(lo, mid, hi, p_blocks, p_power, std::make_index_sequence<lanes>{});
+				return _p::GHASH_clmul::reduce(fold(lo), fold(mid), fold(hi));
+			}
+
+			//	Note: The caller guarantees that the low 32 bits of the counter do not wrap around.
+			template<typename AES_t, bool Encode>
+			ISA_TARGET("aes,pclmul,ssse3,vaes,vpclmulqdq,avx512f,avx512bw")
+			static void crypt(const typename AES_t::key_schedule_t& p_wkey, const GHASH::key_t& p_hash_key,
+				_p::AES_counter_t& p_counter, GHASH::block_t& p_hash,
+				const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+			{
+				constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+				constexpr uintptr_t group = GHASH::key_powers;
+				constexpr std::make_index_sequence<lanes> seq;
+
+				const uintptr_t wide = p_count - p_count % group;
+				if(wide)
+				{
+					std::array<__m512i, number_of_rounds + 1> round_key;
+					for(uintptr_t i = 0; i <= number_of_rounds; ++i)
+					{
+						round_key[i] = _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + i));
+					}
+
+					lanes_t power;
+					load_key(p_hash_key, power);
+
+					__m128i hash = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_hash.data()));
+					__m512i counter = _mm512_add_epi64(
+						_mm512_broadcast_i32x4(_mm_set_epi64x(static_cast<int64_t>(p_counter[0]), static_cast<int64_t>(p_counter[1]))),
+						_mm512_set_epi64(0, 3, 0, 2, 0, 1, 0, 0));
+
+					lanes_t pending;
+					bool has_pending = false;
+
+					const uint8_t* input = p_input;
+					uint8_t* out = p_out;
+					for(uintptr_t count = wide; count; count -= group, input += group * 16, out += group * 16)
+					{
+						lanes_t state;
+						lanes_ctr(state, counter, round_key[0], seq);
+
+						if constexpr(Encode)
+						{
+							if(has_pending)
+							{
+								hash = hash_lanes(hash, pending, power);
+							}
+						}
+						else
+						{
+							lanes_load_reverse(pending, input, seq);
+							hash = hash_lanes(hash, pending, power);
+						}
+
+						for(uintptr_t r = 1; r < number_of_rounds; ++r)
+						{
+							lanes_enc(state, round_key[r], seq);
+						}
+						lanes_enclast_xor(state, round_key[number_of_rounds], input, out, seq);
+
+						if constexpr(Encode)
+						{
+							lanes_reverse(pending, state, seq);
+						}
+						has_pending = true;
+					}
+
+					if constexpr(Encode)
+					{
+						hash = hash_lanes(hash, pending, power);
+					}
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(p_hash.data()), hash);
+					p_counter[1] += wide;
+				}
+
+				AES_GCM_NI_Help::crypt<AES_t, Encode>(p_wkey, p_hash_key, p_counter, p_hash, p_input + wide * 16, p_out + wide * 16, p_count - wide);
+			}
+		};
+
+		static inline bool use_fused_kernel()
+		{
+			return _p::AES_NI_active() && GHASH::accelerated();
+		}
+
+		static inline bool use_wide_kernel()
+		{
+			return AES_get_engine() == AES_engine::VAES_AVX512 && core::amd64::CPU_feature_su::VPCLMULQDQ();
+		}
+#endif
+
+		static inline void pad_block(std::array<uint8_t, 16>& p_block, const uintptr_t p_size)
+		{
+			memset(p_block.data() + p_size, 0, 16 - p_size);
+		}
+	} //namespace
+
+	template<typename AES_t>
+	void AES_GCM<AES_t>::set_key(const key_schedule_t& p_wkey)
+	{
+		m_wkey = p_wkey;
+
+		alignas(8) std::array<uint8_t, block_lenght> H{0};
+		AES_t::encode(m_wkey, H, H);
+		GHASH::make_key(H, m_hash_key);
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::reset(std::span<const uint8_t> p_iv, const uintptr_t p_tag_size)
+	{
+		//	Note: Tag sizes allowed by NIST SP 800-38D 5.2.1.2
+		const bool valid_tag = (p_tag_size >= 12 && p_tag_size <= tag_lenght) || p_tag_size == 8 || p_tag_size == 4;
+		if(p_iv.empty() || !valid_tag)
+		{
+			return false;
+		}
+		m_tag_size = static_cast<uint8_t>(p_tag_size);
+
+		alignas(8) std::array<uint8_t, block_lenght> J0;
+		if(p_iv.size() == 12)
+		{
+			memcpy(J0.data(), p_iv.data(), 12);
+			J0[12] = 0;
+			J0[13] = 0;
+			J0[14] = 0;
+			J0[15] = 1;
+		}
+		else
+		{
+			GHASH::block_t hash{0, 0};
+			const uintptr_t full_size = p_iv.size() & ~uintptr_t{block_lenght - 1};
+			GHASH::update(m_hash_key, hash, p_iv.data(), full_size / block_lenght);
+
+			if(full_size != p_iv.size())
+			{
+				memcpy(J0.data(), p_iv.data() + full_size, p_iv.size() - full_size);
+				pad_block(J0, p_iv.size() - full_size);
+				GHASH::update(m_hash_key, hash, J0.data(), 1);
+			}
+
+			GHASH::store(GHASH::block_t{static_cast<uint64_t>(p_iv.size()) * 8, 0}, J0.data());
+			GHASH::update(m_hash_key, hash, J0.data(), 1);
+			GHASH::store(hash, J0.data());
+		}
+
+		AES_t::encode(m_wkey, J0, m_mask);
+
+		GHASH::block_t counter = GHASH::load(J0.data());
+		m_counter[0] = counter[1];
+		m_counter[1] = (counter[0] & 0xFFFFFFFF00000000) | static_cast<uint32_t>(counter[0] + 1);
+
+		m_hash = {0, 0};
+		m_aad_size = 0;
+		m_data_size = 0;
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::update_aad(std::span<const uint8_t> p_data)
+	{
+		if(m_data_size)
+		{
+			return false;
+		}
+
+		const uint8_t*	pivot	= p_data.data();
+		uintptr_t		size	= p_data.size();
+
+		const uintptr_t offset = static_cast<uintptr_t>(m_aad_size % block_lenght);
+		m_aad_size += size;
+
+		if(offset)
+		{
+			const uintptr_t count = std::min<uintptr_t>(block_lenght - offset, size);
+			memcpy(m_pending.data() + offset, pivot, count);
+			pivot	+= count;
+			size	-= count;
+			if(offset + count < block_lenght)
+			{
+				return true;
+			}
+			GHASH::update(m_hash_key, m_hash, m_pending.data(), 1);
+		}
+
+		const uintptr_t full_size = size & ~uintptr_t{block_lenght - 1};
+		GHASH::update(m_hash_key, m_hash, pivot, full_size / block_lenght);
+		memcpy(m_pending.data(), pivot + full_size, size - full_size);
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::update_aad(std::span<const std::span<const uint8_t>> p_buffers)
+	{
+		if(m_data_size)
+		{
+			return false;
+		}
+
+		for(const std::span<const uint8_t>& tbuffer : p_buffers)
+		{
+			update_aad(tbuffer);
+		}
+		return true;
+	}
+
+	template<typename AES_t>
+	void AES_GCM<AES_t>::hash_pending()
+	{
+		const uintptr_t aad_pending = static_cast<uintptr_t>(m_aad_size % block_lenght);
+		if(m_data_size == 0 && aad_pending)
+		{
+			pad_block(m_pending, aad_pending);
+			GHASH::update(m_hash_key, m_hash, m_pending.data(), 1);
+		}
+	}
+
+	template<typename AES_t>
+	void AES_GCM<AES_t>::process_blocks(const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count, const bool p_encode)
+	{
+		while(p_count)
+		{
+			//	Note: Only the low 32 bits of the counter are incremented,
+			//	calls into the counter mode kernels are split where they would carry into the upper bits.
+			const uint64_t fixed_hi	= m_counter[0];
+			const uint64_t fixed_lo	= m_counter[1] & 0xFFFFFFFF00000000;
+			const uint64_t until_wrap = 0x100000000 - (m_counter[1] & 0xFFFFFFFF);
+			const uintptr_t count	= static_cast<uintptr_t>(std::min<uint64_t>(until_wrap, p_count));
+
+#if defined(_M_AMD64) || defined(__amd64__)
+			if(use_wide_kernel() && use_fused_kernel())
+			{
+				if(p_encode)
+				{
+					AES_GCM_VAES_Help::crypt<AES_t, true>(m_wkey, m_hash_key, m_counter, m_hash, p_input, p_out, count);
+				}
+				else
+				{
+					AES_GCM_VAES_Help::crypt<AES_t, false>(m_wkey, m_hash_key, m_counter, m_hash, p_input, p_out, count);
+				}
+			}
+			else if(use_fused_kernel())
+			{
+				if(p_encode)
+				{
+					AES_GCM_NI_Help::crypt<AES_t, true>(m_wkey, m_hash_key, m_counter, m_hash, p_input, p_out, count);
+				}
+				else
+				{
+					AES_GCM_NI_Help::crypt<AES_t, false>(m_wkey, m_hash_key, m_counter, m_hash, p_input, p_out, count);
+				}
+			}
+			else
+#endif
+			{
+				//	Note: Groups small enough to still be in L1 cache when hashed.
+				for(uintptr_t done = 0; done < count;)
+				{
+					const uintptr_t group = std::min<uintptr_t>(count - done, GHASH::aggregate);
+					const uint8_t* const input	= p_input + done * block_lenght;
+					uint8_t* const out			= p_out   + done * block_lenght;
+
+					if(!p_encode)
+					{
+						GHASH::update(m_hash_key, m_hash, input, group);
+					}
+					_p::AES_ctr_xor<AES_t>(m_wkey, m_counter, input, out, group);
+					if(p_encode)
+					{
+						GHASH::update(m_hash_key, m_hash, out, group);
+					}
+					done += group;
+				}
+			}
+
+			m_counter[0] = fixed_hi;
+			m_counter[1] = fixed_lo | (m_counter[1] & 0xFFFFFFFF);
+
+			p_input	+= count * block_lenght;
+			p_out	+= count * block_lenght;
+			p_count	-= count;
+		}
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::fits(const uint64_t p_size) const
+	{
+		return p_size <= max_data_size - m_data_size;
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::process(const uint8_t* p_input, uint8_t* p_out, uintptr_t p_size, const bool p_encode)
+	{
+		if(!fits(p_size))
+		{
+			return false;
+		}
+
+		if(p_size == 0)
+		{
+			return true;
+		}
+
+		hash_pending();
+
+		uintptr_t offset = static_cast<uintptr_t>(m_data_size % block_lenght);
+		m_data_size += p_size;
+
+		if(offset)
+		{
+			const uintptr_t count = std::min<uintptr_t>(block_lenght - offset, p_size);
+			if(p_encode)
+			{
+				xor_bytes(p_out, p_input, m_cached.data() + offset, count);
+				memcpy(m_pending.data() + offset, p_out, count);
+			}
+			else
+			{
+				memcpy(m_pending.data() + offset, p_input, count);
+				xor_bytes(p_out, p_input, m_cached.data() + offset, count);
+			}
+			p_input	+= count;
+			p_out	+= count;
+			p_size	-= count;
+
+			if(offset + count < block_lenght)
+			{
+				return true;
+			}
+			GHASH::update(m_hash_key, m_hash, m_pending.data(), 1);
+		}
+
+		const uintptr_t block_count = p_size / block_lenght;
+		process_blocks(p_input, p_out, block_count, p_encode);
+		p_input	+= block_count * block_lenght;
+		p_out	+= block_count * block_lenght;
+		p_size	-= block_count * block_lenght;
+
+		if(p_size)
+		{
+			const uint64_t counter_hi = core::endian_host2big(m_counter[0]);
+			const uint64_t counter_lo = core::endian_host2big(m_counter[1]);
+			memcpy(m_cached.data(), &counter_hi, 8);
+			memcpy(m_cached.data() + 8, &counter_lo, 8);
+			AES_t::encode(m_wkey, m_cached, m_cached);
+			m_counter[1] = (m_counter[1] & 0xFFFFFFFF00000000) | static_cast<uint32_t>(m_counter[1] + 1);
+
+			if(p_encode)
+			{
+				xor_bytes(p_out, p_input, m_cached.data(), p_size);
+				memcpy(m_pending.data(), p_out, p_size);
+			}
+			else
+			{
+				memcpy(m_pending.data(), p_input, p_size);
+				xor_bytes(p_out, p_input, m_cached.data(), p_size);
+			}
+		}
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::process_parallel(worker_pool& p_pool, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_size, const bool p_encode)
+	{
+		constexpr uintptr_t chunk_blocks = parallel_chunk / block_lenght;
+
+		if(!fits(p_size))
+		{
+			return false;
+		}
+
+		//	Note: A partial block left by a previous call is completed first, so that the parallel part starts on a block boundary.
+		const uintptr_t offset = static_cast<uintptr_t>(m_data_size % block_lenght);
+		const uintptr_t head = offset ? std::min<uintptr_t>(block_lenght - offset, p_size) : 0;
+		process(p_input, p_out, head, p_encode);
+		p_input	+= head;
+		p_out	+= head;
+		p_size	-= head;
+
+		const uintptr_t block_count = p_size / block_lenght;
+		const uintptr_t chunk_count = (block_count + chunk_blocks - 1) / chunk_blocks;
+		if(p_pool.size() < 2 || chunk_count < 2)
+		{
+			return process(p_input, p_out, p_size, p_encode);
+		}
+
+		hash_pending();
+
+		//	Note: Each chunk is hashed from a zero state, with the counter the serial path would have reached at its first block.
+		std::vector<GHASH::block_t> hashes(chunk_count);
+		const uint32_t counter_base = static_cast<uint32_t>(m_counter[1]);
+		auto task = [&](const uintptr_t p_index)
+			{
+				const uintptr_t first = p_index * chunk_blocks;
+				const uintptr_t count = std::min(chunk_blocks, block_count - first);
+
+				AES_GCM chunk = *this;
+				chunk.m_hash = {0, 0};
+				chunk.m_counter[1] = (m_counter[1] & 0xFFFFFFFF00000000) | static_cast<uint32_t>(counter_base + first);
+				chunk.process_blocks(p_input + first * block_lenght, p_out + first * block_lenght, count, p_encode);
+				hashes[p_index] = chunk.m_hash;
+			};
+		p_pool.run(chunk_count, task);
+
+		//	Note: hash(A || B) = hash(A) * H^blocks(B) ^ hash(B), only the last chunk can be shorter.
+		const GHASH::block_t chunk_power = GHASH::power(m_hash_key, chunk_blocks);
+		const uintptr_t last_count = block_count - (chunk_count - 1) * chunk_blocks;
+		for(uintptr_t i = 0; i < chunk_count; ++i)
+		{
+			const GHASH::block_t power = (i + 1 < chunk_count) ? chunk_power : GHASH::power(m_hash_key, last_count);
+			m_hash = GHASH::multiply(m_hash, power);
+			m_hash[0] ^= hashes[i][0];
+			m_hash[1] ^= hashes[i][1];
+		}
+
+		m_counter[1] = (m_counter[1] & 0xFFFFFFFF00000000) | static_cast<uint32_t>(counter_base + block_count);
+		m_data_size += block_count * block_lenght;
+
+		const uintptr_t done = block_count * block_lenght;
+		return process(p_input + done, p_out + done, p_size - done, p_encode);
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::encode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		return process(p_input.data(), p_out.data(), p_input.size(), true);
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::decode(std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		return process(p_input.data(), p_out.data(), p_input.size(), false);
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::encode(std::span<uint8_t> p_data)
+	{
+		return process(p_data.data(), p_data.data(), p_data.size(), true);
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::decode(std::span<uint8_t> p_data)
+	{
+		return process(p_data.data(), p_data.data(), p_data.size(), false);
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::encode(std::span<const std::span<uint8_t>> p_buffers)
+	{
+		uint64_t total = 0;
+		for(const std::span<uint8_t>& tbuffer : p_buffers)
+		{
+			total += tbuffer.size();
+		}
+		if(!fits(total))
+		{
+			return false;
+		}
+
+		for(const std::span<uint8_t>& tbuffer : p_buffers)
+		{
+			process(tbuffer.data(), tbuffer.data(), tbuffer.size(), true);
+		}
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::decode(std::span<const std::span<uint8_t>> p_buffers)
+	{
+		uint64_t total = 0;
+		for(const std::span<uint8_t>& tbuffer : p_buffers)
+		{
+			total += tbuffer.size();
+		}
+		if(!fits(total))
+		{
+			return false;
+		}
+
+		for(const std::span<uint8_t>& tbuffer : p_buffers)
+		{
+			process(tbuffer.data(), tbuffer.data(), tbuffer.size(), false);
+		}
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::encode(worker_pool& p_pool, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		return process_parallel(p_pool, p_input.data(), p_out.data(), p_input.size(), true);
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::decode(worker_pool& p_pool, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		return process_parallel(p_pool, p_input.data(), p_out.data(), p_input.size(), false);
+	}
+
+	template<typename AES_t>
+	void AES_GCM<AES_t>::finalize()
+	{
+		hash_pending();
+
+		const uintptr_t data_pending = static_cast<uintptr_t>(m_data_size % block_lenght);
+		if(data_pending)
+		{
+			pad_block(m_pending, data_pending);
+			GHASH::update(m_hash_key, m_hash, m_pending.data(), 1);
+		}
+
+		alignas(8) std::array<uint8_t, block_lenght> lenghts;
+		GHASH::store(GHASH::block_t{m_data_size * 8, m_aad_size * 8}, lenghts.data());
+		GHASH::update(m_hash_key, m_hash, lenghts.data(), 1);
+
+		GHASH::store(m_hash, m_tag.data());
+		xor_bytes(m_tag.data(), m_tag.data(), m_mask.data(), tag_lenght);
+	}
+
+	template<typename AES_t>
+	bool AES_GCM<AES_t>::verify(std::span<const uint8_t> p_tag) const
+	{
+		if(p_tag.size() != m_tag_size)
+		{
+			return false;
+		}
+
+		uint8_t diff = 0;
+		for(uintptr_t i = 0; i < p_tag.size(); ++i)
+		{
+			diff |= static_cast<uint8_t>(m_tag[i] ^ p_tag[i]);
+		}
+		return diff == 0;
+	}
+
+	template class AES_GCM<AES_128>;
+	template class AES_GCM<AES_192>;
+	template class AES_GCM<AES_256>;
+
+} //namespace crypto
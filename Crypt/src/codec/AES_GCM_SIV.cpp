@@ -0,0 +1,528 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/AES_GCM_SIV.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <CoreLib/core_endian.hpp>
+
+#include "isa_target.hpp"
+#include "block_help.hpp"
+#include "AES_engine.hpp"
+#include "POLYVAL.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		using _p::POLYVAL;
+
+		//	Note: Number of blocks decrypted and then hashed at once by the portable decode, small enough to still be in L1 cache when hashed.
+		static constexpr uintptr_t decode_chunk = 64;
+
+		template<typename AES_t>
+		struct message_key_t
+		{
+			typename AES_t::key_schedule_t	wkey;
+			POLYVAL::key_t					hash_key;
+		};
+
+		//	Note: The counter is the first 4 bytes of the block, a 32 bit little endian integer
+		//	that wraps around without carrying into the rest of the block.
+		static inline void increment_counter(uint8_t* const p_counter, const uint32_t p_count)
+		{
+			uint32_t counter;
+			memcpy(&counter, p_counter, 4);
+			counter = core::endian_host2little(core::endian_little2host(counter) + p_count);
+			memcpy(p_counter, &counter, 4);
+		}
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		struct AES_GCM_SIV_NI_Help
+		{
+			static constexpr uintptr_t lanes = 8;
+			using lanes_t = std::array<__m128i, lanes>;
+
+			template<uintptr_t... I>
+			ISA_TARGET("aes")
+			static inline void lanes_ctr(std::array<__m128i, sizeof...(I)>& p_state, __m128i& p_counter, const __m128i p_key, std::index_sequence<I...>)
+			{
+				const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+				(((p_state[I] = _mm_xor_si128(p_counter, p_key)), (p_counter = _mm_add_epi32(p_counter, one))), ...);
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("aes")
+			static inline void lanes_enc(std::array<__m128i, sizeof...(I)>& p_state, const __m128i p_key, std::index_sequence<I...>)
+			{
+				((p_state[I] = _mm_aesenc_si128(p_state[I], p_key)), ...);
+			}
+
+			//	Note: The plain text is left in p_state so that decode can hash it without reloading.
+			template<uintptr_t... I>
+			ISA_TARGET("aes")
+			static inline void lanes_enclast_xor(std::array<__m128i, sizeof...(I)>& p_state, const __m128i p_key,
+				const uint8_t* const p_input, uint8_t* const p_out, std::index_sequence<I...>)
+			{
+				((p_state[I] = _mm_xor_si128(_mm_aesenclast_si128(p_state[I], p_key), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input) + I))), ...);
+				(_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out) + I, p_state[I]), ...);
+			}
+
+			template<typename AES_t, uintptr_t... I>
+			ISA_TARGET("aes")
+			static inline void ctr_lanes(const std::array<__m128i, AES_t::number_of_rounds + 1>& p_round_key, __m128i& p_counter,
+				const uint8_t* const p_input, uint8_t* const p_out, std::array<__m128i, sizeof...(I)>& p_state, std::index_sequence<I...> p_seq)
+			{
+				constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+
+				lanes_ctr(p_state, p_counter, p_round_key[0], p_seq);
+				for(uintptr_t r = 1; r < number_of_rounds; ++r)
+				{
+					lanes_enc(p_state, p_round_key[r], p_seq);
+				}
+				lanes_enclast_xor(p_state, p_round_key[number_of_rounds], p_input, p_out, p_seq);
+			}
+
+			template<typename AES_t>
+			ISA_TARGET("aes")
+			static void ctr_xor(const typename AES_t::key_schedule_t& p_wkey, uint8_t* const p_counter, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+			{
+				constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+
+				std::array<__m128i, number_of_rounds + 1> round_key;
+				for(uintptr_t i = 0; i <= number_of_rounds; ++i)
+				{
+					round_key[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + i);
+				}
+
+				__m128i counter = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_counter));
+
+				lanes_t state;
+				for(; p_count >= lanes; p_count -= lanes, p_input += lanes * 16, p_out += lanes * 16)
+				{
+					ctr_lanes<AES_t>(round_key, counter, p_input, p_out, state, std::make_index_sequence<lanes>{});
+				}
+				for(; p_count; --p_count, p_input += 16, p_out += 16)
+				{
+					std::array<__m128i, 1> single;
+					ctr_lanes<AES_t>(round_key, counter, p_input, p_out, single, std::make_index_sequence<1>{});
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_counter), counter);
+			}
+
+			//	Note: Decryption and the hash of the plain text in a single pass.
+			//	The hash of a group of blocks has no dependency on the AES rounds of the next group,
+			//	so the out of order core overlaps both.
+			template<typename AES_t>
+			ISA_TARGET("aes,pclmul")
+			static void decode(const message_key_t<AES_t>& p_key, uint8_t* const p_counter, POLYVAL::block_t& p_hash,
+				const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+			{
+				static_assert(lanes == POLYVAL::aggregate);
+				constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+
+				std::array<__m128i, number_of_rounds + 1> round_key;
+				for(uintptr_t i = 0; i <= number_of_rounds; ++i)
+				{
+					round_key[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_key.wkey.wkey.data()) + i);
+				}
+
+				std::array<__m128i, POLYVAL::aggregate> power;
+				_p::POLYVAL_clmul::load_key(p_key.hash_key, power);
+
+				__m128i counter = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_counter));
+				__m128i hash = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_hash.data()));
+
+				lanes_t pending;
+				bool has_pending = false;
+				for(; p_count >= lanes; p_count -= lanes, p_input += lanes * 16, p_out += lanes * 16)
+				{
+					if(has_pending)
+					{
+						hash = _p::POLYVAL_clmul::hash_blocks(hash, pending.data(), lanes, power.data());
+					}
+					ctr_lanes<AES_t>(round_key, counter, p_input, p_out, pending, std::make_index_sequence<lanes>{});
+					has_pending = true;
+				}
+				if(has_pending)
+				{
+					hash = _p::POLYVAL_clmul::hash_blocks(hash, pending.data(), lanes, power.data());
+				}
+
+				for(; p_count; --p_count, p_input += 16, p_out += 16)
+				{
+					std::array<__m128i, 1> single;
+					ctr_lanes<AES_t>(round_key, counter, p_input, p_out, single, std::make_index_sequence<1>{});
+					hash = _p::POLYVAL_clmul::hash_blocks(hash, single.data(), 1, power.data());
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_counter), counter);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(p_hash.data()), hash);
+			}
+		};
+
+		//	Note: 512 bit version, 16 blocks at a time. The remainder goes through the 128 bit kernel.
+		struct AES_GCM_SIV_VAES_Help
+		{
+			static constexpr uintptr_t vec_blocks	= _p::POLYVAL_wide::vec_blocks;
+			static constexpr uintptr_t lanes		= 4;
+			using lanes_t = std::array<__m512i, lanes>;
+
+			template<typename AES_t>
+			ISA_TARGET("avx512f")
+			static inline void load_round_keys(const typename AES_t::key_schedule_t& p_wkey, std::array<__m512i, AES_t::number_of_rounds + 1>& p_round_key)
+			{
+				for(uintptr_t i = 0; i <= AES_t::number_of_rounds; ++i)
+				{
+					p_round_key[i] = _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(p_wkey.wkey.data()) + i));
+				}
+			}
+
+			//	Note: The 4 blocks of a register are consecutive counters
+			ISA_TARGET("avx512f")
+			static inline __m512i load_counter(const uint8_t* const p_counter)
+			{
+				return _mm512_add_epi32(
+					_mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_counter))),
+					_mm512_set_epi32(0, 0, 0, 3, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 0));
+			}
+
+			template<typename AES_t, uintptr_t... I>
+			ISA_TARGET("vaes,avx512f")
+			static inline void ctr_lanes(const std::array<__m512i, AES_t::number_of_rounds + 1>& p_round_key, __m512i& p_counter,
+				const uint8_t* const p_input, uint8_t* const p_out, lanes_t& state, std::index_sequence<I...>)
+			{
+				constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+				const __m512i step = _mm512_broadcast_i32x4(_mm_set_epi32(0, 0, 0, vec_blocks));
+
+				(((state[I] = _mm512_xor_si512(p_counter, p_round_key[0])), (p_counter = _mm512_add_epi32(p_counter, step))), ...);
+				for(uintptr_t r = 1; r < number_of_rounds; ++r)
+				{
+					((state[I] = _mm512_aesenc_epi128(state[I], p_round_key[r])), ...);
+				}
+				((state[I] = _mm512_xor_si512(_mm512_aesenclast_epi128(state[I], p_round_key[number_of_rounds]), _mm512_loadu_si512(reinterpret_cast<const __m512i*>(p_input) + I))), ...);
+				(_mm512_storeu_si512(reinterpret_cast<__m512i*>(p_out) + I, state[I]), ...);
+			}
+
+			template<typename AES_t>
+			ISA_TARGET("aes,vaes,avx512f")
+			static void ctr_xor(const typename AES_t::key_schedule_t& p_wkey, uint8_t* const p_counter, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+			{
+				constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+				constexpr uintptr_t group = vec_blocks * lanes;
+
+				if(p_count >= group)
+				{
+					std::array<__m512i, number_of_rounds + 1> round_key;
+					load_round_keys<AES_t>(p_wkey, round_key);
+					__m512i counter = load_counter(p_counter);
+
+					lanes_t state;
+					for(; p_count >= group; p_count -= group, p_input += group * 16, p_out += group * 16)
+					{
+						ctr_lanes<AES_t>(round_key, counter, p_input, p_out, state, std::make_index_sequence<lanes>{});
+					}
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(p_counter), _mm512_castsi512_si128(counter));
+				}
+
+				AES_GCM_SIV_NI_Help::ctr_xor<AES_t>(p_wkey, p_counter, p_input, p_out, p_count);
+			}
+
+			//	Note: Same as AES_GCM_SIV_NI_Help::decode, each group of 16 blocks is hashed with H^16 .. H^1.
+			template<typename AES_t>
+			ISA_TARGET("aes,pclmul,vaes,vpclmulqdq,avx512f")
+			static void decode(const message_key_t<AES_t>& p_key, uint8_t* const p_counter, POLYVAL::block_t& p_hash,
+				const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+			{
+				constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+				constexpr uintptr_t group = vec_blocks * lanes;
+
+				if(p_count >= group)
+				{
+					std::array<__m512i, number_of_rounds + 1> round_key;
+					load_round_keys<AES_t>(p_key.wkey, round_key);
+					__m512i counter = load_counter(p_counter);
+
+					lanes_t power;
+					_p::POLYVAL_wide::load_key(p_key.hash_key, power);
+					__m128i hash = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_hash.data()));
+
+					lanes_t pending;
+					bool has_pending = false;
+					for(; p_count >= group; p_count -= group, p_input += group * 16, p_out += group * 16)
+					{
+						if(has_pending)
+						{
+							hash = _p::POLYVAL_wide::hash_lanes(hash, pending, power, std::make_index_sequence<lanes>{});
+						}
+						ctr_lanes<AES_t>(round_key, counter, p_input, p_out, pending, std::make_index_sequence<lanes>{});
+						has_pending = true;
+					}
+					hash = _p::POLYVAL_wide::hash_lanes(hash, pending, power, std::make_index_sequence<lanes>{});
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(p_counter), _mm512_castsi512_si128(counter));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(p_hash.data()), hash);
+				}
+
+				AES_GCM_SIV_NI_Help::decode<AES_t>(p_key, p_counter, p_hash, p_input, p_out, p_count);
+			}
+		};
+#endif
+
+		//	Note: Other engines encrypt a run of counter blocks with their multi-block path.
+		template<typename AES_t>
+		static void ctr_xor(const typename AES_t::key_schedule_t& p_wkey, uint8_t* const p_counter, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+#if defined(_M_AMD64) || defined(__amd64__)
+			if(_p::AES_NI_active())
+			{
+				if(AES_get_engine() == AES_engine::VAES_AVX512)
+				{
+					AES_GCM_SIV_VAES_Help::ctr_xor<AES_t>(p_wkey, p_counter, p_input, p_out, p_count);
+				}
+				else
+				{
+					AES_GCM_SIV_NI_Help::ctr_xor<AES_t>(p_wkey, p_counter, p_input, p_out, p_count);
+				}
+				return;
+			}
+#endif
+
+			constexpr uintptr_t chunk = 32;
+			alignas(16) std::array<uint8_t, chunk * 16> keystream;
+			while(p_count)
+			{
+				const uintptr_t count = std::min(p_count, chunk);
+				for(uintptr_t i = 0; i < count; ++i)
+				{
+					memcpy(keystream.data() + i * 16, p_counter, 16);
+					increment_counter(keystream.data() + i * 16, static_cast<uint32_t>(i));
+				}
+				increment_counter(p_counter, static_cast<uint32_t>(count));
+
+				const std::span<uint8_t> blocks{keystream.data(), count * 16};
+				AES_t::encode_blocks(p_wkey, blocks, blocks);
+				xor_bytes(p_out, p_input, keystream.data(), count * 16);
+
+				p_input	+= count * 16;
+				p_out	+= count * 16;
+				p_count	-= count;
+			}
+		}
+
+		template<typename AES_t>
+		static void ctr_xor_bytes(const typename AES_t::key_schedule_t& p_wkey, uint8_t* const p_counter, const uint8_t* const p_input, uint8_t* const p_out, const uintptr_t p_size)
+		{
+			const uintptr_t count = p_size / 16;
+			const uintptr_t tail = p_size % 16;
+			ctr_xor<AES_t>(p_wkey, p_counter, p_input, p_out, count);
+			if(tail)
+			{
+				alignas(16) std::array<uint8_t, 16> block;
+				memcpy(block.data(), p_input + count * 16, tail);
+				ctr_xor<AES_t>(p_wkey, p_counter, block.data(), block.data(), 1);
+				memcpy(p_out + count * 16, block.data(), tail);
+			}
+		}
+
+		//	Note: Decrypts p_count blocks and hashes the resulting plain text.
+		template<typename AES_t>
+		static void decode_blocks(const message_key_t<AES_t>& p_key, uint8_t* const p_counter, POLYVAL::block_t& p_hash,
+			const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+		{
+#if defined(_M_AMD64) || defined(__amd64__)
+			if(_p::AES_NI_active() && p_key.hash_key.powers >= POLYVAL::aggregate)
+			{
+				if(POLYVAL::wide() && p_key.hash_key.powers == POLYVAL::key_powers)
+				{
+					AES_GCM_SIV_VAES_Help::decode<AES_t>(p_key, p_counter, p_hash, p_input, p_out, p_count);
+				}
+				else
+				{
+					AES_GCM_SIV_NI_Help::decode<AES_t>(p_key, p_counter, p_hash, p_input, p_out, p_count);
+				}
+				return;
+			}
+#endif
+
+			while(p_count)
+			{
+				const uintptr_t chunk = std::min(p_count, decode_chunk);
+				ctr_xor<AES_t>(p_key.wkey, p_counter, p_input, p_out, chunk);
+				POLYVAL::update(p_key.hash_key, p_hash, p_out, chunk);
+				p_input	+= chunk * 16;
+				p_out	+= chunk * 16;
+				p_count	-= chunk;
+			}
+		}
+
+		//	Note: The trailing partial block is zero padded
+		static void hash_padded(const POLYVAL::key_t& p_key, POLYVAL::block_t& p_state, const uint8_t* const p_data, const uintptr_t p_size)
+		{
+			const uintptr_t count = p_size / 16;
+			const uintptr_t tail = p_size % 16;
+			POLYVAL::update(p_key, p_state, p_data, count);
+			if(tail)
+			{
+				alignas(16) std::array<uint8_t, 16> block{0};
+				memcpy(block.data(), p_data + count * 16, tail);
+				POLYVAL::update(p_key, p_state, block.data(), 1);
+			}
+		}
+
+		//	Note: Every block is LE32(i) || nonce, the first half of each encrypted block is kept.
+		//	All of them are encrypted in a single multi-block call.
+		template<typename AES_t>
+		static void derive_keys(const typename AES_t::key_schedule_t& p_wkey, std::span<const uint8_t, 12> p_nonce, message_key_t<AES_t>& p_key)
+		{
+			constexpr uintptr_t key_lenght = AES_t::key_lenght;
+			constexpr uintptr_t block_count = 2 + key_lenght / 8;
+
+			alignas(16) std::array<uint8_t, block_count * 16> blocks;
+			for(uintptr_t i = 0; i < block_count; ++i)
+			{
+				const uint32_t index = core::endian_host2little(static_cast<uint32_t>(i));
+				memcpy(blocks.data() + i * 16, &index, 4);
+				memcpy(blocks.data() + i * 16 + 4, p_nonce.data(), 12);
+			}
+			AES_t::encode_blocks(p_wkey, blocks, blocks);
+
+			alignas(16) std::array<uint8_t, 16> auth_key;
+			alignas(16) std::array<uint8_t, key_lenght> enc_key;
+			for(uintptr_t i = 0; i < 2; ++i)
+			{
+				memcpy(auth_key.data() + i * 8, blocks.data() + i * 16, 8);
+			}
+			for(uintptr_t i = 0; i < key_lenght / 8; ++i)
+			{
+				memcpy(enc_key.data() + i * 8, blocks.data() + (i + 2) * 16, 8);
+			}
+
+			POLYVAL::make_key(auth_key, p_key.hash_key);
+			AES_t::make_key_schedule(enc_key, p_key.wkey);
+		}
+
+		template<typename AES_t>
+		static void compute_tag(const message_key_t<AES_t>& p_key, POLYVAL::block_t& p_hash,
+			std::span<const uint8_t, 12> p_nonce, const uint64_t p_aad_size, const uint64_t p_data_size, std::array<uint8_t, 16>& p_tag)
+		{
+			alignas(16) std::array<uint8_t, 16> block;
+			POLYVAL::store(POLYVAL::block_t{p_aad_size * 8, p_data_size * 8}, block.data());
+			POLYVAL::update(p_key.hash_key, p_hash, block.data(), 1);
+
+			POLYVAL::store(p_hash, block.data());
+			xor_bytes(block.data(), block.data(), p_nonce.data(), 12);
+			block[15] &= 0x7F;
+			AES_t::encode(p_key.wkey, block, p_tag);
+		}
+	} //namespace
+
+	template<typename AES_t>
+	void AES_GCM_SIV<AES_t>::set_key(const key_schedule_t& p_wkey)
+	{
+		m_wkey = p_wkey;
+	}
+
+	template<typename AES_t>
+	bool AES_GCM_SIV<AES_t>::encode(std::span<const uint8_t, nonce_lenght> p_nonce, std::span<const uint8_t> p_aad,
+		std::span<const uint8_t> p_input, std::span<uint8_t> p_out, tag_t& p_tag) const
+	{
+		const uintptr_t size = p_input.size();
+		if(size > max_size || p_aad.size() > max_size || p_out.size() < size)
+		{
+			return false;
+		}
+
+		message_key_t<AES_t> key;
+		derive_keys<AES_t>(m_wkey, p_nonce, key);
+
+		POLYVAL::block_t hash{0, 0};
+		hash_padded(key.hash_key, hash, p_aad.data(), p_aad.size());
+		hash_padded(key.hash_key, hash, p_input.data(), size);
+		compute_tag<AES_t>(key, hash, p_nonce, p_aad.size(), size, p_tag);
+
+		alignas(16) std::array<uint8_t, block_lenght> counter = p_tag;
+		counter[15] |= 0x80;
+		ctr_xor_bytes<AES_t>(key.wkey, counter.data(), p_input.data(), p_out.data(), size);
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_GCM_SIV<AES_t>::decode(std::span<const uint8_t, nonce_lenght> p_nonce, std::span<const uint8_t> p_aad,
+		std::span<const uint8_t> p_input, std::span<uint8_t> p_out, const tag_t& p_tag) const
+	{
+		const uintptr_t size = p_input.size();
+		if(size > max_size || p_aad.size() > max_size || p_out.size() < size)
+		{
+			return false;
+		}
+
+		message_key_t<AES_t> key;
+		derive_keys<AES_t>(m_wkey, p_nonce, key);
+
+		POLYVAL::block_t hash{0, 0};
+		hash_padded(key.hash_key, hash, p_aad.data(), p_aad.size());
+
+		alignas(16) std::array<uint8_t, block_lenght> counter = p_tag;
+		counter[15] |= 0x80;
+
+		const uintptr_t count = size / block_lenght;
+		const uintptr_t tail = size % block_lenght;
+		decode_blocks<AES_t>(key, counter.data(), hash, p_input.data(), p_out.data(), count);
+		if(tail)
+		{
+			const uintptr_t offset = count * block_lenght;
+			ctr_xor_bytes<AES_t>(key.wkey, counter.data(), p_input.data() + offset, p_out.data() + offset, tail);
+			hash_padded(key.hash_key, hash, p_out.data() + offset, tail);
+		}
+
+		tag_t tag;
+		compute_tag<AES_t>(key, hash, p_nonce, p_aad.size(), size, tag);
+
+		uint8_t diff = 0;
+		for(uintptr_t i = 0; i < tag_lenght; ++i)
+		{
+			diff |= static_cast<uint8_t>(tag[i] ^ p_tag[i]);
+		}
+
+		if(diff)
+		{
+			memset(p_out.data(), 0, size);
+			return false;
+		}
+		return true;
+	}
+
+	template class AES_GCM_SIV<AES_128>;
+	template class AES_GCM_SIV<AES_256>;
+
+} //namespace crypto
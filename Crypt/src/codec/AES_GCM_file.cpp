@@ -0,0 +1,514 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/AES_GCM_file.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+#include <Crypt/worker_pool.hpp>
+
+namespace crypto
+{
+	namespace
+	{
+		//	Note: Read only view of a whole file, empty files are not mapped.
+		class mapped_file
+		{
+		public:
+			mapped_file() = default;
+			mapped_file(const mapped_file&) = delete;
+			mapped_file& operator = (const mapped_file&) = delete;
+
+			~mapped_file()
+			{
+				close();
+			}
+
+			bool open(const std::filesystem::path& p_path);
+			void close();
+
+			inline std::span<const uint8_t> data() const { return std::span<const uint8_t>{m_data, m_size}; }
+
+		private:
+			const uint8_t*	m_data = nullptr;
+			uintptr_t		m_size = 0;
+#ifdef _WIN32
+			HANDLE			m_file		= INVALID_HANDLE_VALUE;
+			HANDLE			m_mapping	= nullptr;
+#endif
+		};
+
+#ifdef _WIN32
+		bool mapped_file::open(const std::filesystem::path& p_path)
+		{
+			m_file = CreateFileW(p_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if(m_file == INVALID_HANDLE_VALUE)
+			{
+				return false;
+			}
+
+			LARGE_INTEGER size;
+			if(!GetFileSizeEx(m_file, &size))
+			{
+				close();
+				return false;
+			}
+
+			if(size.QuadPart)
+			{
+				m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if(m_mapping == nullptr)
+				{
+					close();
+					return false;
+				}
+
+				m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+				if(m_data == nullptr)
+				{
+					close();
+					return false;
+				}
+				m_size = static_cast<uintptr_t>(size.QuadPart);
+			}
+			return true;
+		}
+
+		void mapped_file::close()
+		{
+			if(m_data)
+			{
+				UnmapViewOfFile(m_data);
+			}
+			if(m_mapping)
+			{
+				CloseHandle(m_mapping);
+			}
+			if(m_file != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(m_file);
+			}
+			m_data		= nullptr;
+			m_size		= 0;
+			m_mapping	= nullptr;
+			m_file		= INVALID_HANDLE_VALUE;
+		}
+#else
+		bool mapped_file::open(const std::filesystem::path& p_path)
+		{
+			const int file = ::open(p_path.c_str(), O_RDONLY);
+			if(file < 0)
+			{
+				return false;
+			}
+
+			struct stat info;
+			if(fstat(file, &info) != 0)
+			{
+				::close(file);
+				return false;
+			}
+
+			if(info.st_size)
+			{
+				const uintptr_t size = static_cast<uintptr_t>(info.st_size);
+				void* const map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+				if(map == MAP_FAILED)
+				{
+					::close(file);
+					return false;
+				}
+				madvise(map, size, MADV_SEQUENTIAL);
+				m_data = static_cast<const uint8_t*>(map);
+				m_size = size;
+			}
+
+			//	Note: The mapping keeps its own reference to the file.
+			::close(file);
+			return true;
+		}
+
+		void mapped_file::close()
+		{
+			if(m_data)
+			{
+				munmap(const_cast<uint8_t*>(m_data), m_size);
+			}
+			m_data = nullptr;
+			m_size = 0;
+		}
+#endif
+
+		//	Note: Passes ring buffer indexes between stages, it never holds more than the number of buffers.
+		//	A closed queue still hands out what it holds, an aborted one does not.
+		class slot_queue
+		{
+		public:
+			explicit slot_queue(const uint32_t p_capacity)
+				: m_slots(p_capacity)
+			{
+			}
+
+			void push(const uint32_t p_slot)
+			{
+				{
+					std::lock_guard guard(m_lock);
+					if(m_closed)
+					{
+						return;
+					}
+					m_slots[(m_first + m_count) % m_slots.size()] = p_slot;
+					++m_count;
+				}
+				m_ready.notify_one();
+			}
+
+			bool pop(uint32_t& p_slot)
+			{
+				std::unique_lock guard(m_lock);
+				m_ready.wait(guard, [&] { return m_count || m_closed; });
+				if(m_count == 0 || m_aborted)
+				{
+					return false;
+				}
+				p_slot = m_slots[m_first];
+				m_first = (m_first + 1) % m_slots.size();
+				--m_count;
+				return true;
+			}
+
+			void close(const bool p_abort = false)
+			{
+				{
+					std::lock_guard guard(m_lock);
+					m_closed = true;
+					m_aborted = m_aborted || p_abort;
+				}
+				m_ready.notify_all();
+			}
+
+		private:
+			std::mutex				m_lock;
+			std::condition_variable	m_ready;
+			std::vector<uint32_t>	m_slots;
+			uintptr_t				m_first		= 0;
+			uintptr_t				m_count		= 0;
+			bool					m_closed	= false;
+			bool					m_aborted	= false;
+		};
+
+		//	Note: A buffer goes around free -> filled (reader) -> processed (calling thread) -> free (writer).
+		//	With a mapped input the calling thread takes free buffers directly and the filled queue is not used.
+		struct pipeline_t
+		{
+			std::vector<std::vector<uint8_t>>	buffers;
+			std::vector<uintptr_t>				sizes;
+			slot_queue							free;
+			slot_queue							filled;
+			slot_queue							processed;
+			std::atomic<bool>					failed {false};
+
+			pipeline_t(const uint32_t p_count, const uintptr_t p_size)
+				: buffers(p_count, std::vector<uint8_t>(p_size))
+				, sizes(p_count, 0)
+				, free(p_count)
+				, filled(p_count)
+				, processed(p_count)
+			{
+				for(uint32_t i = 0; i < p_count; ++i)
+				{
+					free.push(i);
+				}
+			}
+
+			void fail()
+			{
+				failed.store(true, std::memory_order_relaxed);
+				free.close(true);
+				filled.close(true);
+				processed.close(true);
+			}
+		};
+
+		template<typename AES_t>
+		static bool crypt_chunk(AES_GCM<AES_t>& p_gcm, worker_pool* const p_pool, const uint8_t* const p_input, uint8_t* const p_out, const uintptr_t p_size, const bool p_encode)
+		{
+			const std::span<const uint8_t> input{p_input, p_size};
+			const std::span<uint8_t> out{p_out, p_size};
+
+			if(p_pool)
+			{
+				return p_encode ? p_gcm.encode(*p_pool, input, out) : p_gcm.decode(*p_pool, input, out);
+			}
+			return p_encode ? p_gcm.encode(input, out) : p_gcm.decode(input, out);
+		}
+
+		//	Note: The output is only moved into place once it is complete, and for decoding once the tag is verified.
+		static std::filesystem::path partial_path(const std::filesystem::path& p_output)
+		{
+			std::filesystem::path out = p_output;
+			out += ".part";
+			return out;
+		}
+
+		template<typename AES_t>
+		static bool crypt_file(const typename AES_t::key_schedule_t& p_wkey, std::span<const uint8_t> p_iv, std::span<const uint8_t> p_aad,
+			const std::filesystem::path& p_input, const std::filesystem::path& p_output, const typename AES_GCM_file<AES_t>::options_t& p_options, const bool p_encode)
+		{
+			constexpr uintptr_t tag_lenght = AES_GCM_file<AES_t>::tag_lenght;
+			const uintptr_t chunk_size = p_options.chunk_size;
+
+			if(p_iv.empty() || chunk_size == 0 || chunk_size % AES_t::block_lenght || p_options.buffer_count == 0
+				|| chunk_size > AES_GCM_file<AES_t>::max_ring_size / p_options.buffer_count)
+			{
+				return false;
+			}
+
+			{
+				std::error_code error;
+				if(std::filesystem::equivalent(p_input, p_output, error))
+				{
+					return false;
+				}
+			}
+
+			mapped_file mapping;
+			std::ifstream in_stream;
+			uint64_t data_size = 0;
+			if(p_options.memory_map)
+			{
+				if(!mapping.open(p_input))
+				{
+					return false;
+				}
+				data_size = mapping.data().size();
+			}
+			else
+			{
+				in_stream.open(p_input, std::ios::binary);
+				std::error_code error;
+				data_size = std::filesystem::file_size(p_input, error);
+				if(!in_stream || error)
+				{
+					return false;
+				}
+			}
+
+			if(!p_encode)
+			{
+				if(data_size < tag_lenght)
+				{
+					return false;
+				}
+				data_size -= tag_lenght;
+			}
+
+			if(data_size > AES_GCM<AES_t>::max_data_size)
+			{
+				return false;
+			}
+
+			AES_GCM<AES_t> gcm;
+			gcm.set_key(p_wkey);
+			if(!gcm.reset(p_iv) || !gcm.update_aad(p_aad))
+			{
+				return false;
+			}
+
+			const std::filesystem::path out_path = partial_path(p_output);
+			std::ofstream out_stream(out_path, std::ios::binary | std::ios::trunc);
+			if(!out_stream)
+			{
+				return false;
+			}
+
+			pipeline_t pipe(p_options.buffer_count, chunk_size);
+			alignas(8) std::array<uint8_t, tag_lenght> tag{};
+
+			std::thread writer([&]
+				{
+					uint32_t slot;
+					while(pipe.processed.pop(slot))
+					{
+						if(!out_stream.write(reinterpret_cast<const char*>(pipe.buffers[slot].data()), static_cast<std::streamsize>(pipe.sizes[slot])))
+						{
+							pipe.fail();
+							return;
+						}
+						pipe.free.push(slot);
+					}
+				});
+
+			std::thread reader;
+			if(!p_options.memory_map)
+			{
+				reader = std::thread([&]
+					{
+						for(uint64_t offset = 0; offset < data_size;)
+						{
+							uint32_t slot;
+							if(!pipe.free.pop(slot))
+							{
+								return;
+							}
+							const uintptr_t size = static_cast<uintptr_t>(std::min<uint64_t>(chunk_size, data_size - offset));
+							if(!in_stream.read(reinterpret_cast<char*>(pipe.buffers[slot].data()), static_cast<std::streamsize>(size)))
+							{
+								pipe.fail();
+								return;
+							}
+							pipe.sizes[slot] = size;
+							pipe.filled.push(slot);
+							offset += size;
+						}
+
+						if(!p_encode && !in_stream.read(reinterpret_cast<char*>(tag.data()), tag_lenght))
+						{
+							pipe.fail();
+							return;
+						}
+						pipe.filled.close();
+					});
+			}
+
+			for(uint64_t offset = 0; offset < data_size;)
+			{
+				uint32_t slot;
+				const uint8_t* input;
+				uintptr_t size;
+				if(p_options.memory_map)
+				{
+					if(!pipe.free.pop(slot))
+					{
+						break;
+					}
+					size	= static_cast<uintptr_t>(std::min<uint64_t>(chunk_size, data_size - offset));
+					input	= mapping.data().data() + offset;
+				}
+				else
+				{
+					if(!pipe.filled.pop(slot))
+					{
+						break;
+					}
+					size	= pipe.sizes[slot];
+					input	= pipe.buffers[slot].data();
+				}
+
+				if(!crypt_chunk<AES_t>(gcm, p_options.pool, input, pipe.buffers[slot].data(), size, p_encode))
+				{
+					pipe.fail();
+					break;
+				}
+				pipe.sizes[slot] = size;
+				pipe.processed.push(slot);
+				offset += size;
+			}
+			pipe.processed.close();
+
+			if(reader.joinable())
+			{
+				reader.join();
+			}
+			writer.join();
+
+			bool result = !pipe.failed.load(std::memory_order_relaxed);
+			if(result)
+			{
+				gcm.finalize();
+				if(p_encode)
+				{
+					result = static_cast<bool>(out_stream.write(reinterpret_cast<const char*>(gcm.tag().data()), tag_lenght));
+				}
+				else
+				{
+					if(p_options.memory_map)
+					{
+						memcpy(tag.data(), mapping.data().data() + data_size, tag_lenght);
+					}
+					result = gcm.verify(tag);
+				}
+			}
+
+			out_stream.close();
+			result = result && !out_stream.fail();
+
+			std::error_code error;
+			if(result)
+			{
+				std::filesystem::rename(out_path, p_output, error);
+				result = !error;
+			}
+			if(!result)
+			{
+				std::filesystem::remove(out_path, error);
+			}
+			return result;
+		}
+	} //namespace
+
+	template<typename AES_t>
+	bool AES_GCM_file<AES_t>::encode(const key_schedule_t& p_wkey, std::span<const uint8_t> p_iv, std::span<const uint8_t> p_aad,
+		const std::filesystem::path& p_input, const std::filesystem::path& p_output, const options_t& p_options)
+	{
+		return crypt_file<AES_t>(p_wkey, p_iv, p_aad, p_input, p_output, p_options, true);
+	}
+
+	template<typename AES_t>
+	bool AES_GCM_file<AES_t>::decode(const key_schedule_t& p_wkey, std::span<const uint8_t> p_iv, std::span<const uint8_t> p_aad,
+		const std::filesystem::path& p_input, const std::filesystem::path& p_output, const options_t& p_options)
+	{
+		return crypt_file<AES_t>(p_wkey, p_iv, p_aad, p_input, p_output, p_options, false);
+	}
+
+	template class AES_GCM_file<AES_128>;
+	template class AES_GCM_file<AES_192>;
+	template class AES_GCM_file<AES_256>;
+
+} //namespace crypto
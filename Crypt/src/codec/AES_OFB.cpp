@@ -0,0 +1,230 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+
+#include <Crypt/codec/AES_OFB.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include "block_help.hpp"
+#include "AES_engine.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		static constexpr uintptr_t chunk_blocks = 64;
+		alignas(16) static constexpr std::array<uint8_t, chunk_blocks * 16> zero_input{};
+
+		//	Note: Each key stream block is the encoding of the previous one, which is CBC over zero blocks.
+		//	p_register is updated to the last block.
+		template<typename AES_t>
+		static void generate(const typename AES_t::key_schedule_t& p_wkey, uint8_t* const p_register, uint8_t* p_out, uintptr_t p_count)
+		{
+			while(p_count)
+			{
+				const uintptr_t block_count = std::min(p_count, chunk_blocks);
+				_p::AES_cbc_encode<AES_t>(p_wkey, p_register, zero_input.data(), p_out, block_count);
+				p_out	+= block_count * AES_t::block_lenght;
+				p_count	-= block_count;
+			}
+		}
+	} //namespace
+
+	template<typename AES_t>
+	void AES_OFB<AES_t>::reset(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_iv)
+	{
+		m_wkey = p_wkey;
+		memcpy(m_register.data(), p_iv.data(), block_lenght);
+		m_cached_size = 0;
+	}
+
+	template<typename AES_t>
+	void AES_OFB<AES_t>::update(std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		const uint8_t*	pivot	= p_input.data();
+		uint8_t*		out		= p_out.data();
+		uintptr_t		size	= p_input.size();
+
+		if(m_cached_size)
+		{
+			const uintptr_t count = std::min<uintptr_t>(m_cached_size, size);
+			xor_bytes(out, pivot, m_register.data() + (block_lenght - m_cached_size), count);
+			m_cached_size = static_cast<uint8_t>(m_cached_size - count);
+			pivot	+= count;
+			out		+= count;
+			size	-= count;
+		}
+
+		alignas(16) std::array<uint8_t, chunk_blocks * block_lenght> key_stream;
+		while(size >= block_lenght)
+		{
+			const uintptr_t block_count	= std::min(size / block_lenght, chunk_blocks);
+			const uintptr_t chunk_size	= block_count * block_lenght;
+
+			generate<AES_t>(m_wkey, m_register.data(), key_stream.data(), block_count);
+			xor_bytes(out, pivot, key_stream.data(), chunk_size);
+
+			pivot	+= chunk_size;
+			out		+= chunk_size;
+			size	-= chunk_size;
+		}
+
+		if(size)
+		{
+			AES_t::encode(m_wkey, m_register, m_register);
+			xor_bytes(out, pivot, m_register.data(), size);
+			m_cached_size = static_cast<uint8_t>(block_lenght - size);
+		}
+	}
+
+	template<typename AES_t>
+	void AES_OFB<AES_t>::update(std::span<uint8_t> p_data)
+	{
+		update(p_data, p_data);
+	}
+
+	template<typename AES_t>
+	void AES_OFB<AES_t>::key_stream(std::span<uint8_t> p_out)
+	{
+		uint8_t*	out		= p_out.data();
+		uintptr_t	size	= p_out.size();
+
+		if(m_cached_size)
+		{
+			const uintptr_t count = std::min<uintptr_t>(m_cached_size, size);
+			memcpy(out, m_register.data() + (block_lenght - m_cached_size), count);
+			m_cached_size = static_cast<uint8_t>(m_cached_size - count);
+			out		+= count;
+			size	-= count;
+		}
+
+		if(size >= block_lenght)
+		{
+			const uintptr_t block_count	= size / block_lenght;
+			generate<AES_t>(m_wkey, m_register.data(), out, block_count);
+			out		+= block_count * block_lenght;
+			size	-= block_count * block_lenght;
+		}
+
+		if(size)
+		{
+			AES_t::encode(m_wkey, m_register, m_register);
+			memcpy(out, m_register.data(), size);
+			m_cached_size = static_cast<uint8_t>(block_lenght - size);
+		}
+	}
+
+
+	template<typename AES_t>
+	AES_OFB_buffer<AES_t>::AES_OFB_buffer(const uintptr_t p_capacity)
+		: m_buffer(std::max<uintptr_t>((p_capacity + block_lenght - 1) / block_lenght, 1) * block_lenght)
+	{
+	}
+
+	template<typename AES_t>
+	AES_OFB_buffer<AES_t>::~AES_OFB_buffer()
+	{
+		wipe(m_buffer.data(), m_buffer.size());
+	}
+
+	template<typename AES_t>
+	void AES_OFB_buffer<AES_t>::reset(const key_schedule_t& p_wkey, std::span<const uint8_t, block_lenght> p_iv)
+	{
+		m_generator.reset(p_wkey, p_iv);
+		wipe(m_buffer.data(), m_buffer.size());
+		m_produced.store(0, std::memory_order_relaxed);
+		m_consumed.store(0, std::memory_order_relaxed);
+	}
+
+	//	Note: Only the free part of the ring is written, the consumer releases what it has used through m_consumed.
+	template<typename AES_t>
+	uintptr_t AES_OFB_buffer<AES_t>::fill()
+	{
+		const uintptr_t capacity	= m_buffer.size();
+		const uint64_t produced		= m_produced.load(std::memory_order_relaxed);
+		const uintptr_t free		= static_cast<uintptr_t>(capacity - (produced - m_consumed.load(std::memory_order_acquire)));
+		if(!free)
+		{
+			return 0;
+		}
+
+		const uintptr_t offset	= static_cast<uintptr_t>(produced % capacity);
+		const uintptr_t first	= std::min(free, capacity - offset);
+		m_generator.key_stream(std::span<uint8_t>{m_buffer.data() + offset, first});
+		m_generator.key_stream(std::span<uint8_t>{m_buffer.data(), free - first});
+
+		m_produced.store(produced + free, std::memory_order_release);
+		return free;
+	}
+
+	template<typename AES_t>
+	uintptr_t AES_OFB_buffer<AES_t>::available() const
+	{
+		return static_cast<uintptr_t>(m_produced.load(std::memory_order_acquire) - m_consumed.load(std::memory_order_relaxed));
+	}
+
+	template<typename AES_t>
+	bool AES_OFB_buffer<AES_t>::update(std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		const uintptr_t capacity	= m_buffer.size();
+		const uintptr_t size		= p_input.size();
+		const uint64_t consumed		= m_consumed.load(std::memory_order_relaxed);
+		if(m_produced.load(std::memory_order_acquire) - consumed < size)
+		{
+			return false;
+		}
+
+		const uintptr_t offset	= static_cast<uintptr_t>(consumed % capacity);
+		const uintptr_t first	= std::min(size, capacity - offset);
+		xor_bytes(p_out.data(), p_input.data(), m_buffer.data() + offset, first);
+		xor_bytes(p_out.data() + first, p_input.data() + first, m_buffer.data(), size - first);
+
+		//	Note: Used key stream is wiped before it is released, so that past data can not be recovered from the ring.
+		memset(m_buffer.data() + offset, 0, first);
+		memset(m_buffer.data(), 0, size - first);
+
+		m_consumed.store(consumed + size, std::memory_order_release);
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_OFB_buffer<AES_t>::update(std::span<uint8_t> p_data)
+	{
+		return update(p_data, p_data);
+	}
+
+	template class AES_OFB<AES_128>;
+	template class AES_OFB<AES_192>;
+	template class AES_OFB<AES_256>;
+
+	template class AES_OFB_buffer<AES_128>;
+	template class AES_OFB_buffer<AES_192>;
+	template class AES_OFB_buffer<AES_256>;
+} //namespace crypto
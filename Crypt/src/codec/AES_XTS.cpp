@@ -0,0 +1,220 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/AES_XTS.hpp>
+
+#include <cstring>
+
+#include <CoreLib/core_endian.hpp>
+
+#include "AES_engine.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		//	Note: Number of sector tweaks encrypted together
+		static constexpr uintptr_t tweak_stride = 8;
+
+		///	\brief Multiplication by x in GF(2^128), little endian (IEEE 1619)
+		static inline void xts_double(uint8_t* const p_tweak)
+		{
+			uint64_t lo;
+			uint64_t hi;
+			memcpy(&lo, p_tweak, 8);
+			memcpy(&hi, p_tweak + 8, 8);
+			lo = core::endian_little2host(lo);
+			hi = core::endian_little2host(hi);
+
+			const uint64_t carry = hi >> 63;
+			hi = (hi << 1) | (lo >> 63);
+			lo = (lo << 1) ^ (0x87 & (0 - carry));
+
+			lo = core::endian_host2little(lo);
+			hi = core::endian_host2little(hi);
+			memcpy(p_tweak, &lo, 8);
+			memcpy(p_tweak + 8, &hi, 8);
+		}
+	} //namespace
+
+	template<typename AES_t>
+	bool AES_XTS<AES_t>::set_key(const key_schedule_t& p_data_key, const key_schedule_t& p_tweak_key)
+	{
+		//	Note: Equal keys give equal schedules, compared in constant time.
+		const uint8_t* const data_key	= reinterpret_cast<const uint8_t*>(p_data_key.wkey.data());
+		const uint8_t* const tweak_key	= reinterpret_cast<const uint8_t*>(p_tweak_key.wkey.data());
+		uint8_t diff = 0;
+		for(uintptr_t i = 0; i < sizeof(p_data_key.wkey); ++i)
+		{
+			diff |= static_cast<uint8_t>(data_key[i] ^ tweak_key[i]);
+		}
+		if(diff == 0)
+		{
+			return false;
+		}
+
+		m_data_key  = p_data_key;
+		m_tweak_key = p_tweak_key;
+		AES_t::make_dec_key_schedule(p_data_key, m_data_dkey);
+		return true;
+	}
+
+	//	Note: p_tweak is the encrypted tweak and is used as scratch.
+	template<typename AES_t>
+	template<bool Encode>
+	void AES_XTS<AES_t>::process_unit(uint8_t* const p_tweak, const uint8_t* const p_input, uint8_t* const p_out, const uintptr_t p_size) const
+	{
+		const uintptr_t remainder	= p_size % block_lenght;
+		const uintptr_t block_count	= p_size / block_lenght - (remainder ? 1 : 0);
+
+		if constexpr(Encode)
+		{
+			_p::AES_xts_encode<AES_t>(m_data_key, p_tweak, p_input, p_out, block_count);
+		}
+		else
+		{
+			_p::AES_xts_decode<AES_t>(m_data_dkey, p_tweak, p_input, p_out, block_count);
+		}
+
+		if(remainder == 0)
+		{
+			return;
+		}
+
+		//	Cipher text stealing, the last full block and the partial block
+		const uint8_t* const input	= p_input + block_count * block_lenght;
+		uint8_t* const out			= p_out   + block_count * block_lenght;
+
+		alignas(16) std::array<uint8_t, block_lenght> tweak_next;
+		alignas(16) std::array<uint8_t, block_lenght> block;
+		alignas(16) std::array<uint8_t, block_lenght> stolen;
+		memcpy(tweak_next.data(), p_tweak, block_lenght);
+		xts_double(tweak_next.data());
+
+		if constexpr(Encode)
+		{
+			//	CC = code(P[m-1]), C[m] = CC[0, r), C[m-1] = code(P[m] || CC[r, 16))
+			_p::AES_xts_encode<AES_t>(m_data_key, p_tweak, input, block.data(), 1);
+			memcpy(stolen.data(), input + block_lenght, remainder);
+			memcpy(stolen.data() + remainder, block.data() + remainder, block_lenght - remainder);
+			memcpy(out + block_lenght, block.data(), remainder);
+			_p::AES_xts_encode<AES_t>(m_data_key, tweak_next.data(), stolen.data(), out, 1);
+		}
+		else
+		{
+			//	PP = decode(C[m-1]) with the tweak of block m, P[m] = PP[0, r), P[m-1] = decode(C[m] || PP[r, 16))
+			_p::AES_xts_decode<AES_t>(m_data_dkey, tweak_next.data(), input, block.data(), 1);
+			memcpy(stolen.data(), input + block_lenght, remainder);
+			memcpy(stolen.data() + remainder, block.data() + remainder, block_lenght - remainder);
+			memcpy(out + block_lenght, block.data(), remainder);
+			_p::AES_xts_decode<AES_t>(m_data_dkey, p_tweak, stolen.data(), out, 1);
+		}
+	}
+
+	template<typename AES_t>
+	bool AES_XTS<AES_t>::encode(std::span<const uint8_t, block_lenght> p_tweak, std::span<const uint8_t> p_input, std::span<uint8_t> p_out) const
+	{
+		if(p_input.size() < block_lenght)
+		{
+			return false;
+		}
+
+		alignas(16) tweak_t tweak;
+		AES_t::encode(m_tweak_key, p_tweak, tweak);
+		process_unit<true>(tweak.data(), p_input.data(), p_out.data(), p_input.size());
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_XTS<AES_t>::decode(std::span<const uint8_t, block_lenght> p_tweak, std::span<const uint8_t> p_input, std::span<uint8_t> p_out) const
+	{
+		if(p_input.size() < block_lenght)
+		{
+			return false;
+		}
+
+		alignas(16) tweak_t tweak;
+		AES_t::encode(m_tweak_key, p_tweak, tweak);
+		process_unit<false>(tweak.data(), p_input.data(), p_out.data(), p_input.size());
+		return true;
+	}
+
+	//	Note: The tweaks of several sectors are encrypted together through the multi-block path.
+	template<typename AES_t>
+	template<bool Encode>
+	bool AES_XTS<AES_t>::process_sectors(uint64_t p_sector, const uintptr_t p_sector_size, std::span<const uint8_t> p_input, std::span<uint8_t> p_out) const
+	{
+		if(p_sector_size < block_lenght || p_input.size() % p_sector_size)
+		{
+			return false;
+		}
+
+		const uint8_t*	input	= p_input.data();
+		uint8_t*		out		= p_out.data();
+		uintptr_t		count	= p_input.size() / p_sector_size;
+
+		alignas(16) std::array<uint8_t, block_lenght * tweak_stride> tweaks;
+
+		while(count)
+		{
+			const uintptr_t sector_count = count < tweak_stride ? count : tweak_stride;
+			for(uintptr_t i = 0; i < sector_count; ++i, ++p_sector)
+			{
+				const uint64_t lo = core::endian_host2little(p_sector);
+				const uint64_t hi = 0;
+				memcpy(tweaks.data() + i * block_lenght, &lo, 8);
+				memcpy(tweaks.data() + i * block_lenght + 8, &hi, 8);
+			}
+			AES_t::encode_blocks(m_tweak_key, std::span<const uint8_t>{tweaks.data(), sector_count * block_lenght}, tweaks);
+
+			for(uintptr_t i = 0; i < sector_count; ++i)
+			{
+				process_unit<Encode>(tweaks.data() + i * block_lenght, input, out, p_sector_size);
+				input	+= p_sector_size;
+				out		+= p_sector_size;
+			}
+			count -= sector_count;
+		}
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_XTS<AES_t>::encode_sectors(const uint64_t p_sector, const uintptr_t p_sector_size, std::span<const uint8_t> p_input, std::span<uint8_t> p_out) const
+	{
+		return process_sectors<true>(p_sector, p_sector_size, p_input, p_out);
+	}
+
+	template<typename AES_t>
+	bool AES_XTS<AES_t>::decode_sectors(const uint64_t p_sector, const uintptr_t p_sector_size, std::span<const uint8_t> p_input, std::span<uint8_t> p_out) const
+	{
+		return process_sectors<false>(p_sector, p_sector_size, p_input, p_out);
+	}
+
+	template class AES_XTS<AES_128>;
+	template class AES_XTS<AES_256>;
+
+} //namespace crypto
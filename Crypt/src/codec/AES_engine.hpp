@@ -0,0 +1,81 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <cstdint>
+#include <array>
+
+#include <Crypt/codec/AES.hpp>
+
+//	Note: Entry points into the active AES engine that are shared by the modes of operation,
+//	but are too specialized to be part of the public interface.
+namespace crypto::_p
+{
+	///	\brief 128 bit block counter, [0] is the most significant half. Host endianess.
+	using AES_counter_t = std::array<uint64_t, 2>;
+
+	///	\brief true if the active engine is built on AES-NI (\ref AES_engine::AES_NI or one of the VAES engines),
+	///		kernels outside of the engines can then use the AES instructions directly.
+	bool AES_NI_active();
+
+	///	\brief p_out = p_input ^ encode(counter++), for p_count consecutive blocks.
+	///		The counter is incremented as a 128 bit integer and wraps around.
+	///	\note p_out can be the same buffer as p_input
+	template<typename AES_t>
+	void AES_ctr_xor(const typename AES_t::key_schedule_t& p_wkey, AES_counter_t& p_counter, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count);
+
+	///	\brief Cipher block chaining over p_count blocks.
+	///		p_iv (16 bytes) is updated to the last cipher text block, so that calls can be chained.
+	///	\note p_out can be the same buffer as p_input
+	template<typename AES_t>
+	void AES_cbc_encode(const typename AES_t::key_schedule_t& p_wkey, uint8_t* p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count);
+
+	///	\brief Same as \ref AES_cbc_encode without writing the cipher text (CBC-MAC), only p_iv is updated.
+	template<typename AES_t>
+	void AES_cbc_mac(const typename AES_t::key_schedule_t& p_wkey, uint8_t* p_iv, const uint8_t* p_input, uintptr_t p_count);
+
+	///	\brief Cipher feedback (CFB-128) encoding over p_count blocks: p_out = p_input ^ encode(previous cipher text block)
+	///		p_iv (16 bytes) is updated to the last cipher text block, so that calls can be chained.
+	///		Decoding has no chain, it is done with the multi-block encode.
+	///	\note p_out can be the same buffer as p_input
+	template<typename AES_t>
+	void AES_cfb_encode(const typename AES_t::key_schedule_t& p_wkey, uint8_t* p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count);
+
+	template<typename AES_t>
+	void AES_cbc_decode(const typename AES_t::dec_key_schedule_t& p_dkey, uint8_t* p_iv, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count);
+
+	///	\brief XEX tweaked encode/decode over p_count blocks: p_out = code(p_input ^ T) ^ T
+	///		p_tweak (16 bytes) is doubled in GF(2^128) after every block and updated, so that calls can be chained.
+	///	\note p_out can be the same buffer as p_input
+	template<typename AES_t>
+	void AES_xts_encode(const typename AES_t::key_schedule_t& p_wkey, uint8_t* p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count);
+
+	template<typename AES_t>
+	void AES_xts_decode(const typename AES_t::dec_key_schedule_t& p_dkey, uint8_t* p_tweak, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count);
+
+} //namespace crypto::_p
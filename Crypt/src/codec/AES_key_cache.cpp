@@ -0,0 +1,302 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+
+#include <Crypt/codec/AES_key_cache.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#include <Crypt/hash/crc.hpp>
+
+#include "block_help.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		//	Note: Entries are read without locks, the writer makes the sequence number odd while it changes an entry
+		//	and the reader discards what it read if the sequence number changed in the meantime.
+		//	Every field is an atomic word so that a read racing with a write is still well defined.
+		template<typename AES_t>
+		struct alignas(64) entry_t
+		{
+			static constexpr uintptr_t key_words		= AES_t::key_lenght / 8;
+			static constexpr uintptr_t schedule_words	= sizeof(typename AES_t::key_schedule_t) / 8;
+
+			std::atomic<uint32_t>								sequence{0};
+			std::atomic<uint8_t>								used{0};
+			std::atomic<uint8_t>								referenced{0};	//!< CLOCK reference bit, set by lookups
+			std::array<std::atomic<uint64_t>, key_words>		key{};
+			std::array<std::atomic<uint64_t>, schedule_words>	schedule{};
+		};
+
+		//	Note: The hashes of a set share a cache line, a lookup only reads the entries whose hash matches.
+		template<typename AES_t>
+		struct alignas(64) set_t
+		{
+			static constexpr uintptr_t ways = AES_key_cache<AES_t>::ways;
+
+			std::array<std::atomic<uint32_t>, ways>	hash{};
+			alignas(64) std::array<entry_t<AES_t>, ways> entry;
+			std::mutex	lock;		//!< Held by writers only
+			uint8_t		hand = 0;	//!< CLOCK hand, protected by lock
+		};
+
+		static uint32_t hash_key(std::span<const uint8_t> p_key)
+		{
+			CRC_32C crc;
+			crc.update(p_key);
+			return crc.digest();
+		}
+
+		template<typename AES_t>
+		static bool matches(const entry_t<AES_t>& p_entry, std::span<const uint8_t, AES_t::key_lenght> p_key)
+		{
+			if(!p_entry.used.load(std::memory_order_relaxed))
+			{
+				return false;
+			}
+
+			uint8_t diff = 0;
+			for(uintptr_t i = 0; i < entry_t<AES_t>::key_words; ++i)
+			{
+				uint64_t word;
+				memcpy(&word, p_key.data() + i * 8, 8);
+				diff |= static_cast<uint8_t>(p_entry.key[i].load(std::memory_order_relaxed) != word);
+			}
+			return !diff;
+		}
+
+		//	Note: An entry being written is treated as a miss rather than waited on,
+		//	the entry only ever changes to hold a different key.
+		template<typename AES_t>
+		static bool read_entry(entry_t<AES_t>& p_entry, std::span<const uint8_t, AES_t::key_lenght> p_key, typename AES_t::key_schedule_t& p_out)
+		{
+			const uint32_t sequence = p_entry.sequence.load(std::memory_order_acquire);
+			if((sequence & 1) || !matches<AES_t>(p_entry, p_key))
+			{
+				return false;
+			}
+
+			uint8_t* const out = reinterpret_cast<uint8_t*>(&p_out);
+			for(uintptr_t i = 0; i < entry_t<AES_t>::schedule_words; ++i)
+			{
+				const uint64_t word = p_entry.schedule[i].load(std::memory_order_relaxed);
+				memcpy(out + i * 8, &word, 8);
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if(p_entry.sequence.load(std::memory_order_relaxed) != sequence)
+			{
+				wipe(&p_out, sizeof(p_out));
+				return false;
+			}
+
+			if(!p_entry.referenced.load(std::memory_order_relaxed))
+			{
+				p_entry.referenced.store(1, std::memory_order_relaxed);
+			}
+			return true;
+		}
+
+		template<typename AES_t>
+		static bool read_set(set_t<AES_t>& p_set, const uint32_t p_hash, std::span<const uint8_t, AES_t::key_lenght> p_key,
+			typename AES_t::key_schedule_t& p_out)
+		{
+			for(uintptr_t i = 0; i < set_t<AES_t>::ways; ++i)
+			{
+				if(p_set.hash[i].load(std::memory_order_relaxed) == p_hash && read_entry<AES_t>(p_set.entry[i], p_key, p_out))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		//	Note: Writes the key and schedule, or zeroes the entry when p_key is empty. The set lock must be held.
+		//	The hash is only a filter, readers still compare the key.
+		template<typename AES_t>
+		static void write_entry(set_t<AES_t>& p_set, const uintptr_t p_way, const uint32_t p_hash, std::span<const uint8_t> p_key,
+			const typename AES_t::key_schedule_t* const p_wkey)
+		{
+			entry_t<AES_t>& entry = p_set.entry[p_way];
+			const uint32_t sequence = entry.sequence.load(std::memory_order_relaxed);
+			entry.sequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			const bool used = !p_key.empty();
+			for(uintptr_t i = 0; i < entry_t<AES_t>::key_words; ++i)
+			{
+				uint64_t word = 0;
+				if(used) memcpy(&word, p_key.data() + i * 8, 8);
+				entry.key[i].store(word, std::memory_order_relaxed);
+			}
+
+			const uint8_t* const wkey = reinterpret_cast<const uint8_t*>(p_wkey);
+			for(uintptr_t i = 0; i < entry_t<AES_t>::schedule_words; ++i)
+			{
+				uint64_t word = 0;
+				if(used) memcpy(&word, wkey + i * 8, 8);
+				entry.schedule[i].store(word, std::memory_order_relaxed);
+			}
+
+			entry.referenced.store(0, std::memory_order_relaxed);
+			entry.used.store(used ? 1 : 0, std::memory_order_relaxed);
+
+			entry.sequence.store(sequence + 2, std::memory_order_release);
+			p_set.hash[p_way].store(used ? p_hash : 0, std::memory_order_relaxed);
+		}
+
+		template<typename AES_t>
+		static void wipe_entry(set_t<AES_t>& p_set, const uintptr_t p_way)
+		{
+			write_entry<AES_t>(p_set, p_way, 0, {}, nullptr);
+		}
+
+		//	Note: Free entries are used first, otherwise the hand skips and clears referenced entries until it finds one that is not.
+		template<typename AES_t>
+		static uintptr_t select_victim(set_t<AES_t>& p_set)
+		{
+			for(uintptr_t i = 0; i < set_t<AES_t>::ways; ++i)
+			{
+				if(!p_set.entry[i].used.load(std::memory_order_relaxed))
+				{
+					return i;
+				}
+			}
+
+			for(;;)
+			{
+				const uintptr_t way = p_set.hand;
+				p_set.hand = static_cast<uint8_t>((way + 1) % set_t<AES_t>::ways);
+				if(!p_set.entry[way].referenced.exchange(0, std::memory_order_relaxed))
+				{
+					return way;
+				}
+			}
+		}
+	} //namespace
+
+	template<typename AES_t>
+	struct AES_key_cache<AES_t>::state_t
+	{
+		std::unique_ptr<set_t<AES_t>[]> sets;
+		uintptr_t set_mask;
+	};
+
+	template<typename AES_t>
+	AES_key_cache<AES_t>::AES_key_cache(const uintptr_t p_capacity)
+		: m_state(new state_t)
+	{
+		const uintptr_t set_count = std::bit_ceil(std::max<uintptr_t>((p_capacity + ways - 1) / ways, 1));
+		m_state->sets.reset(new set_t<AES_t>[set_count]);
+		m_state->set_mask = set_count - 1;
+	}
+
+	template<typename AES_t>
+	AES_key_cache<AES_t>::~AES_key_cache()
+	{
+		clear();
+		delete m_state;
+	}
+
+	template<typename AES_t>
+	uintptr_t AES_key_cache<AES_t>::capacity() const
+	{
+		return (m_state->set_mask + 1) * ways;
+	}
+
+	template<typename AES_t>
+	void AES_key_cache<AES_t>::get(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_out)
+	{
+		const uint32_t hash = hash_key(p_key);
+		set_t<AES_t>& set = m_state->sets[hash & m_state->set_mask];
+
+		if(read_set<AES_t>(set, hash, p_key, p_out)) return;
+
+		//	Note: Looked up again under the lock, another thread may have inserted the same key.
+		const std::lock_guard lock(set.lock);
+		if(read_set<AES_t>(set, hash, p_key, p_out)) return;
+
+		AES_t::make_key_schedule(p_key, p_out);
+		write_entry<AES_t>(set, select_victim(set), hash, p_key, &p_out);
+	}
+
+	template<typename AES_t>
+	bool AES_key_cache<AES_t>::find(std::span<const uint8_t, key_lenght> p_key, key_schedule_t& p_out) const
+	{
+		const uint32_t hash = hash_key(p_key);
+		set_t<AES_t>& set = m_state->sets[hash & m_state->set_mask];
+
+		if(read_set<AES_t>(set, hash, p_key, p_out)) return true;
+
+		wipe(&p_out, sizeof(p_out));
+		return false;
+	}
+
+	template<typename AES_t>
+	void AES_key_cache<AES_t>::erase(std::span<const uint8_t, key_lenght> p_key)
+	{
+		const uint32_t hash = hash_key(p_key);
+		set_t<AES_t>& set = m_state->sets[hash & m_state->set_mask];
+
+		const std::lock_guard lock(set.lock);
+		for(uintptr_t i = 0; i < ways; ++i)
+		{
+			if(set.hash[i].load(std::memory_order_relaxed) == hash && matches<AES_t>(set.entry[i], p_key))
+			{
+				wipe_entry(set, i);
+			}
+		}
+	}
+
+	template<typename AES_t>
+	void AES_key_cache<AES_t>::clear()
+	{
+		for(uintptr_t i = 0; i <= m_state->set_mask; ++i)
+		{
+			set_t<AES_t>& set = m_state->sets[i];
+			const std::lock_guard lock(set.lock);
+			for(uintptr_t way = 0; way < ways; ++way)
+			{
+				wipe_entry(set, way);
+			}
+			set.hand = 0;
+		}
+	}
+
+	template class AES_key_cache<AES_128>;
+	template class AES_key_cache<AES_192>;
+	template class AES_key_cache<AES_256>;
+} //namespace crypto
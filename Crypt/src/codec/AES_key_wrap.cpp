@@ -0,0 +1,419 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/AES_key_wrap.hpp>
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include <CoreLib/core_endian.hpp>
+
+#include "isa_target.hpp"
+#include "AES_engine.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		//	Note: Semiblocks are kept in memory order, the step counter t is xored in as a big endian integer.
+		static constexpr uint64_t KW_IV		= 0xA6A6A6A6A6A6A6A6;
+		static constexpr uint32_t KWP_ICV	= 0xA65959A6;
+
+		static inline uint64_t load_semiblock(const uint8_t* const p_input)
+		{
+			uint64_t res;
+			memcpy(&res, p_input, 8);
+			return res;
+		}
+
+		static inline void store_semiblock(const uint64_t p_value, uint8_t* const p_out)
+		{
+			memcpy(p_out, &p_value, 8);
+		}
+
+		///	\brief W (RFC 3394 2.2.1), p_R holds the p_count semiblocks after p_A
+		template<typename AES_t>
+		static void wrap_chain(const typename AES_t::key_schedule_t& p_wkey, uint64_t& p_A, uint8_t* const p_R, const uintptr_t p_count)
+		{
+			alignas(16) std::array<uint8_t, 16> block;
+			alignas(16) std::array<uint8_t, 16> res;
+			uint64_t A = p_A;
+			uint64_t t = 0;
+			for(uintptr_t j = 0; j < 6; ++j)
+			{
+				uint8_t* R = p_R;
+				for(uintptr_t i = 0; i < p_count; ++i, R += 8)
+				{
+					store_semiblock(A, block.data());
+					memcpy(block.data() + 8, R, 8);
+					AES_t::encode(p_wkey, block, res);
+					A = load_semiblock(res.data()) ^ core::endian_host2big(++t);
+					memcpy(R, res.data() + 8, 8);
+				}
+			}
+			p_A = A;
+		}
+
+		///	\brief W^-1 (RFC 3394 2.2.2), p_R holds the p_count semiblocks after p_A
+		template<typename AES_t>
+		static void unwrap_chain(const typename AES_t::dec_key_schedule_t& p_dkey, uint64_t& p_A, uint8_t* const p_R, const uintptr_t p_count)
+		{
+			alignas(16) std::array<uint8_t, 16> block;
+			alignas(16) std::array<uint8_t, 16> res;
+			uint64_t A = p_A;
+			uint64_t t = 6 * static_cast<uint64_t>(p_count);
+			for(uintptr_t j = 0; j < 6; ++j)
+			{
+				uint8_t* R = p_R + p_count * 8;
+				for(uintptr_t i = 0; i < p_count; ++i)
+				{
+					R -= 8;
+					store_semiblock(A ^ core::endian_host2big(t--), block.data());
+					memcpy(block.data() + 8, R, 8);
+					AES_t::decode(p_dkey, block, res);
+					A = load_semiblock(res.data());
+					memcpy(R, res.data() + 8, 8);
+				}
+			}
+			p_A = A;
+		}
+
+		///	\return false if p_input is not a valid wrapped key or p_out can not hold the result
+		template<bool Padded>
+		static inline bool valid_unwrap_size(const uintptr_t p_input_size, const uintptr_t p_out_size)
+		{
+			constexpr uintptr_t min_size = Padded ? 16 : 24;
+			return p_input_size >= min_size && (p_input_size % 8) == 0 && p_out_size >= p_input_size - 8;
+		}
+
+		//	Note: The integrity check of the result, p_R holds the p_count semiblocks that were unwrapped.
+		//	Nothing about the key is released if it fails, p_R is zeroed.
+		template<bool Padded>
+		static bool finish_unwrap(const uint64_t p_A, uint8_t* const p_R, const uintptr_t p_count, uintptr_t& p_out_size)
+		{
+			const uintptr_t size = p_count * 8;
+			uintptr_t key_size = size;
+			bool valid;
+
+			if constexpr(Padded)
+			{
+				const uint64_t A = core::endian_big2host(p_A);
+				const uint64_t MLI = A & 0xFFFFFFFF;
+				valid = (A >> 32) == KWP_ICV && MLI + 8 > size && MLI <= size;
+				if(valid)
+				{
+					key_size = static_cast<uintptr_t>(MLI);
+					uint8_t pad = 0;
+					for(uintptr_t i = key_size; i < size; ++i)
+					{
+						pad |= p_R[i];
+					}
+					valid = pad == 0;
+				}
+			}
+			else
+			{
+				valid = p_A == KW_IV;
+			}
+
+			if(!valid)
+			{
+				memset(p_R, 0, size);
+				p_out_size = 0;
+				return false;
+			}
+			p_out_size = key_size;
+			return true;
+		}
+
+		//	Note: A padded key that fits a single semiblock is wrapped as one block, without the W chain.
+		template<typename AES_t, bool Padded>
+		static bool unwrap_single(const typename AES_t::dec_key_schedule_t& p_dkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out, uintptr_t& p_out_size)
+		{
+			if(!valid_unwrap_size<Padded>(p_input.size(), p_out.size()))
+			{
+				p_out_size = 0;
+				return false;
+			}
+
+			const uintptr_t count = p_input.size() / 8 - 1;
+			uint64_t A;
+			if(Padded && count == 1)
+			{
+				alignas(16) std::array<uint8_t, 16> block;
+				AES_t::decode(p_dkey, p_input.first<16>(), block);
+				A = load_semiblock(block.data());
+				memcpy(p_out.data(), block.data() + 8, 8);
+			}
+			else
+			{
+				A = load_semiblock(p_input.data());
+				memmove(p_out.data(), p_input.data() + 8, count * 8);
+				unwrap_chain<AES_t>(p_dkey, A, p_out.data(), count);
+			}
+			return finish_unwrap<Padded>(A, p_out.data(), count, p_out_size);
+		}
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		//	Note: Same lane scheme as the multi-buffer kernels. Every lane carries the chain of one key,
+		//	one decode of each lane goes through the rounds together, the round keys of a job are copied into
+		//	a round major table when its lane is filled. Lanes without a job decode a scratch semiblock.
+		template<typename AES_t, bool Padded>
+		struct AES_unwrap_NI_Help
+		{
+			static constexpr uintptr_t lanes = AES_key_wrap<AES_t>::lanes;
+			static constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+
+			using job_t = typename AES_key_wrap<AES_t>::job_t;
+			using lanes_t = std::array<__m128i, lanes>;
+
+			struct lane_t
+			{
+				uint8_t*	first;	//!< R[1]
+				uint8_t*	last;	//!< R[n]
+				uint8_t*	R;		//!< Semiblock of the current step
+				uint64_t	A;
+				uint64_t	t;		//!< Steps left, including the current one
+				job_t*		job;	//!< nullptr if idle
+			};
+
+			struct state_t
+			{
+				std::array<lanes_t, number_of_rounds + 1>	key;
+				std::array<lane_t, lanes>					lane;
+				std::array<uint64_t, lanes>					scratch;
+			};
+
+			template<uintptr_t... I>
+			ISA_TARGET("aes")
+			static inline void step(state_t& p_state, std::index_sequence<I...>)
+			{
+				std::array<lane_t, lanes>& lane = p_state.lane;
+				const std::array<lanes_t, number_of_rounds + 1>& key = p_state.key;
+				lanes_t state;
+
+				((state[I] = _mm_xor_si128(
+					_mm_unpacklo_epi64(
+						_mm_cvtsi64_si128(static_cast<int64_t>(lane[I].A ^ core::endian_host2big(lane[I].t))),
+						_mm_loadl_epi64(reinterpret_cast<const __m128i*>(lane[I].R))),
+					key[0][I])), ...);
+
+				for(uintptr_t r = 1; r < number_of_rounds; ++r)
+				{
+					((state[I] = _mm_aesdec_si128(state[I], key[r][I])), ...);
+				}
+				((state[I] = _mm_aesdeclast_si128(state[I], key[number_of_rounds][I])), ...);
+
+				((lane[I].A = static_cast<uint64_t>(_mm_cvtsi128_si64(state[I]))), ...);
+				(_mm_storeh_pd(reinterpret_cast<double*>(lane[I].R), _mm_castsi128_pd(state[I])), ...);
+			}
+
+			//	Note: Jobs that are not valid, or that do not need a chain, are completed here and skipped.
+			///	\return false if there are no more jobs and the lane is now idle
+			ISA_TARGET("aes")
+			static bool fill(state_t& p_state, const uintptr_t p_lane, job_t*& p_next, job_t* const p_end)
+			{
+				lane_t& tlane = p_state.lane[p_lane];
+				for(; p_next != p_end; ++p_next)
+				{
+					job_t& tjob = *p_next;
+					const uintptr_t size = tjob.input.size();
+					if(!valid_unwrap_size<Padded>(size, tjob.out.size()) || (Padded && size == 16))
+					{
+						tjob.valid = unwrap_single<AES_t, Padded>(*tjob.dkey, tjob.input, tjob.out, tjob.out_size);
+						continue;
+					}
+
+					const uintptr_t count = size / 8 - 1;
+					tlane.A = load_semiblock(tjob.input.data());
+					memmove(tjob.out.data(), tjob.input.data() + 8, count * 8);
+					tlane.first	= tjob.out.data();
+					tlane.last	= tlane.first + (count - 1) * 8;
+					tlane.R		= tlane.last;
+					tlane.t		= 6 * static_cast<uint64_t>(count);
+					tlane.job	= &tjob;
+
+					const __m128i* const round_key = reinterpret_cast<const __m128i*>(tjob.dkey->wkey.data());
+					for(uintptr_t r = 0; r <= number_of_rounds; ++r)
+					{
+						p_state.key[r][p_lane] = _mm_load_si128(round_key + r);
+					}
+
+					++p_next;
+					return true;
+				}
+
+				tlane.R		= reinterpret_cast<uint8_t*>(&p_state.scratch[p_lane]);
+				tlane.job	= nullptr;
+				return false;
+			}
+
+			//	Note: Moves a lane to the previous semiblock, wrapping around to the last one at the end of a round.
+			///	\return false if the lane went idle
+			static bool advance(state_t& p_state, const uintptr_t p_lane, job_t*& p_next, job_t* const p_end)
+			{
+				lane_t& tlane = p_state.lane[p_lane];
+				if(--tlane.t)
+				{
+					tlane.R = tlane.R == tlane.first ? tlane.last : tlane.R - 8;
+					return true;
+				}
+
+				job_t& tjob = *tlane.job;
+				tjob.valid = finish_unwrap<Padded>(tlane.A, tlane.first, tjob.input.size() / 8 - 1, tjob.out_size);
+				return fill(p_state, p_lane, p_next, p_end);
+			}
+
+			static void run(std::span<job_t> p_jobs)
+			{
+				job_t*			next = p_jobs.data();
+				job_t* const	end  = next + p_jobs.size();
+
+				state_t state {};
+
+				uintptr_t active = 0;
+				for(uintptr_t l = 0; l < lanes; ++l)
+				{
+					active += fill(state, l, next, end) ? 1 : 0;
+				}
+
+				while(active)
+				{
+					step(state, std::make_index_sequence<lanes>{});
+
+					for(uintptr_t l = 0; l < lanes; ++l)
+					{
+						if(state.lane[l].job && !advance(state, l, next, end))
+						{
+							--active;
+						}
+					}
+				}
+			}
+		};
+#endif
+
+		template<typename AES_t, bool Padded>
+		static bool unwrap_batch(std::span<typename AES_key_wrap<AES_t>::job_t> p_jobs)
+		{
+#if defined(_M_AMD64) || defined(__amd64__)
+			if(_p::AES_NI_active())
+			{
+				AES_unwrap_NI_Help<AES_t, Padded>::run(p_jobs);
+			}
+			else
+#endif
+			{
+				for(typename AES_key_wrap<AES_t>::job_t& tjob : p_jobs)
+				{
+					tjob.valid = unwrap_single<AES_t, Padded>(*tjob.dkey, tjob.input, tjob.out, tjob.out_size);
+				}
+			}
+
+			bool res = true;
+			for(const typename AES_key_wrap<AES_t>::job_t& tjob : p_jobs)
+			{
+				res &= tjob.valid;
+			}
+			return res;
+		}
+	} //namespace
+
+	template<typename AES_t>
+	bool AES_key_wrap<AES_t>::wrap(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		const uintptr_t size = p_input.size();
+		if(size < 16 || size % semiblock_lenght || p_out.size() < size + semiblock_lenght)
+		{
+			return false;
+		}
+
+		uint64_t A = KW_IV;
+		memmove(p_out.data() + semiblock_lenght, p_input.data(), size);
+		wrap_chain<AES_t>(p_wkey, A, p_out.data() + semiblock_lenght, size / semiblock_lenght);
+		store_semiblock(A, p_out.data());
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_key_wrap<AES_t>::unwrap(const dec_key_schedule_t& p_dkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		uintptr_t out_size;
+		return unwrap_single<AES_t, false>(p_dkey, p_input, p_out, out_size);
+	}
+
+	template<typename AES_t>
+	bool AES_key_wrap<AES_t>::wrap_pad(const key_schedule_t& p_wkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		const uintptr_t size = p_input.size();
+		if(size == 0 || size > 0xFFFFFFFF || p_out.size() < wrap_pad_size(size))
+		{
+			return false;
+		}
+
+		const uintptr_t padded_size = wrap_pad_size(size) - semiblock_lenght;
+		uint64_t A = core::endian_host2big((static_cast<uint64_t>(KWP_ICV) << 32) | size);
+		memmove(p_out.data() + semiblock_lenght, p_input.data(), size);
+		memset(p_out.data() + semiblock_lenght + size, 0, padded_size - size);
+
+		if(padded_size == semiblock_lenght)
+		{
+			store_semiblock(A, p_out.data());
+			const std::span<uint8_t, 16> block = p_out.first<16>();
+			AES_t::encode(p_wkey, block, block);
+			return true;
+		}
+
+		wrap_chain<AES_t>(p_wkey, A, p_out.data() + semiblock_lenght, padded_size / semiblock_lenght);
+		store_semiblock(A, p_out.data());
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_key_wrap<AES_t>::unwrap_pad(const dec_key_schedule_t& p_dkey, std::span<const uint8_t> p_input, std::span<uint8_t> p_out, uintptr_t& p_out_size)
+	{
+		return unwrap_single<AES_t, true>(p_dkey, p_input, p_out, p_out_size);
+	}
+
+	template<typename AES_t>
+	bool AES_key_wrap<AES_t>::unwrap(std::span<job_t> p_jobs)
+	{
+		return unwrap_batch<AES_t, false>(p_jobs);
+	}
+
+	template<typename AES_t>
+	bool AES_key_wrap<AES_t>::unwrap_pad(std::span<job_t> p_jobs)
+	{
+		return unwrap_batch<AES_t, true>(p_jobs);
+	}
+
+	template class AES_key_wrap<AES_128>;
+	template class AES_key_wrap<AES_192>;
+	template class AES_key_wrap<AES_256>;
+
+} //namespace crypto
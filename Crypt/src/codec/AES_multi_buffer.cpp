@@ -0,0 +1,411 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/AES_multi_buffer.hpp>
+
+#include <cstring>
+#include <utility>
+
+#include <CoreLib/core_endian.hpp>
+
+#include "isa_target.hpp"
+#include "AES_engine.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		enum class mb_mode: uint8_t
+		{
+			ECB,
+			CBC,
+			CBC_MAC,
+			CTR,
+		};
+
+		static inline _p::AES_counter_t load_counter(const uint8_t* const p_block)
+		{
+			_p::AES_counter_t counter;
+			memcpy(counter.data(), p_block, 16);
+			counter[0] = core::endian_big2host(counter[0]);
+			counter[1] = core::endian_big2host(counter[1]);
+			return counter;
+		}
+
+		static inline void store_counter(const uint64_t p_hi, const uint64_t p_lo, uint8_t* const p_block)
+		{
+			const uint64_t hi = core::endian_host2big(p_hi);
+			const uint64_t lo = core::endian_host2big(p_lo);
+			memcpy(p_block, &hi, 8);
+			memcpy(p_block + 8, &lo, 8);
+		}
+
+		template<typename Job_t>
+		static inline bool whole_blocks(std::span<Job_t> p_jobs)
+		{
+			for(const Job_t& tjob : p_jobs)
+			{
+				if(tjob.input.size() % 16)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		//	Note: Every lane carries its own key schedule, message position and chaining state.
+		//	One block of each lane goes through the rounds together. The round keys of a job are copied
+		//	into a round major table when its lane is filled, so that a round reads all of its keys from one place.
+		//	A lane that runs out of work picks up the next job, lanes without a job encrypt a scratch block
+		//	so that the step stays branch free.
+		template<typename AES_t, mb_mode Mode>
+		struct AES_multi_buffer_NI_Help
+		{
+			static constexpr uintptr_t lanes = AES_multi_buffer<AES_t>::lanes;
+			static constexpr uintptr_t number_of_rounds = AES_t::number_of_rounds;
+
+			using job_t = AES_job<AES_t>;
+			using lanes_t = std::array<__m128i, lanes>;
+
+			struct lane_t
+			{
+				const uint8_t*	input;
+				uint8_t*		out;
+				uintptr_t		count;		//!< Blocks left, including the current one
+				uintptr_t		tail;		//!< Size of the trailing partial block (CTR)
+				uint8_t*		tail_out;	//!< Destination of the trailing partial block, once it is being processed
+				job_t*			job;		//!< nullptr if idle
+			};
+
+			struct state_t
+			{
+				std::array<lanes_t, number_of_rounds + 1>	key;
+				std::array<lane_t, lanes>					lane;
+				lanes_t										chain;
+				std::array<uint64_t, lanes>					hi;
+				std::array<uint64_t, lanes>					lo;
+				alignas(16) std::array<std::array<uint8_t, 16>, lanes> scratch;
+			};
+
+			ISA_TARGET("aes")
+			static inline __m128i ctr_block(const uint64_t p_hi, const uint64_t p_lo)
+			{
+				return _mm_set_epi64x(static_cast<int64_t>(core::endian_host2big(p_lo)), static_cast<int64_t>(core::endian_host2big(p_hi)));
+			}
+
+			template<uintptr_t... I>
+			ISA_TARGET("aes")
+			static inline void step(state_t& p_state, std::index_sequence<I...>)
+			{
+				const std::array<lane_t, lanes>& lane = p_state.lane;
+				const std::array<lanes_t, number_of_rounds + 1>& key = p_state.key;
+				lanes_t state;
+
+				if constexpr(Mode == mb_mode::CTR)
+				{
+					((state[I] = _mm_xor_si128(ctr_block(p_state.hi[I], p_state.lo[I]), key[0][I])), ...);
+					((p_state.hi[I] += (++p_state.lo[I] == 0)), ...);
+				}
+				else if constexpr(Mode == mb_mode::CBC || Mode == mb_mode::CBC_MAC)
+				{
+					((state[I] = _mm_xor_si128(_mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lane[I].input)), p_state.chain[I]), key[0][I])), ...);
+				}
+				else
+				{
+					((state[I] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lane[I].input)), key[0][I])), ...);
+				}
+
+				for(uintptr_t r = 1; r < number_of_rounds; ++r)
+				{
+					((state[I] = _mm_aesenc_si128(state[I], key[r][I])), ...);
+				}
+				((state[I] = _mm_aesenclast_si128(state[I], key[number_of_rounds][I])), ...);
+
+				if constexpr(Mode == mb_mode::CTR)
+				{
+					((state[I] = _mm_xor_si128(state[I], _mm_loadu_si128(reinterpret_cast<const __m128i*>(lane[I].input)))), ...);
+				}
+				else if constexpr(Mode == mb_mode::CBC || Mode == mb_mode::CBC_MAC)
+				{
+					((p_state.chain[I] = state[I]), ...);
+				}
+
+				if constexpr(Mode != mb_mode::CBC_MAC)
+				{
+					(_mm_storeu_si128(reinterpret_cast<__m128i*>(lane[I].out), state[I]), ...);
+				}
+			}
+
+			static void start_tail(state_t& p_state, const uintptr_t p_lane, const uint8_t* const p_input, uint8_t* const p_out)
+			{
+				lane_t& tlane = p_state.lane[p_lane];
+				uint8_t* const scratch = p_state.scratch[p_lane].data();
+				memcpy(scratch, p_input, tlane.tail);
+				tlane.input		= scratch;
+				tlane.out		= scratch;
+				tlane.count		= 1;
+				tlane.tail_out	= p_out;
+			}
+
+			ISA_TARGET("aes")
+			static void finish(state_t& p_state, const uintptr_t p_lane)
+			{
+				job_t& tjob = *p_state.lane[p_lane].job;
+				if constexpr(Mode == mb_mode::CTR)
+				{
+					store_counter(p_state.hi[p_lane], p_state.lo[p_lane], tjob.iv.data());
+				}
+				else if constexpr(Mode == mb_mode::CBC || Mode == mb_mode::CBC_MAC)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(tjob.iv.data()), p_state.chain[p_lane]);
+				}
+			}
+
+			//	Note: Empty jobs are skipped, they have nothing to update.
+			///	\return false if there are no more jobs and the lane is now idle
+			ISA_TARGET("aes")
+			static bool fill(state_t& p_state, const uintptr_t p_lane, job_t*& p_next, job_t* const p_end)
+			{
+				lane_t& tlane = p_state.lane[p_lane];
+				for(; p_next != p_end; ++p_next)
+				{
+					job_t& tjob = *p_next;
+					const uintptr_t size = tjob.input.size();
+					if(size == 0)
+					{
+						continue;
+					}
+
+					tlane.input		= tjob.input.data();
+					tlane.out		= tjob.out.data();
+					tlane.count		= size / 16;
+					tlane.tail		= size % 16;
+					tlane.tail_out	= nullptr;
+					tlane.job		= &tjob;
+
+					const __m128i* const round_key = reinterpret_cast<const __m128i*>(tjob.wkey->wkey.data());
+					for(uintptr_t r = 0; r <= number_of_rounds; ++r)
+					{
+						p_state.key[r][p_lane] = _mm_load_si128(round_key + r);
+					}
+
+					if constexpr(Mode == mb_mode::CTR)
+					{
+						const _p::AES_counter_t counter = load_counter(tjob.iv.data());
+						p_state.hi[p_lane] = counter[0];
+						p_state.lo[p_lane] = counter[1];
+						if(tlane.count == 0)
+						{
+							start_tail(p_state, p_lane, tlane.input, tlane.out);
+						}
+					}
+					else if constexpr(Mode == mb_mode::CBC || Mode == mb_mode::CBC_MAC)
+					{
+						p_state.chain[p_lane] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tjob.iv.data()));
+					}
+
+					++p_next;
+					return true;
+				}
+
+				tlane.input		= p_state.scratch[p_lane].data();
+				tlane.out		= p_state.scratch[p_lane].data();
+				tlane.job		= nullptr;
+				return false;
+			}
+
+			//	Note: Moves a lane past the block it just processed.
+			///	\return false if the lane went idle
+			static bool advance(state_t& p_state, const uintptr_t p_lane, job_t*& p_next, job_t* const p_end)
+			{
+				lane_t& tlane = p_state.lane[p_lane];
+				if(--tlane.count)
+				{
+					tlane.input += 16;
+					if constexpr(Mode != mb_mode::CBC_MAC)
+					{
+						tlane.out += 16;
+					}
+					return true;
+				}
+
+				if constexpr(Mode == mb_mode::CTR)
+				{
+					if(tlane.tail_out)
+					{
+						memcpy(tlane.tail_out, p_state.scratch[p_lane].data(), tlane.tail);
+					}
+					else if(tlane.tail)
+					{
+						start_tail(p_state, p_lane, tlane.input + 16, tlane.out + 16);
+						return true;
+					}
+				}
+
+				finish(p_state, p_lane);
+				return fill(p_state, p_lane, p_next, p_end);
+			}
+
+			static void run(std::span<job_t> p_jobs)
+			{
+				job_t*			next = p_jobs.data();
+				job_t* const	end  = next + p_jobs.size();
+
+				state_t state {};
+
+				uintptr_t active = 0;
+				for(uintptr_t l = 0; l < lanes; ++l)
+				{
+					active += fill(state, l, next, end) ? 1 : 0;
+				}
+
+				while(active)
+				{
+					step(state, std::make_index_sequence<lanes>{});
+
+					for(uintptr_t l = 0; l < lanes; ++l)
+					{
+						if(state.lane[l].job && !advance(state, l, next, end))
+						{
+							--active;
+						}
+					}
+				}
+			}
+		};
+#endif
+	} //namespace
+
+	template<typename AES_t>
+	bool AES_multi_buffer<AES_t>::encode_blocks(std::span<job_t> p_jobs)
+	{
+		if(!whole_blocks(p_jobs))
+		{
+			return false;
+		}
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		if(_p::AES_NI_active())
+		{
+			AES_multi_buffer_NI_Help<AES_t, mb_mode::ECB>::run(p_jobs);
+			return true;
+		}
+#endif
+
+		for(job_t& tjob : p_jobs)
+		{
+			AES_t::encode_blocks(*tjob.wkey, tjob.input, tjob.out);
+		}
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_multi_buffer<AES_t>::cbc_encode(std::span<job_t> p_jobs)
+	{
+		if(!whole_blocks(p_jobs))
+		{
+			return false;
+		}
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		if(_p::AES_NI_active())
+		{
+			AES_multi_buffer_NI_Help<AES_t, mb_mode::CBC>::run(p_jobs);
+			return true;
+		}
+#endif
+
+		for(job_t& tjob : p_jobs)
+		{
+			_p::AES_cbc_encode<AES_t>(*tjob.wkey, tjob.iv.data(), tjob.input.data(), tjob.out.data(), tjob.input.size() / block_lenght);
+		}
+		return true;
+	}
+
+	template<typename AES_t>
+	bool AES_multi_buffer<AES_t>::cbc_mac(std::span<job_t> p_jobs)
+	{
+		if(!whole_blocks(p_jobs))
+		{
+			return false;
+		}
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		if(_p::AES_NI_active())
+		{
+			AES_multi_buffer_NI_Help<AES_t, mb_mode::CBC_MAC>::run(p_jobs);
+			return true;
+		}
+#endif
+
+		for(job_t& tjob : p_jobs)
+		{
+			_p::AES_cbc_mac<AES_t>(*tjob.wkey, tjob.iv.data(), tjob.input.data(), tjob.input.size() / block_lenght);
+		}
+		return true;
+	}
+
+	template<typename AES_t>
+	void AES_multi_buffer<AES_t>::ctr_xor(std::span<job_t> p_jobs)
+	{
+#if defined(_M_AMD64) || defined(__amd64__)
+		if(_p::AES_NI_active())
+		{
+			AES_multi_buffer_NI_Help<AES_t, mb_mode::CTR>::run(p_jobs);
+			return;
+		}
+#endif
+
+		for(job_t& tjob : p_jobs)
+		{
+			const uintptr_t size	= tjob.input.size();
+			const uintptr_t count	= size / block_lenght;
+			const uintptr_t tail	= size % block_lenght;
+			if(size == 0)
+			{
+				continue;
+			}
+
+			_p::AES_counter_t counter = load_counter(tjob.iv.data());
+			_p::AES_ctr_xor<AES_t>(*tjob.wkey, counter, tjob.input.data(), tjob.out.data(), count);
+			if(tail)
+			{
+				alignas(16) std::array<uint8_t, block_lenght> block;
+				memcpy(block.data(), tjob.input.data() + count * block_lenght, tail);
+				_p::AES_ctr_xor<AES_t>(*tjob.wkey, counter, block.data(), block.data(), 1);
+				memcpy(tjob.out.data() + count * block_lenght, block.data(), tail);
+			}
+			store_counter(counter[0], counter[1], tjob.iv.data());
+		}
+	}
+
+	template class AES_multi_buffer<AES_128>;
+	template class AES_multi_buffer<AES_192>;
+	template class AES_multi_buffer<AES_256>;
+
+} //namespace crypto
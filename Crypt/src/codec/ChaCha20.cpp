@@ -0,0 +1,571 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		ChaCha20 - Stream cypher
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/ChaCha20.hpp>
+
+#include <atomic>
+#include <cstring>
+
+#include <CoreLib/core_endian.hpp>
+
+#if defined(_M_AMD64) || defined(__amd64__)
+#	include <CoreLib/core_cpu.hpp>
+#endif
+
+#include "isa_target.hpp"
+#include "block_help.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		//	Note: constants, key, block counter and nonce, as little endian words.
+		//	Word 12 is the block counter, it is updated by the kernels.
+		using ChaCha20_state_t = std::array<uint32_t, 16>;
+
+		static constexpr uintptr_t counter_word = 12;
+
+		static void init_state(std::span<const uint8_t, ChaCha20::key_lenght> p_key, std::span<const uint8_t, ChaCha20::nonce_lenght> p_nonce,
+			const uint32_t p_counter, ChaCha20_state_t& p_state)
+		{
+			p_state[0] = 0x61707865;
+			p_state[1] = 0x3320646E;
+			p_state[2] = 0x79622D32;
+			p_state[3] = 0x6B206574;
+			for(uintptr_t i = 0; i < 8; ++i)
+			{
+				uint32_t word;
+				memcpy(&word, p_key.data() + i * 4, 4);
+				p_state[4 + i] = core::endian_little2host(word);
+			}
+			p_state[counter_word] = p_counter;
+			for(uintptr_t i = 0; i < 3; ++i)
+			{
+				uint32_t word;
+				memcpy(&word, p_nonce.data() + i * 4, 4);
+				p_state[13 + i] = core::endian_little2host(word);
+			}
+		}
+
+		struct ChaCha20_Help
+		{
+			static inline uint32_t rotl(const uint32_t p_val, const uint8_t p_rot)
+			{
+				return (p_val << p_rot) | (p_val >> (32 - p_rot));
+			}
+
+			static inline void quarter_round(uint32_t& p_a, uint32_t& p_b, uint32_t& p_c, uint32_t& p_d)
+			{
+				p_a += p_b; p_d = rotl(p_d ^ p_a, 16);
+				p_c += p_d; p_b = rotl(p_b ^ p_c, 12);
+				p_a += p_b; p_d = rotl(p_d ^ p_a, 8);
+				p_c += p_d; p_b = rotl(p_b ^ p_c, 7);
+			}
+
+			static void xor_blocks(ChaCha20_state_t& p_state, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+			{
+				for(; p_count; --p_count, p_input += ChaCha20::block_lenght, p_out += ChaCha20::block_lenght)
+				{
+					ChaCha20_state_t x = p_state;
+					for(uintptr_t i = 0; i < 10; ++i)
+					{
+						quarter_round(x[0], x[4], x[ 8], x[12]);
+						quarter_round(x[1], x[5], x[ 9], x[13]);
+						quarter_round(x[2], x[6], x[10], x[14]);
+						quarter_round(x[3], x[7], x[11], x[15]);
+						quarter_round(x[0], x[5], x[10], x[15]);
+						quarter_round(x[1], x[6], x[11], x[12]);
+						quarter_round(x[2], x[7], x[ 8], x[13]);
+						quarter_round(x[3], x[4], x[ 9], x[14]);
+					}
+
+					alignas(8) std::array<uint8_t, ChaCha20::block_lenght> key_stream;
+					for(uintptr_t i = 0; i < 16; ++i)
+					{
+						const uint32_t word = core::endian_host2little(x[i] + p_state[i]);
+						memcpy(key_stream.data() + i * 4, &word, 4);
+					}
+					xor_bytes(p_out, p_input, key_stream.data(), ChaCha20::block_lenght);
+					++p_state[counter_word];
+				}
+			}
+		};
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		//	Note: Every register holds the same state word of 4 consecutive blocks.
+		//	At the end, groups of 4 words are transposed back into 16 byte pieces of each block.
+		struct ChaCha20_SSE2_Help
+		{
+			static constexpr uintptr_t lanes = 4;
+			using vec_state_t = std::array<__m128i, 16>;
+
+			template<uint8_t Rot>
+			ISA_TARGET("sse2")
+			static inline __m128i rotl(const __m128i p_val)
+			{
+				if constexpr(Rot == 16)
+				{
+					return _mm_shufflehi_epi16(_mm_shufflelo_epi16(p_val, 0xB1), 0xB1);
+				}
+				else
+				{
+					return _mm_or_si128(_mm_slli_epi32(p_val, Rot), _mm_srli_epi32(p_val, 32 - Rot));
+				}
+			}
+
+			template<uintptr_t A, uintptr_t B, uintptr_t C, uintptr_t D>
+			ISA_TARGET("sse2")
+			static inline void quarter_round(vec_state_t& p_x)
+			{
+				p_x[A] = _mm_add_epi32(p_x[A], p_x[B]); p_x[D] = rotl<16>(_mm_xor_si128(p_x[D], p_x[A]));
+				p_x[C] = _mm_add_epi32(p_x[C], p_x[D]); p_x[B] = rotl<12>(_mm_xor_si128(p_x[B], p_x[C]));
+				p_x[A] = _mm_add_epi32(p_x[A], p_x[B]); p_x[D] = rotl< 8>(_mm_xor_si128(p_x[D], p_x[A]));
+				p_x[C] = _mm_add_epi32(p_x[C], p_x[D]); p_x[B] = rotl< 7>(_mm_xor_si128(p_x[B], p_x[C]));
+			}
+
+			ISA_TARGET("sse2")
+			static inline void double_round(vec_state_t& p_x)
+			{
+				quarter_round<0, 4,  8, 12>(p_x);
+				quarter_round<1, 5,  9, 13>(p_x);
+				quarter_round<2, 6, 10, 14>(p_x);
+				quarter_round<3, 7, 11, 15>(p_x);
+				quarter_round<0, 5, 10, 15>(p_x);
+				quarter_round<1, 6, 11, 12>(p_x);
+				quarter_round<2, 7,  8, 13>(p_x);
+				quarter_round<3, 4,  9, 14>(p_x);
+			}
+
+			//	Note: Transposes words G*4 .. G*4+3, afterwards p_x[G*4 + i] holds piece G of block i.
+			template<uintptr_t G>
+			ISA_TARGET("sse2")
+			static inline void transpose(vec_state_t& p_x)
+			{
+				const __m128i t0 = _mm_unpacklo_epi32(p_x[G * 4 + 0], p_x[G * 4 + 1]);
+				const __m128i t1 = _mm_unpacklo_epi32(p_x[G * 4 + 2], p_x[G * 4 + 3]);
+				const __m128i t2 = _mm_unpackhi_epi32(p_x[G * 4 + 0], p_x[G * 4 + 1]);
+				const __m128i t3 = _mm_unpackhi_epi32(p_x[G * 4 + 2], p_x[G * 4 + 3]);
+				p_x[G * 4 + 0] = _mm_unpacklo_epi64(t0, t1);
+				p_x[G * 4 + 1] = _mm_unpackhi_epi64(t0, t1);
+				p_x[G * 4 + 2] = _mm_unpacklo_epi64(t2, t3);
+				p_x[G * 4 + 3] = _mm_unpackhi_epi64(t2, t3);
+			}
+
+			ISA_TARGET("sse2")
+			static void xor_blocks(ChaCha20_state_t& p_state, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+			{
+				if(p_count >= lanes)
+				{
+					vec_state_t base;
+					for(uintptr_t i = 0; i < 16; ++i)
+					{
+						base[i] = _mm_set1_epi32(static_cast<int32_t>(p_state[i]));
+					}
+					base[counter_word] = _mm_add_epi32(base[counter_word], _mm_set_epi32(3, 2, 1, 0));
+					const __m128i step = _mm_set1_epi32(lanes);
+
+					for(; p_count >= lanes; p_count -= lanes, p_input += lanes * ChaCha20::block_lenght, p_out += lanes * ChaCha20::block_lenght)
+					{
+						vec_state_t x = base;
+						for(uintptr_t i = 0; i < 10; ++i)
+						{
+							double_round(x);
+						}
+						for(uintptr_t i = 0; i < 16; ++i)
+						{
+							x[i] = _mm_add_epi32(x[i], base[i]);
+						}
+						transpose<0>(x);
+						transpose<1>(x);
+						transpose<2>(x);
+						transpose<3>(x);
+
+						for(uintptr_t b = 0; b < lanes; ++b)
+						{
+							for(uintptr_t g = 0; g < 4; ++g)
+							{
+								const uintptr_t offset = b * 4 + g;
+								_mm_storeu_si128(reinterpret_cast<__m128i*>(p_out) + offset,
+									_mm_xor_si128(x[g * 4 + b], _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_input) + offset)));
+							}
+						}
+						base[counter_word] = _mm_add_epi32(base[counter_word], step);
+					}
+					p_state[counter_word] = static_cast<uint32_t>(_mm_cvtsi128_si32(base[counter_word]));
+				}
+				ChaCha20_Help::xor_blocks(p_state, p_input, p_out, p_count);
+			}
+		};
+
+		//	Note: Same as ChaCha20_SSE2_Help, 8 blocks at a time.
+		//	The transposition works within 128 bit lanes, block i is in the low lane and block 4+i in the high lane.
+		struct ChaCha20_AVX2_Help
+		{
+			static constexpr uintptr_t lanes = 8;
+			using vec_state_t = std::array<__m256i, 16>;
+
+			template<uint8_t Rot>
+			ISA_TARGET("avx2")
+			static inline __m256i rotl(const __m256i p_val)
+			{
+				if constexpr(Rot == 16)
+				{
+					return _mm256_shuffle_epi8(p_val, _mm256_set_epi8(
+						13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+						13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2));
+				}
+				else if constexpr(Rot == 8)
+				{
+					return _mm256_shuffle_epi8(p_val, _mm256_set_epi8(
+						14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+						14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3));
+				}
+				else
+				{
+					return _mm256_or_si256(_mm256_slli_epi32(p_val, Rot), _mm256_srli_epi32(p_val, 32 - Rot));
+				}
+			}
+
+			template<uintptr_t A, uintptr_t B, uintptr_t C, uintptr_t D>
+			ISA_TARGET("avx2")
+			static inline void quarter_round(vec_state_t& p_x)
+			{
+				p_x[A] = _mm256_add_epi32(p_x[A], p_x[B]); p_x[D] = rotl<16>(_mm256_xor_si256(p_x[D], p_x[A]));
+				p_x[C] = _mm256_add_epi32(p_x[C], p_x[D]); p_x[B] = rotl<12>(_mm256_xor_si256(p_x[B], p_x[C]));
+				p_x[A] = _mm256_add_epi32(p_x[A], p_x[B]); p_x[D] = rotl< 8>(_mm256_xor_si256(p_x[D], p_x[A]));
+				p_x[C] = _mm256_add_epi32(p_x[C], p_x[D]); p_x[B] = rotl< 7>(_mm256_xor_si256(p_x[B], p_x[C]));
+			}
+
+			ISA_TARGET("avx2")
+			static inline void double_round(vec_state_t& p_x)
+			{
+				quarter_round<0, 4,  8, 12>(p_x);
+				quarter_round<1, 5,  9, 13>(p_x);
+				quarter_round<2, 6, 10, 14>(p_x);
+				quarter_round<3, 7, 11, 15>(p_x);
+				quarter_round<0, 5, 10, 15>(p_x);
+				quarter_round<1, 6, 11, 12>(p_x);
+				quarter_round<2, 7,  8, 13>(p_x);
+				quarter_round<3, 4,  9, 14>(p_x);
+			}
+
+			template<uintptr_t G>
+			ISA_TARGET("avx2")
+			static inline void transpose(vec_state_t& p_x)
+			{
+				const __m256i t0 = _mm256_unpacklo_epi32(p_x[G * 4 + 0], p_x[G * 4 + 1]);
+				const __m256i t1 = _mm256_unpacklo_epi32(p_x[G * 4 + 2], p_x[G * 4 + 3]);
+				const __m256i t2 = _mm256_unpackhi_epi32(p_x[G * 4 + 0], p_x[G * 4 + 1]);
+				const __m256i t3 = _mm256_unpackhi_epi32(p_x[G * 4 + 2], p_x[G * 4 + 3]);
+				p_x[G * 4 + 0] = _mm256_unpacklo_epi64(t0, t1);
+				p_x[G * 4 + 1] = _mm256_unpackhi_epi64(t0, t1);
+				p_x[G * 4 + 2] = _mm256_unpacklo_epi64(t2, t3);
+				p_x[G * 4 + 3] = _mm256_unpackhi_epi64(t2, t3);
+			}
+
+			ISA_TARGET("avx2")
+			static inline void xor_store(const __m256i p_key_stream, const uint8_t* const p_input, uint8_t* const p_out)
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(p_out),
+					_mm256_xor_si256(p_key_stream, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_input))));
+			}
+
+			ISA_TARGET("avx2")
+			static void xor_blocks(ChaCha20_state_t& p_state, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+			{
+				constexpr uintptr_t block_lenght = ChaCha20::block_lenght;
+
+				if(p_count >= lanes)
+				{
+					vec_state_t base;
+					for(uintptr_t i = 0; i < 16; ++i)
+					{
+						base[i] = _mm256_set1_epi32(static_cast<int32_t>(p_state[i]));
+					}
+					base[counter_word] = _mm256_add_epi32(base[counter_word], _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+					const __m256i step = _mm256_set1_epi32(lanes);
+
+					for(; p_count >= lanes; p_count -= lanes, p_input += lanes * block_lenght, p_out += lanes * block_lenght)
+					{
+						vec_state_t x = base;
+						for(uintptr_t i = 0; i < 10; ++i)
+						{
+							double_round(x);
+						}
+						for(uintptr_t i = 0; i < 16; ++i)
+						{
+							x[i] = _mm256_add_epi32(x[i], base[i]);
+						}
+						transpose<0>(x);
+						transpose<1>(x);
+						transpose<2>(x);
+						transpose<3>(x);
+
+						for(uintptr_t b = 0; b < 4; ++b)
+						{
+							const uintptr_t low  = b * block_lenght;
+							const uintptr_t high = (b + 4) * block_lenght;
+							xor_store(_mm256_permute2x128_si256(x[b], x[4 + b], 0x20), p_input + low, p_out + low);
+							xor_store(_mm256_permute2x128_si256(x[8 + b], x[12 + b], 0x20), p_input + low + 32, p_out + low + 32);
+							xor_store(_mm256_permute2x128_si256(x[b], x[4 + b], 0x31), p_input + high, p_out + high);
+							xor_store(_mm256_permute2x128_si256(x[8 + b], x[12 + b], 0x31), p_input + high + 32, p_out + high + 32);
+						}
+						base[counter_word] = _mm256_add_epi32(base[counter_word], step);
+					}
+					p_state[counter_word] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm256_castsi256_si128(base[counter_word])));
+				}
+				ChaCha20_SSE2_Help::xor_blocks(p_state, p_input, p_out, p_count);
+			}
+		};
+
+		//	Note: Same as ChaCha20_SSE2_Help, 16 blocks at a time.
+		//	After the transposition within 128 bit lanes, lane c of p_x[G*4 + i] holds piece G of block 4*c + i.
+		struct ChaCha20_AVX512_Help
+		{
+			static constexpr uintptr_t lanes = 16;
+			using vec_state_t = std::array<__m512i, 16>;
+
+			template<uintptr_t A, uintptr_t B, uintptr_t C, uintptr_t D>
+			ISA_TARGET("avx512f")
+			static inline void quarter_round(vec_state_t& p_x)
+			{
+				p_x[A] = _mm512_add_epi32(p_x[A], p_x[B]); p_x[D] = _mm512_rol_epi32(_mm512_xor_si512(p_x[D], p_x[A]), 16);
+				p_x[C] = _mm512_add_epi32(p_x[C], p_x[D]); p_x[B] = _mm512_rol_epi32(_mm512_xor_si512(p_x[B], p_x[C]), 12);
+				p_x[A] = _mm512_add_epi32(p_x[A], p_x[B]); p_x[D] = _mm512_rol_epi32(_mm512_xor_si512(p_x[D], p_x[A]),  8);
+				p_x[C] = _mm512_add_epi32(p_x[C], p_x[D]); p_x[B] = _mm512_rol_epi32(_mm512_xor_si512(p_x[B], p_x[C]),  7);
+			}
+
+			ISA_TARGET("avx512f")
+			static inline void double_round(vec_state_t& p_x)
+			{
+				quarter_round<0, 4,  8, 12>(p_x);
+				quarter_round<1, 5,  9, 13>(p_x);
+				quarter_round<2, 6, 10, 14>(p_x);
+				quarter_round<3, 7, 11, 15>(p_x);
+				quarter_round<0, 5, 10, 15>(p_x);
+				quarter_round<1, 6, 11, 12>(p_x);
+				quarter_round<2, 7,  8, 13>(p_x);
+				quarter_round<3, 4,  9, 14>(p_x);
+			}
+
+			template<uintptr_t G>
+			ISA_TARGET("avx512f")
+			static inline void transpose(vec_state_t& p_x)
+			{
+				const __m512i t0 = _mm512_unpacklo_epi32(p_x[G * 4 + 0], p_x[G * 4 + 1]);
+				const __m512i t1 = _mm512_unpacklo_epi32(p_x[G * 4 + 2], p_x[G * 4 + 3]);
+				const __m512i t2 = _mm512_unpackhi_epi32(p_x[G * 4 + 0], p_x[G * 4 + 1]);
+				const __m512i t3 = _mm512_unpackhi_epi32(p_x[G * 4 + 2], p_x[G * 4 + 3]);
+				p_x[G * 4 + 0] = _mm512_unpacklo_epi64(t0, t1);
+				p_x[G * 4 + 1] = _mm512_unpackhi_epi64(t0, t1);
+				p_x[G * 4 + 2] = _mm512_unpacklo_epi64(t2, t3);
+				p_x[G * 4 + 3] = _mm512_unpackhi_epi64(t2, t3);
+			}
+
+			ISA_TARGET("avx512f")
+			static inline void xor_store(const __m512i p_key_stream, const uint8_t* const p_input, uint8_t* const p_out)
+			{
+				_mm512_storeu_si512(p_out, _mm512_xor_si512(p_key_stream, _mm512_loadu_si512(p_input)));
+			}
+
+			ISA_TARGET("avx2,avx512f")
+			static void xor_blocks(ChaCha20_state_t& p_state, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_count)
+			{
+				constexpr uintptr_t block_lenght = ChaCha20::block_lenght;
+
+				if(p_count >= lanes)
+				{
+					vec_state_t base;
+					for(uintptr_t i = 0; i < 16; ++i)
+					{
+						base[i] = _mm512_set1_epi32(static_cast<int32_t>(p_state[i]));
+					}
+					base[counter_word] = _mm512_add_epi32(base[counter_word], _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+					const __m512i step = _mm512_set1_epi32(lanes);
+
+					for(; p_count >= lanes; p_count -= lanes, p_input += lanes * block_lenght, p_out += lanes * block_lenght)
+					{
+						vec_state_t x = base;
+						for(uintptr_t i = 0; i < 10; ++i)
+						{
+							double_round(x);
+						}
+						for(uintptr_t i = 0; i < 16; ++i)
+						{
+							x[i] = _mm512_add_epi32(x[i], base[i]);
+						}
+						transpose<0>(x);
+						transpose<1>(x);
+						transpose<2>(x);
+						transpose<3>(x);
+
+						//	128 bit lanes are transposed across the 4 pieces of each block
+						for(uintptr_t b = 0; b < 4; ++b)
+						{
+							const __m512i t0 = _mm512_shuffle_i32x4(x[b], x[4 + b], 0x44);
+							const __m512i t1 = _mm512_shuffle_i32x4(x[b], x[4 + b], 0xEE);
+							const __m512i t2 = _mm512_shuffle_i32x4(x[8 + b], x[12 + b], 0x44);
+							const __m512i t3 = _mm512_shuffle_i32x4(x[8 + b], x[12 + b], 0xEE);
+							xor_store(_mm512_shuffle_i32x4(t0, t2, 0x88), p_input + (b +  0) * block_lenght, p_out + (b +  0) * block_lenght);
+							xor_store(_mm512_shuffle_i32x4(t0, t2, 0xDD), p_input + (b +  4) * block_lenght, p_out + (b +  4) * block_lenght);
+							xor_store(_mm512_shuffle_i32x4(t1, t3, 0x88), p_input + (b +  8) * block_lenght, p_out + (b +  8) * block_lenght);
+							xor_store(_mm512_shuffle_i32x4(t1, t3, 0xDD), p_input + (b + 12) * block_lenght, p_out + (b + 12) * block_lenght);
+						}
+						base[counter_word] = _mm512_add_epi32(base[counter_word], step);
+					}
+					p_state[counter_word] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm512_castsi512_si128(base[counter_word])));
+				}
+				ChaCha20_AVX2_Help::xor_blocks(p_state, p_input, p_out, p_count);
+			}
+		};
+#endif
+
+		struct ChaCha20_Dispatch
+		{
+			using blocks_cb_t = void (*)(ChaCha20_state_t&, const uint8_t*, uint8_t*, uintptr_t);
+
+			ChaCha20_engine	id;
+			blocks_cb_t		xor_blocks;
+		};
+
+		constexpr ChaCha20_Dispatch software_engine{ChaCha20_engine::software, ChaCha20_Help::xor_blocks};
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		constexpr ChaCha20_Dispatch SSE2_engine{ChaCha20_engine::SSE2, ChaCha20_SSE2_Help::xor_blocks};
+		constexpr ChaCha20_Dispatch AVX2_engine{ChaCha20_engine::AVX2, ChaCha20_AVX2_Help::xor_blocks};
+		constexpr ChaCha20_Dispatch AVX512_engine{ChaCha20_engine::AVX512, ChaCha20_AVX512_Help::xor_blocks};
+
+		static inline bool AVX2_supported()
+		{
+			return core::amd64::CPU_feature_su::AVX2();
+		}
+
+		//	Note: The AVX-512 engine falls back to the AVX2 kernel for the remainder.
+		static inline bool AVX512_supported()
+		{
+			return AVX2_supported() && core::amd64::CPU_feature_su::AVX512F();
+		}
+
+		const ChaCha20_Dispatch* select_engine(const ChaCha20_engine p_engine)
+		{
+			switch(p_engine)
+			{
+			case ChaCha20_engine::automatic:
+				if(AVX512_supported())
+				{
+					return &AVX512_engine;
+				}
+				return AVX2_supported() ? &AVX2_engine : &SSE2_engine;
+			case ChaCha20_engine::software:
+				return &software_engine;
+			case ChaCha20_engine::SSE2:
+				return &SSE2_engine;
+			case ChaCha20_engine::AVX2:
+				return AVX2_supported() ? &AVX2_engine : nullptr;
+			case ChaCha20_engine::AVX512:
+				return AVX512_supported() ? &AVX512_engine : nullptr;
+			default:
+				break;
+			}
+			return nullptr;
+		}
+#else
+		const ChaCha20_Dispatch* select_engine(const ChaCha20_engine p_engine)
+		{
+			switch(p_engine)
+			{
+			case ChaCha20_engine::automatic:
+			case ChaCha20_engine::software:
+				return &software_engine;
+			default:
+				break;
+			}
+			return nullptr;
+		}
+#endif
+
+		//	Note: Same scheme as the AES engine, constant initialized and resolved on first use.
+		static std::atomic<const ChaCha20_Dispatch*> active_engine{nullptr};
+
+		static inline const ChaCha20_Dispatch& current_engine()
+		{
+			const ChaCha20_Dispatch* engine = active_engine.load(std::memory_order_relaxed);
+			if(engine == nullptr) [[unlikely]]
+			{
+				const ChaCha20_Dispatch* const selected = select_engine(ChaCha20_engine::automatic);
+				if(active_engine.compare_exchange_strong(engine, selected, std::memory_order_relaxed))
+				{
+					engine = selected;
+				}
+			}
+			return *engine;
+		}
+	} //namespace
+
+	bool ChaCha20_set_engine(const ChaCha20_engine p_engine)
+	{
+		const ChaCha20_Dispatch* const engine = select_engine(p_engine);
+		if(engine)
+		{
+			active_engine.store(engine, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	ChaCha20_engine ChaCha20_get_engine()
+	{
+		return current_engine().id;
+	}
+
+	bool ChaCha20::xor_stream(std::span<const uint8_t, key_lenght> p_key, std::span<const uint8_t, nonce_lenght> p_nonce, const uint32_t p_counter,
+		std::span<const uint8_t> p_input, std::span<uint8_t> p_out)
+	{
+		const uintptr_t size = p_input.size();
+		if(p_out.size() < size || (static_cast<uint64_t>(size) + block_lenght - 1) / block_lenght > (uint64_t{1} << 32) - p_counter)
+		{
+			return false;
+		}
+
+		ChaCha20_state_t state;
+		init_state(p_key, p_nonce, p_counter, state);
+
+		const uintptr_t count = size / block_lenght;
+		current_engine().xor_blocks(state, p_input.data(), p_out.data(), count);
+
+		if(const uintptr_t tail = size % block_lenght)
+		{
+			const uintptr_t offset = count * block_lenght;
+			alignas(16) std::array<uint8_t, block_lenght> block;
+			memcpy(block.data(), p_input.data() + offset, tail);
+			ChaCha20_Help::xor_blocks(state, block.data(), block.data(), 1);
+			memcpy(p_out.data() + offset, block.data(), tail);
+		}
+		return true;
+	}
+} //namespace crypto
@@ -0,0 +1,146 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		ChaCha20-Poly1305 - Authenticated encryption
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/codec/ChaCha20_Poly1305.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <CoreLib/core_endian.hpp>
+
+#include "Poly1305.hpp"
+
+namespace crypto
+{
+	namespace
+	{
+		using _p::Poly1305;
+
+		//	Note: Number of bytes encrypted and then hashed at once, small enough to still be in L1 cache when hashed.
+		//	Must be a multiple of the ChaCha20 block size.
+		static constexpr uintptr_t chunk = 4096;
+		static_assert(chunk % ChaCha20::block_lenght == 0);
+
+		//	Note: The one time Poly1305 key is the first half of key stream block 0, the message starts at block 1.
+		static void make_poly_key(std::span<const uint8_t, ChaCha20::key_lenght> p_key, std::span<const uint8_t, ChaCha20::nonce_lenght> p_nonce,
+			Poly1305::key_t& p_out)
+		{
+			std::array<uint8_t, Poly1305::key_lenght> poly_key{};
+			ChaCha20::xor_stream(p_key, p_nonce, 0, poly_key, poly_key);
+			Poly1305::make_key(poly_key, p_out);
+		}
+
+		static uint32_t chunk_counter(const uintptr_t p_offset)
+		{
+			return static_cast<uint32_t>(1 + p_offset / ChaCha20::block_lenght);
+		}
+
+		static void compute_tag(const Poly1305::key_t& p_key, Poly1305::state_t& p_hash, const uint64_t p_aad_size, const uint64_t p_data_size,
+			ChaCha20_Poly1305::tag_t& p_tag)
+		{
+			alignas(8) std::array<uint8_t, Poly1305::block_lenght> block;
+			const uint64_t aad_size  = core::endian_host2little(p_aad_size);
+			const uint64_t data_size = core::endian_host2little(p_data_size);
+			memcpy(block.data(), &aad_size, 8);
+			memcpy(block.data() + 8, &data_size, 8);
+			Poly1305::update(p_key, p_hash, block.data(), 1);
+			Poly1305::finalize(p_key, p_hash, p_tag);
+		}
+	} //namespace
+
+	void ChaCha20_Poly1305::set_key(std::span<const uint8_t, key_lenght> p_key)
+	{
+		memcpy(m_key.data(), p_key.data(), key_lenght);
+	}
+
+	bool ChaCha20_Poly1305::encode(std::span<const uint8_t, nonce_lenght> p_nonce, std::span<const uint8_t> p_aad,
+		std::span<const uint8_t> p_input, std::span<uint8_t> p_out, tag_t& p_tag) const
+	{
+		const uintptr_t size = p_input.size();
+		if(size > max_size || p_out.size() < size)
+		{
+			return false;
+		}
+
+		Poly1305::key_t poly_key;
+		make_poly_key(m_key, p_nonce, poly_key);
+
+		Poly1305::state_t hash{0, 0, 0};
+		Poly1305::update_padded(poly_key, hash, p_aad.data(), p_aad.size());
+
+		for(uintptr_t offset = 0; offset < size; offset += chunk)
+		{
+			const uintptr_t count = std::min(chunk, size - offset);
+			ChaCha20::xor_stream(m_key, p_nonce, chunk_counter(offset), p_input.subspan(offset, count), p_out.subspan(offset, count));
+			Poly1305::update_padded(poly_key, hash, p_out.data() + offset, count);
+		}
+
+		compute_tag(poly_key, hash, p_aad.size(), size, p_tag);
+		return true;
+	}
+
+	bool ChaCha20_Poly1305::decode(std::span<const uint8_t, nonce_lenght> p_nonce, std::span<const uint8_t> p_aad,
+		std::span<const uint8_t> p_input, std::span<uint8_t> p_out, const tag_t& p_tag) const
+	{
+		const uintptr_t size = p_input.size();
+		if(size > max_size || p_out.size() < size)
+		{
+			return false;
+		}
+
+		Poly1305::key_t poly_key;
+		make_poly_key(m_key, p_nonce, poly_key);
+
+		Poly1305::state_t hash{0, 0, 0};
+		Poly1305::update_padded(poly_key, hash, p_aad.data(), p_aad.size());
+
+		//	Note: The cypher text is hashed before it is decrypted, p_out can be the same buffer as p_input.
+		for(uintptr_t offset = 0; offset < size; offset += chunk)
+		{
+			const uintptr_t count = std::min(chunk, size - offset);
+			Poly1305::update_padded(poly_key, hash, p_input.data() + offset, count);
+			ChaCha20::xor_stream(m_key, p_nonce, chunk_counter(offset), p_input.subspan(offset, count), p_out.subspan(offset, count));
+		}
+
+		tag_t tag;
+		compute_tag(poly_key, hash, p_aad.size(), size, tag);
+
+		uint8_t diff = 0;
+		for(uintptr_t i = 0; i < tag_lenght; ++i)
+		{
+			diff |= static_cast<uint8_t>(tag[i] ^ p_tag[i]);
+		}
+
+		if(diff)
+		{
+			memset(p_out.data(), 0, size);
+			return false;
+		}
+		return true;
+	}
+} //namespace crypto
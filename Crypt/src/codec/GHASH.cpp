@@ -0,0 +1,234 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include "GHASH.hpp"
+
+#include <cstring>
+
+#include <CoreLib/core_endian.hpp>
+
+#if defined(_M_AMD64) || defined(__amd64__)
+#	include <CoreLib/core_cpu.hpp>
+#	include <Crypt/codec/AES.hpp>
+#endif
+
+namespace crypto::_p
+{
+	namespace
+	{
+		//	Note: Constant time portable implementation.
+		//	64x64 carry-less multiplication is emulated with integer multiplications on operands with 3 bit holes between data bits,
+		//	so that carries never reach the next data bit. The high half of the product is obtained by multiplying the bit reversed operands.
+		struct GHASH_Help
+		{
+			static inline uint64_t bmul64(const uint64_t p_1, const uint64_t p_2)
+			{
+				constexpr uint64_t m0 = 0x1111111111111111;
+				constexpr uint64_t m1 = 0x2222222222222222;
+				constexpr uint64_t m2 = 0x4444444444444444;
+				constexpr uint64_t m3 = 0x8888888888888888;
+
+				const uint64_t x0 = p_1 & m0;
+				const uint64_t x1 = p_1 & m1;
+				const uint64_t x2 = p_1 & m2;
+				const uint64_t x3 = p_1 & m3;
+				const uint64_t y0 = p_2 & m0;
+				const uint64_t y1 = p_2 & m1;
+				const uint64_t y2 = p_2 & m2;
+				const uint64_t y3 = p_2 & m3;
+
+				const uint64_t z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+				const uint64_t z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+				const uint64_t z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+				const uint64_t z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+
+				return (z0 & m0) | (z1 & m1) | (z2 & m2) | (z3 & m3);
+			}
+
+			static inline uint64_t rev64(uint64_t p_val)
+			{
+				p_val = ((p_val & 0x5555555555555555) <<  1) | ((p_val >>  1) & 0x5555555555555555);
+				p_val = ((p_val & 0x3333333333333333) <<  2) | ((p_val >>  2) & 0x3333333333333333);
+				p_val = ((p_val & 0x0F0F0F0F0F0F0F0F) <<  4) | ((p_val >>  4) & 0x0F0F0F0F0F0F0F0F);
+				p_val = ((p_val & 0x00FF00FF00FF00FF) <<  8) | ((p_val >>  8) & 0x00FF00FF00FF00FF);
+				p_val = ((p_val & 0x0000FFFF0000FFFF) << 16) | ((p_val >> 16) & 0x0000FFFF0000FFFF);
+				return (p_val << 32) | (p_val >> 32);
+			}
+
+			static GHASH::block_t multiply(const GHASH::block_t& p_1, const GHASH::block_t& p_2)
+			{
+				const uint64_t y0 = p_1[0];
+				const uint64_t y1 = p_1[1];
+				const uint64_t h0 = p_2[0];
+				const uint64_t h1 = p_2[1];
+
+				const uint64_t y0r = rev64(y0);
+				const uint64_t y1r = rev64(y1);
+				const uint64_t h0r = rev64(h0);
+				const uint64_t h1r = rev64(h1);
+
+				//	Karatsuba
+				const uint64_t z0  = bmul64(y0, h0);
+				const uint64_t z1  = bmul64(y1, h1);
+				uint64_t       z2  = bmul64(y0 ^ y1, h0 ^ h1);
+				uint64_t       z0h = bmul64(y0r, h0r);
+				uint64_t       z1h = bmul64(y1r, h1r);
+				uint64_t       z2h = bmul64(y0r ^ y1r, h0r ^ h1r);
+
+				z2  ^= z0  ^ z1;
+				z2h ^= z0h ^ z1h;
+				z0h = rev64(z0h) >> 1;
+				z1h = rev64(z1h) >> 1;
+				z2h = rev64(z2h) >> 1;
+
+				uint64_t v0 = z0;
+				uint64_t v1 = z0h ^ z2;
+				uint64_t v2 = z1  ^ z2h;
+				uint64_t v3 = z1h;
+
+				//	bit reflected product is 1 bit short
+				v3 = (v3 << 1) | (v2 >> 63);
+				v2 = (v2 << 1) | (v1 >> 63);
+				v1 = (v1 << 1) | (v0 >> 63);
+				v0 = (v0 << 1);
+
+				//	reduction modulo x^128 + x^7 + x^2 + x + 1
+				v2 ^= v0 ^ (v0 >> 1) ^ (v0 >> 2) ^ (v0 >> 7);
+				v1 ^= (v0 << 63) ^ (v0 << 62) ^ (v0 << 57);
+				v3 ^= v1 ^ (v1 >> 1) ^ (v1 >> 2) ^ (v1 >> 7);
+				v2 ^= (v1 << 63) ^ (v1 << 62) ^ (v1 << 57);
+
+				return {v2, v3};
+			}
+
+			static void update(const GHASH::key_t& p_key, GHASH::block_t& p_state, const uint8_t* p_data, uintptr_t p_count)
+			{
+				GHASH::block_t state = p_state;
+				for(; p_count; --p_count, p_data += GHASH::block_lenght)
+				{
+					const GHASH::block_t block = GHASH::load(p_data);
+					state[0] ^= block[0];
+					state[1] ^= block[1];
+					state = multiply(state, p_key.power[0]);
+				}
+				p_state = state;
+			}
+		};
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		ISA_TARGET("pclmul,ssse3")
+		static void update_clmul(const GHASH::key_t& p_key, GHASH::block_t& p_state, const uint8_t* p_data, uintptr_t p_count)
+		{
+			std::array<__m128i, GHASH::aggregate> power;
+			GHASH_clmul::load_key(p_key, power);
+
+			__m128i state = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_state.data()));
+			GHASH_clmul::update(power, state, p_data, p_count);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_state.data()), state);
+		}
+#endif
+	} //namespace
+
+	void GHASH::make_key(std::span<const uint8_t, block_lenght> p_H, key_t& p_key)
+	{
+		p_key.power[0] = load(p_H.data());
+		for(uintptr_t i = 1; i < key_powers; ++i)
+		{
+			p_key.power[i] = GHASH_Help::multiply(p_key.power[i - 1], p_key.power[0]);
+		}
+	}
+
+	void GHASH::update(const key_t& p_key, block_t& p_state, const uint8_t* p_data, uintptr_t p_count)
+	{
+#if defined(_M_AMD64) || defined(__amd64__)
+		if(accelerated())
+		{
+			update_clmul(p_key, p_state, p_data, p_count);
+			return;
+		}
+#endif
+		GHASH_Help::update(p_key, p_state, p_data, p_count);
+	}
+
+	GHASH::block_t GHASH::multiply(const block_t& p_1, const block_t& p_2)
+	{
+		return GHASH_Help::multiply(p_1, p_2);
+	}
+
+	GHASH::block_t GHASH::power(const key_t& p_key, uint64_t p_exponent)
+	{
+		if(p_exponent <= key_powers)
+		{
+			return p_key.power[p_exponent - 1];
+		}
+
+		block_t out = p_key.power[0];
+		block_t square = p_key.power[0];
+		--p_exponent;
+		while(p_exponent)
+		{
+			if(p_exponent & 1)
+			{
+				out = GHASH_Help::multiply(out, square);
+			}
+			square = GHASH_Help::multiply(square, square);
+			p_exponent >>= 1;
+		}
+		return out;
+	}
+
+	GHASH::block_t GHASH::load(const uint8_t* p_data)
+	{
+		block_t out;
+		memcpy(&out[1], p_data, 8);
+		memcpy(&out[0], p_data + 8, 8);
+		out[0] = core::endian_big2host(out[0]);
+		out[1] = core::endian_big2host(out[1]);
+		return out;
+	}
+
+	void GHASH::store(const block_t& p_block, uint8_t* p_out)
+	{
+		const uint64_t hi = core::endian_host2big(p_block[1]);
+		const uint64_t lo = core::endian_host2big(p_block[0]);
+		memcpy(p_out, &hi, 8);
+		memcpy(p_out + 8, &lo, 8);
+	}
+
+	bool GHASH::accelerated()
+	{
+#if defined(_M_AMD64) || defined(__amd64__)
+		return
+			core::amd64::CPU_feature_su::PCLMULQDQ() &&
+			core::amd64::CPU_feature_su::SSSE3() &&
+			AES_get_engine() != AES_engine::software;
+#else
+		return false;
+#endif
+	}
+
+} //namespace crypto::_p
@@ -0,0 +1,173 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include <Crypt/codec/AES_GCM.hpp>
+
+#include "isa_target.hpp"
+
+namespace crypto::_p
+{
+	///	\brief GHASH universal hash (NIST SP 800-38D), the authentication part of AES-GCM
+	///	\note Blocks are kept as a host order 128 bit integer of the big endian block, {low half, high half}.
+	///		That is also the layout of a byte reversed block in an SSE register.
+	class GHASH
+	{
+	public:
+		static constexpr uintptr_t block_lenght = 16;
+
+		///	\brief Number of blocks multiplied before a single reduction
+		static constexpr uintptr_t aggregate = 8;
+
+		///	\brief Number of powers of H kept in the key, the 512 bit AES-GCM kernel reduces once every 16 blocks
+		static constexpr uintptr_t key_powers = 16;
+
+		using block_t = std::array<uint64_t, 2>;
+
+		using key_t = GHASH_key_t;
+		static_assert(std::tuple_size_v<decltype(key_t::power)> == key_powers);
+
+	public:
+		static void make_key(std::span<const uint8_t, block_lenght> p_H, key_t& p_key);
+
+		///	\brief p_state = (p_state ^ block) * H, for p_count consecutive blocks
+		static void update(const key_t& p_key, block_t& p_state, const uint8_t* p_data, uintptr_t p_count);
+
+		static block_t multiply(const block_t& p_1, const block_t& p_2);
+
+		///	\brief H^p_exponent, used to join hashes computed separately: hash(A || B) = hash(A) * H^blocks(B) ^ hash(B)
+		///	\param[in] p_exponent - Must be at least 1.
+		static block_t power(const key_t& p_key, uint64_t p_exponent);
+
+		static block_t load(const uint8_t* p_data);
+		static void store(const block_t& p_block, uint8_t* p_out);
+
+		///	\brief true if carry-less multiplication is in use.
+		///		The portable implementation is used if the CPU does not support it or \ref AES_engine::software is active.
+		static bool accelerated();
+	};
+
+#if defined(_M_AMD64) || defined(__amd64__)
+	//	Note: Also used by the fused AES-GCM kernel
+	struct GHASH_clmul
+	{
+		ISA_TARGET("ssse3")
+		static inline __m128i reverse(const __m128i p_block)
+		{
+			return _mm_shuffle_epi8(p_block, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+		}
+
+		ISA_TARGET("pclmul")
+		static inline void multiply_accumulate(__m128i& p_lo, __m128i& p_mid, __m128i& p_hi, const __m128i p_block, const __m128i p_H)
+		{
+			p_lo  = _mm_xor_si128(p_lo,  _mm_clmulepi64_si128(p_block, p_H, 0x00));
+			p_hi  = _mm_xor_si128(p_hi,  _mm_clmulepi64_si128(p_block, p_H, 0x11));
+			p_mid = _mm_xor_si128(p_mid, _mm_clmulepi64_si128(p_block, p_H, 0x01));
+			p_mid = _mm_xor_si128(p_mid, _mm_clmulepi64_si128(p_block, p_H, 0x10));
+		}
+
+		///	\brief Reduces an unreduced 256 bit product modulo x^128 + x^7 + x^2 + x + 1
+		///	\note The bit reflected product is 1 bit short, hence the shift before the reduction.
+		ISA_TARGET("sse2")
+		static inline __m128i reduce(__m128i p_lo, const __m128i p_mid, __m128i p_hi)
+		{
+			p_lo = _mm_xor_si128(p_lo, _mm_slli_si128(p_mid, 8));
+			p_hi = _mm_xor_si128(p_hi, _mm_srli_si128(p_mid, 8));
+
+			{
+				__m128i carry_lo = _mm_srli_epi32(p_lo, 31);
+				__m128i carry_hi = _mm_srli_epi32(p_hi, 31);
+				const __m128i carry_mid = _mm_srli_si128(carry_lo, 12);
+				carry_lo = _mm_slli_si128(carry_lo, 4);
+				carry_hi = _mm_slli_si128(carry_hi, 4);
+				p_lo = _mm_or_si128(_mm_slli_epi32(p_lo, 1), carry_lo);
+				p_hi = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(p_hi, 1), carry_hi), carry_mid);
+			}
+
+			__m128i t1 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(p_lo, 31), _mm_slli_epi32(p_lo, 30)), _mm_slli_epi32(p_lo, 25));
+			const __m128i t2 = _mm_srli_si128(t1, 4);
+			t1 = _mm_slli_si128(t1, 12);
+			p_lo = _mm_xor_si128(p_lo, t1);
+
+			__m128i t3 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(p_lo, 1), _mm_srli_epi32(p_lo, 2)), _mm_srli_epi32(p_lo, 7));
+			t3 = _mm_xor_si128(t3, t2);
+			p_lo = _mm_xor_si128(p_lo, t3);
+
+			return _mm_xor_si128(p_hi, p_lo);
+		}
+
+		///	\brief p_state = (...((p_state ^ block[0]) * H ^ block[1]) * H ...) for p_count <= \ref GHASH::aggregate byte reversed blocks
+		///		Each block is multiplied by its own power of H so that only one reduction is needed.
+		ISA_TARGET("pclmul")
+		static inline __m128i hash_blocks(const __m128i p_state, const __m128i* const p_blocks, const uintptr_t p_count, const __m128i* const p_power)
+		{
+			__m128i lo  = _mm_setzero_si128();
+			__m128i mid = _mm_setzero_si128();
+			__m128i hi  = _mm_setzero_si128();
+
+			multiply_accumulate(lo, mid, hi, _mm_xor_si128(p_blocks[0], p_state), p_power[p_count - 1]);
+			for(uintptr_t i = 1; i < p_count; ++i)
+			{
+				multiply_accumulate(lo, mid, hi, p_blocks[i], p_power[p_count - 1 - i]);
+			}
+			return reduce(lo, mid, hi);
+		}
+
+		ISA_TARGET("pclmul,ssse3")
+		static inline void load_key(const GHASH::key_t& p_key, std::array<__m128i, GHASH::aggregate>& p_power)
+		{
+			for(uintptr_t i = 0; i < GHASH::aggregate; ++i)
+			{
+				p_power[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_key.power[i].data()));
+			}
+		}
+
+		ISA_TARGET("pclmul,ssse3")
+		static inline void update(const std::array<__m128i, GHASH::aggregate>& p_power, __m128i& p_state, const uint8_t* p_data, uintptr_t p_count)
+		{
+			std::array<__m128i, GHASH::aggregate> blocks;
+			while(p_count)
+			{
+				const uintptr_t count = p_count < GHASH::aggregate ? p_count : GHASH::aggregate;
+				for(uintptr_t i = 0; i < count; ++i)
+				{
+					blocks[i] = reverse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_data) + i));
+				}
+				p_state = hash_blocks(p_state, blocks.data(), count, p_power.data());
+				p_data  += count * GHASH::block_lenght;
+				p_count -= count;
+			}
+		}
+	};
+#endif
+
+} //namespace crypto::_p
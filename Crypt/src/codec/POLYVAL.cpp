@@ -0,0 +1,253 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include "POLYVAL.hpp"
+
+#include <cstring>
+#include <utility>
+
+#include <CoreLib/core_endian.hpp>
+
+#if defined(_M_AMD64) || defined(__amd64__)
+#	include <CoreLib/core_cpu.hpp>
+#	include <Crypt/codec/AES.hpp>
+#endif
+
+#include "GHASH.hpp"
+
+namespace crypto::_p
+{
+	namespace
+	{
+		//	Note: Portable implementation, RFC 8452 Appendix A.
+		//	POLYVAL(H, X_1, ..., X_n) = ByteReverse(GHASH(mulX_GHASH(ByteReverse(H)), ByteReverse(X_1), ..., ByteReverse(X_n)))
+		//	A byte reversed block loaded by GHASH is the little endian block loaded by POLYVAL, so only the key needs converting.
+		struct POLYVAL_Help
+		{
+			static inline POLYVAL::block_t mulX_GHASH(const POLYVAL::block_t& p_block)
+			{
+				const uint64_t carry = p_block[0] & 1;
+				return
+				{
+					(p_block[0] >> 1) | (p_block[1] << 63),
+					(p_block[1] >> 1) ^ (0xE100000000000000 & (0 - carry))
+				};
+			}
+
+			static void update(const POLYVAL::key_t& p_key, POLYVAL::block_t& p_state, const uint8_t* p_data, uintptr_t p_count)
+			{
+				POLYVAL::block_t state = p_state;
+				for(; p_count; --p_count, p_data += POLYVAL::block_lenght)
+				{
+					const POLYVAL::block_t block = POLYVAL::load(p_data);
+					state[0] ^= block[0];
+					state[1] ^= block[1];
+					state = GHASH::multiply(state, p_key.ghash_H);
+				}
+				p_state = state;
+			}
+		};
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		//	Note: Powers are derived from the ones already known, H^(n + k) = H^n * H^k, so that the multiplications
+		//	are independent of each other instead of one long chain.
+		ISA_TARGET("pclmul")
+		static void make_key_clmul(POLYVAL::key_t& p_key)
+		{
+			std::array<__m128i, POLYVAL::aggregate> power;
+			power[0] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_key.power[0].data()));
+			power[1] = POLYVAL_clmul::multiply(power[0], power[0]);
+			power[2] = POLYVAL_clmul::multiply(power[1], power[0]);
+			power[3] = POLYVAL_clmul::multiply(power[1], power[1]);
+			for(uintptr_t i = 4; i < POLYVAL::aggregate; ++i)
+			{
+				power[i] = POLYVAL_clmul::multiply(power[i - 4], power[3]);
+			}
+
+			for(uintptr_t i = 1; i < POLYVAL::aggregate; ++i)
+			{
+				_mm_store_si128(reinterpret_cast<__m128i*>(p_key.power[i].data()), power[i]);
+			}
+		}
+
+		//	Note: Extends H^1 .. H^8 to H^1 .. H^32, 4 powers per multiplication.
+		ISA_TARGET("vpclmulqdq,avx512f,avx512bw")
+		static void make_key_wide(POLYVAL::key_t& p_key)
+		{
+			constexpr uintptr_t vec_blocks = POLYVAL_wide::vec_blocks;
+			std::array<__m512i, POLYVAL::key_powers / vec_blocks> power;
+			power[0] = _mm512_load_si512(p_key.power[0].data());
+			power[1] = _mm512_load_si512(p_key.power[vec_blocks].data());
+
+			for(uintptr_t known = 2; known < power.size(); known *= 2)
+			{
+				const __m512i step = _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(p_key.power[known * vec_blocks - 1].data())));
+				for(uintptr_t i = 0; i < known; ++i)
+				{
+					power[known + i] = POLYVAL_wide::multiply(power[i], step);
+					_mm512_store_si512(p_key.power[(known + i) * vec_blocks].data(), power[known + i]);
+				}
+			}
+		}
+
+		ISA_TARGET("pclmul")
+		static void update_clmul(const POLYVAL::key_t& p_key, POLYVAL::block_t& p_state, const uint8_t* p_data, uintptr_t p_count)
+		{
+			std::array<__m128i, POLYVAL::aggregate> power;
+			POLYVAL_clmul::load_key(p_key, power);
+
+			__m128i state = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_state.data()));
+			POLYVAL_clmul::update(power, state, p_data, p_count);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_state.data()), state);
+		}
+
+		template<uintptr_t Lanes>
+		ISA_TARGET("avx512f")
+		static inline std::array<__m512i, Lanes> load_lanes(const uint8_t* const p_data)
+		{
+			std::array<__m512i, Lanes> blocks;
+			for(uintptr_t i = 0; i < Lanes; ++i)
+			{
+				blocks[i] = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(p_data) + i);
+			}
+			return blocks;
+		}
+
+		//	Note: Groups of 32 blocks, then one group of 16, the remainder goes through the 128 bit kernel.
+		ISA_TARGET("pclmul,vpclmulqdq,avx512f")
+		static void update_wide(const POLYVAL::key_t& p_key, POLYVAL::block_t& p_state, const uint8_t* p_data, uintptr_t p_count)
+		{
+			constexpr uintptr_t vec_blocks	= POLYVAL_wide::vec_blocks;
+			constexpr uintptr_t lanes		= POLYVAL::key_powers / vec_blocks;
+			constexpr uintptr_t group		= POLYVAL::key_powers;
+
+			__m128i state = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_state.data()));
+
+			if(p_count >= group)
+			{
+				std::array<__m512i, lanes> power;
+				POLYVAL_wide::load_key(p_key, power);
+				for(; p_count >= group; p_count -= group, p_data += group * POLYVAL::block_lenght)
+				{
+					state = POLYVAL_wide::hash_lanes(state, load_lanes<lanes>(p_data), power, std::make_index_sequence<lanes>{});
+				}
+			}
+
+			if(p_count >= group / 2)
+			{
+				std::array<__m512i, lanes / 2> power;
+				POLYVAL_wide::load_key(p_key, power);
+				state = POLYVAL_wide::hash_lanes(state, load_lanes<lanes / 2>(p_data), power, std::make_index_sequence<lanes / 2>{});
+				p_count -= group / 2;
+				p_data  += group / 2 * POLYVAL::block_lenght;
+			}
+
+			if(p_count)
+			{
+				std::array<__m128i, POLYVAL::aggregate> power;
+				POLYVAL_clmul::load_key(p_key, power);
+				POLYVAL_clmul::update(power, state, p_data, p_count);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p_state.data()), state);
+		}
+#endif
+	} //namespace
+
+	void POLYVAL::make_key(std::span<const uint8_t, block_lenght> p_H, key_t& p_key)
+	{
+		p_key.power[0] = load(p_H.data());
+		p_key.ghash_H = POLYVAL_Help::mulX_GHASH(p_key.power[0]);
+		p_key.powers = 1;
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		if(accelerated())
+		{
+			make_key_clmul(p_key);
+			p_key.powers = aggregate;
+			if(wide())
+			{
+				make_key_wide(p_key);
+				p_key.powers = key_powers;
+			}
+		}
+#endif
+	}
+
+	void POLYVAL::update(const key_t& p_key, block_t& p_state, const uint8_t* p_data, uintptr_t p_count)
+	{
+		//	Note: A key with more than H^1 was made when the CPU supported the matching kernel.
+#if defined(_M_AMD64) || defined(__amd64__)
+		if(p_key.powers == key_powers)
+		{
+			update_wide(p_key, p_state, p_data, p_count);
+			return;
+		}
+		if(p_key.powers == aggregate)
+		{
+			update_clmul(p_key, p_state, p_data, p_count);
+			return;
+		}
+#endif
+		POLYVAL_Help::update(p_key, p_state, p_data, p_count);
+	}
+
+	POLYVAL::block_t POLYVAL::load(const uint8_t* p_data)
+	{
+		block_t out;
+		memcpy(&out[0], p_data, 8);
+		memcpy(&out[1], p_data + 8, 8);
+		out[0] = core::endian_little2host(out[0]);
+		out[1] = core::endian_little2host(out[1]);
+		return out;
+	}
+
+	void POLYVAL::store(const block_t& p_block, uint8_t* p_out)
+	{
+		const uint64_t lo = core::endian_host2little(p_block[0]);
+		const uint64_t hi = core::endian_host2little(p_block[1]);
+		memcpy(p_out, &lo, 8);
+		memcpy(p_out + 8, &hi, 8);
+	}
+
+	bool POLYVAL::accelerated()
+	{
+		return GHASH::accelerated();
+	}
+
+	bool POLYVAL::wide()
+	{
+#if defined(_M_AMD64) || defined(__amd64__)
+		return
+			AES_get_engine() == AES_engine::VAES_AVX512 &&
+			core::amd64::CPU_feature_su::VPCLMULQDQ() &&
+			accelerated();
+#else
+		return false;
+#endif
+	}
+
+} //namespace crypto::_p
@@ -0,0 +1,235 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <span>
+
+#include "isa_target.hpp"
+
+namespace crypto::_p
+{
+	///	\brief POLYVAL universal hash (RFC 8452), the authentication part of AES-GCM-SIV
+	///	\note Blocks are kept as a host order 128 bit little endian integer, {low half, high half}.
+	///		That is also the layout of the block in an SSE register, no byte reversal is needed.
+	class POLYVAL
+	{
+	public:
+		static constexpr uintptr_t block_lenght = 16;
+
+		///	\brief Number of blocks multiplied before a single reduction
+		static constexpr uintptr_t aggregate = 8;
+
+		///	\brief Number of powers of H kept in the key, the 512 bit kernel reduces once every 32 blocks
+		static constexpr uintptr_t key_powers = 32;
+
+		using block_t = std::array<uint64_t, 2>;
+
+		struct key_t
+		{
+			///	\brief H^1 .. H^32. Only H^1 .. H^8 are set if \ref wide is false, and only H^1 if \ref accelerated is false.
+			alignas(64) std::array<block_t, key_powers> power;
+
+			///	\brief mulX_GHASH(ByteReverse(H)), the portable implementation goes through GHASH
+			block_t ghash_H;
+
+			///	\brief Number of powers set by \ref make_key (1, \ref aggregate or \ref key_powers).
+			///		\ref update picks its kernel from it, so a key stays valid if the AES engine changes afterwards.
+			uint8_t powers = 1;
+		};
+
+	public:
+		static void make_key(std::span<const uint8_t, block_lenght> p_H, key_t& p_key);
+
+		///	\brief p_state = dot(p_state ^ block, H), for p_count consecutive blocks
+		///	\note The kernel is chosen by the layout of p_key, not by the active engine.
+		static void update(const key_t& p_key, block_t& p_state, const uint8_t* p_data, uintptr_t p_count);
+
+		static block_t load(const uint8_t* p_data);
+		static void store(const block_t& p_block, uint8_t* p_out);
+
+		///	\brief true if carry-less multiplication is in use, same conditions as \ref GHASH::accelerated
+		static bool accelerated();
+
+		///	\brief true if the 512 bit carry-less multiplication is in use, when \ref AES_engine::VAES_AVX512 is active.
+		static bool wide();
+	};
+
+#if defined(_M_AMD64) || defined(__amd64__)
+	struct POLYVAL_clmul
+	{
+		ISA_TARGET("pclmul")
+		static inline void multiply_accumulate(__m128i& p_lo, __m128i& p_mid, __m128i& p_hi, const __m128i p_block, const __m128i p_H)
+		{
+			p_lo  = _mm_xor_si128(p_lo,  _mm_clmulepi64_si128(p_block, p_H, 0x00));
+			p_hi  = _mm_xor_si128(p_hi,  _mm_clmulepi64_si128(p_block, p_H, 0x11));
+			p_mid = _mm_xor_si128(p_mid, _mm_clmulepi64_si128(p_block, p_H, 0x01));
+			p_mid = _mm_xor_si128(p_mid, _mm_clmulepi64_si128(p_block, p_H, 0x10));
+		}
+
+		///	\brief Montgomery reduction of an unreduced 256 bit product, result = product * x^-128 mod x^128 + x^127 + x^126 + x^121 + 1
+		///	\note Two folds of the low 64 bits by the constant 0xC2 << 56, each one clears 64 bits.
+		ISA_TARGET("pclmul")
+		static inline __m128i reduce(__m128i p_lo, const __m128i p_mid, __m128i p_hi)
+		{
+			const __m128i poly = _mm_set_epi64x(static_cast<int64_t>(0xC200000000000000), 0);
+
+			p_lo = _mm_xor_si128(p_lo, _mm_slli_si128(p_mid, 8));
+			p_hi = _mm_xor_si128(p_hi, _mm_srli_si128(p_mid, 8));
+
+			p_lo = _mm_xor_si128(_mm_shuffle_epi32(p_lo, 0x4E), _mm_clmulepi64_si128(p_lo, poly, 0x10));
+			p_lo = _mm_xor_si128(_mm_shuffle_epi32(p_lo, 0x4E), _mm_clmulepi64_si128(p_lo, poly, 0x10));
+			return _mm_xor_si128(p_hi, p_lo);
+		}
+
+		ISA_TARGET("pclmul")
+		static inline __m128i multiply(const __m128i p_1, const __m128i p_2)
+		{
+			__m128i lo  = _mm_setzero_si128();
+			__m128i mid = _mm_setzero_si128();
+			__m128i hi  = _mm_setzero_si128();
+			multiply_accumulate(lo, mid, hi, p_1, p_2);
+			return reduce(lo, mid, hi);
+		}
+
+		///	\brief p_state = dot(...dot(dot(p_state ^ block[0], H) ^ block[1], H) ...) for p_count <= \ref POLYVAL::aggregate blocks
+		///		Each block is multiplied by its own power of H so that only one reduction is needed.
+		ISA_TARGET("pclmul")
+		static inline __m128i hash_blocks(const __m128i p_state, const __m128i* const p_blocks, const uintptr_t p_count, const __m128i* const p_power)
+		{
+			__m128i lo  = _mm_setzero_si128();
+			__m128i mid = _mm_setzero_si128();
+			__m128i hi  = _mm_setzero_si128();
+
+			for(uintptr_t i = 1; i < p_count; ++i)
+			{
+				multiply_accumulate(lo, mid, hi, p_blocks[i], p_power[p_count - 1 - i]);
+			}
+			multiply_accumulate(lo, mid, hi, _mm_xor_si128(p_blocks[0], p_state), p_power[p_count - 1]);
+			return reduce(lo, mid, hi);
+		}
+
+		ISA_TARGET("pclmul")
+		static inline void load_key(const POLYVAL::key_t& p_key, std::array<__m128i, POLYVAL::aggregate>& p_power)
+		{
+			for(uintptr_t i = 0; i < POLYVAL::aggregate; ++i)
+			{
+				p_power[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(p_key.power[i].data()));
+			}
+		}
+
+		ISA_TARGET("pclmul")
+		static inline void update(const std::array<__m128i, POLYVAL::aggregate>& p_power, __m128i& p_state, const uint8_t* p_data, uintptr_t p_count)
+		{
+			std::array<__m128i, POLYVAL::aggregate> blocks;
+			//	Note: Full groups have a fixed count so that the loads and products are fully unrolled.
+			for(; p_count >= POLYVAL::aggregate; p_count -= POLYVAL::aggregate)
+			{
+				for(uintptr_t i = 0; i < POLYVAL::aggregate; ++i)
+				{
+					blocks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_data) + i);
+				}
+				p_state = hash_blocks(p_state, blocks.data(), POLYVAL::aggregate, p_power.data());
+				p_data += POLYVAL::aggregate * POLYVAL::block_lenght;
+			}
+			if(p_count)
+			{
+				for(uintptr_t i = 0; i < p_count; ++i)
+				{
+					blocks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_data) + i);
+				}
+				p_state = hash_blocks(p_state, blocks.data(), p_count, p_power.data());
+			}
+		}
+	};
+
+	//	Note: 512 bit carry-less multiplication, 4 blocks per instruction.
+	//	A group of 4 * Lanes blocks is multiplied by H^(4 * Lanes) .. H^1, the 4 lanes of the products are summed
+	//	and reduced once.
+	struct POLYVAL_wide
+	{
+		static constexpr uintptr_t vec_blocks = 4;
+
+		ISA_TARGET("avx512f")
+		static inline __m128i fold(const __m512i p_val)
+		{
+			const __m256i half = _mm256_xor_si256(_mm512_castsi512_si256(p_val), _mm512_extracti64x4_epi64(p_val, 1));
+			return _mm_xor_si128(_mm256_castsi256_si128(half), _mm256_extracti128_si256(half, 1));
+		}
+
+		//	Note: p_power[j] holds H^(4 * Lanes - 4j) .. H^(4 * Lanes - 4j - 3), the key holds them in ascending order.
+		template<uintptr_t Lanes>
+		ISA_TARGET("avx512f")
+		static inline void load_key(const POLYVAL::key_t& p_key, std::array<__m512i, Lanes>& p_power)
+		{
+			static_assert(Lanes * vec_blocks <= POLYVAL::key_powers);
+			for(uintptr_t i = 0; i < Lanes; ++i)
+			{
+				const __m512i power = _mm512_load_si512(p_key.power[vec_blocks * (Lanes - i - 1)].data());
+				p_power[i] = _mm512_shuffle_i64x2(power, power, 0x1B);
+			}
+		}
+
+		template<uintptr_t... I>
+		ISA_TARGET("pclmul,vpclmulqdq,avx512f")
+		static inline __m128i hash_lanes(const __m128i p_state, std::array<__m512i, sizeof...(I)> p_blocks, const std::array<__m512i, sizeof...(I)>& p_power, std::index_sequence<I...>)
+		{
+			p_blocks[0] = _mm512_xor_si512(p_blocks[0], _mm512_zextsi128_si512(p_state));
+
+			__m512i lo  = _mm512_setzero_si512();
+			__m512i mid = _mm512_setzero_si512();
+			__m512i hi  = _mm512_setzero_si512();
+			((lo  = _mm512_xor_si512(lo,  _mm512_clmulepi64_epi128(p_blocks[I], p_power[I], 0x00))), ...);
+			((hi  = _mm512_xor_si512(hi,  _mm512_clmulepi64_epi128(p_blocks[I], p_power[I], 0x11))), ...);
+			((mid = _mm512_xor_si512(mid, _mm512_clmulepi64_epi128(p_blocks[I], p_power[I], 0x01))), ...);
+			((mid = _mm512_xor_si512(mid, _mm512_clmulepi64_epi128(p_blocks[I], p_power[I], 0x10))), ...);
+			return POLYVAL_clmul::reduce(fold(lo), fold(mid), fold(hi));
+		}
+
+		///	\brief Independent products of the 4 blocks of each operand, each one reduced on its own
+		ISA_TARGET("vpclmulqdq,avx512f,avx512bw")
+		static inline __m512i multiply(const __m512i p_1, const __m512i p_2)
+		{
+			const __m512i poly = _mm512_broadcast_i32x4(_mm_set_epi64x(static_cast<int64_t>(0xC200000000000000), 0));
+
+			__m512i lo  = _mm512_clmulepi64_epi128(p_1, p_2, 0x00);
+			__m512i hi  = _mm512_clmulepi64_epi128(p_1, p_2, 0x11);
+			__m512i mid = _mm512_xor_si512(_mm512_clmulepi64_epi128(p_1, p_2, 0x01), _mm512_clmulepi64_epi128(p_1, p_2, 0x10));
+
+			lo = _mm512_xor_si512(lo, _mm512_bslli_epi128(mid, 8));
+			hi = _mm512_xor_si512(hi, _mm512_bsrli_epi128(mid, 8));
+
+			lo = _mm512_xor_si512(_mm512_shuffle_epi32(lo, _MM_PERM_BADC), _mm512_clmulepi64_epi128(lo, poly, 0x10));
+			lo = _mm512_xor_si512(_mm512_shuffle_epi32(lo, _MM_PERM_BADC), _mm512_clmulepi64_epi128(lo, poly, 0x10));
+			return _mm512_xor_si512(hi, lo);
+		}
+	};
+#endif
+
+} //namespace crypto::_p
@@ -0,0 +1,369 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		Poly1305 - One time authenticator
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include "Poly1305.hpp"
+
+#include <cstring>
+
+#include <CoreLib/core_endian.hpp>
+
+#include <Crypt/codec/ChaCha20.hpp>
+
+#include "isa_target.hpp"
+#include "extended_precision.hpp"
+
+namespace crypto::_p
+{
+	namespace
+	{
+		static constexpr uint64_t limb_mask = 0x3FFFFFF;
+
+		//	Note: Below this number of blocks the setup of the vectorized kernel costs more than it saves.
+		static constexpr uintptr_t vector_threshold = 16;
+
+		static inline uint64_t load64(const uint8_t* const p_data)
+		{
+			uint64_t val;
+			memcpy(&val, p_data, 8);
+			return core::endian_little2host(val);
+		}
+
+		static inline void store64(const uint64_t p_val, uint8_t* const p_out)
+		{
+			const uint64_t val = core::endian_host2little(p_val);
+			memcpy(p_out, &val, 8);
+		}
+
+		//	Note: Radix 2^64 implementation, based on the multi-precision helpers also used by the elliptic curves.
+		//	r1 has its 2 low bits cleared, so that h1 * r1 * 2^128 = h1 * (r1 / 4) * 2^130 = h1 * (5 * r1 / 4) mod p,
+		//	with 5 * r1 / 4 = r1 + (r1 >> 2).
+		struct Poly1305_Help
+		{
+			static FORCE_INLINE void add_block(Poly1305::state_t& p_h, const uint8_t* const p_data)
+			{
+				uint8_t carry = addcarry(0, p_h[0], load64(p_data), p_h[0]);
+				carry = addcarry(carry, p_h[1], load64(p_data + 8), p_h[1]);
+				p_h[2] += carry + 1;
+			}
+
+			static FORCE_INLINE void multiply(Poly1305::state_t& p_h, const uint64_t p_r0, const uint64_t p_r1, const uint64_t p_s1)
+			{
+				uint64_t d0_hi;
+				uint64_t d1_hi;
+				uint64_t t_hi;
+
+				uint64_t d0 = umul(p_h[0], p_r0, d0_hi);
+				uint64_t t  = umul(p_h[1], p_s1, t_hi);
+				d0_hi += t_hi + addcarry(0, d0, t, d0);
+
+				uint64_t d1 = umul(p_h[0], p_r1, d1_hi);
+				t = umul(p_h[1], p_r0, t_hi);
+				d1_hi += t_hi + addcarry(0, d1, t, d1);
+				d1_hi += addcarry(0, d1, p_h[2] * p_s1, d1);
+				d1_hi += addcarry(0, d1, d0_hi, d1);
+
+				const uint64_t d2 = p_h[2] * p_r0 + d1_hi;
+
+				//	Everything above 2^130 is folded back in multiplied by 5
+				const uint64_t fold = (d2 >> 2) + (d2 & ~uint64_t{3});
+				uint8_t carry = addcarry(0, d0, fold, p_h[0]);
+				carry = addcarry(carry, d1, 0, p_h[1]);
+				p_h[2] = (d2 & 3) + carry;
+			}
+
+			//	Note: Constant time, the result is the canonical value in [0, 2^130 - 5)
+			static inline void reduce(Poly1305::state_t& p_h)
+			{
+				const uint64_t fold = (p_h[2] >> 2) + (p_h[2] & ~uint64_t{3});
+				uint8_t carry = addcarry(0, p_h[0], fold, p_h[0]);
+				carry = addcarry(carry, p_h[1], 0, p_h[1]);
+				p_h[2] = (p_h[2] & 3) + carry;
+
+				uint64_t g0;
+				uint64_t g1;
+				carry = addcarry(0, p_h[0], 5, g0);
+				carry = addcarry(carry, p_h[1], 0, g1);
+				const uint64_t g2 = p_h[2] + carry;
+
+				const uint64_t mask = uint64_t{0} - (g2 >> 2);
+				p_h[0] = (p_h[0] & ~mask) | (g0 & mask);
+				p_h[1] = (p_h[1] & ~mask) | (g1 & mask);
+				p_h[2] = (p_h[2] & ~mask) | (g2 & mask & 3);
+			}
+
+			static inline void to_limbs(const Poly1305::state_t& p_h, std::array<uint32_t, 5>& p_limbs)
+			{
+				p_limbs[0] = static_cast<uint32_t>(p_h[0] & limb_mask);
+				p_limbs[1] = static_cast<uint32_t>((p_h[0] >> 26) & limb_mask);
+				p_limbs[2] = static_cast<uint32_t>(((p_h[0] >> 52) | (p_h[1] << 12)) & limb_mask);
+				p_limbs[3] = static_cast<uint32_t>((p_h[1] >> 14) & limb_mask);
+				p_limbs[4] = static_cast<uint32_t>((p_h[1] >> 40) | (p_h[2] << 24));
+			}
+
+			//	Note: Limbs can be slightly above 26 bits, they are carried before being packed.
+			static inline void from_limbs(std::array<uint64_t, 5>& p_limbs, Poly1305::state_t& p_h)
+			{
+				for(uintptr_t i = 0; i < 4; ++i)
+				{
+					p_limbs[i + 1] += p_limbs[i] >> 26;
+					p_limbs[i] &= limb_mask;
+				}
+				p_limbs[0] += (p_limbs[4] >> 26) * 5;
+				p_limbs[4] &= limb_mask;
+				p_limbs[1] += p_limbs[0] >> 26;
+				p_limbs[0] &= limb_mask;
+
+				p_h[0] = p_limbs[0] + (p_limbs[1] << 26);
+				uint8_t carry = addcarry(0, p_h[0], p_limbs[2] << 52, p_h[0]);
+				p_h[1] = (p_limbs[2] >> 12) + (p_limbs[3] << 14);
+				carry = addcarry(carry, p_h[1], p_limbs[4] << 40, p_h[1]);
+				p_h[2] = (p_limbs[4] >> 24) + carry;
+			}
+
+			static void update(const Poly1305::key_t& p_key, Poly1305::state_t& p_state, const uint8_t* p_data, uintptr_t p_count)
+			{
+				const uint64_t r0 = p_key.r[0];
+				const uint64_t r1 = p_key.r[1];
+				const uint64_t s1 = r1 + (r1 >> 2);
+
+				Poly1305::state_t h = p_state;
+				for(; p_count; --p_count, p_data += Poly1305::block_lenght)
+				{
+					add_block(h, p_data);
+					multiply(h, r0, r1, s1);
+				}
+				p_state = h;
+			}
+		};
+
+#if defined(_M_AMD64) || defined(__amd64__)
+		//	Note: Radix 2^26 implementation, every 64 bit lane holds a 26 bit limb of a different block.
+		//	Lane i hashes blocks i, i + 4, i + 8, ... multiplying by r^4 at every step,
+		//	the last step multiplies the lanes by r^4, r^3, r^2 and r^1 before adding them up.
+		struct Poly1305_AVX2_Help
+		{
+			using limbs_t = std::array<__m256i, 5>;
+
+			ISA_TARGET("avx2")
+			static inline void load_blocks(const uint8_t* const p_data, limbs_t& p_m)
+			{
+				const __m256i mask = _mm256_set1_epi64x(limb_mask);
+				const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_data));
+				const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_data) + 1);
+				const __m256i lo = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xD8);
+				const __m256i hi = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), 0xD8);
+
+				p_m[0] = _mm256_and_si256(lo, mask);
+				p_m[1] = _mm256_and_si256(_mm256_srli_epi64(lo, 26), mask);
+				p_m[2] = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(lo, 52), _mm256_slli_epi64(hi, 12)), mask);
+				p_m[3] = _mm256_and_si256(_mm256_srli_epi64(hi, 14), mask);
+				p_m[4] = _mm256_or_si256(_mm256_srli_epi64(hi, 40), _mm256_set1_epi64x(1 << 24));
+			}
+
+			ISA_TARGET("avx2")
+			static inline __m256i times5(const __m256i p_val)
+			{
+				return _mm256_add_epi64(p_val, _mm256_slli_epi64(p_val, 2));
+			}
+
+			//	Note: p_1 * p_2 + p_3 * p_4 + ... on the low 32 bits of each lane
+			ISA_TARGET("avx2")
+			static inline __m256i dot5(
+				const __m256i p_h0, const __m256i p_r0, const __m256i p_h1, const __m256i p_r1, const __m256i p_h2, const __m256i p_r2,
+				const __m256i p_h3, const __m256i p_r3, const __m256i p_h4, const __m256i p_r4)
+			{
+				return _mm256_add_epi64(
+					_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(p_h0, p_r0), _mm256_mul_epu32(p_h1, p_r1)),
+						_mm256_add_epi64(_mm256_mul_epu32(p_h2, p_r2), _mm256_mul_epu32(p_h3, p_r3))),
+					_mm256_mul_epu32(p_h4, p_r4));
+			}
+
+			ISA_TARGET("avx2")
+			static inline void carry(__m256i& p_low, __m256i& p_high)
+			{
+				p_high = _mm256_add_epi64(p_high, _mm256_srli_epi64(p_low, 26));
+				p_low = _mm256_and_si256(p_low, _mm256_set1_epi64x(limb_mask));
+			}
+
+			//	Note: p_s = 5 * p_r, limbs above 2^130 wrap around multiplied by 5
+			ISA_TARGET("avx2")
+			static inline void multiply(limbs_t& p_h, const limbs_t& p_r, const limbs_t& p_s)
+			{
+				const auto& [h0, h1, h2, h3, h4] = p_h;
+				__m256i d0 = dot5(h0, p_r[0], h1, p_s[4], h2, p_s[3], h3, p_s[2], h4, p_s[1]);
+				__m256i d1 = dot5(h0, p_r[1], h1, p_r[0], h2, p_s[4], h3, p_s[3], h4, p_s[2]);
+				__m256i d2 = dot5(h0, p_r[2], h1, p_r[1], h2, p_r[0], h3, p_s[4], h4, p_s[3]);
+				__m256i d3 = dot5(h0, p_r[3], h1, p_r[2], h2, p_r[1], h3, p_r[0], h4, p_s[4]);
+				__m256i d4 = dot5(h0, p_r[4], h1, p_r[3], h2, p_r[2], h3, p_r[1], h4, p_r[0]);
+
+				//	Two independent carry chains, d4 wraps around into d0
+				carry(d0, d1); carry(d3, d4);
+				carry(d1, d2);
+				__m256i top = _mm256_srli_epi64(d4, 26);
+				d4 = _mm256_and_si256(d4, _mm256_set1_epi64x(limb_mask));
+				d0 = _mm256_add_epi64(d0, times5(top));
+				carry(d2, d3);
+				carry(d0, d1); carry(d3, d4);
+
+				p_h = {d0, d1, d2, d3, d4};
+			}
+
+			ISA_TARGET("avx2")
+			static inline void add(limbs_t& p_h, const limbs_t& p_m)
+			{
+				p_h = {
+					_mm256_add_epi64(p_h[0], p_m[0]),
+					_mm256_add_epi64(p_h[1], p_m[1]),
+					_mm256_add_epi64(p_h[2], p_m[2]),
+					_mm256_add_epi64(p_h[3], p_m[3]),
+					_mm256_add_epi64(p_h[4], p_m[4])};
+			}
+
+			ISA_TARGET("avx2")
+			static inline uint64_t horizontal_add(const __m256i p_val)
+			{
+				const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(p_val), _mm256_extracti128_si256(p_val, 1));
+				return static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_add_epi64(half, _mm_unpackhi_epi64(half, half))));
+			}
+
+			//	Note: p_count must be a multiple of \ref Poly1305::lanes
+			ISA_TARGET("avx2")
+			static void update(const Poly1305::key_t& p_key, Poly1305::state_t& p_state, const uint8_t* p_data, uintptr_t p_count)
+			{
+				limbs_t r4;
+				limbs_t s4;
+				limbs_t r_last;
+				limbs_t s_last;
+				for(uintptr_t i = 0; i < 5; ++i)
+				{
+					r4[i] = _mm256_set1_epi64x(p_key.power[3][i]);
+					s4[i] = times5(r4[i]);
+					r_last[i] = _mm256_set_epi64x(p_key.power[0][i], p_key.power[1][i], p_key.power[2][i], p_key.power[3][i]);
+					s_last[i] = times5(r_last[i]);
+				}
+
+				std::array<uint32_t, 5> state;
+				Poly1305_Help::to_limbs(p_state, state);
+
+				limbs_t h;
+				load_blocks(p_data, h);
+				for(uintptr_t i = 0; i < 5; ++i)
+				{
+					h[i] = _mm256_add_epi64(h[i], _mm256_set_epi64x(0, 0, 0, state[i]));
+				}
+
+				for(p_count -= Poly1305::lanes, p_data += Poly1305::lanes * Poly1305::block_lenght; p_count;
+					p_count -= Poly1305::lanes, p_data += Poly1305::lanes * Poly1305::block_lenght)
+				{
+					multiply(h, r4, s4);
+					limbs_t m;
+					load_blocks(p_data, m);
+					add(h, m);
+				}
+				multiply(h, r_last, s_last);
+
+				std::array<uint64_t, 5> sum;
+				for(uintptr_t i = 0; i < 5; ++i)
+				{
+					sum[i] = horizontal_add(h[i]);
+				}
+				Poly1305_Help::from_limbs(sum, p_state);
+			}
+		};
+#endif
+	} //namespace
+
+	void Poly1305::make_key(std::span<const uint8_t, key_lenght> p_key, key_t& p_out)
+	{
+		p_out.r[0] = load64(p_key.data()) & 0x0FFFFFFC0FFFFFFF;
+		p_out.r[1] = load64(p_key.data() + 8) & 0x0FFFFFFC0FFFFFFC;
+		p_out.s[0] = load64(p_key.data() + 16);
+		p_out.s[1] = load64(p_key.data() + 24);
+
+		//	Note: Always derived, a few multiplications per message, so that the key does not depend on the active engine.
+		const uint64_t s1 = p_out.r[1] + (p_out.r[1] >> 2);
+		state_t h{p_out.r[0], p_out.r[1], 0};
+		Poly1305_Help::to_limbs(h, p_out.power[0]);
+		for(uintptr_t i = 1; i < lanes; ++i)
+		{
+			Poly1305_Help::multiply(h, p_out.r[0], p_out.r[1], s1);
+			state_t power = h;
+			Poly1305_Help::reduce(power);
+			Poly1305_Help::to_limbs(power, p_out.power[i]);
+		}
+	}
+
+	void Poly1305::update(const key_t& p_key, state_t& p_state, const uint8_t* p_data, uintptr_t p_count)
+	{
+#if defined(_M_AMD64) || defined(__amd64__)
+		if(p_count >= vector_threshold && vectorized())
+		{
+			const uintptr_t count = p_count & ~(lanes - 1);
+			Poly1305_AVX2_Help::update(p_key, p_state, p_data, count);
+			p_data  += count * block_lenght;
+			p_count -= count;
+		}
+#endif
+		Poly1305_Help::update(p_key, p_state, p_data, p_count);
+	}
+
+	void Poly1305::update_padded(const key_t& p_key, state_t& p_state, const uint8_t* const p_data, const uintptr_t p_size)
+	{
+		const uintptr_t count = p_size / block_lenght;
+		update(p_key, p_state, p_data, count);
+		if(const uintptr_t tail = p_size % block_lenght)
+		{
+			std::array<uint8_t, block_lenght> block{};
+			memcpy(block.data(), p_data + count * block_lenght, tail);
+			Poly1305_Help::update(p_key, p_state, block.data(), 1);
+		}
+	}
+
+	void Poly1305::finalize(const key_t& p_key, const state_t& p_state, tag_t& p_tag)
+	{
+		state_t h = p_state;
+		Poly1305_Help::reduce(h);
+
+		uint64_t t0;
+		uint64_t t1;
+		const uint8_t carry = addcarry(0, h[0], p_key.s[0], t0);
+		addcarry(carry, h[1], p_key.s[1], t1);
+		store64(t0, p_tag.data());
+		store64(t1, p_tag.data() + 8);
+	}
+
+	bool Poly1305::vectorized()
+	{
+#if defined(_M_AMD64) || defined(__amd64__)
+		const ChaCha20_engine engine = ChaCha20_get_engine();
+		return engine == ChaCha20_engine::AVX2 || engine == ChaCha20_engine::AVX512;
+#else
+		return false;
+#endif
+	}
+} //namespace crypto::_p
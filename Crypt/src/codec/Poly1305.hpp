@@ -0,0 +1,74 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///		Poly1305 - One time authenticator
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <span>
+
+namespace crypto::_p
+{
+	///	\brief Poly1305 one time authenticator (RFC 8439), the authentication part of ChaCha20-Poly1305
+	///	\note The accumulator is a 130 bit integer {low, middle, high} that is only partially reduced between blocks.
+	class Poly1305
+	{
+	public:
+		static constexpr uintptr_t block_lenght = 16;
+		static constexpr uintptr_t key_lenght = 32;
+		static constexpr uintptr_t tag_lenght = 16;
+
+		///	\brief Number of blocks hashed at once by the vectorized implementation
+		static constexpr uintptr_t lanes = 4;
+
+		struct key_t
+		{
+			std::array<uint64_t, 2> r;
+			std::array<uint64_t, 2> s;
+			///	\brief r^1 .. r^4 in 26 bit limbs, used by the vectorized implementation
+			std::array<std::array<uint32_t, 5>, lanes> power;
+		};
+
+		using state_t = std::array<uint64_t, 3>;
+		using tag_t = std::array<uint8_t, tag_lenght>;
+
+	public:
+		static void make_key(std::span<const uint8_t, key_lenght> p_key, key_t& p_out);
+
+		///	\brief p_state = (p_state + block + 2^128) * r, for p_count consecutive blocks
+		static void update(const key_t& p_key, state_t& p_state, const uint8_t* p_data, uintptr_t p_count);
+
+		///	\brief Same as \ref update over p_size bytes, the last partial block is zero padded (RFC 8439 section 2.8).
+		static void update_padded(const key_t& p_key, state_t& p_state, const uint8_t* p_data, uintptr_t p_size);
+
+		static void finalize(const key_t& p_key, const state_t& p_state, tag_t& p_tag);
+
+		///	\brief true if the vectorized implementation is in use, that is if \ref ChaCha20_engine::AVX2 or above is active.
+		static bool vectorized();
+	};
+} //namespace crypto::_p
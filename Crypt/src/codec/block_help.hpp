@@ -0,0 +1,74 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace crypto
+{
+	///	\brief p_out = p_1 ^ p_2, buffers may overlap as long as they are identical
+	static inline void xor_bytes(uint8_t* p_out, const uint8_t* p_1, const uint8_t* p_2, uintptr_t p_size)
+	{
+		for(; p_size >= 16; p_size -= 16, p_out += 16, p_1 += 16, p_2 += 16)
+		{
+			uint64_t v1[2];
+			uint64_t v2[2];
+			memcpy(v1, p_1, 16);
+			memcpy(v2, p_2, 16);
+			v1[0] ^= v2[0];
+			v1[1] ^= v2[1];
+			memcpy(p_out, v1, 16);
+		}
+
+		for(; p_size >= 8; p_size -= 8, p_out += 8, p_1 += 8, p_2 += 8)
+		{
+			uint64_t v1;
+			uint64_t v2;
+			memcpy(&v1, p_1, 8);
+			memcpy(&v2, p_2, 8);
+			v1 ^= v2;
+			memcpy(p_out, &v1, 8);
+		}
+
+		for(; p_size; --p_size)
+		{
+			*(p_out++) = *(p_1++) ^ *(p_2++);
+		}
+	}
+
+	///	\brief Zeroes p_data through a volatile pointer, so that the compiler does not drop the wipe of a buffer that is no longer read.
+	static inline void wipe(void* const p_data, const uintptr_t p_size)
+	{
+		volatile uint8_t* data = static_cast<volatile uint8_t*>(p_data);
+		for(uintptr_t i = 0; i < p_size; ++i)
+		{
+			data[i] = 0;
+		}
+	}
+} //namespace crypto
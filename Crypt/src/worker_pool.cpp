@@ -0,0 +1,177 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <Crypt/worker_pool.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace crypto
+{
+	//	Note: Tasks are handed out through an atomic index, threads that finish early take the next one.
+	//	Each call to run is a new generation, workers wake up when the generation changes.
+	struct worker_pool::state_t
+	{
+		std::mutex					run_lock;
+		std::mutex					lock;
+		std::condition_variable		wake;
+		std::condition_variable		done;
+		std::vector<std::thread>	threads;
+
+		task_t					task	= nullptr;
+		void*					context	= nullptr;
+		uintptr_t				count	= 0;
+		std::atomic<uintptr_t>	next	{0};
+		uint64_t				generation	= 0;
+		uint32_t				busy		= 0;
+		bool					stop		= false;
+
+		void work()
+		{
+			for(uintptr_t index = next.fetch_add(1, std::memory_order_relaxed); index < count; index = next.fetch_add(1, std::memory_order_relaxed))
+			{
+				task(context, index);
+			}
+		}
+
+		void worker()
+		{
+			uint64_t seen = 0;
+			std::unique_lock guard(lock);
+			while(true)
+			{
+				wake.wait(guard, [&] { return stop || generation != seen; });
+				if(stop)
+				{
+					return;
+				}
+				seen = generation;
+				++busy;
+				guard.unlock();
+
+				work();
+
+				guard.lock();
+				if(--busy == 0)
+				{
+					done.notify_all();
+				}
+			}
+		}
+
+		void shutdown()
+		{
+			{
+				std::lock_guard guard(lock);
+				stop = true;
+			}
+			wake.notify_all();
+			for(std::thread& tthread : threads)
+			{
+				tthread.join();
+			}
+		}
+	};
+
+	worker_pool::worker_pool(uint32_t p_threads)
+		: m_state(new state_t)
+	{
+		if(p_threads == 0)
+		{
+			p_threads = std::thread::hardware_concurrency();
+		}
+
+		//	Note: If a thread can not be created, the ones already running are stopped before the exception leaves.
+		try
+		{
+			m_state->threads.reserve(p_threads ? p_threads - 1 : 0);
+			for(uint32_t i = 1; i < p_threads; ++i)
+			{
+				m_state->threads.emplace_back(&state_t::worker, m_state);
+			}
+		}
+		catch(...)
+		{
+			m_state->shutdown();
+			delete m_state;
+			throw;
+		}
+	}
+
+	worker_pool::~worker_pool()
+	{
+		m_state->shutdown();
+		delete m_state;
+	}
+
+	uint32_t worker_pool::size() const
+	{
+		return static_cast<uint32_t>(m_state->threads.size() + 1);
+	}
+
+	void worker_pool::run(const uintptr_t p_count, const task_t p_task, void* const p_context)
+	{
+		if(p_count == 0)
+		{
+			return;
+		}
+
+		state_t& state = *m_state;
+		std::lock_guard run_guard(state.run_lock);
+
+		if(p_count == 1 || state.threads.empty())
+		{
+			for(uintptr_t i = 0; i < p_count; ++i)
+			{
+				p_task(p_context, i);
+			}
+			return;
+		}
+
+		//	Note: A worker can wake up after the previous call already returned and find no task left,
+		//	it must be done reading the previous task before it is replaced.
+		{
+			std::unique_lock guard(state.lock);
+			state.done.wait(guard, [&] { return state.busy == 0; });
+			state.task		= p_task;
+			state.context	= p_context;
+			state.count		= p_count;
+			state.next.store(0, std::memory_order_relaxed);
+			++state.generation;
+		}
+		state.wake.notify_all();
+
+		state.work();
+
+		//	Note: Every task has been taken once the calling thread runs out of work, the ones still running are counted in busy.
+		std::unique_lock guard(state.lock);
+		state.done.wait(guard, [&] { return state.busy == 0; });
+	}
+} //namespace crypto
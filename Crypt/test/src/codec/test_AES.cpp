@@ -26,6 +26,8 @@
 //======== ======== ======== ======== ======== ======== ======== ========
 
 #include <array>
+#include <random>
+#include <vector>
 
 #include <CoreLib/core_type.hpp>
 #include <CoreLib/toPrint/toPrint.hpp>
@@ -36,6 +38,7 @@
 #include <gmock/gmock.h>
 
 #include <Crypt/codec/AES.hpp>
+#include <Crypt/codec/AES_constexpr.hpp>
 
 #include <test_utils.hpp>
 
@@ -289,4 +292,265 @@ TEST(codec_symmetric, AES_256)
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+template<typename AES_t>
+static void check_AES_vectors(std::u32string_view p_codecName)
+{
+	constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+	constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+
+	testUtils::EncodeList testList = testUtils::getSymmetricEncodeList("../test_vectors/tests.scef", p_codecName, key_lenght);
+	ASSERT_FALSE(testList.empty());
+
+	for(const testUtils::SymmetricEncodable& testcase : testList)
+	{
+		std::optional<std::vector<uint8_t>> tdata = testcase.source.getData();
+		ASSERT_TRUE(tdata.has_value());
+		const std::vector<uint8_t> testData = std::move(tdata.value());
+		ASSERT_EQ(testData.size(), block_lenght);
+
+		for(const testUtils::SymmetricEncodable::result_t& tkeyCase : testcase.encoded)
+		{
+			ASSERT_EQ(tkeyCase.key.size(), key_lenght);
+
+			std::optional<std::vector<uint8_t>> texpected = tkeyCase.source.getData();
+			ASSERT_TRUE(texpected.has_value());
+			ASSERT_EQ(texpected.value().size(), block_lenght);
+
+			typename AES_t::key_schedule_t tkey_schedule;
+			AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{tkeyCase.key.data(), key_lenght}, tkey_schedule);
+
+			std::array<uint8_t, block_lenght> encoded;
+			AES_t::encode(tkey_schedule, std::span<const uint8_t, block_lenght>{testData.data(), block_lenght}, encoded);
+			ASSERT_TRUE(memcmp(encoded.data(), texpected.value().data(), block_lenght) == 0)
+				<< "\n  Actual: " << testPrint{encoded}
+				<< "\nExpected: " << testPrint{texpected.value()};
+
+			std::array<uint8_t, block_lenght> decoded;
+			AES_t::decode(tkey_schedule, encoded, decoded);
+			ASSERT_TRUE(memcmp(decoded.data(), testData.data(), block_lenght) == 0)
+				<< "\n  Actual: " << testPrint{decoded}
+				<< "\nExpected: " << testPrint{testData};
+
+			typename AES_t::dec_key_schedule_t tdec_schedule;
+			AES_t::make_dec_key_schedule(tkey_schedule, tdec_schedule);
+			decoded.fill(0);
+			AES_t::decode(tdec_schedule, encoded, decoded);
+			ASSERT_TRUE(memcmp(decoded.data(), testData.data(), block_lenght) == 0)
+				<< "\n  Actual: " << testPrint{decoded}
+				<< "\nExpected: " << testPrint{testData};
+		}
+	}
+}
+
+TEST(codec_symmetric, AES_engines)
+{
+	testUtils::for_each_AES_engine([](const crypto::AES_engine p_engine)
+		{
+			ASSERT_EQ(crypto::AES_get_engine(), p_engine);
+
+			check_AES_vectors<crypto::AES_128>(U"AES_128");
+			check_AES_vectors<crypto::AES_192>(U"AES_192");
+			check_AES_vectors<crypto::AES_256>(U"AES_256");
+		});
+}
+
+template<typename AES_t>
+static void check_AES_blocks()
+{
+	constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+	constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+	constexpr uintptr_t max_blocks		= 69;
+
+	std::mt19937 gen(0x5EED);
+	std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+	std::array<uint8_t, key_lenght> key;
+	for(uint8_t& tbyte : key) tbyte = static_cast<uint8_t>(distrib(gen));
+
+	std::vector<uint8_t> source(max_blocks * block_lenght);
+	for(uint8_t& tbyte : source) tbyte = static_cast<uint8_t>(distrib(gen));
+
+	typename AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(key, tkey_schedule);
+
+	typename AES_t::dec_key_schedule_t tdec_schedule;
+	AES_t::make_dec_key_schedule(tkey_schedule, tdec_schedule);
+
+	static_assert(alignof(typename AES_t::key_schedule_t) == 16);
+	static_assert(alignof(typename AES_t::key_t) == 64 && sizeof(typename AES_t::key_t) % 64 == 0);
+
+	typename AES_t::key_t tkey;
+	AES_t::make_key(key, tkey);
+	ASSERT_EQ(memcmp(&tkey.enc, &tkey_schedule, sizeof(tkey_schedule)), 0);
+	ASSERT_EQ(memcmp(&tkey.dec, &tdec_schedule, sizeof(tdec_schedule)), 0);
+
+	std::vector<uint8_t> expected(max_blocks * block_lenght);
+	for(uintptr_t i = 0; i < max_blocks; ++i)
+	{
+		AES_t::encode(tkey_schedule,
+			std::span<const uint8_t, block_lenght>{source.data() + i * block_lenght, block_lenght},
+			std::span<uint8_t, block_lenght>{expected.data() + i * block_lenght, block_lenght});
+	}
+
+	for(uintptr_t count = 0; count <= max_blocks; ++count)
+	{
+		const uintptr_t size = count * block_lenght;
+		std::vector<uint8_t> encoded(size);
+		AES_t::encode_blocks(tkey_schedule, std::span<const uint8_t>{source.data(), size}, encoded);
+		ASSERT_TRUE(memcmp(encoded.data(), expected.data(), size) == 0) << "Block count " << count;
+
+		std::vector<uint8_t> in_place{source.begin(), source.begin() + size};
+		AES_t::encode_blocks(tkey_schedule, in_place, in_place);
+		ASSERT_TRUE(in_place == encoded) << "Block count " << count;
+
+		AES_t::decode_blocks(tkey_schedule, in_place, in_place);
+		ASSERT_TRUE(memcmp(in_place.data(), source.data(), size) == 0) << "Block count " << count;
+
+		std::vector<uint8_t> decoded(size);
+		AES_t::decode_blocks(tdec_schedule, encoded, decoded);
+		ASSERT_TRUE(memcmp(decoded.data(), source.data(), size) == 0) << "Block count " << count;
+
+		std::vector<uint8_t> combined(size);
+		AES_t::encode_blocks(tkey, std::span<const uint8_t>{source.data(), size}, combined);
+		ASSERT_TRUE(combined == encoded) << "Block count " << count;
+		AES_t::decode_blocks(tkey, combined, combined);
+		ASSERT_TRUE(memcmp(combined.data(), source.data(), size) == 0) << "Block count " << count;
+	}
+
+	std::array<uint8_t, block_lenght> single;
+	AES_t::encode(tkey, std::span<const uint8_t, block_lenght>{source.data(), block_lenght}, single);
+	ASSERT_EQ(memcmp(single.data(), expected.data(), block_lenght), 0);
+	AES_t::decode(tkey, single, single);
+	ASSERT_EQ(memcmp(single.data(), source.data(), block_lenght), 0);
+}
+
+TEST(codec_symmetric, AES_blocks)
+{
+	testUtils::for_each_AES_engine([]
+		{
+			check_AES_blocks<crypto::AES_128>();
+			check_AES_blocks<crypto::AES_192>();
+			check_AES_blocks<crypto::AES_256>();
+		});
+}
+
+//	Note: Compares single and batched key expansion, and the decoding schedule, of every engine against the software engine.
+template<typename AES_t>
+static void check_AES_key_schedules()
+{
+	constexpr uintptr_t key_lenght	= AES_t::key_lenght;
+	constexpr uintptr_t max_keys	= 9;
+
+	std::mt19937 gen(0x4E75);
+	std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+	std::vector<uint8_t> keys(max_keys * key_lenght);
+	for(uint8_t& tbyte : keys) tbyte = static_cast<uint8_t>(distrib(gen));
+
+	ASSERT_TRUE(crypto::AES_set_engine(crypto::AES_engine::software));
+	std::vector<typename AES_t::key_schedule_t> expected(max_keys);
+	std::vector<typename AES_t::dec_key_schedule_t> expected_dec(max_keys);
+	for(uintptr_t i = 0; i < max_keys; ++i)
+	{
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{keys.data() + i * key_lenght, key_lenght}, expected[i]);
+		AES_t::make_dec_key_schedule(expected[i], expected_dec[i]);
+	}
+
+	testUtils::for_each_AES_engine([&]
+		{
+			for(uintptr_t i = 0; i < max_keys; ++i)
+			{
+				typename AES_t::key_schedule_t tkey_schedule;
+				AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{keys.data() + i * key_lenght, key_lenght}, tkey_schedule);
+				ASSERT_TRUE(memcmp(&tkey_schedule, &expected[i], sizeof(tkey_schedule)) == 0) << "Key " << i;
+
+				typename AES_t::dec_key_schedule_t tdec_schedule;
+				AES_t::make_dec_key_schedule(tkey_schedule, tdec_schedule);
+				ASSERT_TRUE(memcmp(&tdec_schedule, &expected_dec[i], sizeof(tdec_schedule)) == 0) << "Key " << i;
+			}
+
+			for(uintptr_t count = 0; count <= max_keys; ++count)
+			{
+				std::vector<typename AES_t::key_schedule_t> tkey_schedules(count);
+				AES_t::make_key_schedules(std::span<const uint8_t>{keys.data(), count * key_lenght}, tkey_schedules);
+				ASSERT_TRUE(memcmp(tkey_schedules.data(), expected.data(), count * sizeof(typename AES_t::key_schedule_t)) == 0) << "Key count " << count;
+			}
+		});
+}
+
+TEST(codec_symmetric, AES_key_schedules)
+{
+	check_AES_key_schedules<crypto::AES_128>();
+	check_AES_key_schedules<crypto::AES_192>();
+	check_AES_key_schedules<crypto::AES_256>();
+}
+
+//FIPS-197 Appendix C
+static constexpr std::array<uint8_t, 32> fips197_key
+{
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+};
+static constexpr std::array<uint8_t, 16> fips197_plain
+{
+	0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+};
+
+template<typename AES_t>
+static constexpr std::array<uint8_t, 16> fips197_encode()
+{
+	return crypto::AES_constexpr<AES_t>::encode(std::span<const uint8_t, AES_t::key_lenght>{fips197_key.data(), AES_t::key_lenght}, fips197_plain);
+}
+
+static_assert(fips197_encode<crypto::AES_128>() == std::array<uint8_t, 16>{0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a});
+static_assert(fips197_encode<crypto::AES_192>() == std::array<uint8_t, 16>{0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0, 0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91});
+static_assert(fips197_encode<crypto::AES_256>() == std::array<uint8_t, 16>{0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89});
+
+//	Note: The compile time schedule must be usable by every engine, it is compared byte for byte with the run time one.
+template<typename AES_t>
+static void check_AES_constexpr()
+{
+	using constexpr_t = crypto::AES_constexpr<AES_t>;
+	constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+	constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+
+	static constexpr typename AES_t::key_schedule_t fixed_schedule =
+		constexpr_t::make_key_schedule(std::span<const uint8_t, key_lenght>{fips197_key.data(), key_lenght});
+	static constexpr std::array<uint8_t, block_lenght> fixed_cipher = constexpr_t::encode(fixed_schedule, fips197_plain);
+
+	std::mt19937 gen(0xCE);
+	std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+	testUtils::for_each_AES_engine([&]
+		{
+			std::array<uint8_t, block_lenght> encoded;
+			AES_t::encode(fixed_schedule, fips197_plain, encoded);
+			ASSERT_TRUE(encoded == fixed_cipher);
+
+			for(uintptr_t i = 0; i < 16; ++i)
+			{
+				std::array<uint8_t, key_lenght> key;
+				std::array<uint8_t, block_lenght> plain;
+				for(uint8_t& tbyte : key) tbyte = static_cast<uint8_t>(distrib(gen));
+				for(uint8_t& tbyte : plain) tbyte = static_cast<uint8_t>(distrib(gen));
+
+				typename AES_t::key_schedule_t expected_schedule;
+				AES_t::make_key_schedule(key, expected_schedule);
+				const typename AES_t::key_schedule_t schedule = constexpr_t::make_key_schedule(key);
+				ASSERT_EQ(memcmp(&schedule, &expected_schedule, sizeof(schedule)), 0);
+
+				std::array<uint8_t, block_lenght> expected;
+				AES_t::encode(expected_schedule, plain, expected);
+				ASSERT_TRUE(constexpr_t::encode(schedule, plain) == expected);
+				ASSERT_TRUE(constexpr_t::encode(key, plain) == expected);
+			}
+		});
+}
+
+TEST(codec_symmetric, AES_constexpr)
+{
+	check_AES_constexpr<crypto::AES_128>();
+	check_AES_constexpr<crypto::AES_192>();
+	check_AES_constexpr<crypto::AES_256>();
+}
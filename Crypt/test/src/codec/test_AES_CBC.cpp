@@ -0,0 +1,258 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <random>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_CBC.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	struct CBC_TestCase
+	{
+		std::string_view key;
+		std::string_view iv;
+		std::string_view plain;
+		std::string_view cipher;
+	};
+
+	//NIST SP 800-38A F.2
+	constexpr std::string_view sp800_38a_iv = "000102030405060708090a0b0c0d0e0f";
+	constexpr std::string_view sp800_38a_plain =
+		"6bc1bee22e409f96e93d7e117393172a"
+		"ae2d8a571e03ac9c9eb76fac45af8e51"
+		"30c81c46a35ce411e5fbc1191a0a52ef"
+		"f69f2445df4f9b17ad2b417be66c3710";
+
+	template<typename AES_t>
+	void check_CBC_case(const CBC_TestCase& p_case)
+	{
+		using CBC_t = crypto::AES_CBC<AES_t>;
+		constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+
+		const std::vector<uint8_t> key		= testUtils::hex_data(p_case.key);
+		const std::vector<uint8_t> iv		= testUtils::hex_data(p_case.iv);
+		const std::vector<uint8_t> plain	= testUtils::hex_data(p_case.plain);
+		const std::vector<uint8_t> cipher	= testUtils::hex_data(p_case.cipher);
+		ASSERT_EQ(key.size(), key_lenght);
+		ASSERT_EQ(iv.size(), block_lenght);
+		ASSERT_EQ(plain.size(), cipher.size());
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{key.data(), key_lenght}, tkey_schedule);
+
+		CBC_t engine;
+
+		//whole buffer at once
+		{
+			std::vector<uint8_t> encoded(plain.size());
+			engine.reset(tkey_schedule, std::span<const uint8_t, block_lenght>{iv.data(), block_lenght});
+			ASSERT_EQ(engine.encode(plain, encoded), plain.size());
+			ASSERT_TRUE(encoded == cipher)
+				<< "\n  Actual: " << testPrint{encoded}
+				<< "\nExpected: " << testPrint{cipher};
+		}
+
+		//every block split point, in place
+		for(uintptr_t split = 0; split <= plain.size(); split += block_lenght)
+		{
+			std::vector<uint8_t> buffer = cipher;
+			engine.reset(tkey_schedule, std::span<const uint8_t, block_lenght>{iv.data(), block_lenght});
+			engine.decode(std::span<const uint8_t>{buffer.data(), split}, std::span<uint8_t>{buffer.data(), split});
+			engine.decode(std::span<const uint8_t>{buffer.data() + split, buffer.size() - split}, std::span<uint8_t>{buffer.data() + split, buffer.size() - split});
+			ASSERT_TRUE(buffer == plain) << "Split " << split
+				<< "\n  Actual: " << testPrint{buffer}
+				<< "\nExpected: " << testPrint{plain};
+		}
+
+		//combined encoding and decoding key
+		{
+			typename AES_t::key_t tkey;
+			AES_t::make_key(std::span<const uint8_t, key_lenght>{key.data(), key_lenght}, tkey);
+
+			std::vector<uint8_t> buffer = plain;
+			engine.reset(tkey, std::span<const uint8_t, block_lenght>{iv.data(), block_lenght});
+			engine.encode(buffer);
+			ASSERT_TRUE(buffer == cipher)
+				<< "\n  Actual: " << testPrint{buffer}
+				<< "\nExpected: " << testPrint{cipher};
+
+			engine.reset(tkey, std::span<const uint8_t, block_lenght>{iv.data(), block_lenght});
+			engine.decode(buffer);
+			ASSERT_TRUE(buffer == plain)
+				<< "\n  Actual: " << testPrint{buffer}
+				<< "\nExpected: " << testPrint{plain};
+		}
+	}
+
+	//	Note: Long enough to exercise the wide decode path, compared against single block decodes.
+	template<typename AES_t>
+	void check_CBC_stream()
+	{
+		using CBC_t = crypto::AES_CBC<AES_t>;
+		constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+		constexpr uintptr_t block_count		= 61;
+
+		std::mt19937 gen(0xCB);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+		std::array<uint8_t, key_lenght> key;
+		std::array<uint8_t, block_lenght> iv;
+		std::vector<uint8_t> cipher(block_count * block_lenght);
+		for(uint8_t& tbyte : key)		tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : iv)		tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : cipher)	tbyte = static_cast<uint8_t>(distrib(gen));
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(key, tkey_schedule);
+
+		std::vector<uint8_t> expected(cipher.size());
+		for(uintptr_t i = 0; i < block_count; ++i)
+		{
+			const uint8_t* const previous = i ? cipher.data() + (i - 1) * block_lenght : iv.data();
+			std::array<uint8_t, block_lenght> block;
+			AES_t::decode(tkey_schedule, std::span<const uint8_t, block_lenght>{cipher.data() + i * block_lenght, block_lenght}, block);
+			for(uintptr_t j = 0; j < block_lenght; ++j)
+			{
+				expected[i * block_lenght + j] = block[j] ^ previous[j];
+			}
+		}
+
+		std::uniform_int_distribution<uintptr_t> split_distrib(0, 20);
+
+		CBC_t engine;
+		engine.reset(tkey_schedule, iv);
+		std::vector<uint8_t> buffer = cipher;
+		for(uintptr_t pos = 0; pos < block_count;)
+		{
+			const uintptr_t count = std::min(split_distrib(gen), block_count - pos);
+			engine.decode(
+				std::span<const uint8_t>{buffer.data() + pos * block_lenght, count * block_lenght},
+				std::span<uint8_t>{buffer.data() + pos * block_lenght, count * block_lenght});
+			pos += count;
+		}
+
+		ASSERT_TRUE(buffer == expected);
+		ASSERT_TRUE(std::equal(engine.iv().begin(), engine.iv().end(), cipher.end() - block_lenght));
+
+		engine.reset(tkey_schedule, iv);
+		engine.encode(buffer, buffer);
+		ASSERT_TRUE(buffer == cipher);
+
+		//scatter-gather in place, fragments are mostly not block aligned
+		std::uniform_int_distribution<uintptr_t> fragment_distrib(0, 40);
+		std::vector<std::span<uint8_t>> buffers;
+		for(uintptr_t pos = 0; pos < buffer.size();)
+		{
+			const uintptr_t count = std::min(fragment_distrib(gen), buffer.size() - pos);
+			buffers.emplace_back(buffer.data() + pos, count);
+			pos += count;
+		}
+		engine.reset(tkey_schedule, iv);
+		ASSERT_EQ(engine.decode(buffers), buffer.size());
+		ASSERT_TRUE(buffer == expected);
+		ASSERT_TRUE(std::equal(engine.iv().begin(), engine.iv().end(), cipher.end() - block_lenght));
+
+		engine.reset(tkey_schedule, iv);
+		ASSERT_EQ(engine.encode(buffers), buffer.size());
+		ASSERT_TRUE(buffer == cipher);
+
+		//trailing partial block is left untouched, and is reported as not processed
+		engine.reset(tkey_schedule, iv);
+		ASSERT_EQ(engine.decode(std::span<uint8_t>{buffer.data(), buffer.size() - 1}), buffer.size() - block_lenght);
+		ASSERT_TRUE(std::equal(buffer.begin(), buffer.end() - block_lenght, expected.begin()));
+		ASSERT_TRUE(std::equal(buffer.end() - block_lenght, buffer.end(), cipher.end() - block_lenght));
+
+		//then given again at the start of the next call
+		ASSERT_EQ(engine.decode(std::span<uint8_t>{buffer.data() + buffer.size() - block_lenght, block_lenght}), block_lenght);
+		ASSERT_TRUE(buffer == expected);
+
+		buffer = cipher;
+		while(buffers.back().empty())
+		{
+			buffers.pop_back();
+		}
+		buffers.back() = buffers.back().first(buffers.back().size() - 1);
+		engine.reset(tkey_schedule, iv);
+		ASSERT_EQ(engine.decode(buffers), buffer.size() - block_lenght);
+		ASSERT_TRUE(std::equal(buffer.begin(), buffer.end() - block_lenght, expected.begin()));
+		ASSERT_TRUE(std::equal(buffer.end() - block_lenght, buffer.end(), cipher.end() - block_lenght));
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_CBC)
+{
+	testUtils::for_each_AES_engine([&]
+		{
+			check_CBC_case<crypto::AES_128>(CBC_TestCase{
+				.key	= "2b7e151628aed2a6abf7158809cf4f3c",
+				.iv		= sp800_38a_iv,
+				.plain	= sp800_38a_plain,
+				.cipher	=
+					"7649abac8119b246cee98e9b12e9197d"
+					"5086cb9b507219ee95db113a917678b2"
+					"73bed6b8e3c1743b7116e69e22229516"
+					"3ff1caa1681fac09120eca307586e1a7"});
+
+			check_CBC_case<crypto::AES_192>(CBC_TestCase{
+				.key	= "8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b",
+				.iv		= sp800_38a_iv,
+				.plain	= sp800_38a_plain,
+				.cipher	=
+					"4f021db243bc633d7178183a9fa071e8"
+					"b4d9ada9ad7dedf4e5e738763f69145a"
+					"571b242012fb7ae07fa9baac3df102e0"
+					"08b0e27988598881d920a9e64f5615cd"});
+
+			check_CBC_case<crypto::AES_256>(CBC_TestCase{
+				.key	= "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4",
+				.iv		= sp800_38a_iv,
+				.plain	= sp800_38a_plain,
+				.cipher	=
+					"f58c4c04d6e5f1ba779eabfb5f7bfbd6"
+					"9cfc4e967edb808d679f777bc6702c7d"
+					"39f23369a9d9bacfa530e26304231461"
+					"b2eb05e2c39be9fcda6c19078c6a9d1b"});
+
+			check_CBC_stream<crypto::AES_128>();
+			check_CBC_stream<crypto::AES_192>();
+			check_CBC_stream<crypto::AES_256>();
+		});
+}
@@ -0,0 +1,258 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <random>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_CCM.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	struct CCM_TestCase
+	{
+		std::string_view key;
+		std::string_view nonce;
+		std::string_view aad {};
+		std::string_view plain {};
+		std::string_view cipher {};
+		std::string_view tag;
+	};
+
+	template<typename AES_t>
+	void check_CCM_case(const CCM_TestCase& p_case)
+	{
+		using CCM_t = crypto::AES_CCM<AES_t>;
+		constexpr uintptr_t key_lenght = AES_t::key_lenght;
+
+		const std::vector<uint8_t> key		= testUtils::hex_data(p_case.key);
+		const std::vector<uint8_t> nonce	= testUtils::hex_data(p_case.nonce);
+		const std::vector<uint8_t> aad		= testUtils::hex_data(p_case.aad);
+		const std::vector<uint8_t> plain	= testUtils::hex_data(p_case.plain);
+		const std::vector<uint8_t> cipher	= testUtils::hex_data(p_case.cipher);
+		const std::vector<uint8_t> tag		= testUtils::hex_data(p_case.tag);
+		ASSERT_EQ(key.size(), key_lenght);
+		ASSERT_EQ(plain.size(), cipher.size());
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{key.data(), key_lenght}, tkey_schedule);
+
+		CCM_t engine;
+		engine.set_key(tkey_schedule);
+
+		//whole buffer at once
+		{
+			std::vector<uint8_t> encoded(plain.size());
+			ASSERT_TRUE(engine.reset(nonce, aad.size(), plain.size(), tag.size()));
+			ASSERT_TRUE(engine.update_aad(aad));
+			ASSERT_TRUE(engine.encode(plain, encoded));
+			ASSERT_TRUE(engine.finalize());
+			ASSERT_TRUE(encoded == cipher)
+				<< "\n  Actual: " << testPrint{encoded}
+				<< "\nExpected: " << testPrint{cipher};
+			ASSERT_TRUE(std::equal(tag.begin(), tag.end(), engine.tag().begin(), engine.tag().end()))
+				<< "\n  Actual: " << testPrint{engine.tag()}
+				<< "\nExpected: " << testPrint{tag};
+		}
+
+		//every split point, in place
+		for(uintptr_t split = 0; split <= cipher.size(); ++split)
+		{
+			std::vector<uint8_t> buffer = cipher;
+			ASSERT_TRUE(engine.reset(nonce, aad.size(), plain.size(), tag.size()));
+			ASSERT_TRUE(engine.update_aad(std::span<const uint8_t>{aad.data(), aad.size() / 2}));
+			ASSERT_TRUE(engine.update_aad(std::span<const uint8_t>{aad.data() + aad.size() / 2, aad.size() - aad.size() / 2}));
+			ASSERT_TRUE(engine.decode(std::span<uint8_t>{buffer.data(), split}));
+			ASSERT_TRUE(engine.decode(std::span<uint8_t>{buffer.data() + split, buffer.size() - split}));
+			ASSERT_TRUE(engine.finalize());
+			ASSERT_TRUE(buffer == plain) << "Split " << split
+				<< "\n  Actual: " << testPrint{buffer}
+				<< "\nExpected: " << testPrint{plain};
+			ASSERT_TRUE(engine.verify(tag));
+		}
+
+		std::vector<uint8_t> bad_tag = tag;
+		bad_tag.back() ^= 0x01;
+		ASSERT_FALSE(engine.verify(bad_tag));
+		ASSERT_FALSE(engine.verify(std::span<const uint8_t>{tag.data(), tag.size() - 2}));
+	}
+
+	//	Note: Long enough for the bulk paths, with additional data large enough for the 6 byte size encoding.
+	//	Every engine is compared against the software engine.
+	template<typename AES_t>
+	void check_CCM_stream()
+	{
+		using CCM_t = crypto::AES_CCM<AES_t>;
+		constexpr uintptr_t key_lenght	= AES_t::key_lenght;
+		constexpr uintptr_t data_size	= 3000;
+		constexpr uintptr_t aad_size	= 0xFF10;
+		constexpr uintptr_t tag_size	= 16;
+
+		std::mt19937 gen(0xCC);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+		std::array<uint8_t, key_lenght> key;
+		std::array<uint8_t, 12> nonce;
+		std::vector<uint8_t> aad(aad_size);
+		std::vector<uint8_t> data(data_size);
+		for(uint8_t& tbyte : key)	tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : nonce)	tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : aad)	tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : data)	tbyte = static_cast<uint8_t>(distrib(gen));
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(key, tkey_schedule);
+
+		std::vector<uint8_t> expected(data_size);
+		std::vector<uint8_t> expected_tag;
+		{
+			ASSERT_TRUE(crypto::AES_set_engine(crypto::AES_engine::software));
+			CCM_t engine;
+			engine.set_key(tkey_schedule);
+			ASSERT_TRUE(engine.reset(nonce, aad_size, data_size, tag_size));
+			ASSERT_TRUE(engine.update_aad(aad));
+			ASSERT_TRUE(engine.encode(data, expected));
+			ASSERT_TRUE(engine.finalize());
+			expected_tag.assign(engine.tag().begin(), engine.tag().end());
+		}
+
+		std::uniform_int_distribution<uintptr_t> split_distrib(0, 400);
+
+		testUtils::for_each_AES_engine([&]
+			{
+				CCM_t engine;
+				engine.set_key(tkey_schedule);
+				ASSERT_TRUE(engine.reset(nonce, aad_size, data_size, tag_size));
+				ASSERT_TRUE(engine.update_aad(std::span<const uint8_t>{aad.data(), 5}));
+				ASSERT_FALSE(engine.encode(data, data));
+				ASSERT_TRUE(engine.update_aad(std::span<const uint8_t>{aad.data() + 5, aad_size - 5}));
+				ASSERT_FALSE(engine.update_aad(std::span<const uint8_t>{aad.data(), 1}));
+
+				std::vector<uint8_t> buffer = data;
+				for(uintptr_t pos = 0; pos < data_size;)
+				{
+					const uintptr_t count = std::min(split_distrib(gen), data_size - pos);
+					ASSERT_TRUE(engine.encode(std::span<uint8_t>{buffer.data() + pos, count}));
+					pos += count;
+				}
+				ASSERT_FALSE(engine.encode(std::span<uint8_t>{buffer.data(), 1}));
+				ASSERT_TRUE(engine.finalize());
+
+				ASSERT_TRUE(buffer == expected);
+				ASSERT_TRUE(engine.verify(expected_tag));
+
+				ASSERT_TRUE(engine.reset(nonce, aad_size, data_size, tag_size));
+				ASSERT_TRUE(engine.update_aad(aad));
+				ASSERT_TRUE(engine.decode(buffer, buffer));
+				ASSERT_TRUE(engine.finalize());
+				ASSERT_TRUE(buffer == data);
+				ASSERT_TRUE(engine.verify(expected_tag));
+
+				//incomplete message
+				ASSERT_TRUE(engine.reset(nonce, aad_size, data_size, tag_size));
+				ASSERT_TRUE(engine.update_aad(aad));
+				ASSERT_TRUE(engine.decode(std::span<uint8_t>{buffer.data(), data_size - 1}));
+				ASSERT_FALSE(engine.finalize());
+			});
+	}
+
+	template<typename AES_t>
+	void check_CCM_parameters()
+	{
+		using CCM_t = crypto::AES_CCM<AES_t>;
+
+		typename AES_t::key_schedule_t tkey_schedule{};
+		const std::array<uint8_t, 14> nonce{};
+
+		CCM_t engine;
+		engine.set_key(tkey_schedule);
+		ASSERT_FALSE(engine.reset(std::span<const uint8_t>{nonce.data(), 6}, 0, 0, 16));
+		ASSERT_FALSE(engine.reset(std::span<const uint8_t>{nonce.data(), 14}, 0, 0, 16));
+		ASSERT_FALSE(engine.reset(std::span<const uint8_t>{nonce.data(), 12}, 0, 0, 2));
+		ASSERT_FALSE(engine.reset(std::span<const uint8_t>{nonce.data(), 12}, 0, 0, 5));
+		ASSERT_FALSE(engine.reset(std::span<const uint8_t>{nonce.data(), 12}, 0, 0, 18));
+		ASSERT_TRUE (engine.reset(std::span<const uint8_t>{nonce.data(), 13}, 0, 0xFFFF, 4));
+		ASSERT_FALSE(engine.reset(std::span<const uint8_t>{nonce.data(), 13}, 0, 0x10000, 4));
+		ASSERT_TRUE (engine.reset(std::span<const uint8_t>{nonce.data(), 7}, 0, 0xFFFFFFFFFFFFFFFF, 4));
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_CCM)
+{
+	testUtils::for_each_AES_engine([&]
+		{
+			//NIST SP 800-38C C.1 - C.3
+			check_CCM_case<crypto::AES_128>(CCM_TestCase{
+				.key	= "404142434445464748494a4b4c4d4e4f",
+				.nonce	= "10111213141516",
+				.aad	= "0001020304050607",
+				.plain	= "20212223",
+				.cipher	= "7162015b",
+				.tag	= "4dac255d"});
+
+			check_CCM_case<crypto::AES_128>(CCM_TestCase{
+				.key	= "404142434445464748494a4b4c4d4e4f",
+				.nonce	= "1011121314151617",
+				.aad	= "000102030405060708090a0b0c0d0e0f",
+				.plain	= "202122232425262728292a2b2c2d2e2f",
+				.cipher	= "d2a1f0e051ea5f62081a7792073d593d",
+				.tag	= "1fc64fbfaccd"});
+
+			check_CCM_case<crypto::AES_128>(CCM_TestCase{
+				.key	= "404142434445464748494a4b4c4d4e4f",
+				.nonce	= "101112131415161718191a1b",
+				.aad	= "000102030405060708090a0b0c0d0e0f10111213",
+				.plain	= "202122232425262728292a2b2c2d2e2f3031323334353637",
+				.cipher	= "e3b201a9f5b71a7a9b1ceaeccd97e70b6176aad9a4428aa5",
+				.tag	= "484392fbc1b09951"});
+
+			//RFC 3610 packet vector #1
+			check_CCM_case<crypto::AES_128>(CCM_TestCase{
+				.key	= "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf",
+				.nonce	= "00000003020100a0a1a2a3a4a5",
+				.aad	= "0001020304050607",
+				.plain	= "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e",
+				.cipher	= "588c979a61c663d2f066d0c2c0f989806d5f6b61dac384",
+				.tag	= "17e8d12cfdf926e0"});
+
+			check_CCM_parameters<crypto::AES_128>();
+		});
+
+	check_CCM_stream<crypto::AES_128>();
+	check_CCM_stream<crypto::AES_192>();
+	check_CCM_stream<crypto::AES_256>();
+}
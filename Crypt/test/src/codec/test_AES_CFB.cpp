@@ -0,0 +1,212 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <random>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_CFB.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	struct CFB_TestCase
+	{
+		std::string_view key;
+		std::string_view iv;
+		std::string_view plain;
+		std::string_view cipher;
+	};
+
+	//NIST SP 800-38A F.3.13 to F.3.18
+	constexpr std::string_view sp800_38a_iv = "000102030405060708090a0b0c0d0e0f";
+	constexpr std::string_view sp800_38a_plain =
+		"6bc1bee22e409f96e93d7e117393172a"
+		"ae2d8a571e03ac9c9eb76fac45af8e51"
+		"30c81c46a35ce411e5fbc1191a0a52ef"
+		"f69f2445df4f9b17ad2b417be66c3710";
+
+	template<typename AES_t>
+	void check_CFB_case(const CFB_TestCase& p_case)
+	{
+		using CFB_t = crypto::AES_CFB<AES_t>;
+		constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+
+		const std::vector<uint8_t> key		= testUtils::hex_data(p_case.key);
+		const std::vector<uint8_t> iv		= testUtils::hex_data(p_case.iv);
+		const std::vector<uint8_t> plain	= testUtils::hex_data(p_case.plain);
+		const std::vector<uint8_t> cipher	= testUtils::hex_data(p_case.cipher);
+		ASSERT_EQ(key.size(), key_lenght);
+		ASSERT_EQ(iv.size(), block_lenght);
+		ASSERT_EQ(plain.size(), cipher.size());
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{key.data(), key_lenght}, tkey_schedule);
+
+		CFB_t engine;
+
+		//every split point, in place
+		for(uintptr_t split = 0; split <= plain.size(); ++split)
+		{
+			std::vector<uint8_t> buffer = plain;
+			engine.reset(tkey_schedule, std::span<const uint8_t, block_lenght>{iv.data(), block_lenght});
+			engine.encode(std::span<uint8_t>{buffer.data(), split});
+			engine.encode(std::span<uint8_t>{buffer.data() + split, buffer.size() - split});
+			ASSERT_TRUE(buffer == cipher) << "Split " << split
+				<< "\n  Actual: " << testPrint{buffer}
+				<< "\nExpected: " << testPrint{cipher};
+
+			engine.reset(tkey_schedule, std::span<const uint8_t, block_lenght>{iv.data(), block_lenght});
+			engine.decode(std::span<uint8_t>{buffer.data(), split});
+			engine.decode(std::span<uint8_t>{buffer.data() + split, buffer.size() - split});
+			ASSERT_TRUE(buffer == plain) << "Split " << split
+				<< "\n  Actual: " << testPrint{buffer}
+				<< "\nExpected: " << testPrint{plain};
+		}
+	}
+
+	//	Note: Long enough to take several chunks of the wide decode path, compared against single block encodes.
+	template<typename AES_t>
+	void check_CFB_stream()
+	{
+		using CFB_t = crypto::AES_CFB<AES_t>;
+		constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+		constexpr uintptr_t data_size		= 3000;
+
+		std::mt19937 gen(0xCF);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+		std::array<uint8_t, key_lenght> key;
+		std::array<uint8_t, block_lenght> iv;
+		for(uint8_t& tbyte : key) tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : iv) tbyte = static_cast<uint8_t>(distrib(gen));
+
+		std::vector<uint8_t> data(data_size);
+		for(uint8_t& tbyte : data) tbyte = static_cast<uint8_t>(distrib(gen));
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(key, tkey_schedule);
+
+		std::vector<uint8_t> expected(data_size);
+		{
+			std::array<uint8_t, block_lenght> feedback = iv;
+			for(uintptr_t i = 0; i < data_size; i += block_lenght)
+			{
+				std::array<uint8_t, block_lenght> key_stream;
+				AES_t::encode(tkey_schedule, feedback, key_stream);
+				for(uintptr_t j = 0; j < block_lenght && i + j < data_size; ++j)
+				{
+					expected[i + j] = data[i + j] ^ key_stream[j];
+					feedback[j] = expected[i + j];
+				}
+			}
+		}
+
+		CFB_t engine;
+		engine.reset(tkey_schedule, iv);
+		std::vector<uint8_t> encoded(data_size);
+		engine.encode(data, encoded);
+		ASSERT_TRUE(encoded == expected);
+
+		engine.reset(tkey_schedule, iv);
+		std::vector<uint8_t> decoded(data_size);
+		engine.decode(encoded, decoded);
+		ASSERT_TRUE(decoded == data);
+
+		std::uniform_int_distribution<uintptr_t> split_distrib(0, 1200);
+
+		engine.reset(tkey_schedule, iv);
+		std::vector<uint8_t> buffer = data;
+		for(uintptr_t pos = 0; pos < data_size;)
+		{
+			const uintptr_t count = std::min(split_distrib(gen), data_size - pos);
+			engine.encode(std::span<uint8_t>{buffer.data() + pos, count});
+			pos += count;
+		}
+		ASSERT_TRUE(buffer == expected);
+
+		engine.reset(tkey_schedule, iv);
+		for(uintptr_t pos = 0; pos < data_size;)
+		{
+			const uintptr_t count = std::min(split_distrib(gen), data_size - pos);
+			engine.decode(std::span<uint8_t>{buffer.data() + pos, count});
+			pos += count;
+		}
+		ASSERT_TRUE(buffer == data);
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_CFB)
+{
+	testUtils::for_each_AES_engine([&]
+		{
+			check_CFB_case<crypto::AES_128>(CFB_TestCase{
+				.key	= "2b7e151628aed2a6abf7158809cf4f3c",
+				.iv		= sp800_38a_iv,
+				.plain	= sp800_38a_plain,
+				.cipher	=
+					"3b3fd92eb72dad20333449f8e83cfb4a"
+					"c8a64537a0b3a93fcde3cdad9f1ce58b"
+					"26751f67a3cbb140b1808cf187a4f4df"
+					"c04b05357c5d1c0eeac4c66f9ff7f2e6"});
+
+			check_CFB_case<crypto::AES_192>(CFB_TestCase{
+				.key	= "8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b",
+				.iv		= sp800_38a_iv,
+				.plain	= sp800_38a_plain,
+				.cipher	=
+					"cdc80d6fddf18cab34c25909c99a4174"
+					"67ce7f7f81173621961a2b70171d3d7a"
+					"2e1e8a1dd59b88b1c8e60fed1efac4c9"
+					"c05f9f9ca9834fa042ae8fba584b09ff"});
+
+			check_CFB_case<crypto::AES_256>(CFB_TestCase{
+				.key	= "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4",
+				.iv		= sp800_38a_iv,
+				.plain	= sp800_38a_plain,
+				.cipher	=
+					"dc7e84bfda79164b7ecd8486985d3860"
+					"39ffed143b28b1c832113c6331e5407b"
+					"df10132415e54b92a13ed0a8267ae2f9"
+					"75a385741ab9cef82031623d55b1e471"});
+
+			check_CFB_stream<crypto::AES_128>();
+			check_CFB_stream<crypto::AES_192>();
+			check_CFB_stream<crypto::AES_256>();
+		});
+}
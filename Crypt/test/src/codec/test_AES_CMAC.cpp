@@ -0,0 +1,191 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <random>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_CMAC.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	struct CMAC_TestCase
+	{
+		std::string_view key;
+		uintptr_t size;
+		std::string_view tag;
+	};
+
+	//NIST SP 800-38B D.1 - D.3, the messages are prefixes of the same text
+	constexpr std::string_view cmac_message =
+		"6bc1bee22e409f96e93d7e117393172a"
+		"ae2d8a571e03ac9c9eb76fac45af8e51"
+		"30c81c46a35ce411e5fbc1191a0a52ef"
+		"f69f2445df4f9b17ad2b417be66c3710";
+
+	template<typename AES_t>
+	void check_CMAC_case(const CMAC_TestCase& p_case)
+	{
+		using CMAC_t = crypto::AES_CMAC<AES_t>;
+		constexpr uintptr_t key_lenght = AES_t::key_lenght;
+
+		const std::vector<uint8_t> key		= testUtils::hex_data(p_case.key);
+		const std::vector<uint8_t> message	= testUtils::hex_data(cmac_message.substr(0, p_case.size * 2));
+		const std::vector<uint8_t> tag		= testUtils::hex_data(p_case.tag);
+		ASSERT_EQ(key.size(), key_lenght);
+		ASSERT_EQ(tag.size(), CMAC_t::tag_lenght);
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{key.data(), key_lenght}, tkey_schedule);
+
+		CMAC_t engine;
+		engine.set_key(tkey_schedule);
+
+		//every split point
+		for(uintptr_t split = 0; split <= message.size(); ++split)
+		{
+			ASSERT_TRUE(engine.reset());
+			engine.update(std::span<const uint8_t>{message.data(), split});
+			engine.update(std::span<const uint8_t>{message.data() + split, message.size() - split});
+			engine.finalize();
+			ASSERT_TRUE(std::equal(tag.begin(), tag.end(), engine.tag().begin())) << "Split " << split
+				<< "\n  Actual: " << testPrint{engine.tag()}
+				<< "\nExpected: " << testPrint{tag};
+		}
+
+		ASSERT_TRUE(engine.verify(tag));
+		//truncated tags are rejected unless their size was given to reset()
+		ASSERT_FALSE(engine.verify(std::span<const uint8_t>{tag.data(), 8}));
+		ASSERT_FALSE(engine.verify(std::span<const uint8_t>{tag.data(), 7}));
+
+		std::vector<uint8_t> bad_tag = tag;
+		bad_tag[15] ^= 0x01;
+		ASSERT_FALSE(engine.verify(bad_tag));
+
+		ASSERT_TRUE(engine.reset(8));
+		ASSERT_EQ(engine.tag_size(), 8);
+		engine.update(message);
+		engine.finalize();
+		ASSERT_TRUE(engine.verify(std::span<const uint8_t>{tag.data(), 8}));
+		ASSERT_FALSE(engine.verify(tag));
+		ASSERT_FALSE(engine.verify(std::span<const uint8_t>{tag.data(), 12}));
+		ASSERT_FALSE(engine.verify(std::span<const uint8_t>{tag.data(), 4}));
+
+		for(const uintptr_t tsize : {uintptr_t{0}, uintptr_t{4}, uintptr_t{7}, uintptr_t{17}})
+		{
+			ASSERT_FALSE(engine.reset(tsize)) << tsize;
+		}
+		ASSERT_TRUE(engine.reset());
+		ASSERT_EQ(engine.tag_size(), CMAC_t::tag_lenght);
+	}
+
+	//	Note: More messages than lanes, of every length class (empty, partial, whole blocks), each under its own key.
+	//	Compared against the incremental interface.
+	template<typename AES_t>
+	void check_CMAC_compute()
+	{
+		using CMAC_t = crypto::AES_CMAC<AES_t>;
+		constexpr uintptr_t key_lenght	= AES_t::key_lenght;
+		constexpr uintptr_t job_count	= 45;
+
+		std::mt19937 gen(0xC3);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+		std::uniform_int_distribution<uintptr_t> size_distrib(0, 100);
+
+		std::vector<typename CMAC_t::key_t> keys(job_count);
+		std::vector<std::vector<uint8_t>> messages(job_count);
+		std::vector<typename CMAC_t::job_t> jobs(job_count);
+
+		for(uintptr_t i = 0; i < job_count; ++i)
+		{
+			std::array<uint8_t, key_lenght> key;
+			for(uint8_t& tbyte : key) tbyte = static_cast<uint8_t>(distrib(gen));
+			typename AES_t::key_schedule_t tkey_schedule;
+			AES_t::make_key_schedule(key, tkey_schedule);
+			CMAC_t::make_key(tkey_schedule, keys[i]);
+
+			const uintptr_t size = (i % 3) ? size_distrib(gen) : (i / 3 % 4) * AES_t::block_lenght;
+			messages[i].resize(size);
+			for(uint8_t& tbyte : messages[i]) tbyte = static_cast<uint8_t>(distrib(gen));
+
+			jobs[i].key		= &keys[i];
+			jobs[i].message	= messages[i];
+		}
+
+		CMAC_t::compute(jobs);
+
+		CMAC_t engine;
+		for(uintptr_t i = 0; i < job_count; ++i)
+		{
+			engine.set_key(keys[i]);
+			engine.reset();
+			engine.update(messages[i]);
+			engine.finalize();
+			ASSERT_TRUE(jobs[i].tag == engine.tag()) << "Job " << i
+				<< "\n  Actual: " << testPrint{jobs[i].tag}
+				<< "\nExpected: " << testPrint{engine.tag()};
+		}
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_CMAC)
+{
+	testUtils::for_each_AES_engine([&]
+		{
+			constexpr std::string_view key_128 = "2b7e151628aed2a6abf7158809cf4f3c";
+			check_CMAC_case<crypto::AES_128>(CMAC_TestCase{.key = key_128, .size =  0, .tag = "bb1d6929e95937287fa37d129b756746"});
+			check_CMAC_case<crypto::AES_128>(CMAC_TestCase{.key = key_128, .size = 16, .tag = "070a16b46b4d4144f79bdd9dd04a287c"});
+			check_CMAC_case<crypto::AES_128>(CMAC_TestCase{.key = key_128, .size = 40, .tag = "dfa66747de9ae63030ca32611497c827"});
+			check_CMAC_case<crypto::AES_128>(CMAC_TestCase{.key = key_128, .size = 64, .tag = "51f0bebf7e3b9d92fc49741779363cfe"});
+
+			constexpr std::string_view key_192 = "8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b";
+			check_CMAC_case<crypto::AES_192>(CMAC_TestCase{.key = key_192, .size =  0, .tag = "d17ddf46adaacde531cac483de7a9367"});
+			check_CMAC_case<crypto::AES_192>(CMAC_TestCase{.key = key_192, .size = 16, .tag = "9e99a7bf31e710900662f65e617c5184"});
+			check_CMAC_case<crypto::AES_192>(CMAC_TestCase{.key = key_192, .size = 40, .tag = "8a1de5be2eb31aad089a82e6ee908b0e"});
+			check_CMAC_case<crypto::AES_192>(CMAC_TestCase{.key = key_192, .size = 64, .tag = "a1d5df0eed790f794d77589659f39a11"});
+
+			constexpr std::string_view key_256 = "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4";
+			check_CMAC_case<crypto::AES_256>(CMAC_TestCase{.key = key_256, .size =  0, .tag = "028962f61b7bf89efc6b551f4667d983"});
+			check_CMAC_case<crypto::AES_256>(CMAC_TestCase{.key = key_256, .size = 16, .tag = "28a7023f452e8f82bd4bf28d8c37c35c"});
+			check_CMAC_case<crypto::AES_256>(CMAC_TestCase{.key = key_256, .size = 40, .tag = "aaf3d8f1de5640c232f5b169b9c911e6"});
+			check_CMAC_case<crypto::AES_256>(CMAC_TestCase{.key = key_256, .size = 64, .tag = "e1992190549f6ed5696a2c056c315410"});
+
+			check_CMAC_compute<crypto::AES_128>();
+			check_CMAC_compute<crypto::AES_192>();
+			check_CMAC_compute<crypto::AES_256>();
+		});
+}
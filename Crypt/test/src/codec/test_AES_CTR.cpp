@@ -0,0 +1,295 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <random>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_CTR.hpp>
+#include <Crypt/worker_pool.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	struct CTR_TestCase
+	{
+		std::string_view key;
+		std::string_view counter;
+		std::string_view plain;
+		std::string_view cipher;
+	};
+
+	//NIST SP 800-38A F.5
+	constexpr std::string_view sp800_38a_counter = "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+	constexpr std::string_view sp800_38a_plain =
+		"6bc1bee22e409f96e93d7e117393172a"
+		"ae2d8a571e03ac9c9eb76fac45af8e51"
+		"30c81c46a35ce411e5fbc1191a0a52ef"
+		"f69f2445df4f9b17ad2b417be66c3710";
+
+	template<typename AES_t>
+	void check_CTR_case(const CTR_TestCase& p_case)
+	{
+		using CTR_t = crypto::AES_CTR<AES_t>;
+		constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+
+		const std::vector<uint8_t> key		= testUtils::hex_data(p_case.key);
+		const std::vector<uint8_t> counter	= testUtils::hex_data(p_case.counter);
+		const std::vector<uint8_t> plain	= testUtils::hex_data(p_case.plain);
+		const std::vector<uint8_t> cipher	= testUtils::hex_data(p_case.cipher);
+		ASSERT_EQ(key.size(), key_lenght);
+		ASSERT_EQ(counter.size(), block_lenght);
+		ASSERT_EQ(plain.size(), cipher.size());
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{key.data(), key_lenght}, tkey_schedule);
+
+		CTR_t engine;
+
+		//whole buffer at once
+		{
+			std::vector<uint8_t> encoded(plain.size());
+			engine.reset(tkey_schedule, std::span<const uint8_t, block_lenght>{counter.data(), block_lenght});
+			engine.update(plain, encoded);
+			ASSERT_TRUE(encoded == cipher)
+				<< "\n  Actual: " << testPrint{encoded}
+				<< "\nExpected: " << testPrint{cipher};
+		}
+
+		//every split point, in place
+		for(uintptr_t split = 0; split <= plain.size(); ++split)
+		{
+			std::vector<uint8_t> buffer = cipher;
+			engine.reset(tkey_schedule, std::span<const uint8_t, block_lenght>{counter.data(), block_lenght});
+			engine.update(std::span<const uint8_t>{buffer.data(), split}, std::span<uint8_t>{buffer.data(), split});
+			engine.update(std::span<const uint8_t>{buffer.data() + split, buffer.size() - split}, std::span<uint8_t>{buffer.data() + split, buffer.size() - split});
+			ASSERT_TRUE(buffer == plain) << "Split " << split
+				<< "\n  Actual: " << testPrint{buffer}
+				<< "\nExpected: " << testPrint{plain};
+		}
+	}
+
+	//	Note: Compares against a reference built from single block encodes,
+	//	starting close enough to the 64 bit boundary to exercise the carry after a few multi-block passes.
+	template<typename AES_t>
+	void check_CTR_stream()
+	{
+		using CTR_t = crypto::AES_CTR<AES_t>;
+		constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+		constexpr uintptr_t data_size		= 1000;
+
+		std::mt19937 gen(0xC7);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+		std::array<uint8_t, key_lenght> key;
+		for(uint8_t& tbyte : key) tbyte = static_cast<uint8_t>(distrib(gen));
+
+		std::vector<uint8_t> data(data_size);
+		for(uint8_t& tbyte : data) tbyte = static_cast<uint8_t>(distrib(gen));
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(key, tkey_schedule);
+
+		std::array<uint8_t, block_lenght> counter
+		{
+			0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xD0,
+		};
+
+		std::vector<uint8_t> expected(data_size);
+		{
+			std::array<uint8_t, block_lenght> tcounter = counter;
+			for(uintptr_t i = 0; i < data_size; i += block_lenght)
+			{
+				std::array<uint8_t, block_lenght> key_stream;
+				AES_t::encode(tkey_schedule, tcounter, key_stream);
+				for(uintptr_t j = 0; j < block_lenght && i + j < data_size; ++j)
+				{
+					expected[i + j] = data[i + j] ^ key_stream[j];
+				}
+				for(uintptr_t j = block_lenght; j-- && ++tcounter[j] == 0;);
+			}
+		}
+
+		std::uniform_int_distribution<uintptr_t> split_distrib(0, 200);
+
+		CTR_t engine;
+		engine.reset(tkey_schedule, counter);
+		std::vector<uint8_t> encoded(data_size);
+		for(uintptr_t pos = 0; pos < data_size;)
+		{
+			const uintptr_t count = std::min(split_distrib(gen), data_size - pos);
+			engine.update(std::span<const uint8_t>{data.data() + pos, count}, std::span<uint8_t>{encoded.data() + pos, count});
+			pos += count;
+		}
+
+		ASSERT_TRUE(encoded == expected);
+
+		const std::array<uint8_t, block_lenght> expected_counter
+		{
+			0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x09,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F,
+		};
+		ASSERT_TRUE(engine.counter() == expected_counter)
+			<< "\n  Actual: " << testPrint{engine.counter()}
+			<< "\nExpected: " << testPrint{expected_counter};
+
+		engine.reset(tkey_schedule, counter);
+		std::vector<uint8_t> single_call(data_size);
+		engine.update(data, single_call);
+		ASSERT_TRUE(single_call == expected);
+		ASSERT_TRUE(engine.counter() == expected_counter);
+
+		//scatter-gather in place, fragments are mostly not block aligned
+		std::uniform_int_distribution<uintptr_t> fragment_distrib(0, 40);
+		std::vector<uint8_t> buffer = data;
+		std::vector<std::span<uint8_t>> buffers;
+		for(uintptr_t pos = 0; pos < data_size;)
+		{
+			const uintptr_t count = std::min(fragment_distrib(gen), data_size - pos);
+			buffers.emplace_back(buffer.data() + pos, count);
+			pos += count;
+		}
+		engine.reset(tkey_schedule, counter);
+		engine.update(buffers);
+		ASSERT_TRUE(buffer == expected);
+		ASSERT_TRUE(engine.counter() == expected_counter);
+
+		engine.reset(tkey_schedule, counter);
+		engine.update(buffer);
+		ASSERT_TRUE(buffer == data);
+	}
+
+	//	Note: The counter starts close enough to the 64 bit boundary for the chunk offsets to carry into the upper half.
+	template<typename AES_t>
+	void check_CTR_parallel(crypto::worker_pool& p_pool)
+	{
+		using CTR_t = crypto::AES_CTR<AES_t>;
+		constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+		constexpr uintptr_t data_size		= CTR_t::parallel_chunk * 5 + 1007;
+		constexpr uintptr_t head			= 5;
+
+		std::mt19937 gen(0x9A);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+		std::array<uint8_t, key_lenght> key;
+		for(uint8_t& tbyte : key) tbyte = static_cast<uint8_t>(distrib(gen));
+
+		std::vector<uint8_t> data(data_size);
+		for(uint8_t& tbyte : data) tbyte = static_cast<uint8_t>(distrib(gen));
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(key, tkey_schedule);
+
+		const std::array<uint8_t, block_lenght> counter
+		{
+			0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x10, 0x00,
+		};
+
+		CTR_t engine;
+		engine.reset(tkey_schedule, counter);
+		std::vector<uint8_t> expected(data_size);
+		engine.update(data, expected);
+		const typename CTR_t::counter_t expected_counter = engine.counter();
+
+		std::vector<uint8_t> encoded(data_size);
+		engine.reset(tkey_schedule, counter);
+		engine.update(std::span<const uint8_t>{data.data(), head}, std::span<uint8_t>{encoded.data(), head});
+		engine.update(p_pool, std::span<const uint8_t>{data.data() + head, data_size - head}, std::span<uint8_t>{encoded.data() + head, data_size - head});
+		ASSERT_TRUE(encoded == expected);
+		ASSERT_TRUE(engine.counter() == expected_counter);
+
+		engine.reset(tkey_schedule, counter);
+		engine.update(p_pool, encoded, encoded);
+		ASSERT_TRUE(encoded == data);
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_CTR)
+{
+	testUtils::for_each_AES_engine([&]
+		{
+			check_CTR_case<crypto::AES_128>(CTR_TestCase{
+				.key		= "2b7e151628aed2a6abf7158809cf4f3c",
+				.counter	= sp800_38a_counter,
+				.plain		= sp800_38a_plain,
+				.cipher		=
+					"874d6191b620e3261bef6864990db6ce"
+					"9806f66b7970fdff8617187bb9fffdff"
+					"5ae4df3edbd5d35e5b4f09020db03eab"
+					"1e031dda2fbe03d1792170a0f3009cee"});
+
+			check_CTR_case<crypto::AES_192>(CTR_TestCase{
+				.key		= "8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b",
+				.counter	= sp800_38a_counter,
+				.plain		= sp800_38a_plain,
+				.cipher		=
+					"1abc932417521ca24f2b0459fe7e6e0b"
+					"090339ec0aa6faefd5ccc2c6f4ce8e94"
+					"1e36b26bd1ebc670d1bd1d665620abf7"
+					"4f78a7f6d29809585a97daec58c6b050"});
+
+			check_CTR_case<crypto::AES_256>(CTR_TestCase{
+				.key		= "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4",
+				.counter	= sp800_38a_counter,
+				.plain		= sp800_38a_plain,
+				.cipher		=
+					"601ec313775789a5b7a7f504bbf3d228"
+					"f443e3ca4d62b59aca84e990cacaf5c5"
+					"2b0930daa23de94ce87017ba2d84988d"
+					"dfc9c58db67aada613c2dd08457941a6"});
+
+			check_CTR_stream<crypto::AES_128>();
+			check_CTR_stream<crypto::AES_192>();
+			check_CTR_stream<crypto::AES_256>();
+		});
+}
+
+TEST(codec_symmetric, AES_CTR_parallel)
+{
+	crypto::worker_pool pool(4);
+	ASSERT_EQ(pool.size(), 4);
+
+	testUtils::for_each_AES_engine([&]
+		{
+			check_CTR_parallel<crypto::AES_128>(pool);
+			check_CTR_parallel<crypto::AES_256>(pool);
+		});
+}
@@ -0,0 +1,274 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <thread>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#ifndef _WIN32
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
+
+#include <Crypt/codec/AES_CTR_DRBG.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	using seed_t = std::array<uint8_t, crypto::AES_CTR_DRBG::seed_lenght>;
+
+	seed_t make_seed(const uint8_t p_start)
+	{
+		seed_t out;
+		for(uintptr_t i = 0; i < out.size(); ++i)
+		{
+			out[i] = static_cast<uint8_t>(p_start + i);
+		}
+		return out;
+	}
+
+	bool fixed_source(std::span<uint8_t, crypto::AES_CTR_DRBG::seed_lenght> p_out)
+	{
+		const seed_t seed = make_seed(0x00);
+		std::copy(seed.begin(), seed.end(), p_out.begin());
+		return true;
+	}
+
+	bool failing_source(std::span<uint8_t, crypto::AES_CTR_DRBG::seed_lenght>)
+	{
+		return false;
+	}
+
+	//	Note: First 150 bytes of the output of a generator instantiated with make_seed(0x00).
+	constexpr std::string_view first_output =
+		"061550234d158c5ec95595fe04ef7a25767f2e24cc2bc479d09d86dc9abcfde7"
+		"056a8c266f9ef97ed08541dbd2e1ffa19810f5392d076276ef41277c3ab6e94a"
+		"4e3b7dcc104a05bb089d338bf55c72cab375389a94bb920bd5d6dc9e7f2ec6fd"
+		"e028b6f5724bb039f3652ad98df8ce6c97013210b84bbe81388c3d141d61957c"
+		"73bcdc5e5cd92525f46a2b757b03cab5c337004a2da3";
+} //namespace
+
+TEST(codec_symmetric, AES_CTR_DRBG)
+{
+	using crypto::AES_CTR_DRBG;
+
+	const seed_t entropy			= make_seed(0x00);
+	const seed_t reseed_entropy		= make_seed(0x40);
+	const seed_t personalization	= make_seed(0x80);
+	const std::array<uint8_t, 32> additional = []
+		{
+			std::array<uint8_t, 32> out;
+			for(uintptr_t i = 0; i < out.size(); ++i) out[i] = static_cast<uint8_t>(0xC0 + i);
+			return out;
+		}();
+
+	const std::vector<uint8_t> expected_plain = testUtils::hex_data(
+		"04562ad35e8ecafaafda16981cdaa147606beea62801342af13c8b5535f72f94"
+		"95b74317c762f0adab7abe710797612176b61b0e208398113cf9c170157bc75f");
+	const std::vector<uint8_t> expected_additional = testUtils::hex_data(
+		"0a718a12eb4e8c248498af5d802538c5e76462e934758373bd0435c7c9144b1c"
+		"5435c0ab3fc88826d3346cd54de1402bd4c998b47dc0ca8f188d9a5dc54621c4");
+	const std::vector<uint8_t> expected_reseed = testUtils::hex_data(
+		"a7e7f36187c06c08364629913561d9f502b5d356e4e924ff91a305e5fddcca89"
+		"1141cf5b76");
+	const std::vector<uint8_t> expected_first = testUtils::hex_data(first_output);
+
+	testUtils::for_each_AES_engine([&]
+		{
+			AES_CTR_DRBG drbg;
+
+			//the second of two requests is checked
+			{
+				std::vector<uint8_t> out(64);
+				ASSERT_TRUE(drbg.instantiate(entropy));
+				ASSERT_TRUE(drbg.generate(out));
+				ASSERT_TRUE(drbg.generate(out));
+				ASSERT_TRUE(out == expected_plain)
+					<< "\n  Actual: " << testPrint{out}
+					<< "\nExpected: " << testPrint{expected_plain};
+			}
+
+			//personalization and additional input
+			{
+				std::vector<uint8_t> out(64);
+				ASSERT_TRUE(drbg.instantiate(entropy, personalization));
+				ASSERT_TRUE(drbg.generate(out, additional));
+				ASSERT_TRUE(drbg.generate(out, additional));
+				ASSERT_TRUE(out == expected_additional)
+					<< "\n  Actual: " << testPrint{out}
+					<< "\nExpected: " << testPrint{expected_additional};
+			}
+
+			//reseed, request not block aligned
+			{
+				std::vector<uint8_t> out(37);
+				ASSERT_TRUE(drbg.instantiate(entropy));
+				ASSERT_TRUE(drbg.reseed(reseed_entropy, additional));
+				ASSERT_TRUE(drbg.generate(out));
+				ASSERT_TRUE(out == expected_reseed)
+					<< "\n  Actual: " << testPrint{out}
+					<< "\nExpected: " << testPrint{expected_reseed};
+			}
+
+			//a request spanning several multi-block passes
+			{
+				std::vector<uint8_t> out(AES_CTR_DRBG::max_request);
+				ASSERT_TRUE(drbg.instantiate(entropy));
+				ASSERT_TRUE(drbg.generate(out));
+				ASSERT_TRUE(std::equal(expected_first.begin(), expected_first.end(), out.begin()));
+			}
+		});
+
+	//invalid use
+	{
+		AES_CTR_DRBG drbg;
+		std::vector<uint8_t> out(16);
+		ASSERT_FALSE(drbg.generate(out));
+		ASSERT_FALSE(drbg.reseed(entropy));
+
+		const std::array<uint8_t, AES_CTR_DRBG::seed_lenght + 1> too_long{};
+		ASSERT_FALSE(drbg.instantiate(entropy, too_long));
+		ASSERT_TRUE(drbg.instantiate(entropy));
+		ASSERT_FALSE(drbg.reseed(entropy, too_long));
+		ASSERT_FALSE(drbg.generate(out, too_long));
+
+		std::vector<uint8_t> large(AES_CTR_DRBG::max_request + 1);
+		ASSERT_FALSE(drbg.generate(large));
+		ASSERT_FALSE(drbg.reseed_required());
+
+		drbg.uninstantiate();
+		ASSERT_FALSE(drbg.generate(out));
+	}
+}
+
+TEST(codec_symmetric, AES_CTR_DRBG_thread)
+{
+	using crypto::AES_CTR_DRBG;
+
+	const std::vector<uint8_t> expected_first = testUtils::hex_data(first_output);
+
+	//	Note: Each check runs on a new thread, so that it starts from a fresh per thread generator.
+	AES_CTR_DRBG::set_entropy_source(fixed_source);
+
+	//small requests served from the buffer
+	std::thread([&]
+		{
+			std::vector<uint8_t> out(150);
+			ASSERT_TRUE(AES_CTR_DRBG::thread_generate(std::span<uint8_t>{out.data(), 100}));
+			ASSERT_TRUE(AES_CTR_DRBG::thread_generate(std::span<uint8_t>{out.data() + 100, 50}));
+			ASSERT_TRUE(out == expected_first)
+				<< "\n  Actual: " << testPrint{out}
+				<< "\nExpected: " << testPrint{expected_first};
+
+			//a reseed discards the buffer
+			std::vector<uint8_t> next(150);
+			ASSERT_TRUE(AES_CTR_DRBG::thread_reseed());
+			ASSERT_TRUE(AES_CTR_DRBG::thread_generate(next));
+			ASSERT_FALSE(next == expected_first);
+		}).join();
+
+	//large request bypassing the buffer
+	std::thread([&]
+		{
+			std::vector<uint8_t> out(AES_CTR_DRBG::thread_buffer_size * 3 + 5);
+			ASSERT_TRUE(AES_CTR_DRBG::thread_generate(out));
+			ASSERT_TRUE(std::equal(expected_first.begin(), expected_first.end(), out.begin()));
+		}).join();
+
+	AES_CTR_DRBG::set_entropy_source(failing_source);
+	std::thread([&]
+		{
+			std::vector<uint8_t> out(150, 0xAA);
+			ASSERT_FALSE(AES_CTR_DRBG::thread_generate(out));
+			ASSERT_TRUE(std::all_of(out.begin(), out.end(), [](const uint8_t p_byte) { return p_byte == 0; }));
+		}).join();
+
+	AES_CTR_DRBG::set_entropy_source(nullptr);
+	std::thread([&]
+		{
+			std::vector<uint8_t> out(16);
+			ASSERT_FALSE(AES_CTR_DRBG::thread_generate(out));
+		}).join();
+}
+
+#ifndef _WIN32
+TEST(codec_symmetric, AES_CTR_DRBG_fork)
+{
+	using crypto::AES_CTR_DRBG;
+
+	const std::vector<uint8_t> expected_first = testUtils::hex_data(first_output);
+
+	//	Note: With a fixed source a child that starts a new generator repeats the first output,
+	//	while the parent carries on from its buffer.
+	AES_CTR_DRBG::set_entropy_source(fixed_source);
+	std::thread([&]
+		{
+			std::vector<uint8_t> out(100);
+			ASSERT_TRUE(AES_CTR_DRBG::thread_generate(out));
+
+			int fds[2];
+			ASSERT_EQ(pipe(fds), 0);
+
+			const pid_t child = fork();
+			ASSERT_NE(child, -1);
+			if(child == 0)
+			{
+				std::array<uint8_t, 50> child_out;
+				const bool ok = AES_CTR_DRBG::thread_generate(child_out);
+				_exit(ok && write(fds[1], child_out.data(), child_out.size()) == static_cast<ssize_t>(child_out.size()) ? 0 : 1);
+			}
+			close(fds[1]);
+
+			std::array<uint8_t, 50> child_out;
+			const ssize_t received = read(fds[0], child_out.data(), child_out.size());
+			close(fds[0]);
+			int status = 0;
+			ASSERT_EQ(waitpid(child, &status, 0), child);
+			ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+			ASSERT_EQ(received, static_cast<ssize_t>(child_out.size()));
+
+			std::array<uint8_t, 50> parent_out;
+			ASSERT_TRUE(AES_CTR_DRBG::thread_generate(parent_out));
+
+			ASSERT_TRUE(std::equal(child_out.begin(), child_out.end(), expected_first.begin()))
+				<< "\n  Actual: " << testPrint{child_out};
+			ASSERT_TRUE(std::equal(parent_out.begin(), parent_out.end(), expected_first.begin() + 100))
+				<< "\n  Actual: " << testPrint{parent_out};
+		}).join();
+
+	AES_CTR_DRBG::set_entropy_source(nullptr);
+}
+#endif
@@ -0,0 +1,503 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <random>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_GCM.hpp>
+#include <Crypt/worker_pool.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	struct GCM_TestCase
+	{
+		std::string_view key;
+		std::string_view iv;
+		std::string_view aad {};
+		std::string_view plain {};
+		std::string_view cipher {};
+		std::string_view tag;
+	};
+
+	//The Galois/Counter Mode of Operation (GCM), McGrew & Viega, Appendix B
+	constexpr std::string_view gcm_key = "feffe9928665731c6d6a8f9467308308";
+	constexpr std::string_view gcm_iv  = "cafebabefacedbaddecaf888";
+	constexpr std::string_view gcm_aad = "feedfacedeadbeeffeedfacedeadbeefabaddad2";
+	constexpr std::string_view gcm_plain =
+		"d9313225f88406e5a55909c5aff5269a"
+		"86a7a9531534f7da2e4c303d8a318a72"
+		"1c3c0c95956809532fcf0e2449a6b525"
+		"b16aedf5aa0de657ba637b391aafd255";
+	constexpr std::string_view gcm_plain_60 = gcm_plain.substr(0, 120);
+
+	template<typename AES_t>
+	void check_GCM_case(const GCM_TestCase& p_case)
+	{
+		using GCM_t = crypto::AES_GCM<AES_t>;
+		constexpr uintptr_t key_lenght = AES_t::key_lenght;
+
+		const std::vector<uint8_t> key		= testUtils::hex_data(p_case.key);
+		const std::vector<uint8_t> iv		= testUtils::hex_data(p_case.iv);
+		const std::vector<uint8_t> aad		= testUtils::hex_data(p_case.aad);
+		const std::vector<uint8_t> plain	= testUtils::hex_data(p_case.plain);
+		const std::vector<uint8_t> cipher	= testUtils::hex_data(p_case.cipher);
+		const std::vector<uint8_t> tag		= testUtils::hex_data(p_case.tag);
+		ASSERT_EQ(key.size(), key_lenght);
+		ASSERT_EQ(plain.size(), cipher.size());
+		ASSERT_EQ(tag.size(), GCM_t::tag_lenght);
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{key.data(), key_lenght}, tkey_schedule);
+
+		GCM_t engine;
+		engine.set_key(tkey_schedule);
+
+		//whole buffer at once
+		{
+			std::vector<uint8_t> encoded(plain.size());
+			ASSERT_TRUE(engine.reset(iv));
+			ASSERT_TRUE(engine.update_aad(aad));
+			engine.encode(plain, encoded);
+			engine.finalize();
+			ASSERT_TRUE(encoded == cipher)
+				<< "\n  Actual: " << testPrint{encoded}
+				<< "\nExpected: " << testPrint{cipher};
+			ASSERT_TRUE(std::equal(tag.begin(), tag.end(), engine.tag().begin()))
+				<< "\n  Actual: " << testPrint{engine.tag()}
+				<< "\nExpected: " << testPrint{tag};
+			ASSERT_TRUE(engine.verify(tag));
+			ASSERT_FALSE(engine.verify(std::span<const uint8_t>{tag.data(), 12}));
+			ASSERT_FALSE(engine.verify(std::span<const uint8_t>{tag.data(), 4}));
+		}
+
+		//truncated tags are only accepted at the size given to reset
+		for(const uintptr_t tag_size : {uintptr_t{12}, uintptr_t{8}, uintptr_t{4}})
+		{
+			std::vector<uint8_t> buffer = cipher;
+			ASSERT_TRUE(engine.reset(iv, tag_size));
+			ASSERT_EQ(engine.tag_size(), tag_size);
+			ASSERT_TRUE(engine.update_aad(aad));
+			ASSERT_TRUE(engine.decode(buffer));
+			engine.finalize();
+			ASSERT_TRUE(engine.verify(std::span<const uint8_t>{tag.data(), tag_size})) << "Tag size " << tag_size;
+			ASSERT_FALSE(engine.verify(tag)) << "Tag size " << tag_size;
+			ASSERT_FALSE(engine.verify(std::span<const uint8_t>{tag.data(), tag_size - 1})) << "Tag size " << tag_size;
+		}
+		for(const uintptr_t tag_size : {uintptr_t{0}, uintptr_t{3}, uintptr_t{5}, uintptr_t{7}, uintptr_t{9}, uintptr_t{11}, uintptr_t{17}})
+		{
+			ASSERT_FALSE(engine.reset(iv, tag_size)) << "Tag size " << tag_size;
+		}
+
+		//every split point, in place
+		for(uintptr_t split = 0; split <= plain.size(); ++split)
+		{
+			std::vector<uint8_t> buffer = cipher;
+			const uintptr_t aad_split = split < aad.size() ? split : aad.size();
+
+			ASSERT_TRUE(engine.reset(iv));
+			ASSERT_TRUE(engine.update_aad(std::span<const uint8_t>{aad.data(), aad_split}));
+			ASSERT_TRUE(engine.update_aad(std::span<const uint8_t>{aad.data() + aad_split, aad.size() - aad_split}));
+			engine.decode(std::span<const uint8_t>{buffer.data(), split}, std::span<uint8_t>{buffer.data(), split});
+			engine.decode(std::span<const uint8_t>{buffer.data() + split, buffer.size() - split}, std::span<uint8_t>{buffer.data() + split, buffer.size() - split});
+			engine.finalize();
+			ASSERT_TRUE(buffer == plain) << "Split " << split
+				<< "\n  Actual: " << testPrint{buffer}
+				<< "\nExpected: " << testPrint{plain};
+			ASSERT_TRUE(engine.verify(tag)) << "Split " << split;
+		}
+
+		//tampered
+		if(!cipher.empty())
+		{
+			std::vector<uint8_t> buffer = cipher;
+			buffer.back() ^= 0x01;
+			ASSERT_TRUE(engine.reset(iv));
+			ASSERT_TRUE(engine.update_aad(aad));
+			engine.decode(buffer, buffer);
+			engine.finalize();
+			ASSERT_FALSE(engine.verify(tag));
+		}
+	}
+
+	//	Note: Long messages with random splits, compared against the result of the software engine.
+	template<typename AES_t>
+	void check_GCM_stream()
+	{
+		using GCM_t = crypto::AES_GCM<AES_t>;
+		constexpr uintptr_t key_lenght	= AES_t::key_lenght;
+		constexpr uintptr_t data_size	= 3000;
+		constexpr uintptr_t aad_size	= 77;
+
+		std::mt19937 gen(0x6C);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+		std::array<uint8_t, key_lenght> key;
+		std::array<uint8_t, 12> iv;
+		std::vector<uint8_t> aad(aad_size);
+		std::vector<uint8_t> data(data_size);
+		for(uint8_t& tbyte : key)	tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : iv)	tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : aad)	tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : data)	tbyte = static_cast<uint8_t>(distrib(gen));
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(key, tkey_schedule);
+
+		std::vector<uint8_t> expected(data_size);
+		typename GCM_t::tag_t expected_tag;
+		{
+			ASSERT_TRUE(crypto::AES_set_engine(crypto::AES_engine::software));
+			GCM_t engine;
+			engine.set_key(tkey_schedule);
+			engine.reset(iv);
+			engine.update_aad(aad);
+			engine.encode(data, expected);
+			engine.finalize();
+			expected_tag = engine.tag();
+		}
+
+		std::uniform_int_distribution<uintptr_t> split_distrib(0, 400);
+
+		testUtils::for_each_AES_engine([&]
+			{
+				GCM_t engine;
+				engine.set_key(tkey_schedule);
+				engine.reset(iv);
+				engine.update_aad(std::span<const uint8_t>{aad.data(), 5});
+				engine.update_aad(std::span<const uint8_t>{aad.data() + 5, aad_size - 5});
+
+				std::vector<uint8_t> buffer = data;
+				for(uintptr_t pos = 0; pos < data_size;)
+				{
+					const uintptr_t count = std::min(split_distrib(gen), data_size - pos);
+					engine.encode(std::span<const uint8_t>{buffer.data() + pos, count}, std::span<uint8_t>{buffer.data() + pos, count});
+					pos += count;
+				}
+				ASSERT_FALSE(engine.update_aad(aad));
+				engine.finalize();
+
+				ASSERT_TRUE(buffer == expected);
+				ASSERT_TRUE(engine.tag() == expected_tag);
+
+				engine.reset(iv);
+				engine.update_aad(aad);
+				engine.decode(buffer, buffer);
+				engine.finalize();
+				ASSERT_TRUE(buffer == data);
+				ASSERT_TRUE(engine.verify(expected_tag));
+
+				//scatter-gather in place, fragments are mostly not block aligned
+				std::uniform_int_distribution<uintptr_t> fragment_distrib(0, 40);
+				std::vector<std::span<uint8_t>> buffers;
+				for(uintptr_t pos = 0; pos < data_size;)
+				{
+					const uintptr_t count = std::min(fragment_distrib(gen), data_size - pos);
+					buffers.emplace_back(buffer.data() + pos, count);
+					pos += count;
+				}
+				const std::array<std::span<const uint8_t>, 3> aad_buffers
+				{
+					std::span<const uint8_t>{aad.data(), 7},
+					std::span<const uint8_t>{},
+					std::span<const uint8_t>{aad.data() + 7, aad_size - 7},
+				};
+
+				engine.reset(iv);
+				ASSERT_TRUE(engine.update_aad(aad_buffers));
+				engine.encode(buffers);
+				ASSERT_FALSE(engine.update_aad(aad_buffers));
+				engine.finalize();
+				ASSERT_TRUE(buffer == expected);
+				ASSERT_TRUE(engine.tag() == expected_tag);
+
+				engine.reset(iv);
+				engine.update_aad(aad);
+				engine.decode(buffers);
+				engine.finalize();
+				ASSERT_TRUE(buffer == data);
+				ASSERT_TRUE(engine.verify(expected_tag));
+
+				engine.reset(iv);
+				engine.update_aad(aad);
+				engine.encode(buffer);
+				engine.finalize();
+				ASSERT_TRUE(buffer == expected);
+				ASSERT_TRUE(engine.tag() == expected_tag);
+			});
+	}
+
+	template<typename AES_t>
+	void check_GCM_parallel(crypto::worker_pool& p_pool)
+	{
+		using GCM_t = crypto::AES_GCM<AES_t>;
+		constexpr uintptr_t key_lenght	= AES_t::key_lenght;
+		constexpr uintptr_t data_size	= GCM_t::parallel_chunk * 5 + 1007;
+		constexpr uintptr_t aad_size	= 21;
+		constexpr uintptr_t head		= 5;
+
+		std::mt19937 gen(0x6C);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+		std::array<uint8_t, key_lenght> key;
+		std::array<uint8_t, 12> iv;
+		std::array<uint8_t, aad_size> aad;
+		for(uint8_t& tbyte : key) tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : iv) tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : aad) tbyte = static_cast<uint8_t>(distrib(gen));
+
+		std::vector<uint8_t> data(data_size);
+		for(uint8_t& tbyte : data) tbyte = static_cast<uint8_t>(distrib(gen));
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(key, tkey_schedule);
+
+		GCM_t engine;
+		engine.set_key(tkey_schedule);
+
+		std::vector<uint8_t> expected(data_size);
+		engine.reset(iv);
+		engine.update_aad(aad);
+		engine.encode(data, expected);
+		engine.finalize();
+		const typename GCM_t::tag_t expected_tag = engine.tag();
+
+		//the pending aad block is hashed before the chunks
+		std::vector<uint8_t> buffer(data_size);
+		engine.reset(iv);
+		engine.update_aad(aad);
+		engine.encode(p_pool, data, buffer);
+		engine.finalize();
+		ASSERT_TRUE(buffer == expected);
+		ASSERT_TRUE(engine.tag() == expected_tag);
+
+		//not starting on a block boundary
+		engine.reset(iv);
+		engine.update_aad(aad);
+		engine.encode(std::span<const uint8_t>{data.data(), head}, std::span<uint8_t>{buffer.data(), head});
+		engine.encode(p_pool, std::span<const uint8_t>{data.data() + head, data_size - head}, std::span<uint8_t>{buffer.data() + head, data_size - head});
+		engine.finalize();
+		ASSERT_TRUE(buffer == expected);
+		ASSERT_TRUE(engine.tag() == expected_tag);
+
+		engine.reset(iv);
+		engine.update_aad(aad);
+		engine.decode(p_pool, buffer, buffer);
+		engine.finalize();
+		ASSERT_TRUE(buffer == data);
+		ASSERT_TRUE(engine.verify(expected_tag));
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_GCM)
+{
+	testUtils::for_each_AES_engine([&]
+		{
+			//Test case 1
+			check_GCM_case<crypto::AES_128>(GCM_TestCase{
+				.key	= "00000000000000000000000000000000",
+				.iv		= "000000000000000000000000",
+				.tag	= "58e2fccefa7e3061367f1d57a4e7455a"});
+
+			//Test case 2
+			check_GCM_case<crypto::AES_128>(GCM_TestCase{
+				.key	= "00000000000000000000000000000000",
+				.iv		= "000000000000000000000000",
+				.plain	= "00000000000000000000000000000000",
+				.cipher	= "0388dace60b6a392f328c2b971b2fe78",
+				.tag	= "ab6e47d42cec13bdf53a67b21257bddf"});
+
+			//Test case 3
+			check_GCM_case<crypto::AES_128>(GCM_TestCase{
+				.key	= gcm_key,
+				.iv		= gcm_iv,
+				.plain	= gcm_plain,
+				.cipher	=
+					"42831ec2217774244b7221b784d0d49c"
+					"e3aa212f2c02a4e035c17e2329aca12e"
+					"21d514b25466931c7d8f6a5aac84aa05"
+					"1ba30b396a0aac973d58e091473f5985",
+				.tag	= "4d5c2af327cd64a62cf35abd2ba6fab4"});
+
+			//Test case 4
+			check_GCM_case<crypto::AES_128>(GCM_TestCase{
+				.key	= gcm_key,
+				.iv		= gcm_iv,
+				.aad	= gcm_aad,
+				.plain	= gcm_plain_60,
+				.cipher	=
+					"42831ec2217774244b7221b784d0d49c"
+					"e3aa212f2c02a4e035c17e2329aca12e"
+					"21d514b25466931c7d8f6a5aac84aa05"
+					"1ba30b396a0aac973d58e091",
+				.tag	= "5bc94fbc3221a5db94fae95ae7121a47"});
+
+			//Test case 5
+			check_GCM_case<crypto::AES_128>(GCM_TestCase{
+				.key	= gcm_key,
+				.iv		= "cafebabefacedbad",
+				.aad	= gcm_aad,
+				.plain	= gcm_plain_60,
+				.cipher	=
+					"61353b4c2806934a777ff51fa22a4755"
+					"699b2a714fcdc6f83766e5f97b6c7423"
+					"73806900e49f24b22b097544d4896b42"
+					"4989b5e1ebac0f07c23f4598",
+				.tag	= "3612d2e79e3b0785561be14aaca2fccb"});
+
+			//Test case 6
+			check_GCM_case<crypto::AES_128>(GCM_TestCase{
+				.key	= gcm_key,
+				.iv		=
+					"9313225df88406e555909c5aff5269aa"
+					"6a7a9538534f7da1e4c303d2a318a728"
+					"c3c0c95156809539fcf0e2429a6b5254"
+					"16aedbf5a0de6a57a637b39b",
+				.aad	= gcm_aad,
+				.plain	= gcm_plain_60,
+				.cipher	=
+					"8ce24998625615b603a033aca13fb894"
+					"be9112a5c3a211a8ba262a3cca7e2ca7"
+					"01e4a9a4fba43c90ccdcb281d48c7c6f"
+					"d62875d2aca417034c34aee5",
+				.tag	= "619cc5aefffe0bfa462af43c1699d050"});
+
+			//Test case 7
+			check_GCM_case<crypto::AES_192>(GCM_TestCase{
+				.key	= "000000000000000000000000000000000000000000000000",
+				.iv		= "000000000000000000000000",
+				.tag	= "cd33b28ac773f74ba00ed1f312572435"});
+
+			//Test case 8
+			check_GCM_case<crypto::AES_192>(GCM_TestCase{
+				.key	= "000000000000000000000000000000000000000000000000",
+				.iv		= "000000000000000000000000",
+				.plain	= "00000000000000000000000000000000",
+				.cipher	= "98e7247c07f0fe411c267e4384b0f600",
+				.tag	= "2ff58d80033927ab8ef4d4587514f0fb"});
+
+			//Test case 13
+			check_GCM_case<crypto::AES_256>(GCM_TestCase{
+				.key	= "0000000000000000000000000000000000000000000000000000000000000000",
+				.iv		= "000000000000000000000000",
+				.tag	= "530f8afbc74536b9a963b4f1c4cb738b"});
+
+			//Test case 14
+			check_GCM_case<crypto::AES_256>(GCM_TestCase{
+				.key	= "0000000000000000000000000000000000000000000000000000000000000000",
+				.iv		= "000000000000000000000000",
+				.plain	= "00000000000000000000000000000000",
+				.cipher	= "cea7403d4d606b6e074ec5d3baf39d18",
+				.tag	= "d0d1c8a799996bf0265b98b5d48ab919"});
+
+			//Test case 15
+			check_GCM_case<crypto::AES_256>(GCM_TestCase{
+				.key	= "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+				.iv		= gcm_iv,
+				.plain	= gcm_plain,
+				.cipher	=
+					"522dc1f099567d07f47f37a32a84427d"
+					"643a8cdcbfe5c0c97598a2bd2555d1aa"
+					"8cb08e48590dbb3da7b08b1056828838"
+					"c5f61e6393ba7a0abcc9f662898015ad",
+				.tag	= "b094dac5d93471bdec1a502270e3cc6c"});
+
+			//Test case 16
+			check_GCM_case<crypto::AES_256>(GCM_TestCase{
+				.key	= "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+				.iv		= gcm_iv,
+				.aad	= gcm_aad,
+				.plain	= gcm_plain_60,
+				.cipher	=
+					"522dc1f099567d07f47f37a32a84427d"
+					"643a8cdcbfe5c0c97598a2bd2555d1aa"
+					"8cb08e48590dbb3da7b08b1056828838"
+					"c5f61e6393ba7a0abcc9f662",
+				.tag	= "76fc6ece0f4e1768cddf8853bb2d551b"});
+		});
+
+	check_GCM_stream<crypto::AES_128>();
+	check_GCM_stream<crypto::AES_192>();
+	check_GCM_stream<crypto::AES_256>();
+}
+
+TEST(codec_symmetric, AES_GCM_parallel)
+{
+	crypto::worker_pool pool(4);
+
+	testUtils::for_each_AES_engine([&]
+		{
+			check_GCM_parallel<crypto::AES_128>(pool);
+			check_GCM_parallel<crypto::AES_256>(pool);
+		});
+}
+
+//	Note: The oversized spans are never accessed, the size is rejected before any data is touched.
+TEST(codec_symmetric, AES_GCM_limit)
+{
+	using GCM_t = crypto::AES_GCM<crypto::AES_128>;
+
+	if constexpr(sizeof(uintptr_t) >= sizeof(uint64_t))
+	{
+		crypto::AES_128::key_schedule_t tkey_schedule;
+		crypto::AES_128::make_key_schedule(std::array<uint8_t, crypto::AES_128::key_lenght>{}, tkey_schedule);
+		const std::array<uint8_t, 12> iv{};
+
+		GCM_t engine;
+		engine.set_key(tkey_schedule);
+
+		constexpr std::array<uint8_t, 32> zero{};
+		std::array<uint8_t, 32> buffer{};
+		ASSERT_TRUE(engine.reset(iv));
+		ASSERT_FALSE(engine.encode(std::span<uint8_t>{buffer.data(), static_cast<uintptr_t>(GCM_t::max_data_size + 1)}));
+		ASSERT_TRUE(buffer == zero);
+
+		ASSERT_TRUE(engine.encode(std::span<uint8_t>{buffer.data(), 17}));
+		ASSERT_FALSE(engine.decode(std::span<uint8_t>{buffer.data(), static_cast<uintptr_t>(GCM_t::max_data_size - 16)}));
+
+		crypto::worker_pool pool(2);
+		ASSERT_FALSE(engine.encode(pool, std::span<const uint8_t>{buffer.data(), static_cast<uintptr_t>(GCM_t::max_data_size - 16)}, buffer));
+
+		const std::array<std::span<uint8_t>, 2> buffers
+		{
+			std::span<uint8_t>{buffer.data(), 15},
+			std::span<uint8_t>{buffer.data(), static_cast<uintptr_t>(GCM_t::max_data_size - 31)},
+		};
+		ASSERT_FALSE(engine.encode(buffers));
+		ASSERT_TRUE(engine.encode(std::span<uint8_t>{buffer.data(), 15}));
+	}
+}
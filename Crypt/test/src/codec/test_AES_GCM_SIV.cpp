@@ -0,0 +1,225 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <random>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_GCM_SIV.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	struct GCM_SIV_TestCase
+	{
+		std::string_view key;
+		std::string_view nonce;
+		std::string_view aad {};
+		std::string_view plain {};
+		std::string_view result;	//!< Cipher text followed by the tag
+	};
+
+	template<typename AES_t>
+	void check_GCM_SIV_case(const GCM_SIV_TestCase& p_case)
+	{
+		using SIV_t = crypto::AES_GCM_SIV<AES_t>;
+		constexpr uintptr_t key_lenght = AES_t::key_lenght;
+
+		const std::vector<uint8_t> key		= testUtils::hex_data(p_case.key);
+		const std::vector<uint8_t> nonce	= testUtils::hex_data(p_case.nonce);
+		const std::vector<uint8_t> aad		= testUtils::hex_data(p_case.aad);
+		const std::vector<uint8_t> plain	= testUtils::hex_data(p_case.plain);
+		const std::vector<uint8_t> result	= testUtils::hex_data(p_case.result);
+		ASSERT_EQ(key.size(), key_lenght);
+		ASSERT_EQ(nonce.size(), SIV_t::nonce_lenght);
+		ASSERT_EQ(result.size(), plain.size() + SIV_t::tag_lenght);
+
+		const std::span<const uint8_t, SIV_t::nonce_lenght> tnonce{nonce.data(), SIV_t::nonce_lenght};
+		const std::vector<uint8_t> cipher{result.begin(), result.end() - SIV_t::tag_lenght};
+		typename SIV_t::tag_t tag;
+		std::copy(result.end() - SIV_t::tag_lenght, result.end(), tag.begin());
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{key.data(), key_lenght}, tkey_schedule);
+
+		SIV_t engine;
+		engine.set_key(tkey_schedule);
+
+		std::vector<uint8_t> buffer(plain.size());
+		typename SIV_t::tag_t out_tag;
+		ASSERT_TRUE(engine.encode(tnonce, aad, plain, buffer, out_tag));
+		ASSERT_TRUE(buffer == cipher)
+			<< "\n  Actual: " << testPrint{buffer}
+			<< "\nExpected: " << testPrint{cipher};
+		ASSERT_TRUE(out_tag == tag)
+			<< "\n  Actual: " << testPrint{out_tag}
+			<< "\nExpected: " << testPrint{tag};
+
+		//in place
+		ASSERT_TRUE(engine.decode(tnonce, aad, buffer, buffer, tag));
+		ASSERT_TRUE(buffer == plain)
+			<< "\n  Actual: " << testPrint{buffer}
+			<< "\nExpected: " << testPrint{plain};
+
+		tag[3] ^= 0x20;
+		buffer = cipher;
+		ASSERT_FALSE(engine.decode(tnonce, aad, buffer, buffer, tag));
+		ASSERT_TRUE(std::all_of(buffer.begin(), buffer.end(), [](const uint8_t p_val){ return p_val == 0; }));
+	}
+
+	//	Note: Sizes around the 8 and 16 block groups and the decode chunks.
+	//	Every engine is compared against the software engine.
+	template<typename AES_t>
+	void check_GCM_SIV_stream()
+	{
+		using SIV_t = crypto::AES_GCM_SIV<AES_t>;
+		constexpr uintptr_t key_lenght = AES_t::key_lenght;
+		constexpr std::array<uintptr_t, 9> sizes{1, 15, 16, 127, 128, 257, 1024, 1041, 5000};
+
+		std::mt19937 gen(0x8452);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+		std::array<uint8_t, key_lenght> key;
+		std::array<uint8_t, SIV_t::nonce_lenght> nonce;
+		std::vector<uint8_t> aad(333);
+		std::vector<uint8_t> data(sizes.back());
+		for(uint8_t& tbyte : key)	tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : nonce)	tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : aad)	tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : data)	tbyte = static_cast<uint8_t>(distrib(gen));
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(key, tkey_schedule);
+
+		std::array<std::vector<uint8_t>, sizes.size()> expected;
+		std::array<typename SIV_t::tag_t, sizes.size()> expected_tag;
+		{
+			ASSERT_TRUE(crypto::AES_set_engine(crypto::AES_engine::software));
+			SIV_t engine;
+			engine.set_key(tkey_schedule);
+			for(uintptr_t i = 0; i < sizes.size(); ++i)
+			{
+				expected[i].resize(sizes[i]);
+				ASSERT_TRUE(engine.encode(nonce, aad, std::span<const uint8_t>{data.data(), sizes[i]}, expected[i], expected_tag[i]));
+			}
+		}
+
+		testUtils::for_each_AES_engine([&]
+			{
+				SIV_t engine;
+				engine.set_key(tkey_schedule);
+				for(uintptr_t i = 0; i < sizes.size(); ++i)
+				{
+					SCOPED_TRACE(sizes[i]);
+					std::vector<uint8_t> buffer{data.begin(), data.begin() + sizes[i]};
+					typename SIV_t::tag_t tag;
+					ASSERT_TRUE(engine.encode(nonce, aad, buffer, buffer, tag));
+					ASSERT_TRUE(buffer == expected[i]);
+					ASSERT_TRUE(tag == expected_tag[i]);
+
+					ASSERT_TRUE(engine.decode(nonce, aad, buffer, buffer, tag));
+					ASSERT_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin()));
+
+					buffer = expected[i];
+					buffer[sizes[i] / 2] ^= 0x01;
+					ASSERT_FALSE(engine.decode(nonce, aad, buffer, buffer, tag));
+				}
+
+				std::array<uint8_t, 4> small;
+				typename SIV_t::tag_t tag;
+				ASSERT_FALSE(engine.encode(nonce, aad, std::span<const uint8_t>{data.data(), 5}, small, tag));
+			});
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_GCM_SIV)
+{
+	testUtils::for_each_AES_engine([&]
+		{
+			//RFC 8452 C.1
+			check_GCM_SIV_case<crypto::AES_128>(GCM_SIV_TestCase{
+				.key	= "01000000000000000000000000000000",
+				.nonce	= "030000000000000000000000",
+				.result	= "dc20e2d83f25705bb49e439eca56de25"});
+
+			check_GCM_SIV_case<crypto::AES_128>(GCM_SIV_TestCase{
+				.key	= "01000000000000000000000000000000",
+				.nonce	= "030000000000000000000000",
+				.plain	= "0100000000000000",
+				.result	= "b5d839330ac7b786578782fff6013b815b287c22493a364c"});
+
+			check_GCM_SIV_case<crypto::AES_128>(GCM_SIV_TestCase{
+				.key	= "01000000000000000000000000000000",
+				.nonce	= "030000000000000000000000",
+				.plain	= "0100000000000000000000000000000002000000000000000000000000000000",
+				.result	= "84e07e62ba83a6585417245d7ec413a9fe427d6315c09b57ce45f2e3936a94451a8e45dcd4578c667cd86847bf6155ff"});
+
+			check_GCM_SIV_case<crypto::AES_128>(GCM_SIV_TestCase{
+				.key	= "01000000000000000000000000000000",
+				.nonce	= "030000000000000000000000",
+				.aad	= "01",
+				.plain	= "0200000000000000",
+				.result	= "1e6daba35669f4273b0a1a2560969cdf790d99759abd1508"});
+
+			//RFC 8452 C.2
+			check_GCM_SIV_case<crypto::AES_256>(GCM_SIV_TestCase{
+				.key	= "0100000000000000000000000000000000000000000000000000000000000000",
+				.nonce	= "030000000000000000000000",
+				.result	= "07f5f4169bbf55a8400cd47ea6fd400f"});
+
+			check_GCM_SIV_case<crypto::AES_256>(GCM_SIV_TestCase{
+				.key	= "0100000000000000000000000000000000000000000000000000000000000000",
+				.nonce	= "030000000000000000000000",
+				.plain	= "0100000000000000",
+				.result	= "c2ef328e5c71c83b843122130f7364b761e0b97427e3df28"});
+
+			//RFC 8452 C.3, the counter wraps around
+			check_GCM_SIV_case<crypto::AES_256>(GCM_SIV_TestCase{
+				.key	= "0000000000000000000000000000000000000000000000000000000000000000",
+				.nonce	= "000000000000000000000000",
+				.plain	= "000000000000000000000000000000004db923dc793ee6497c76dcc03a98e108",
+				.result	= "f3f80f2cf0cb2dd9c5984fcda908456cc537703b5ba70324a6793a7bf218d3eaffffffff000000000000000000000000"});
+
+			check_GCM_SIV_case<crypto::AES_256>(GCM_SIV_TestCase{
+				.key	= "0000000000000000000000000000000000000000000000000000000000000000",
+				.nonce	= "000000000000000000000000",
+				.plain	= "eb3640277c7ffd1303c7a542d02d3e4c0000000000000000",
+				.result	= "18ce4f0b8cb4d0cac65fea8f79257b20888e53e72299e56dffffffff000000000000000000000000"});
+		});
+
+	check_GCM_SIV_stream<crypto::AES_128>();
+	check_GCM_SIV_stream<crypto::AES_256>();
+}
@@ -0,0 +1,193 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_GCM_file.hpp>
+#include <Crypt/worker_pool.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	using AES_t		= crypto::AES_256;
+	using GCM_t		= crypto::AES_GCM<AES_t>;
+	using file_t	= crypto::AES_GCM_file<AES_t>;
+
+	//	Note: Files live in the system temporary directory and are removed when the test ends.
+	struct temp_files
+	{
+		std::filesystem::path plain		= std::filesystem::temp_directory_path() / "crypt_test_gcm_file_plain.bin";
+		std::filesystem::path cipher	= std::filesystem::temp_directory_path() / "crypt_test_gcm_file_cipher.bin";
+		std::filesystem::path decoded	= std::filesystem::temp_directory_path() / "crypt_test_gcm_file_decoded.bin";
+
+		~temp_files()
+		{
+			std::error_code error;
+			std::filesystem::remove(plain, error);
+			std::filesystem::remove(cipher, error);
+			std::filesystem::remove(decoded, error);
+		}
+	};
+
+	void write_file(const std::filesystem::path& p_path, const std::vector<uint8_t>& p_data)
+	{
+		std::ofstream stream(p_path, std::ios::binary | std::ios::trunc);
+		stream.write(reinterpret_cast<const char*>(p_data.data()), static_cast<std::streamsize>(p_data.size()));
+	}
+
+	std::vector<uint8_t> read_file(const std::filesystem::path& p_path)
+	{
+		std::ifstream stream(p_path, std::ios::binary);
+		return std::vector<uint8_t>{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+	}
+
+	struct GCM_file_context
+	{
+		AES_t::key_schedule_t		wkey;
+		std::array<uint8_t, 12>		iv;
+		std::array<uint8_t, 19>		aad;
+	};
+
+	void check_GCM_file(const GCM_file_context& p_context, const std::vector<uint8_t>& p_data, const file_t::options_t& p_options)
+	{
+		temp_files files;
+
+		std::vector<uint8_t> expected(p_data.size());
+		{
+			GCM_t engine;
+			engine.set_key(p_context.wkey);
+			engine.reset(p_context.iv);
+			engine.update_aad(p_context.aad);
+			engine.encode(p_data, expected);
+			engine.finalize();
+			expected.insert(expected.end(), engine.tag().begin(), engine.tag().end());
+		}
+
+		write_file(files.plain, p_data);
+		ASSERT_TRUE(file_t::encode(p_context.wkey, p_context.iv, p_context.aad, files.plain, files.cipher, p_options));
+		ASSERT_TRUE(read_file(files.cipher) == expected);
+		ASSERT_FALSE(std::filesystem::exists(std::filesystem::path{files.cipher} += ".part"));
+
+		ASSERT_TRUE(file_t::decode(p_context.wkey, p_context.iv, p_context.aad, files.cipher, files.decoded, p_options));
+		ASSERT_TRUE(read_file(files.decoded) == p_data);
+
+		//tampered cipher text, the previous output is left untouched and the partial plain text is removed
+		std::vector<uint8_t> tampered = expected;
+		tampered[tampered.size() / 2] ^= 0x01;
+		write_file(files.cipher, tampered);
+		ASSERT_FALSE(file_t::decode(p_context.wkey, p_context.iv, p_context.aad, files.cipher, files.decoded, p_options));
+		ASSERT_TRUE(read_file(files.decoded) == p_data);
+		ASSERT_FALSE(std::filesystem::exists(std::filesystem::path{files.decoded} += ".part"));
+
+		std::error_code error;
+		std::filesystem::remove(files.decoded, error);
+		ASSERT_FALSE(file_t::decode(p_context.wkey, p_context.iv, p_context.aad, files.cipher, files.decoded, p_options));
+		ASSERT_FALSE(std::filesystem::exists(files.decoded));
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_GCM_file)
+{
+	std::mt19937 gen(0xF1);
+	std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+	GCM_file_context context;
+	{
+		std::array<uint8_t, AES_t::key_lenght> key;
+		for(uint8_t& tbyte : key) tbyte = static_cast<uint8_t>(distrib(gen));
+		AES_t::make_key_schedule(key, context.wkey);
+	}
+	for(uint8_t& tbyte : context.iv) tbyte = static_cast<uint8_t>(distrib(gen));
+	for(uint8_t& tbyte : context.aad) tbyte = static_cast<uint8_t>(distrib(gen));
+
+	constexpr uintptr_t chunk_size = 4096;
+
+	for(const bool memory_map : {true, false})
+	{
+		SCOPED_TRACE(memory_map);
+
+		//more chunks than buffers, partial chunks and blocks
+		for(const uintptr_t size : {uintptr_t{0}, uintptr_t{1}, chunk_size - 1, chunk_size, chunk_size * 11 + 17})
+		{
+			SCOPED_TRACE(size);
+			std::vector<uint8_t> data(size);
+			for(uint8_t& tbyte : data) tbyte = static_cast<uint8_t>(distrib(gen));
+
+			check_GCM_file(context, data, file_t::options_t{.chunk_size = chunk_size, .buffer_count = 3, .memory_map = memory_map});
+		}
+
+		//chunks split across a pool
+		{
+			crypto::worker_pool pool(3);
+			std::vector<uint8_t> data(GCM_t::parallel_chunk * 5 + 100);
+			for(uint8_t& tbyte : data) tbyte = static_cast<uint8_t>(distrib(gen));
+
+			check_GCM_file(context, data, file_t::options_t{.chunk_size = GCM_t::parallel_chunk * 2 + 16, .buffer_count = 3, .memory_map = memory_map, .pool = &pool});
+		}
+	}
+
+	//invalid use
+	{
+		temp_files files;
+		write_file(files.plain, std::vector<uint8_t>(10));
+
+		ASSERT_FALSE(file_t::encode(context.wkey, {}, context.aad, files.plain, files.cipher));
+		ASSERT_FALSE(file_t::encode(context.wkey, context.iv, context.aad, files.plain, files.cipher, file_t::options_t{.chunk_size = 0}));
+		ASSERT_FALSE(file_t::encode(context.wkey, context.iv, context.aad, files.plain, files.cipher, file_t::options_t{.chunk_size = 4097}));
+		ASSERT_FALSE(file_t::encode(context.wkey, context.iv, context.aad, files.plain, files.cipher, file_t::options_t{.buffer_count = 0}));
+		ASSERT_FALSE(file_t::encode(context.wkey, context.iv, context.aad, files.plain, files.cipher, file_t::options_t{.chunk_size = file_t::max_ring_size, .buffer_count = 2}));
+		ASSERT_FALSE(file_t::encode(context.wkey, context.iv, context.aad, files.plain, files.cipher, file_t::options_t{.chunk_size = ~uintptr_t{15}, .buffer_count = 0xFFFFFFFF}));
+		ASSERT_FALSE(std::filesystem::exists(files.cipher));
+
+		//same file as input and output, the input is left intact
+		for(const bool memory_map : {true, false})
+		{
+			ASSERT_FALSE(file_t::encode(context.wkey, context.iv, context.aad, files.plain, files.plain, file_t::options_t{.memory_map = memory_map}));
+			ASSERT_TRUE(read_file(files.plain) == std::vector<uint8_t>(10));
+		}
+
+		//shorter than the tag
+		ASSERT_FALSE(file_t::decode(context.wkey, context.iv, context.aad, files.plain, files.decoded));
+
+		std::error_code error;
+		std::filesystem::remove(files.plain, error);
+		ASSERT_FALSE(file_t::encode(context.wkey, context.iv, context.aad, files.plain, files.cipher));
+		ASSERT_FALSE(file_t::encode(context.wkey, context.iv, context.aad, files.plain, files.cipher, file_t::options_t{.memory_map = false}));
+	}
+}
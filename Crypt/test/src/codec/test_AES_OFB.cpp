@@ -0,0 +1,282 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_OFB.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	struct OFB_TestCase
+	{
+		std::string_view key;
+		std::string_view iv;
+		std::string_view plain;
+		std::string_view cipher;
+	};
+
+	//NIST SP 800-38A F.4
+	constexpr std::string_view sp800_38a_iv = "000102030405060708090a0b0c0d0e0f";
+	constexpr std::string_view sp800_38a_plain =
+		"6bc1bee22e409f96e93d7e117393172a"
+		"ae2d8a571e03ac9c9eb76fac45af8e51"
+		"30c81c46a35ce411e5fbc1191a0a52ef"
+		"f69f2445df4f9b17ad2b417be66c3710";
+
+	template<typename AES_t>
+	void check_OFB_case(const OFB_TestCase& p_case)
+	{
+		using OFB_t = crypto::AES_OFB<AES_t>;
+		using buffer_t = crypto::AES_OFB_buffer<AES_t>;
+		constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+
+		const std::vector<uint8_t> key		= testUtils::hex_data(p_case.key);
+		const std::vector<uint8_t> iv		= testUtils::hex_data(p_case.iv);
+		const std::vector<uint8_t> plain	= testUtils::hex_data(p_case.plain);
+		const std::vector<uint8_t> cipher	= testUtils::hex_data(p_case.cipher);
+		ASSERT_EQ(key.size(), key_lenght);
+		ASSERT_EQ(iv.size(), block_lenght);
+		ASSERT_EQ(plain.size(), cipher.size());
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{key.data(), key_lenght}, tkey_schedule);
+		const std::span<const uint8_t, block_lenght> tiv{iv.data(), block_lenght};
+
+		OFB_t engine;
+
+		//every split point, in place
+		for(uintptr_t split = 0; split <= plain.size(); ++split)
+		{
+			std::vector<uint8_t> buffer = cipher;
+			engine.reset(tkey_schedule, tiv);
+			engine.update(std::span<uint8_t>{buffer.data(), split});
+			engine.update(std::span<uint8_t>{buffer.data() + split, buffer.size() - split});
+			ASSERT_TRUE(buffer == plain) << "Split " << split
+				<< "\n  Actual: " << testPrint{buffer}
+				<< "\nExpected: " << testPrint{plain};
+		}
+
+		//key stream split at every point
+		for(uintptr_t split = 0; split <= plain.size(); ++split)
+		{
+			std::vector<uint8_t> key_stream(plain.size());
+			engine.reset(tkey_schedule, tiv);
+			engine.key_stream(std::span<uint8_t>{key_stream.data(), split});
+			engine.key_stream(std::span<uint8_t>{key_stream.data() + split, key_stream.size() - split});
+			for(uintptr_t i = 0; i < key_stream.size(); ++i)
+			{
+				key_stream[i] ^= plain[i];
+			}
+			ASSERT_TRUE(key_stream == cipher) << "Split " << split;
+		}
+
+		//buffered, smaller than the message so that it wraps around
+		{
+			buffer_t buffered{40};
+			buffered.reset(tkey_schedule, tiv);
+			std::vector<uint8_t> buffer = plain;
+			ASSERT_FALSE(buffered.update(std::span<uint8_t>{buffer.data(), 1}));
+			ASSERT_EQ(buffered.fill(), 48);
+			ASSERT_EQ(buffered.fill(), 0);
+			ASSERT_FALSE(buffered.update(std::span<uint8_t>{buffer.data(), 49}));
+			ASSERT_TRUE(buffered.update(std::span<uint8_t>{buffer.data(), 37}));
+			ASSERT_EQ(buffered.available(), 11);
+			ASSERT_EQ(buffered.fill(), 37);
+			ASSERT_TRUE(buffered.update(std::span<uint8_t>{buffer.data() + 37, 27}));
+			ASSERT_EQ(buffered.available(), 21);
+			ASSERT_TRUE(buffered.update(std::span<uint8_t>{buffer.data() + 64, 0}));
+			ASSERT_TRUE(buffer == cipher)
+				<< "\n  Actual: " << testPrint{buffer}
+				<< "\nExpected: " << testPrint{cipher};
+		}
+	}
+
+	//	Note: Long enough to take several chunks of key stream, compared against single block encodes.
+	template<typename AES_t>
+	void check_OFB_stream()
+	{
+		using OFB_t = crypto::AES_OFB<AES_t>;
+		constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+		constexpr uintptr_t data_size		= 3000;
+
+		std::mt19937 gen(0x0F);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+		std::array<uint8_t, key_lenght> key;
+		std::array<uint8_t, block_lenght> iv;
+		for(uint8_t& tbyte : key) tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : iv) tbyte = static_cast<uint8_t>(distrib(gen));
+
+		std::vector<uint8_t> data(data_size);
+		for(uint8_t& tbyte : data) tbyte = static_cast<uint8_t>(distrib(gen));
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		AES_t::make_key_schedule(key, tkey_schedule);
+
+		std::vector<uint8_t> expected(data_size);
+		{
+			std::array<uint8_t, block_lenght> key_stream = iv;
+			for(uintptr_t i = 0; i < data_size; i += block_lenght)
+			{
+				AES_t::encode(tkey_schedule, key_stream, key_stream);
+				for(uintptr_t j = 0; j < block_lenght && i + j < data_size; ++j)
+				{
+					expected[i + j] = data[i + j] ^ key_stream[j];
+				}
+			}
+		}
+
+		std::uniform_int_distribution<uintptr_t> split_distrib(0, 1200);
+
+		OFB_t engine;
+		engine.reset(tkey_schedule, iv);
+		std::vector<uint8_t> encoded(data_size);
+		for(uintptr_t pos = 0; pos < data_size;)
+		{
+			const uintptr_t count = std::min(split_distrib(gen), data_size - pos);
+			engine.update(std::span<const uint8_t>{data.data() + pos, count}, std::span<uint8_t>{encoded.data() + pos, count});
+			pos += count;
+		}
+		ASSERT_TRUE(encoded == expected);
+
+		engine.reset(tkey_schedule, iv);
+		engine.update(encoded);
+		ASSERT_TRUE(encoded == data);
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_OFB)
+{
+	testUtils::for_each_AES_engine([&]
+		{
+			check_OFB_case<crypto::AES_128>(OFB_TestCase{
+				.key	= "2b7e151628aed2a6abf7158809cf4f3c",
+				.iv		= sp800_38a_iv,
+				.plain	= sp800_38a_plain,
+				.cipher	=
+					"3b3fd92eb72dad20333449f8e83cfb4a"
+					"7789508d16918f03f53c52dac54ed825"
+					"9740051e9c5fecf64344f7a82260edcc"
+					"304c6528f659c77866a510d9c1d6ae5e"});
+
+			check_OFB_case<crypto::AES_192>(OFB_TestCase{
+				.key	= "8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b",
+				.iv		= sp800_38a_iv,
+				.plain	= sp800_38a_plain,
+				.cipher	=
+					"cdc80d6fddf18cab34c25909c99a4174"
+					"fcc28b8d4c63837c09e81700c1100401"
+					"8d9a9aeac0f6596f559c6d4daf59a5f2"
+					"6d9f200857ca6c3e9cac524bd9acc92a"});
+
+			check_OFB_case<crypto::AES_256>(OFB_TestCase{
+				.key	= "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4",
+				.iv		= sp800_38a_iv,
+				.plain	= sp800_38a_plain,
+				.cipher	=
+					"dc7e84bfda79164b7ecd8486985d3860"
+					"4febdc6740d20b3ac88f6ad82a4fb08d"
+					"71ab47a086e86eedf39d1c5bba97c408"
+					"0126141d67f37be8538f5a8be740e484"});
+
+			check_OFB_stream<crypto::AES_128>();
+			check_OFB_stream<crypto::AES_192>();
+			check_OFB_stream<crypto::AES_256>();
+		});
+}
+
+//	Note: A background thread keeps the buffer full while records of random sizes are encoded as soon as there is enough key stream.
+TEST(codec_symmetric, AES_OFB_buffer_thread)
+{
+	using AES_t = crypto::AES_256;
+	constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+	constexpr uintptr_t data_size		= 200000;
+
+	std::mt19937 gen(0xBF);
+	std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+	std::array<uint8_t, AES_t::key_lenght> key;
+	std::array<uint8_t, block_lenght> iv;
+	for(uint8_t& tbyte : key) tbyte = static_cast<uint8_t>(distrib(gen));
+	for(uint8_t& tbyte : iv) tbyte = static_cast<uint8_t>(distrib(gen));
+
+	std::vector<uint8_t> data(data_size);
+	for(uint8_t& tbyte : data) tbyte = static_cast<uint8_t>(distrib(gen));
+
+	AES_t::key_schedule_t tkey_schedule;
+	AES_t::make_key_schedule(key, tkey_schedule);
+
+	crypto::AES_OFB<AES_t> engine;
+	engine.reset(tkey_schedule, iv);
+	std::vector<uint8_t> expected(data_size);
+	engine.update(data, expected);
+
+	crypto::AES_OFB_buffer<AES_t> buffered{4096};
+	buffered.reset(tkey_schedule, iv);
+
+	std::atomic<bool> done = false;
+	std::thread producer{[&]()
+		{
+			while(!done.load(std::memory_order_relaxed))
+			{
+				if(!buffered.fill()) std::this_thread::yield();
+			}
+		}};
+
+	std::uniform_int_distribution<uintptr_t> split_distrib(0, 1500);
+	std::vector<uint8_t> encoded = data;
+	for(uintptr_t pos = 0; pos < data_size;)
+	{
+		const uintptr_t count = std::min(split_distrib(gen), data_size - pos);
+		while(!buffered.update(std::span<uint8_t>{encoded.data() + pos, count}))
+		{
+			std::this_thread::yield();
+		}
+		pos += count;
+	}
+
+	done.store(true, std::memory_order_relaxed);
+	producer.join();
+
+	ASSERT_TRUE(encoded == expected);
+}
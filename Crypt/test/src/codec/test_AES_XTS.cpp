@@ -0,0 +1,272 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <random>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_XTS.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	struct XTS_TestCase
+	{
+		std::string_view key1;
+		std::string_view key2;
+		std::string_view tweak;
+		std::string_view plain;
+		std::string_view cipher;
+	};
+
+	template<typename AES_t>
+	void check_XTS_case(const XTS_TestCase& p_case)
+	{
+		using XTS_t = crypto::AES_XTS<AES_t>;
+		constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+
+		const std::vector<uint8_t> key1		= testUtils::hex_data(p_case.key1);
+		const std::vector<uint8_t> key2		= testUtils::hex_data(p_case.key2);
+		const std::vector<uint8_t> tweak	= testUtils::hex_data(p_case.tweak);
+		const std::vector<uint8_t> plain	= testUtils::hex_data(p_case.plain);
+		const std::vector<uint8_t> cipher	= testUtils::hex_data(p_case.cipher);
+		ASSERT_EQ(key1.size(), key_lenght);
+		ASSERT_EQ(key2.size(), key_lenght);
+		ASSERT_EQ(tweak.size(), block_lenght);
+		ASSERT_EQ(plain.size(), cipher.size());
+
+		typename AES_t::key_schedule_t tkey1;
+		typename AES_t::key_schedule_t tkey2;
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{key1.data(), key_lenght}, tkey1);
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{key2.data(), key_lenght}, tkey2);
+
+		XTS_t engine;
+		if(key1 == key2)
+		{
+			//IEEE 1619 vector 1 uses the same all zero key for data and tweak, which is not allowed
+			ASSERT_FALSE(engine.set_key(tkey1, tkey2));
+			return;
+		}
+		ASSERT_TRUE(engine.set_key(tkey1, tkey2));
+
+		std::vector<uint8_t> buffer(plain.size());
+		ASSERT_TRUE(engine.encode(std::span<const uint8_t, block_lenght>{tweak.data(), block_lenght}, plain, buffer));
+		ASSERT_TRUE(buffer == cipher)
+			<< "\n  Actual: " << testPrint{buffer}
+			<< "\nExpected: " << testPrint{cipher};
+
+		ASSERT_TRUE(engine.decode(std::span<const uint8_t, block_lenght>{tweak.data(), block_lenght}, buffer, buffer));
+		ASSERT_TRUE(buffer == plain)
+			<< "\n  Actual: " << testPrint{buffer}
+			<< "\nExpected: " << testPrint{plain};
+
+		//the same key for data and tweak is rejected, the previous keys stay in use
+		ASSERT_FALSE(engine.set_key(tkey1, tkey1));
+		ASSERT_FALSE(engine.set_key(tkey2, tkey2));
+		ASSERT_TRUE(engine.decode(std::span<const uint8_t, block_lenght>{tweak.data(), block_lenght}, cipher, buffer));
+		ASSERT_TRUE(buffer == plain);
+	}
+
+	//	Note: Straight from the definition, one block at a time.
+	template<typename AES_t>
+	void reference_XTS(
+		const typename AES_t::key_schedule_t& p_key1, const typename AES_t::key_schedule_t& p_key2,
+		uint64_t p_sector, const uint8_t* p_input, uint8_t* p_out, uintptr_t p_size)
+	{
+		constexpr uintptr_t block_lenght = AES_t::block_lenght;
+
+		std::array<uint8_t, block_lenght> tweak{0};
+		for(uintptr_t i = 0; i < 8; ++i)
+		{
+			tweak[i] = static_cast<uint8_t>(p_sector >> (i * 8));
+		}
+		AES_t::encode(p_key2, tweak, tweak);
+
+		const auto code_block = [&](const uint8_t* p_in, uint8_t* p_o, const std::array<uint8_t, block_lenght>& p_tweak)
+		{
+			std::array<uint8_t, block_lenght> block;
+			for(uintptr_t j = 0; j < block_lenght; ++j) block[j] = p_in[j] ^ p_tweak[j];
+			AES_t::encode(p_key1, block, block);
+			for(uintptr_t j = 0; j < block_lenght; ++j) p_o[j] = block[j] ^ p_tweak[j];
+		};
+
+		const auto double_tweak = [](std::array<uint8_t, block_lenght>& p_tweak)
+		{
+			uint8_t carry = 0;
+			for(uint8_t& tbyte : p_tweak)
+			{
+				const uint8_t next = tbyte >> 7;
+				tbyte = static_cast<uint8_t>((tbyte << 1) | carry);
+				carry = next;
+			}
+			if(carry) p_tweak[0] ^= 0x87;
+		};
+
+		const uintptr_t remainder = p_size % block_lenght;
+		const uintptr_t full = p_size / block_lenght;
+		for(uintptr_t i = 0; i < full; ++i)
+		{
+			code_block(p_input + i * block_lenght, p_out + i * block_lenght, tweak);
+			double_tweak(tweak);
+		}
+
+		if(remainder)
+		{
+			uint8_t* const last = p_out + (full - 1) * block_lenght;
+			std::array<uint8_t, block_lenght> stolen;
+			for(uintptr_t j = 0; j < block_lenght; ++j)
+			{
+				stolen[j] = j < remainder ? p_input[full * block_lenght + j] : last[j];
+			}
+			for(uintptr_t j = 0; j < remainder; ++j)
+			{
+				p_out[full * block_lenght + j] = last[j];
+			}
+			code_block(stolen.data(), last, tweak);
+		}
+	}
+
+	template<typename AES_t>
+	void check_XTS_sectors(const uintptr_t p_sector_size)
+	{
+		using XTS_t = crypto::AES_XTS<AES_t>;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+		constexpr uintptr_t sector_count	= 11;
+		constexpr uint64_t first_sector		= 0xFFFFFFFC;
+
+		std::mt19937 gen(0x75);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+		std::array<uint8_t, key_lenght> key1;
+		std::array<uint8_t, key_lenght> key2;
+		std::vector<uint8_t> data(sector_count * p_sector_size);
+		for(uint8_t& tbyte : key1) tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : key2) tbyte = static_cast<uint8_t>(distrib(gen));
+		for(uint8_t& tbyte : data) tbyte = static_cast<uint8_t>(distrib(gen));
+
+		typename AES_t::key_schedule_t tkey1;
+		typename AES_t::key_schedule_t tkey2;
+		AES_t::make_key_schedule(key1, tkey1);
+		AES_t::make_key_schedule(key2, tkey2);
+
+		std::vector<uint8_t> expected(data.size());
+		for(uintptr_t i = 0; i < sector_count; ++i)
+		{
+			reference_XTS<AES_t>(tkey1, tkey2, first_sector + i, data.data() + i * p_sector_size, expected.data() + i * p_sector_size, p_sector_size);
+		}
+
+		XTS_t engine;
+		ASSERT_TRUE(engine.set_key(tkey1, tkey2));
+
+		std::vector<uint8_t> buffer = data;
+		ASSERT_TRUE(engine.encode_sectors(first_sector, p_sector_size, buffer, buffer));
+		ASSERT_TRUE(buffer == expected) << "Sector size " << p_sector_size;
+
+		ASSERT_TRUE(engine.decode_sectors(first_sector, p_sector_size, buffer, buffer));
+		ASSERT_TRUE(buffer == data) << "Sector size " << p_sector_size;
+
+		ASSERT_FALSE(engine.encode_sectors(first_sector, p_sector_size, std::span<const uint8_t>{data.data(), data.size() - 1}, buffer));
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_XTS)
+{
+	testUtils::for_each_AES_engine([&]
+		{
+			//IEEE 1619 Annex B, Vector 1
+			check_XTS_case<crypto::AES_128>(XTS_TestCase{
+				.key1	= "00000000000000000000000000000000",
+				.key2	= "00000000000000000000000000000000",
+				.tweak	= "00000000000000000000000000000000",
+				.plain	= "0000000000000000000000000000000000000000000000000000000000000000",
+				.cipher	= "917cf69ebd68b2ec9b9fe9a3eadda692cd43d2f59598ed858c02c2652fbf922e"});
+
+			//Vector 2
+			check_XTS_case<crypto::AES_128>(XTS_TestCase{
+				.key1	= "11111111111111111111111111111111",
+				.key2	= "22222222222222222222222222222222",
+				.tweak	= "33333333330000000000000000000000",
+				.plain	= "4444444444444444444444444444444444444444444444444444444444444444",
+				.cipher	= "c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0"});
+
+			//Vector 3
+			check_XTS_case<crypto::AES_128>(XTS_TestCase{
+				.key1	= "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0",
+				.key2	= "22222222222222222222222222222222",
+				.tweak	= "33333333330000000000000000000000",
+				.plain	= "4444444444444444444444444444444444444444444444444444444444444444",
+				.cipher	= "af85336b597afc1a900b2eb21ec949d292df4c047e0b21532186a5971a227a89"});
+
+			//Vector 15
+			check_XTS_case<crypto::AES_128>(XTS_TestCase{
+				.key1	= "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0",
+				.key2	= "bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0",
+				.tweak	= "9a785634120000000000000000000000",
+				.plain	= "000102030405060708090a0b0c0d0e0f10",
+				.cipher	= "6c1625db4671522d3d7599601de7ca09ed"});
+
+			//Vector 16
+			check_XTS_case<crypto::AES_128>(XTS_TestCase{
+				.key1	= "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0",
+				.key2	= "bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0",
+				.tweak	= "9a785634120000000000000000000000",
+				.plain	= "000102030405060708090a0b0c0d0e0f1011",
+				.cipher	= "d069444b7a7e0cab09e24447d24deb1fedbf"});
+
+			//Vector 17
+			check_XTS_case<crypto::AES_128>(XTS_TestCase{
+				.key1	= "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0",
+				.key2	= "bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0",
+				.tweak	= "9a785634120000000000000000000000",
+				.plain	= "000102030405060708090a0b0c0d0e0f101112",
+				.cipher	= "e5df1351c0544ba1350b3363cd8ef4beedbf9d"});
+
+			//Vector 18
+			check_XTS_case<crypto::AES_128>(XTS_TestCase{
+				.key1	= "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0",
+				.key2	= "bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0",
+				.tweak	= "9a785634120000000000000000000000",
+				.plain	= "000102030405060708090a0b0c0d0e0f10111213",
+				.cipher	= "9d84c813f719aa2c7be3f66171c7c5c2edbf9dac"});
+
+			for(const uintptr_t sector_size : {16, 17, 31, 160, 527, 4096})
+			{
+				check_XTS_sectors<crypto::AES_128>(sector_size);
+				check_XTS_sectors<crypto::AES_256>(sector_size);
+			}
+		});
+}
@@ -0,0 +1,190 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Crypt/codec/AES_key_cache.hpp>
+
+namespace
+{
+	template<typename AES_t>
+	using raw_key_t = std::array<uint8_t, AES_t::key_lenght>;
+
+	template<typename AES_t>
+	std::vector<raw_key_t<AES_t>> random_keys(const uintptr_t p_count, const uint32_t p_seed)
+	{
+		std::mt19937 gen(p_seed);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+
+		std::vector<raw_key_t<AES_t>> keys(p_count);
+		for(raw_key_t<AES_t>& tkey : keys)
+		{
+			for(uint8_t& tbyte : tkey) tbyte = static_cast<uint8_t>(distrib(gen));
+		}
+		return keys;
+	}
+
+	template<typename AES_t>
+	bool same_schedule(const typename AES_t::key_schedule_t& p_1, const typename AES_t::key_schedule_t& p_2)
+	{
+		return memcmp(&p_1, &p_2, sizeof(p_1)) == 0;
+	}
+
+	template<typename AES_t>
+	void check_key_cache()
+	{
+		using cache_t = crypto::AES_key_cache<AES_t>;
+		using schedule_t = typename AES_t::key_schedule_t;
+
+		const std::vector<raw_key_t<AES_t>> keys = random_keys<AES_t>(40, 0xCAC4E);
+
+		cache_t cache{100};
+		ASSERT_EQ(cache.capacity(), 128);
+
+		schedule_t expected;
+		schedule_t cached;
+		for(const raw_key_t<AES_t>& tkey : keys)
+		{
+			AES_t::make_key_schedule(tkey, expected);
+			ASSERT_FALSE(cache.find(tkey, cached));
+			cache.get(tkey, cached);
+			ASSERT_TRUE(same_schedule<AES_t>(cached, expected));
+			ASSERT_TRUE(cache.find(tkey, cached));
+			ASSERT_TRUE(same_schedule<AES_t>(cached, expected));
+		}
+
+		cache.erase(keys[0]);
+		ASSERT_FALSE(cache.find(keys[0], cached));
+		ASSERT_TRUE(cache.find(keys[1], cached));
+
+		cache.clear();
+		for(const raw_key_t<AES_t>& tkey : keys)
+		{
+			ASSERT_FALSE(cache.find(tkey, cached));
+		}
+	}
+
+	//	Note: A single set, the key looked up since it was inserted survives the next eviction.
+	template<typename AES_t>
+	void check_key_cache_eviction()
+	{
+		using cache_t = crypto::AES_key_cache<AES_t>;
+		using schedule_t = typename AES_t::key_schedule_t;
+
+		const std::vector<raw_key_t<AES_t>> keys = random_keys<AES_t>(cache_t::ways * 3, 0xE71C7);
+
+		cache_t cache{1};
+		ASSERT_EQ(cache.capacity(), cache_t::ways);
+
+		schedule_t schedule;
+		for(uintptr_t i = 0; i < cache_t::ways; ++i)
+		{
+			cache.get(keys[i], schedule);
+		}
+
+		ASSERT_TRUE(cache.find(keys[0], schedule));
+		cache.get(keys[cache_t::ways], schedule);
+		ASSERT_TRUE(cache.find(keys[0], schedule));
+		ASSERT_FALSE(cache.find(keys[1], schedule));
+
+		for(const raw_key_t<AES_t>& tkey : keys)
+		{
+			cache.get(tkey, schedule);
+		}
+
+		uintptr_t cached = 0;
+		for(const raw_key_t<AES_t>& tkey : keys)
+		{
+			if(cache.find(tkey, schedule)) ++cached;
+		}
+		ASSERT_EQ(cached, cache_t::ways);
+		ASSERT_TRUE(cache.find(keys.back(), schedule));
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_key_cache)
+{
+	check_key_cache<crypto::AES_128>();
+	check_key_cache<crypto::AES_192>();
+	check_key_cache<crypto::AES_256>();
+
+	check_key_cache_eviction<crypto::AES_128>();
+	check_key_cache_eviction<crypto::AES_192>();
+	check_key_cache_eviction<crypto::AES_256>();
+}
+
+//	Note: More keys than the cache holds, so that lookups keep racing with evictions.
+TEST(codec_symmetric, AES_key_cache_thread)
+{
+	using AES_t = crypto::AES_256;
+	using schedule_t = AES_t::key_schedule_t;
+	constexpr uintptr_t thread_count = 4;
+	constexpr uintptr_t iterations = 4000;
+
+	const std::vector<raw_key_t<AES_t>> keys = random_keys<AES_t>(96, 0x7123AD);
+	std::vector<schedule_t> expected(keys.size());
+	for(uintptr_t i = 0; i < keys.size(); ++i)
+	{
+		AES_t::make_key_schedule(keys[i], expected[i]);
+	}
+
+	crypto::AES_key_cache<AES_t> cache{32};
+	std::array<uintptr_t, thread_count> errors{};
+	std::vector<std::thread> threads;
+	for(uintptr_t t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back([&, t]()
+			{
+				std::mt19937 gen(static_cast<uint32_t>(t));
+				std::uniform_int_distribution<uintptr_t> distrib(0, keys.size() - 1);
+				schedule_t schedule;
+				for(uintptr_t i = 0; i < iterations; ++i)
+				{
+					const uintptr_t index = distrib(gen);
+					cache.get(keys[index], schedule);
+					if(!same_schedule<AES_t>(schedule, expected[index])) ++errors[t];
+					if(cache.find(keys[index], schedule) && !same_schedule<AES_t>(schedule, expected[index])) ++errors[t];
+				}
+			});
+	}
+
+	for(std::thread& tthread : threads)
+	{
+		tthread.join();
+	}
+
+	for(const uintptr_t terrors : errors)
+	{
+		ASSERT_EQ(terrors, 0);
+	}
+}
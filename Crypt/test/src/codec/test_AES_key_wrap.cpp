@@ -0,0 +1,286 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <random>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_key_wrap.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	struct KW_TestCase
+	{
+		std::string_view kek;
+		std::string_view key;
+		std::string_view wrapped;
+	};
+
+	template<typename AES_t, bool Padded>
+	void check_KW_case(const KW_TestCase& p_case)
+	{
+		using KW_t = crypto::AES_key_wrap<AES_t>;
+		constexpr uintptr_t key_lenght = AES_t::key_lenght;
+
+		const std::vector<uint8_t> kek		= testUtils::hex_data(p_case.kek);
+		const std::vector<uint8_t> key		= testUtils::hex_data(p_case.key);
+		const std::vector<uint8_t> wrapped	= testUtils::hex_data(p_case.wrapped);
+		ASSERT_EQ(kek.size(), key_lenght);
+
+		typename AES_t::key_schedule_t tkey_schedule;
+		typename AES_t::dec_key_schedule_t tdec_key_schedule;
+		AES_t::make_key_schedule(std::span<const uint8_t, key_lenght>{kek.data(), key_lenght}, tkey_schedule);
+		AES_t::make_dec_key_schedule(tkey_schedule, tdec_key_schedule);
+
+		std::vector<uint8_t> out(wrapped.size());
+		if constexpr(Padded)
+		{
+			ASSERT_EQ(KW_t::wrap_pad_size(key.size()), wrapped.size());
+			ASSERT_TRUE(KW_t::wrap_pad(tkey_schedule, key, out));
+		}
+		else
+		{
+			ASSERT_TRUE(KW_t::wrap(tkey_schedule, key, out));
+		}
+		ASSERT_TRUE(out == wrapped)
+			<< "\n  Actual: " << testPrint{out}
+			<< "\nExpected: " << testPrint{wrapped};
+
+		//in place
+		std::vector<uint8_t> buffer = wrapped;
+		uintptr_t out_size = 0;
+		if constexpr(Padded)
+		{
+			ASSERT_TRUE(KW_t::unwrap_pad(tdec_key_schedule, buffer, buffer, out_size));
+		}
+		else
+		{
+			ASSERT_TRUE(KW_t::unwrap(tdec_key_schedule, buffer, buffer));
+			out_size = buffer.size() - 8;
+		}
+		ASSERT_EQ(out_size, key.size());
+		ASSERT_TRUE(std::equal(key.begin(), key.end(), buffer.begin()))
+			<< "\n  Actual: " << testPrint{std::span<const uint8_t>{buffer.data(), out_size}}
+			<< "\nExpected: " << testPrint{key};
+
+		//integrity check
+		for(const uintptr_t pos : {uintptr_t{0}, wrapped.size() - 1})
+		{
+			buffer = wrapped;
+			buffer[pos] ^= 0x10;
+			std::vector<uint8_t> unwrapped(wrapped.size() - 8, 0xFF);
+			if constexpr(Padded)
+			{
+				ASSERT_FALSE(KW_t::unwrap_pad(tdec_key_schedule, buffer, unwrapped, out_size));
+				ASSERT_EQ(out_size, 0);
+			}
+			else
+			{
+				ASSERT_FALSE(KW_t::unwrap(tdec_key_schedule, buffer, unwrapped));
+			}
+			ASSERT_TRUE(std::all_of(unwrapped.begin(), unwrapped.end(), [](const uint8_t p_val){ return p_val == 0; }));
+		}
+	}
+
+	template<typename AES_t>
+	void check_KW_parameters()
+	{
+		using KW_t = crypto::AES_key_wrap<AES_t>;
+
+		typename AES_t::key_schedule_t tkey_schedule{};
+		typename AES_t::dec_key_schedule_t tdec_key_schedule{};
+		std::array<uint8_t, 40> buffer{};
+		uintptr_t out_size;
+
+		ASSERT_FALSE(KW_t::wrap(tkey_schedule, std::span<const uint8_t>{buffer.data(), 8}, buffer));
+		ASSERT_FALSE(KW_t::wrap(tkey_schedule, std::span<const uint8_t>{buffer.data(), 20}, buffer));
+		ASSERT_FALSE(KW_t::wrap(tkey_schedule, std::span<const uint8_t>{buffer.data(), 16}, std::span<uint8_t>{buffer.data(), 16}));
+		ASSERT_FALSE(KW_t::unwrap(tdec_key_schedule, std::span<const uint8_t>{buffer.data(), 16}, buffer));
+		ASSERT_FALSE(KW_t::unwrap(tdec_key_schedule, std::span<const uint8_t>{buffer.data(), 28}, buffer));
+		ASSERT_FALSE(KW_t::unwrap(tdec_key_schedule, std::span<const uint8_t>{buffer.data(), 32}, std::span<uint8_t>{buffer.data(), 16}));
+		ASSERT_FALSE(KW_t::wrap_pad(tkey_schedule, std::span<const uint8_t>{}, buffer));
+		ASSERT_FALSE(KW_t::wrap_pad(tkey_schedule, std::span<const uint8_t>{buffer.data(), 9}, std::span<uint8_t>{buffer.data(), 16}));
+		ASSERT_FALSE(KW_t::unwrap_pad(tdec_key_schedule, std::span<const uint8_t>{buffer.data(), 8}, buffer, out_size));
+		ASSERT_FALSE(KW_t::unwrap_pad(tdec_key_schedule, std::span<const uint8_t>{buffer.data(), 20}, buffer, out_size));
+	}
+
+	//	Note: Many keys of different sizes under a few key encryption keys, some of them corrupted.
+	//	The batch is compared against the single unwrap.
+	template<typename AES_t, bool Padded>
+	void check_KW_batch()
+	{
+		using KW_t = crypto::AES_key_wrap<AES_t>;
+		using job_t = typename KW_t::job_t;
+		constexpr uintptr_t key_lenght = AES_t::key_lenght;
+		constexpr uintptr_t kek_count = 3;
+		constexpr uintptr_t job_count = 61;
+
+		std::mt19937 gen(0x3394);
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+		std::uniform_int_distribution<uintptr_t> size_distrib(Padded ? 1 : 2, Padded ? 70 : 9);
+
+		std::array<typename AES_t::key_schedule_t, kek_count> wkey;
+		std::array<typename AES_t::dec_key_schedule_t, kek_count> dkey;
+		for(uintptr_t i = 0; i < kek_count; ++i)
+		{
+			std::array<uint8_t, key_lenght> kek;
+			for(uint8_t& tbyte : kek) tbyte = static_cast<uint8_t>(distrib(gen));
+			AES_t::make_key_schedule(kek, wkey[i]);
+			AES_t::make_dec_key_schedule(wkey[i], dkey[i]);
+		}
+
+		std::vector<std::vector<uint8_t>> keys(job_count);
+		std::vector<std::vector<uint8_t>> wrapped(job_count);
+		std::vector<bool> corrupt(job_count);
+		for(uintptr_t i = 0; i < job_count; ++i)
+		{
+			keys[i].resize(Padded ? size_distrib(gen) : size_distrib(gen) * 8);
+			for(uint8_t& tbyte : keys[i]) tbyte = static_cast<uint8_t>(distrib(gen));
+
+			if constexpr(Padded)
+			{
+				wrapped[i].resize(KW_t::wrap_pad_size(keys[i].size()));
+				ASSERT_TRUE(KW_t::wrap_pad(wkey[i % kek_count], keys[i], wrapped[i]));
+			}
+			else
+			{
+				wrapped[i].resize(keys[i].size() + 8);
+				ASSERT_TRUE(KW_t::wrap(wkey[i % kek_count], keys[i], wrapped[i]));
+			}
+
+			corrupt[i] = (i % 7) == 3;
+			if(corrupt[i])
+			{
+				wrapped[i][i % wrapped[i].size()] ^= 0x01;
+			}
+		}
+
+		testUtils::for_each_AES_engine([&]
+			{
+				std::vector<std::vector<uint8_t>> out(job_count);
+				std::vector<job_t> jobs(job_count);
+				for(uintptr_t i = 0; i < job_count; ++i)
+				{
+					out[i].resize(wrapped[i].size() - 8, 0xFF);
+					jobs[i].dkey	= &dkey[i % kek_count];
+					jobs[i].input	= wrapped[i];
+					jobs[i].out		= out[i];
+				}
+
+				//size not valid
+				std::array<uint8_t, 12> short_input{};
+				jobs[5].input = short_input;
+
+				if constexpr(Padded)
+				{
+					ASSERT_FALSE(KW_t::unwrap_pad(jobs));
+				}
+				else
+				{
+					ASSERT_FALSE(KW_t::unwrap(jobs));
+				}
+
+				for(uintptr_t i = 0; i < job_count; ++i)
+				{
+					SCOPED_TRACE(i);
+					if(i == 5)
+					{
+						ASSERT_FALSE(jobs[i].valid);
+						continue;
+					}
+
+					ASSERT_EQ(jobs[i].valid, !corrupt[i]);
+					if(corrupt[i])
+					{
+						ASSERT_EQ(jobs[i].out_size, 0);
+						ASSERT_TRUE(std::all_of(out[i].begin(), out[i].end(), [](const uint8_t p_val){ return p_val == 0; }));
+					}
+					else
+					{
+						ASSERT_EQ(jobs[i].out_size, keys[i].size());
+						ASSERT_TRUE(std::equal(keys[i].begin(), keys[i].end(), out[i].begin()));
+					}
+				}
+			});
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_key_wrap)
+{
+	testUtils::for_each_AES_engine([&]
+		{
+			//RFC 3394 4.1 - 4.6
+			check_KW_case<crypto::AES_128, false>(KW_TestCase{
+				.kek		= "000102030405060708090A0B0C0D0E0F",
+				.key		= "00112233445566778899AABBCCDDEEFF",
+				.wrapped	= "1FA68B0A8112B447AEF34BD8FB5A7B829D3E862371D2CFE5"});
+
+			check_KW_case<crypto::AES_192, false>(KW_TestCase{
+				.kek		= "000102030405060708090A0B0C0D0E0F1011121314151617",
+				.key		= "00112233445566778899AABBCCDDEEFF",
+				.wrapped	= "96778B25AE6CA435F92B5B97C050AED2468AB8A17AD84E5D"});
+
+			check_KW_case<crypto::AES_256, false>(KW_TestCase{
+				.kek		= "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F",
+				.key		= "00112233445566778899AABBCCDDEEFF0001020304050607",
+				.wrapped	= "A8F9BC1612C68B3FF6E6F4FBE30E71E4769C8B80A32CB8958CD5D17D6B254DA1"});
+
+			check_KW_case<crypto::AES_256, false>(KW_TestCase{
+				.kek		= "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F",
+				.key		= "00112233445566778899AABBCCDDEEFF000102030405060708090A0B0C0D0E0F",
+				.wrapped	= "28C9F404C4B810F4CBCCB35CFB87F8263F5786E2D80ED326CBC7F0E71A99F43BFB988B9B7A02DD21"});
+
+			//RFC 5649 6
+			check_KW_case<crypto::AES_192, true>(KW_TestCase{
+				.kek		= "5840df6e29b02af1ab493b705bf16ea1ae8338f4dcc176a8",
+				.key		= "c37b7e6492584340bed12207808941155068f738",
+				.wrapped	= "138bdeaa9b8fa7fc61f97742e72248ee5ae6ae5360d1ae6a5f54f373fa543b6a"});
+
+			check_KW_case<crypto::AES_192, true>(KW_TestCase{
+				.kek		= "5840df6e29b02af1ab493b705bf16ea1ae8338f4dcc176a8",
+				.key		= "466f7250617369",
+				.wrapped	= "afbeb0f07dfbf5419200f2ccb50bb24f"});
+
+			check_KW_parameters<crypto::AES_128>();
+		});
+
+	check_KW_batch<crypto::AES_128, false>();
+	check_KW_batch<crypto::AES_192, false>();
+	check_KW_batch<crypto::AES_256, false>();
+	check_KW_batch<crypto::AES_128, true>();
+	check_KW_batch<crypto::AES_256, true>();
+}
@@ -0,0 +1,206 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/AES_multi_buffer.hpp>
+#include <Crypt/codec/AES_CBC.hpp>
+#include <Crypt/codec/AES_CTR.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	enum class MB_Mode
+	{
+		ECB,
+		CBC,
+		CBC_MAC,
+		CTR,
+	};
+
+	//	Note: More jobs than lanes, with unequal lengths (including empty ones), so that lanes are refilled and go idle at different times.
+	//	Every other job is done in place. Each job is compared against the single message interface.
+	template<typename AES_t, MB_Mode Mode>
+	void check_multi_buffer()
+	{
+		using MB_t = crypto::AES_multi_buffer<AES_t>;
+		using job_t = typename MB_t::job_t;
+		constexpr uintptr_t block_lenght	= AES_t::block_lenght;
+		constexpr uintptr_t key_lenght		= AES_t::key_lenght;
+		constexpr uintptr_t job_count		= 29;
+
+		std::mt19937 gen(0x3B + static_cast<uint32_t>(Mode));
+		std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+		std::uniform_int_distribution<uintptr_t> size_distrib(0, Mode == MB_Mode::CTR ? 7 * block_lenght : 7);
+
+		std::vector<typename AES_t::key_schedule_t> keys(job_count);
+		std::vector<std::vector<uint8_t>> input(job_count);
+		std::vector<std::vector<uint8_t>> out(job_count);
+		std::vector<job_t> jobs(job_count);
+
+		for(uintptr_t i = 0; i < job_count; ++i)
+		{
+			std::array<uint8_t, key_lenght> key;
+			for(uint8_t& tbyte : key) tbyte = static_cast<uint8_t>(distrib(gen));
+			AES_t::make_key_schedule(key, keys[i]);
+
+			uintptr_t size = size_distrib(gen);
+			if(Mode != MB_Mode::CTR) size *= block_lenght;
+			if(i == 3) size = 40 * block_lenght + (Mode == MB_Mode::CTR ? 5 : 0);
+
+			input[i].resize(size);
+			for(uint8_t& tbyte : input[i]) tbyte = static_cast<uint8_t>(distrib(gen));
+			out[i].resize(size);
+
+			jobs[i].wkey = &keys[i];
+			for(uint8_t& tbyte : jobs[i].iv) tbyte = static_cast<uint8_t>(distrib(gen));
+			if(i == 5)
+			{
+				//counter low half about to wrap
+				std::fill(jobs[i].iv.begin() + 8, jobs[i].iv.end(), uint8_t{0xFF});
+			}
+			jobs[i].input = input[i];
+			jobs[i].out = (i % 2) ? std::span<uint8_t>{input[i]} : std::span<uint8_t>{out[i]};
+		}
+
+		std::vector<std::vector<uint8_t>> expected(job_count);
+		std::vector<std::array<uint8_t, block_lenght>> expected_iv(job_count);
+		for(uintptr_t i = 0; i < job_count; ++i)
+		{
+			expected[i].resize(input[i].size());
+			expected_iv[i] = jobs[i].iv;
+			if constexpr(Mode == MB_Mode::ECB)
+			{
+				AES_t::encode_blocks(keys[i], input[i], expected[i]);
+			}
+			else if constexpr(Mode == MB_Mode::CBC || Mode == MB_Mode::CBC_MAC)
+			{
+				crypto::AES_CBC<AES_t> engine;
+				engine.reset(keys[i], jobs[i].iv);
+				engine.encode(input[i], expected[i]);
+				expected_iv[i] = engine.iv();
+				if constexpr(Mode == MB_Mode::CBC_MAC)
+				{
+					//nothing is written
+					expected[i] = (i % 2) ? input[i] : out[i];
+				}
+			}
+			else
+			{
+				crypto::AES_CTR<AES_t> engine;
+				engine.reset(keys[i], jobs[i].iv);
+				engine.update(input[i], expected[i]);
+				expected_iv[i] = engine.counter();
+			}
+		}
+
+		if constexpr(Mode == MB_Mode::ECB)
+		{
+			ASSERT_TRUE(MB_t::encode_blocks(jobs));
+		}
+		else if constexpr(Mode == MB_Mode::CBC)
+		{
+			ASSERT_TRUE(MB_t::cbc_encode(jobs));
+		}
+		else if constexpr(Mode == MB_Mode::CBC_MAC)
+		{
+			ASSERT_TRUE(MB_t::cbc_mac(jobs));
+		}
+		else
+		{
+			MB_t::ctr_xor(jobs);
+		}
+
+		for(uintptr_t i = 0; i < job_count; ++i)
+		{
+			const std::vector<uint8_t>& result = (i % 2) ? input[i] : out[i];
+			ASSERT_TRUE(result == expected[i]) << "Job " << i
+				<< "\n  Actual: " << testPrint{result}
+				<< "\nExpected: " << testPrint{expected[i]};
+			ASSERT_TRUE(jobs[i].iv == expected_iv[i]) << "Job " << i;
+		}
+	}
+
+	template<typename AES_t>
+	void check_multi_buffer_size()
+	{
+		using MB_t = crypto::AES_multi_buffer<AES_t>;
+		constexpr uintptr_t block_lenght = AES_t::block_lenght;
+
+		typename AES_t::key_schedule_t tkey_schedule{};
+		std::array<uint8_t, block_lenght * 2> buffer{};
+		const std::array<uint8_t, block_lenght * 2> original = buffer;
+
+		std::array<typename MB_t::job_t, 2> jobs;
+		jobs[0].wkey	= &tkey_schedule;
+		jobs[0].input	= std::span<const uint8_t>{buffer.data(), block_lenght};
+		jobs[0].out		= std::span<uint8_t>{buffer.data(), block_lenght};
+		jobs[1].wkey	= &tkey_schedule;
+		jobs[1].input	= std::span<const uint8_t>{buffer.data() + block_lenght, block_lenght - 1};
+		jobs[1].out		= std::span<uint8_t>{buffer.data() + block_lenght, block_lenght - 1};
+
+		ASSERT_FALSE(MB_t::encode_blocks(jobs));
+		ASSERT_FALSE(MB_t::cbc_encode(jobs));
+		ASSERT_FALSE(MB_t::cbc_mac(jobs));
+		ASSERT_TRUE(buffer == original);
+	}
+} //namespace
+
+TEST(codec_symmetric, AES_multi_buffer)
+{
+	testUtils::for_each_AES_engine([&]
+		{
+			check_multi_buffer<crypto::AES_128, MB_Mode::ECB>();
+			check_multi_buffer<crypto::AES_192, MB_Mode::ECB>();
+			check_multi_buffer<crypto::AES_256, MB_Mode::ECB>();
+
+			check_multi_buffer<crypto::AES_128, MB_Mode::CBC>();
+			check_multi_buffer<crypto::AES_192, MB_Mode::CBC>();
+			check_multi_buffer<crypto::AES_256, MB_Mode::CBC>();
+
+			check_multi_buffer<crypto::AES_128, MB_Mode::CBC_MAC>();
+			check_multi_buffer<crypto::AES_192, MB_Mode::CBC_MAC>();
+			check_multi_buffer<crypto::AES_256, MB_Mode::CBC_MAC>();
+
+			check_multi_buffer<crypto::AES_128, MB_Mode::CTR>();
+			check_multi_buffer<crypto::AES_192, MB_Mode::CTR>();
+			check_multi_buffer<crypto::AES_256, MB_Mode::CTR>();
+
+			check_multi_buffer_size<crypto::AES_128>();
+			check_multi_buffer_size<crypto::AES_256>();
+		});
+}
@@ -0,0 +1,215 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <array>
+#include <random>
+#include <vector>
+#include <string_view>
+
+#include <CoreLib/core_type.hpp>
+#include <CoreLib/toPrint/toPrint.hpp>
+#include <CoreLib/toPrint/toPrint_std_ostream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/codec/ChaCha20_Poly1305.hpp>
+
+#include <test_utils.hpp>
+
+namespace
+{
+	constexpr std::array ChaCha20_engines
+	{
+		crypto::ChaCha20_engine::software,
+		crypto::ChaCha20_engine::SSE2,
+		crypto::ChaCha20_engine::AVX2,
+		crypto::ChaCha20_engine::AVX512,
+	};
+
+	constexpr std::string_view sunscreen = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+
+	//	Note: Sizes around the 4, 8 and 16 block groups, the vectorized Poly1305 and the AEAD chunks.
+	//	Every engine is compared against the software engine.
+	constexpr std::array<uintptr_t, 12> stream_sizes{1, 63, 64, 255, 256, 511, 512, 1023, 1024, 1089, 4096, 9000};
+} //namespace
+
+TEST(codec_symmetric, ChaCha20)
+{
+	//RFC 8439 2.4.2
+	const std::vector<uint8_t> key		= testUtils::hex_data("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+	const std::vector<uint8_t> nonce	= testUtils::hex_data("000000000000004a00000000");
+	const std::vector<uint8_t> expected	= testUtils::hex_data(
+		"6e2e359a2568f98041ba0728dd0d6981e97e7aec1d4360c20a27afccfd9fae0bf91b65c5524733ab8f593dabcd62b357"
+		"1639d624e65152ab8f530c359f0861d807ca0dbf500d6a6156a38e088a22b65e52bc514d16ccf806818ce91ab7793736"
+		"5af90bbf74a35be6b40b8eedf2785e42874d");
+	const std::span<const uint8_t, crypto::ChaCha20::key_lenght> tkey{key.data(), crypto::ChaCha20::key_lenght};
+	const std::span<const uint8_t, crypto::ChaCha20::nonce_lenght> tnonce{nonce.data(), crypto::ChaCha20::nonce_lenght};
+	const std::span<const uint8_t> plain{reinterpret_cast<const uint8_t*>(sunscreen.data()), sunscreen.size()};
+
+	std::mt19937 gen(0x8439);
+	std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+	std::vector<uint8_t> data(stream_sizes.back());
+	for(uint8_t& tbyte : data) tbyte = static_cast<uint8_t>(distrib(gen));
+
+	std::array<std::vector<uint8_t>, stream_sizes.size()> stream;
+	{
+		ASSERT_TRUE(crypto::ChaCha20_set_engine(crypto::ChaCha20_engine::software));
+		for(uintptr_t i = 0; i < stream_sizes.size(); ++i)
+		{
+			stream[i].resize(stream_sizes[i]);
+			ASSERT_TRUE(crypto::ChaCha20::xor_stream(tkey, tnonce, 7, std::span<const uint8_t>{data.data(), stream_sizes[i]}, stream[i]));
+		}
+	}
+
+	for(const crypto::ChaCha20_engine tengine : ChaCha20_engines)
+	{
+		if(!crypto::ChaCha20_set_engine(tengine))
+		{
+			continue;
+		}
+		SCOPED_TRACE(static_cast<uint32_t>(tengine));
+
+		std::vector<uint8_t> buffer(plain.size());
+		ASSERT_TRUE(crypto::ChaCha20::xor_stream(tkey, tnonce, 1, plain, buffer));
+		ASSERT_TRUE(buffer == expected)
+			<< "\n  Actual: " << testPrint{buffer}
+			<< "\nExpected: " << testPrint{expected};
+
+		//in place
+		ASSERT_TRUE(crypto::ChaCha20::xor_stream(tkey, tnonce, 1, buffer, buffer));
+		ASSERT_TRUE(std::equal(buffer.begin(), buffer.end(), plain.begin()));
+
+		for(uintptr_t i = 0; i < stream_sizes.size(); ++i)
+		{
+			SCOPED_TRACE(stream_sizes[i]);
+			std::vector<uint8_t> out(stream_sizes[i]);
+			ASSERT_TRUE(crypto::ChaCha20::xor_stream(tkey, tnonce, 7, std::span<const uint8_t>{data.data(), stream_sizes[i]}, out));
+			ASSERT_TRUE(out == stream[i]);
+		}
+
+		//the block counter does not wrap around
+		std::array<uint8_t, crypto::ChaCha20::block_lenght + 1> block{};
+		ASSERT_TRUE(crypto::ChaCha20::xor_stream(tkey, tnonce, 0xFFFFFFFF, std::span<uint8_t>{block.data(), crypto::ChaCha20::block_lenght}, block));
+		ASSERT_FALSE(crypto::ChaCha20::xor_stream(tkey, tnonce, 0xFFFFFFFF, block, block));
+
+		std::array<uint8_t, 4> small;
+		ASSERT_FALSE(crypto::ChaCha20::xor_stream(tkey, tnonce, 0, std::span<const uint8_t>{data.data(), 5}, small));
+	}
+
+	ASSERT_TRUE(crypto::ChaCha20_set_engine(crypto::ChaCha20_engine::automatic));
+}
+
+TEST(codec_symmetric, ChaCha20_Poly1305)
+{
+	using AEAD_t = crypto::ChaCha20_Poly1305;
+
+	//RFC 8439 2.8.2
+	const std::vector<uint8_t> key		= testUtils::hex_data("808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f");
+	const std::vector<uint8_t> nonce	= testUtils::hex_data("070000004041424344454647");
+	const std::vector<uint8_t> aad		= testUtils::hex_data("50515253c0c1c2c3c4c5c6c7");
+	const std::vector<uint8_t> cipher	= testUtils::hex_data(
+		"d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d63dbea45e8ca9671282fafb69da92728b"
+		"1a71de0a9e060b2905d6a5b67ecd3b3692ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc"
+		"3ff4def08e4b7a9de576d26586cec64b6116");
+	const std::vector<uint8_t> expected_tag = testUtils::hex_data("1ae10b594f09e26a7e902ecbd0600691");
+	const std::span<const uint8_t, AEAD_t::key_lenght> tkey{key.data(), AEAD_t::key_lenght};
+	const std::span<const uint8_t, AEAD_t::nonce_lenght> tnonce{nonce.data(), AEAD_t::nonce_lenght};
+	const std::span<const uint8_t> plain{reinterpret_cast<const uint8_t*>(sunscreen.data()), sunscreen.size()};
+	AEAD_t::tag_t tag;
+	std::copy(expected_tag.begin(), expected_tag.end(), tag.begin());
+
+	std::mt19937 gen(0x1305);
+	std::uniform_int_distribution<uint16_t> distrib(0, 0xFF);
+	std::vector<uint8_t> stream_aad(333);
+	std::vector<uint8_t> data(stream_sizes.back());
+	for(uint8_t& tbyte : stream_aad)	tbyte = static_cast<uint8_t>(distrib(gen));
+	for(uint8_t& tbyte : data)			tbyte = static_cast<uint8_t>(distrib(gen));
+
+	AEAD_t engine;
+	engine.set_key(tkey);
+
+	std::array<std::vector<uint8_t>, stream_sizes.size()> expected;
+	std::array<AEAD_t::tag_t, stream_sizes.size()> stream_tag;
+	{
+		ASSERT_TRUE(crypto::ChaCha20_set_engine(crypto::ChaCha20_engine::software));
+		for(uintptr_t i = 0; i < stream_sizes.size(); ++i)
+		{
+			expected[i].resize(stream_sizes[i]);
+			ASSERT_TRUE(engine.encode(tnonce, stream_aad, std::span<const uint8_t>{data.data(), stream_sizes[i]}, expected[i], stream_tag[i]));
+		}
+	}
+
+	for(const crypto::ChaCha20_engine tengine : ChaCha20_engines)
+	{
+		if(!crypto::ChaCha20_set_engine(tengine))
+		{
+			continue;
+		}
+		SCOPED_TRACE(static_cast<uint32_t>(tengine));
+
+		std::vector<uint8_t> buffer(plain.size());
+		AEAD_t::tag_t out_tag;
+		ASSERT_TRUE(engine.encode(tnonce, aad, plain, buffer, out_tag));
+		ASSERT_TRUE(buffer == cipher)
+			<< "\n  Actual: " << testPrint{buffer}
+			<< "\nExpected: " << testPrint{cipher};
+		ASSERT_TRUE(out_tag == tag)
+			<< "\n  Actual: " << testPrint{out_tag}
+			<< "\nExpected: " << testPrint{tag};
+
+		//in place
+		ASSERT_TRUE(engine.decode(tnonce, aad, buffer, buffer, tag));
+		ASSERT_TRUE(std::equal(buffer.begin(), buffer.end(), plain.begin()));
+
+		buffer = cipher;
+		ASSERT_FALSE(engine.decode(tnonce, std::span<const uint8_t>{aad.data(), aad.size() - 1}, buffer, buffer, tag));
+		ASSERT_TRUE(std::all_of(buffer.begin(), buffer.end(), [](const uint8_t p_val){ return p_val == 0; }));
+
+		for(uintptr_t i = 0; i < stream_sizes.size(); ++i)
+		{
+			SCOPED_TRACE(stream_sizes[i]);
+			std::vector<uint8_t> stream{data.begin(), data.begin() + stream_sizes[i]};
+			AEAD_t::tag_t stag;
+			ASSERT_TRUE(engine.encode(tnonce, stream_aad, stream, stream, stag));
+			ASSERT_TRUE(stream == expected[i]);
+			ASSERT_TRUE(stag == stream_tag[i]);
+
+			ASSERT_TRUE(engine.decode(tnonce, stream_aad, stream, stream, stag));
+			ASSERT_TRUE(std::equal(stream.begin(), stream.end(), data.begin()));
+
+			stream = expected[i];
+			stream[stream_sizes[i] / 2] ^= 0x01;
+			ASSERT_FALSE(engine.decode(tnonce, stream_aad, stream, stream, stag));
+		}
+
+		std::array<uint8_t, 4> small;
+		ASSERT_FALSE(engine.encode(tnonce, aad, std::span<const uint8_t>{data.data(), 5}, small, out_tag));
+	}
+
+	ASSERT_TRUE(crypto::ChaCha20_set_engine(crypto::ChaCha20_engine::automatic));
+}
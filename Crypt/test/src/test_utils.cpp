@@ -210,6 +210,46 @@ namespace testUtils
 		return outp;
 	}
 
+	std::vector<uint8_t> hex_data(const std::string_view p_text)
+	{
+		const auto nibble = [](const char p_char) -> int16_t
+			{
+				if(p_char >= '0' && p_char <= '9') return static_cast<int16_t>(p_char - '0');
+				if(p_char >= 'a' && p_char <= 'f') return static_cast<int16_t>(p_char - 'a' + 10);
+				if(p_char >= 'A' && p_char <= 'F') return static_cast<int16_t>(p_char - 'A' + 10);
+				return -1;
+			};
+
+		std::vector<uint8_t> outp;
+		int16_t high = -1;
+		for(const char tchar : p_text)
+		{
+			if(tchar == ' ')
+			{
+				continue;
+			}
+			const int16_t val = nibble(tchar);
+			if(val < 0)
+			{
+				return {};
+			}
+			if(high < 0)
+			{
+				high = val;
+			}
+			else
+			{
+				outp.push_back(static_cast<uint8_t>((high << 4) | val));
+				high = -1;
+			}
+		}
+		if(high >= 0)
+		{
+			return {};
+		}
+		return outp;
+	}
+
 	static std::vector<uint8_t> get_hash(const scef::keyedValue& p_key, const uint32_t p_expectedSize)
 	{
 		std::u32string_view tvalue = p_key.value();
@@ -27,16 +27,22 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <vector>
 #include <filesystem>
 #include <string_view>
 #include <optional>
+#include <type_traits>
 
 #include <CoreLib/core_type.hpp>
 #include <CoreLib/toPrint/toPrint.hpp>
 #include <CoreLib/toPrint/toPrint_std_ostream.hpp>
 
+#include <gtest/gtest.h>
+
+#include <Crypt/codec/AES.hpp>
+
 class testPrint: public core::toPrint_base
 {
 public:
@@ -133,6 +139,51 @@ namespace testUtils
 	EncodeList	getSymmetricEncodeList	(const std::filesystem::path& p_configPath, std::u32string_view p_codecName, uint32_t p_keySize);
 	PairList	getPrivatePublicKeyList	(const std::filesystem::path& p_configPath, std::u32string_view p_codecName, uint32_t p_privateKeySize, uint32_t p_publicKeySize);
 
+	///	\brief Converts an hexadecimal string to binary, spaces are ignored.
+	///	\return empty on malformed input
+	std::vector<uint8_t> hex_data(std::string_view p_text);
+
+	inline constexpr std::array AES_engines
+	{
+		crypto::AES_engine::software,
+		crypto::AES_engine::T_table,
+		crypto::AES_engine::bitsliced,
+		crypto::AES_engine::AES_NI,
+		crypto::AES_engine::VAES_AVX2,
+		crypto::AES_engine::VAES_AVX512,
+	};
+
+	///	\brief Runs \p p_callable once for every AES engine the host supports, with that engine selected.
+	///	\param[in] p_callable - Either takes no arguments or takes the selected crypto::AES_engine.
+	///	\note Stops at the first fatal failure, and restores crypto::AES_engine::automatic before returning.
+	template<typename Callable>
+	void for_each_AES_engine(Callable&& p_callable)
+	{
+		for(const crypto::AES_engine tengine : AES_engines)
+		{
+			if(!crypto::AES_set_engine(tengine))
+			{
+				continue;
+			}
+			SCOPED_TRACE(static_cast<uint32_t>(tengine));
+
+			if constexpr(std::is_invocable_v<Callable&, crypto::AES_engine>)
+			{
+				p_callable(tengine);
+			}
+			else
+			{
+				p_callable();
+			}
+
+			if(::testing::Test::HasFatalFailure())
+			{
+				break;
+			}
+		}
+		crypto::AES_set_engine(crypto::AES_engine::automatic);
+	}
+
 
 
 
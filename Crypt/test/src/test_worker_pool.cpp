@@ -0,0 +1,93 @@
+//======== ======== ======== ======== ======== ======== ======== ========
+///	\file
+///
+///	\copyright
+///		Copyright (c) Tiago Miguel Oliveira Freire
+///
+///		Permission is hereby granted, free of charge, to any person obtaining a copy
+///		of this software and associated documentation files (the "Software"),
+///		to copy, modify, publish, and/or distribute copies of the Software,
+///		and to permit persons to whom the Software is furnished to do so,
+///		subject to the following conditions:
+///
+///		The copyright notice and this permission notice shall be included in all
+///		copies or substantial portions of the Software.
+///		The copyrighted work, or derived works, shall not be used to train
+///		Artificial Intelligence models of any sort; or otherwise be used in a
+///		transformative way that could obfuscate the source of the copyright.
+///
+///		THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+///		IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+///		FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+///		AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+///		LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+///		OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+///		SOFTWARE.
+//======== ======== ======== ======== ======== ======== ======== ========
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <Crypt/worker_pool.hpp>
+
+TEST(worker_pool, run)
+{
+	constexpr uintptr_t task_count = 1000;
+
+	for(const uint32_t threads : {1u, 2u, 4u, 9u})
+	{
+		SCOPED_TRACE(threads);
+		crypto::worker_pool pool(threads);
+		ASSERT_EQ(pool.size(), threads);
+
+		std::vector<std::atomic<uint32_t>> calls(task_count);
+		auto task = [&](const uintptr_t p_index)
+			{
+				calls[p_index].fetch_add(1, std::memory_order_relaxed);
+			};
+
+		//every task exactly once per call, over many calls so that late workers overlap the next one
+		constexpr uint32_t runs = 200;
+		for(uint32_t i = 0; i < runs; ++i)
+		{
+			pool.run(task_count, task);
+		}
+		for(const std::atomic<uint32_t>& tcalls : calls)
+		{
+			ASSERT_EQ(tcalls.load(), runs);
+		}
+
+		pool.run(0, task);
+		pool.run(1, task);
+		ASSERT_EQ(calls[0].load(), runs + 1);
+		ASSERT_EQ(calls[1].load(), runs);
+	}
+}
+
+TEST(worker_pool, concurrent_callers)
+{
+	crypto::worker_pool pool(3);
+	std::atomic<uint64_t> sum{0};
+
+	auto caller = [&]
+		{
+			auto task = [&](const uintptr_t p_index)
+				{
+					sum.fetch_add(p_index, std::memory_order_relaxed);
+				};
+			for(uint32_t i = 0; i < 100; ++i)
+			{
+				pool.run(100, task);
+			}
+		};
+
+	std::thread other(caller);
+	caller();
+	other.join();
+
+	ASSERT_EQ(sum.load(), uint64_t{2} * 100 * (99 * 100 / 2));
+}